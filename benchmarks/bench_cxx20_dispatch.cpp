@@ -0,0 +1,224 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Per-event cost of the C++20 EventDispatcher.
+//
+// A stream of queued events is fed through EventDispatcher::queueCallback,
+// called through a function pointer like maru_scanQueue() does, and through
+// an equivalent callback built on the `switch` the dispatch table replaced.
+// The visitor handles six event types; the stream mixes those with ids it
+// ignores.
+//
+// Usage: maru_bench_cxx20_dispatch [iterations]
+
+#include "maru/maru.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace {
+
+using namespace maru;
+
+constexpr uint32_t kBenchEvents = 4096u;
+
+// The dispatch EventDispatcher used before the table, kept for reference.
+template <typename Visitor>
+void bench_switch_dispatch(MARU_EventId type, MARU_WindowId window_id,
+                           const MARU_Event &evt, Visitor &&f) {
+  using F_raw = std::remove_cvref_t<Visitor>;
+  switch (type) {
+    case MARU_EVENT_WINDOW_READY:
+      if constexpr (std::invocable<F_raw, QueuedWindowReadyEvent>)
+        f(QueuedWindowReadyEvent{window_id, evt.window_ready});
+      break;
+    case MARU_EVENT_CLOSE_REQUESTED:
+      if constexpr (std::invocable<F_raw, QueuedCloseRequestedEvent>)
+        f(QueuedCloseRequestedEvent{window_id, evt.close_requested});
+      break;
+    case MARU_EVENT_WINDOW_RESIZED:
+      if constexpr (std::invocable<F_raw, QueuedWindowResizedEvent>)
+        f(QueuedWindowResizedEvent{window_id, evt.window_resized});
+      break;
+    case MARU_EVENT_WINDOW_STATE_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedWindowStateChangedEvent>)
+        f(QueuedWindowStateChangedEvent{window_id, evt.window_state_changed});
+      break;
+    case MARU_EVENT_KEY_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedKeyChangedEvent>)
+        f(QueuedKeyChangedEvent{window_id, evt.key_changed});
+      break;
+    case MARU_EVENT_MOUSE_MOVED:
+      if constexpr (std::invocable<F_raw, QueuedMouseMovedEvent>)
+        f(QueuedMouseMovedEvent{window_id, evt.mouse_moved});
+      break;
+    case MARU_EVENT_MOUSE_BUTTON_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedMouseButtonChangedEvent>)
+        f(QueuedMouseButtonChangedEvent{window_id, evt.mouse_button_changed});
+      break;
+    case MARU_EVENT_MOUSE_SCROLLED:
+      if constexpr (std::invocable<F_raw, QueuedMouseScrolledEvent>)
+        f(QueuedMouseScrolledEvent{window_id, evt.mouse_scrolled});
+      break;
+    case MARU_EVENT_IDLE_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedIdleEvent>)
+        f(QueuedIdleEvent{window_id, evt.idle_changed});
+      break;
+    case MARU_EVENT_MONITOR_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedMonitorChangedEvent>)
+        f(QueuedMonitorChangedEvent{window_id, evt.monitor_changed});
+      break;
+    case MARU_EVENT_MONITOR_MODE_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedMonitorModeEvent>)
+        f(QueuedMonitorModeEvent{window_id, evt.monitor_mode_changed});
+      break;
+    case MARU_EVENT_DROP_ENTERED:
+      if constexpr (std::invocable<F_raw, QueuedDropEnteredEvent>)
+        f(QueuedDropEnteredEvent{window_id, evt.drop_entered});
+      break;
+    case MARU_EVENT_DROP_HOVERED:
+      if constexpr (std::invocable<F_raw, QueuedDropHoveredEvent>)
+        f(QueuedDropHoveredEvent{window_id, evt.drop_hovered});
+      break;
+    case MARU_EVENT_DROP_EXITED:
+      if constexpr (std::invocable<F_raw, QueuedDropExitedEvent>)
+        f(QueuedDropExitedEvent{window_id, evt.drop_exited});
+      break;
+    case MARU_EVENT_DROP_DROPPED:
+      if constexpr (std::invocable<F_raw, QueuedDropDroppedEvent>)
+        f(QueuedDropDroppedEvent{window_id, evt.drop_dropped});
+      break;
+    case MARU_EVENT_DATA_RECEIVED:
+      if constexpr (std::invocable<F_raw, QueuedDataReceivedEvent>)
+        f(QueuedDataReceivedEvent{window_id, evt.data_received});
+      break;
+    case MARU_EVENT_DATA_REQUESTED:
+      if constexpr (std::invocable<F_raw, QueuedDataRequestEvent>)
+        f(QueuedDataRequestEvent{window_id, evt.data_requested});
+      break;
+    case MARU_EVENT_DATA_RELEASED:
+      if constexpr (std::invocable<F_raw, QueuedDataReleasedEvent>)
+        f(QueuedDataReleasedEvent{window_id, evt.data_released});
+      break;
+    case MARU_EVENT_DRAG_FINISHED:
+      if constexpr (std::invocable<F_raw, QueuedDragFinishedEvent>)
+        f(QueuedDragFinishedEvent{window_id, evt.drag_finished});
+      break;
+    case MARU_EVENT_CONTROLLER_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedControllerChangedEvent>)
+        f(QueuedControllerChangedEvent{window_id, evt.controller_changed});
+      break;
+    case MARU_EVENT_CONTROLLER_BUTTON_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedControllerButtonChangedEvent>)
+        f(QueuedControllerButtonChangedEvent{window_id, evt.controller_button_changed});
+      break;
+    case MARU_EVENT_CONTROLLER_ANALOG_CHANGED:
+      if constexpr (std::invocable<F_raw, QueuedControllerAnalogChangedEvent>)
+        f(QueuedControllerAnalogChangedEvent{window_id, evt.controller_analog_changed});
+      break;
+    case MARU_EVENT_WINDOW_FRAME:
+      if constexpr (std::invocable<F_raw, QueuedWindowFrameEvent>)
+        f(QueuedWindowFrameEvent{window_id, evt.window_frame});
+      break;
+    case MARU_EVENT_TEXT_EDIT_STARTED:
+      if constexpr (std::invocable<F_raw, QueuedTextEditStartedEvent>)
+        f(QueuedTextEditStartedEvent{window_id, evt.text_edit_started});
+      break;
+    case MARU_EVENT_TEXT_EDIT_UPDATED:
+      if constexpr (std::invocable<F_raw, QueuedTextEditUpdatedEvent>)
+        f(QueuedTextEditUpdatedEvent{window_id, evt.text_edit_updated});
+      break;
+    case MARU_EVENT_TEXT_EDIT_COMMITTED:
+      if constexpr (std::invocable<F_raw, QueuedTextEditCommittedEvent>)
+        f(QueuedTextEditCommittedEvent{window_id, evt.text_edit_committed});
+      break;
+    case MARU_EVENT_TEXT_EDIT_ENDED:
+      if constexpr (std::invocable<F_raw, QueuedTextEditEndedEvent>)
+        f(QueuedTextEditEndedEvent{window_id, evt.text_edit_ended});
+      break;
+    default:
+      break;
+  }
+}
+
+struct BenchVisitor {
+  uint64_t *sink;
+  void operator()(maru::QueuedMouseMovedEvent e) const { *sink += e.window_id; }
+  void operator()(maru::QueuedMouseScrolledEvent e) const { *sink += e.window_id * 3u; }
+  void operator()(maru::QueuedKeyChangedEvent e) const { *sink += e.window_id * 5u; }
+  void operator()(maru::QueuedWindowResizedEvent e) const { *sink += e.window_id * 7u; }
+  void operator()(maru::QueuedWindowFrameEvent e) const { *sink += e.window_id * 11u; }
+  void operator()(maru::QueuedCloseRequestedEvent e) const { *sink += e.window_id * 13u; }
+};
+
+void bench_switch_callback(MARU_EventId type, MARU_WindowId window_id, const MARU_Event *evt,
+                           void *userdata) {
+  bench_switch_dispatch(type, window_id, *evt, *static_cast<BenchVisitor *>(userdata));
+}
+
+struct BenchEntry {
+  MARU_EventId type;
+  MARU_WindowId window_id;
+};
+
+template <typename Callback>
+double bench_ns_per_event(const std::vector<BenchEntry> &entries, const MARU_Event &evt,
+                          Callback volatile &callback, void *userdata, uint32_t iterations) {
+  const auto start = std::chrono::steady_clock::now();
+  for (uint32_t it = 0; it < iterations; ++it) {
+    const Callback cb = callback;
+    for (const BenchEntry &entry : entries) {
+      cb(entry.type, entry.window_id, &evt, userdata);
+    }
+  }
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+         (static_cast<double>(iterations) * static_cast<double>(entries.size()));
+}
+
+}  // namespace
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 20000u;
+  if (argc > 1) {
+    iterations = static_cast<uint32_t>(std::strtoul(argv[1], nullptr, 10));
+    if (iterations == 0) {
+      std::fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  static const MARU_EventId ids[] = {
+      MARU_EVENT_MOUSE_MOVED,   MARU_EVENT_MOUSE_SCROLLED,   MARU_EVENT_KEY_CHANGED,
+      MARU_EVENT_WINDOW_RESIZED, MARU_EVENT_WINDOW_FRAME,    MARU_EVENT_CLOSE_REQUESTED,
+      MARU_EVENT_IDLE_CHANGED,  MARU_EVENT_MOUSE_BUTTON_CHANGED, MARU_EVENT_USER_0,
+      MARU_EVENT_TEXT_EDIT_UPDATED};
+  std::vector<BenchEntry> entries(kBenchEvents);
+  uint32_t seed = 0x9e3779b9u;
+  for (BenchEntry &entry : entries) {
+    seed = seed * 1664525u + 1013904223u;
+    entry.type = ids[(seed >> 16) % (sizeof(ids) / sizeof(ids[0]))];
+    entry.window_id = (seed >> 8) & 0xffu;
+  }
+  const MARU_Event evt = {};
+
+  uint64_t sink = 0;
+  maru::EventDispatcher<BenchVisitor> dispatcher(BenchVisitor{&sink});
+  BenchVisitor reference_visitor{&sink};
+  MARU_QueueEventCallback volatile table_cb = &maru::EventDispatcher<BenchVisitor>::queueCallback;
+  MARU_QueueEventCallback volatile switch_cb = &bench_switch_callback;
+
+  // Warm up both paths before timing.
+  bench_ns_per_event(entries, evt, switch_cb, &reference_visitor, iterations / 10u + 1u);
+  bench_ns_per_event(entries, evt, table_cb, &dispatcher, iterations / 10u + 1u);
+  const double reference =
+      bench_ns_per_event(entries, evt, switch_cb, &reference_visitor, iterations);
+  const double table = bench_ns_per_event(entries, evt, table_cb, &dispatcher, iterations);
+
+  std::printf("%14s %14s %8s\n", "switch ns", "table ns", "speedup");
+  std::printf("%14.3f %14.3f %7.2fx\n", reference, table, reference / table);
+  std::printf("(checksum %llu)\n", static_cast<unsigned long long>(sink));
+  return 0;
+}
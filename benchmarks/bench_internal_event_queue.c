@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Multi-producer throughput of the internal MPSC event queue.
+//
+// Worker threads push MARU_EVENT_USER_0 events as fast as the queue accepts
+// them while the main thread drains it, once claiming a single slot per
+// acquire (the old per-event pop) and once claiming full batches.
+//
+// Usage: maru_bench_internal_event_queue [events_per_producer]
+
+#include "maru_internal.h"
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_QUEUE_CAPACITY 4096u
+#define BENCH_MAX_PRODUCERS 8u
+
+typedef struct BenchProducer {
+  pthread_t thread;
+  MARU_InternalEventQueue *queue;
+  _Atomic(bool) *start;
+  uint64_t id;
+  uint64_t count;
+} BenchProducer;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void *bench_producer_main(void *arg) {
+  BenchProducer *producer = (BenchProducer *)arg;
+  MARU_Event evt;
+  memset(&evt, 0, sizeof(evt));
+
+  while (!atomic_load_explicit(producer->start, memory_order_acquire)) {
+    sched_yield();
+  }
+  for (uint64_t i = 0; i < producer->count; ++i) {
+    const uint64_t payload = (producer->id << 48) | i;
+    memcpy(evt.user.raw_payload, &payload, sizeof(payload));
+    while (!_maru_internal_event_queue_push(producer->queue, MARU_EVENT_USER_0, NULL,
+                                            &evt, NULL, NULL)) {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+static bool bench_run(MARU_Context_Base *ctx_base, uint32_t producer_count,
+                      uint64_t events_per_producer, uint32_t batch,
+                      double *out_events_per_sec) {
+  MARU_InternalEventQueue queue;
+  memset(&queue, 0, sizeof(queue));
+  if (!_maru_internal_event_queue_init(&queue, ctx_base, BENCH_QUEUE_CAPACITY, false)) {
+    return false;
+  }
+
+  _Atomic(bool) start;
+  atomic_init(&start, false);
+  BenchProducer producers[BENCH_MAX_PRODUCERS];
+  uint32_t started = 0;
+  for (; started < producer_count; ++started) {
+    producers[started] = (BenchProducer){
+        .queue = &queue,
+        .start = &start,
+        .id = started,
+        .count = events_per_producer,
+    };
+    if (pthread_create(&producers[started].thread, NULL, bench_producer_main,
+                       &producers[started]) != 0) {
+      break;
+    }
+  }
+
+  bool ok = started == producer_count;
+  const uint64_t total = (uint64_t)started * events_per_producer;
+  uint64_t last_seen[BENCH_MAX_PRODUCERS];
+  memset(last_seen, 0, sizeof(last_seen));
+  uint64_t consumed = 0;
+
+  const uint64_t start_ns = bench_now_ns();
+  atomic_store_explicit(&start, true, memory_order_release);
+  while (consumed < total) {
+    size_t first;
+    const uint32_t count = _maru_internal_event_queue_acquire(&queue, &first, batch);
+    if (count == 0) {
+      sched_yield();
+      continue;
+    }
+    uint32_t index = (uint32_t)(first % queue.capacity);
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t payload;
+      memcpy(&payload, queue.events[index].user.raw_payload, sizeof(payload));
+      // Events of a single producer must come out in the order they went in.
+      const uint64_t producer = payload >> 48;
+      const uint64_t seq = (payload & 0xffffffffffffull) + 1u;
+      if (seq <= last_seen[producer]) {
+        ok = false;
+      }
+      last_seen[producer] = seq;
+      if (++index == queue.capacity) {
+        index = 0;
+      }
+    }
+    _maru_internal_event_queue_release(&queue, first, count);
+    consumed += count;
+  }
+  const uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+  for (uint32_t i = 0; i < started; ++i) {
+    pthread_join(producers[i].thread, NULL);
+  }
+  _maru_internal_event_queue_cleanup(&queue, ctx_base);
+
+  *out_events_per_sec =
+      elapsed_ns ? (double)total * 1e9 / (double)elapsed_ns : 0.0;
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  uint64_t events_per_producer = 2000000u;
+  if (argc > 1) {
+    events_per_producer = strtoull(argv[1], NULL, 10);
+    if (events_per_producer == 0 || events_per_producer >= (1ull << 48)) {
+      fprintf(stderr, "usage: %s [events_per_producer]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  MARU_Context_Base ctx_base;
+  memset(&ctx_base, 0, sizeof(ctx_base));
+  ctx_base.allocator.alloc_cb = _maru_default_alloc;
+  ctx_base.allocator.realloc_cb = _maru_default_realloc;
+  ctx_base.allocator.free_cb = _maru_default_free;
+
+  printf("capacity %u, %llu events per producer\n", BENCH_QUEUE_CAPACITY,
+         (unsigned long long)events_per_producer);
+  printf("%-10s %16s %16s\n", "producers", "batch=1 (Mev/s)", "batch=64 (Mev/s)");
+
+  const uint32_t batches[2] = {1u, MARU_INTERNAL_EVENT_QUEUE_BATCH};
+  for (uint32_t producers = 1; producers <= BENCH_MAX_PRODUCERS; producers *= 2) {
+    double rates[2];
+    for (uint32_t b = 0; b < 2; ++b) {
+      if (!bench_run(&ctx_base, producers, events_per_producer, batches[b], &rates[b])) {
+        fprintf(stderr, "run with %u producers and batch %u failed\n", producers,
+                batches[b]);
+        return 1;
+      }
+    }
+    printf("%-10u %16.2f %16.2f\n", producers, rates[0] / 1e6, rates[1] / 1e6);
+  }
+  return 0;
+}
@@ -0,0 +1,321 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Read cost of the Linux controller input path.
+//
+// A virtual gamepad is created through /dev/uinput and fed reports of two axis
+// updates plus a SYN_REPORT, in rounds small enough to never overflow the
+// evdev client buffer. After each round the main thread drains the device
+// exactly as the pump does, through _maru_linux_common_process_pollfds().
+// Without access to /dev/uinput the same stream goes through a pipe, which
+// keeps the syscall counts comparable but skips the evdev layer.
+//
+// The "one read per event" row reproduces the former read loop as a reference
+// point. read() calls are taken from the syscr counter in /proc/self/io.
+//
+// Usage: maru_bench_linux_controller_read [rounds]
+
+#include "linux/linux_internal.h"
+#include "maru_mem_internal.h"
+
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <linux/uinput.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <time.h>
+#include <unistd.h>
+
+// Reports per round; 48 events stay well inside the evdev client buffer.
+#define BENCH_REPORTS_PER_ROUND 16u
+#define BENCH_EVENTS_PER_REPORT 3u
+
+typedef struct BenchDevice {
+  int write_fd;
+  int read_fd;
+  bool is_uinput;
+} BenchDevice;
+
+typedef struct BenchResult {
+  double ns_per_event;
+  uint64_t reads;
+  uint64_t reports;
+} BenchResult;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t bench_read_syscalls(void) {
+  FILE *file = fopen("/proc/self/io", "r");
+  if (!file) {
+    return 0;
+  }
+  char line[128];
+  unsigned long long value = 0;
+  while (fgets(line, sizeof(line), file)) {
+    if (sscanf(line, "syscr: %llu", &value) == 1) {
+      break;
+    }
+  }
+  fclose(file);
+  return (uint64_t)value;
+}
+
+// Finds the evdev node the kernel created for a uinput device.
+static int bench_open_uinput_node(int uinput_fd) {
+  char sysname[64];
+  if (ioctl(uinput_fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+    return -1;
+  }
+  char path[320];
+  snprintf(path, sizeof(path), "/sys/devices/virtual/input/%s", sysname);
+  DIR *dir = opendir(path);
+  if (!dir) {
+    return -1;
+  }
+  int fd = -1;
+  for (struct dirent *entry; (entry = readdir(dir)) != NULL;) {
+    if (strncmp(entry->d_name, "event", 5) == 0) {
+      snprintf(path, sizeof(path), "/dev/input/%s", entry->d_name);
+      fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+      break;
+    }
+  }
+  closedir(dir);
+  return fd;
+}
+
+static bool bench_open_uinput(BenchDevice *device) {
+  const int fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = ioctl(fd, UI_SET_EVBIT, EV_ABS) == 0 && ioctl(fd, UI_SET_EVBIT, EV_KEY) == 0 &&
+            ioctl(fd, UI_SET_KEYBIT, BTN_SOUTH) == 0 &&
+            ioctl(fd, UI_SET_ABSBIT, ABS_X) == 0 && ioctl(fd, UI_SET_ABSBIT, ABS_Y) == 0;
+  for (int code = ABS_X; ok && code <= ABS_Y; ++code) {
+    struct uinput_abs_setup abs;
+    memset(&abs, 0, sizeof(abs));
+    abs.code = (uint16_t)code;
+    abs.absinfo.minimum = -1000;
+    abs.absinfo.maximum = 1000;
+    ok = ioctl(fd, UI_ABS_SETUP, &abs) == 0;
+  }
+  struct uinput_setup setup;
+  memset(&setup, 0, sizeof(setup));
+  setup.id.bustype = BUS_VIRTUAL;
+  snprintf(setup.name, sizeof(setup.name), "maru bench gamepad");
+  ok = ok && ioctl(fd, UI_DEV_SETUP, &setup) == 0 && ioctl(fd, UI_DEV_CREATE) == 0;
+  if (!ok) {
+    close(fd);
+    return false;
+  }
+
+  // udev may need a moment to create the node.
+  int read_fd = -1;
+  for (int attempt = 0; attempt < 100 && read_fd < 0; ++attempt) {
+    read_fd = bench_open_uinput_node(fd);
+    if (read_fd < 0) {
+      usleep(10000);
+    }
+  }
+  if (read_fd < 0) {
+    ioctl(fd, UI_DEV_DESTROY);
+    close(fd);
+    return false;
+  }
+  *device = (BenchDevice){.write_fd = fd, .read_fd = read_fd, .is_uinput = true};
+  return true;
+}
+
+static bool bench_open_pipe(BenchDevice *device) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  (void)fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  *device = (BenchDevice){.write_fd = fds[1], .read_fd = fds[0], .is_uinput = false};
+  return true;
+}
+
+static void bench_close_device(BenchDevice *device) {
+  close(device->read_fd);
+  if (device->is_uinput) {
+    ioctl(device->write_fd, UI_DEV_DESTROY);
+  }
+  close(device->write_fd);
+}
+
+// Values swing across the range so neither the input core nor the analog
+// epsilon filters a report.
+static bool bench_feed_round(const BenchDevice *device, uint64_t round) {
+  struct input_event events[BENCH_REPORTS_PER_ROUND * BENCH_EVENTS_PER_REPORT];
+  memset(events, 0, sizeof(events));
+  for (uint32_t i = 0; i < BENCH_REPORTS_PER_ROUND; ++i) {
+    const int32_t value = ((round * BENCH_REPORTS_PER_ROUND + i) & 1u) ? 900 : -900;
+    struct input_event *report = &events[i * BENCH_EVENTS_PER_REPORT];
+    report[0].type = EV_ABS;
+    report[0].code = ABS_X;
+    report[0].value = value;
+    report[1].type = EV_ABS;
+    report[1].code = ABS_Y;
+    report[1].value = -value;
+    report[2].type = EV_SYN;
+    report[2].code = SYN_REPORT;
+  }
+  return write(device->write_fd, events, sizeof(events)) == (ssize_t)sizeof(events);
+}
+
+static void bench_on_event(MARU_EventId type, MARU_Window *window,
+                           const MARU_Event *evt, void *userdata) {
+  (void)window;
+  (void)evt;
+  if (type == MARU_EVENT_CONTROLLER_ANALOG_CHANGED) {
+    (*(uint64_t *)userdata)++;
+  }
+}
+
+// Waits until a full round is readable, so both paths see the same batches.
+static void bench_wait_round(const BenchDevice *device) {
+  struct pollfd pfd = {.fd = device->read_fd, .events = POLLIN};
+  (void)poll(&pfd, 1, 100);
+}
+
+static bool bench_run_maru(const BenchDevice *device, uint64_t rounds, BenchResult *out) {
+  MARU_Context_Base ctx_base;
+  MARU_Context_Linux_Common common;
+  MARU_PumpContext pump_ctx;
+  MARU_LinuxController ctrl;
+  MARU_AnalogInputState states[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  MARU_Scalar reported[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  struct input_absinfo abs_info[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  uint64_t reports = 0;
+
+  memset(&ctx_base, 0, sizeof(ctx_base));
+  memset(&common, 0, sizeof(common));
+  memset(&ctrl, 0, sizeof(ctrl));
+  memset(states, 0, sizeof(states));
+  memset(reported, 0, sizeof(reported));
+  memset(abs_info, 0, sizeof(abs_info));
+  MARU_ContextTuning tuning = MARU_CONTEXT_TUNING_DEFAULT;
+  ctx_base.tuning = tuning;
+  ctx_base.pump_ctx = &pump_ctx;
+  pump_ctx = (MARU_PumpContext){
+      .mask = MARU_ALL_EVENTS,
+      .callback = bench_on_event,
+      .userdata = &reports,
+  };
+
+  ctrl.fd = device->read_fd;
+  ctrl.analog_states = states;
+  ctrl.analog_reported = reported;
+  ctrl.analog_abs_info = abs_info;
+  memset(ctrl.evdev_to_button, 0xff, sizeof(ctrl.evdev_to_button));
+  memset(ctrl.evdev_to_analog, 0xff, sizeof(ctrl.evdev_to_analog));
+  ctrl.evdev_to_analog[ABS_X] = MARU_CONTROLLER_ANALOG_LEFT_X;
+  ctrl.evdev_to_analog[ABS_Y] = MARU_CONTROLLER_ANALOG_LEFT_Y;
+  for (uint32_t i = 0; i < MARU_CONTROLLER_ANALOG_STANDARD_COUNT; ++i) {
+    abs_info[i].minimum = -1000;
+    abs_info[i].maximum = 1000;
+  }
+  common.ctx_base = &ctx_base;
+  common.controllers = &ctrl;
+
+  uint64_t elapsed_ns = 0;
+  uint64_t reads = 0;
+  for (uint64_t round = 0; round < rounds; ++round) {
+    if (!bench_feed_round(device, round)) {
+      return false;
+    }
+    bench_wait_round(device);
+    struct pollfd pfd = {.fd = device->read_fd, .events = POLLIN, .revents = POLLIN};
+    const uint64_t reads_before = bench_read_syscalls();
+    const uint64_t start_ns = bench_now_ns();
+    _maru_linux_common_process_pollfds(&common, &pfd, 1);
+    elapsed_ns += bench_now_ns() - start_ns;
+    // Opening /proc/self/io costs one read() of its own.
+    reads += bench_read_syscalls() - reads_before - 1u;
+  }
+
+  const uint64_t events = rounds * BENCH_REPORTS_PER_ROUND * BENCH_EVENTS_PER_REPORT;
+  *out = (BenchResult){
+      .ns_per_event = (double)elapsed_ns / (double)events,
+      .reads = reads,
+      .reports = reports,
+  };
+  return true;
+}
+
+// The controller loop as it was before reads were batched.
+static bool bench_run_reference(const BenchDevice *device, uint64_t rounds,
+                                BenchResult *out) {
+  uint64_t elapsed_ns = 0;
+  uint64_t reads = 0;
+  uint64_t reports = 0;
+  for (uint64_t round = 0; round < rounds; ++round) {
+    if (!bench_feed_round(device, round)) {
+      return false;
+    }
+    bench_wait_round(device);
+    const uint64_t reads_before = bench_read_syscalls();
+    const uint64_t start_ns = bench_now_ns();
+    struct input_event ev;
+    while (read(device->read_fd, &ev, sizeof(ev)) > 0) {
+      if (ev.type == EV_SYN && ev.code == SYN_REPORT) {
+        reports++;
+      }
+    }
+    elapsed_ns += bench_now_ns() - start_ns;
+    reads += bench_read_syscalls() - reads_before - 1u;
+  }
+
+  const uint64_t events = rounds * BENCH_REPORTS_PER_ROUND * BENCH_EVENTS_PER_REPORT;
+  *out = (BenchResult){
+      .ns_per_event = (double)elapsed_ns / (double)events,
+      .reads = reads,
+      .reports = reports,
+  };
+  return true;
+}
+
+int main(int argc, char **argv) {
+  uint64_t rounds = 20000u;
+  if (argc > 1) {
+    rounds = strtoull(argv[1], NULL, 10);
+    if (rounds == 0) {
+      fprintf(stderr, "usage: %s [rounds]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  BenchDevice device;
+  if (!bench_open_uinput(&device) && !bench_open_pipe(&device)) {
+    fprintf(stderr, "could not open /dev/uinput or a pipe\n");
+    return 1;
+  }
+
+  BenchResult results[2];
+  bool ok = bench_run_reference(&device, rounds, &results[0]);
+  ok = ok && bench_run_maru(&device, rounds, &results[1]);
+  bench_close_device(&device);
+  if (!ok) {
+    fprintf(stderr, "feeding the device failed: %s\n", strerror(errno));
+    return 1;
+  }
+
+  const uint64_t expected_reports = rounds * BENCH_REPORTS_PER_ROUND;
+  printf("%llu reports of %u events through %s\n", (unsigned long long)expected_reports,
+         BENCH_EVENTS_PER_REPORT, device.is_uinput ? "uinput" : "a pipe (no /dev/uinput)");
+  printf("%-24s %10s %12s %10s\n", "path", "ns/event", "read() calls", "reports");
+  printf("%-24s %10.1f %12llu %10llu\n", "one read per event", results[0].ns_per_event,
+         (unsigned long long)results[0].reads, (unsigned long long)results[0].reports);
+  printf("%-24s %10.1f %12llu %10llu\n", "batched", results[1].ns_per_event,
+         (unsigned long long)results[1].reads, (unsigned long long)results[1].reports);
+  return 0;
+}
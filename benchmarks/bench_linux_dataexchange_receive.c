@@ -0,0 +1,250 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Receive throughput of the Linux data-exchange pipe path.
+//
+// A writer thread stands in for the compositor and the source client: it
+// pushes the payload into the pipe a data offer would hand out. The main
+// thread pumps the transfer exactly as the Wayland backend does, polling the
+// fds from maru_linux_dataexchange_fillPollFds() and feeding the results to
+// maru_linux_dataexchange_processTransfers().
+//
+// The "4 KiB copy" row reproduces the former stack buffer plus memcpy loop as
+// a reference point.
+//
+// Usage: maru_bench_linux_dataexchange_receive [payload_mib]
+
+#include "linux/linux_dataexchange.h"
+#include "maru_mem_internal.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+typedef struct BenchWriter {
+  pthread_t thread;
+  int fd;
+  const uint8_t *data;
+  size_t size;
+} BenchWriter;
+
+typedef struct BenchResult {
+  bool done;
+  MARU_Status status;
+  size_t size;
+  uint32_t first_byte;
+} BenchResult;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void *bench_writer_main(void *arg) {
+  BenchWriter *writer = (BenchWriter *)arg;
+  size_t written = 0;
+  while (written < writer->size) {
+    const ssize_t n = write(writer->fd, writer->data + written, writer->size - written);
+    if (n > 0) {
+      written += (size_t)n;
+    } else if (n < 0 && errno != EINTR) {
+      break;
+    }
+  }
+  close(writer->fd);
+  return NULL;
+}
+
+static void bench_on_event(MARU_EventId type, MARU_Window *window,
+                           const MARU_Event *evt, void *userdata) {
+  BenchResult *result = (BenchResult *)userdata;
+  (void)window;
+  if (type == MARU_EVENT_DATA_RECEIVED) {
+    result->done = true;
+    result->status = evt->data_received.status;
+    result->size = evt->data_received.size;
+    if (evt->data_received.size > 0) {
+      result->first_byte = ((const uint8_t *)evt->data_received.data)[0];
+    }
+  } else if (type == MARU_EVENT_DATA_CHUNK_RECEIVED) {
+    if (evt->data_chunk_received.offset == 0 && evt->data_chunk_received.size > 0) {
+      result->first_byte = ((const uint8_t *)evt->data_chunk_received.data)[0];
+    }
+    result->size += evt->data_chunk_received.size;
+    if (evt->data_chunk_received.is_final) {
+      result->done = true;
+      result->status = evt->data_chunk_received.status;
+    }
+  }
+}
+
+static bool bench_start_writer(BenchWriter *writer, const uint8_t *data, size_t size,
+                               int *out_read_fd) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  (void)fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  *writer = (BenchWriter){.fd = fds[1], .data = data, .size = size};
+  if (pthread_create(&writer->thread, NULL, bench_writer_main, writer) != 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return false;
+  }
+  *out_read_fd = fds[0];
+  return true;
+}
+
+static bool bench_run_maru(MARU_Context_Base *ctx_base, const uint8_t *data,
+                           size_t size, bool stream, double *out_mib_per_sec) {
+  BenchResult result = {0};
+  MARU_PumpContext pump_ctx = {
+      .mask = MARU_ALL_EVENTS,
+      .callback = bench_on_event,
+      .userdata = &result,
+  };
+  ctx_base->pump_ctx = &pump_ctx;
+
+  BenchWriter writer;
+  int read_fd = -1;
+  if (!bench_start_writer(&writer, data, size, &read_fd)) {
+    return false;
+  }
+
+  const uint64_t start_ns = bench_now_ns();
+  MARU_LinuxDataTransfer *transfers = NULL;
+  bool ok = maru_linux_dataexchange_queueTransfer(
+                ctx_base, &transfers, read_fd, NULL,
+                MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "image/png", NULL, stream) ==
+            MARU_SUCCESS;
+  while (ok && transfers) {
+    struct pollfd pfd;
+    const int count = maru_linux_dataexchange_fillPollFds(transfers, &pfd, 1);
+    if (poll(&pfd, (nfds_t)count, -1) < 0 && errno != EINTR) {
+      ok = false;
+      break;
+    }
+    maru_linux_dataexchange_processTransfers(ctx_base, &transfers, &pfd, 0, count);
+  }
+  const uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+  pthread_join(writer.thread, NULL);
+  maru_linux_dataexchange_destroyTransfers(ctx_base, &transfers);
+  ctx_base->pump_ctx = NULL;
+
+  *out_mib_per_sec =
+      elapsed_ns ? (double)size * 1e9 / (double)elapsed_ns / (1024.0 * 1024.0) : 0.0;
+  return ok && result.done && result.status == MARU_SUCCESS && result.size == size &&
+         result.first_byte == data[0];
+}
+
+// The receive loop as it was before reads went straight into the payload.
+static bool bench_run_copy_reference(const uint8_t *data, size_t size,
+                                     double *out_mib_per_sec) {
+  BenchWriter writer;
+  int read_fd = -1;
+  if (!bench_start_writer(&writer, data, size, &read_fd)) {
+    return false;
+  }
+
+  const uint64_t start_ns = bench_now_ns();
+  uint8_t *buffer = NULL;
+  size_t used = 0;
+  size_t capacity = 0;
+  bool ok = true;
+  bool done = false;
+  while (ok && !done) {
+    struct pollfd pfd = {.fd = read_fd, .events = POLLIN};
+    if (poll(&pfd, 1, -1) < 0 && errno != EINTR) {
+      ok = false;
+      break;
+    }
+    for (;;) {
+      uint8_t tmp[4096];
+      const ssize_t n = read(read_fd, tmp, sizeof(tmp));
+      if (n > 0) {
+        if (used + (size_t)n > capacity) {
+          size_t next_cap = capacity ? capacity : 4096u;
+          while (next_cap < used + (size_t)n) next_cap *= 2u;
+          uint8_t *next = (uint8_t *)realloc(buffer, next_cap);
+          if (!next) {
+            ok = false;
+            break;
+          }
+          buffer = next;
+          capacity = next_cap;
+        }
+        memcpy(buffer + used, tmp, (size_t)n);
+        used += (size_t)n;
+        continue;
+      }
+      if (n == 0) {
+        done = true;
+      } else if (errno == EINTR) {
+        continue;
+      } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        ok = false;
+      }
+      break;
+    }
+  }
+  const uint64_t elapsed_ns = bench_now_ns() - start_ns;
+
+  pthread_join(writer.thread, NULL);
+  close(read_fd);
+  ok = ok && used == size && buffer && buffer[0] == data[0];
+  free(buffer);
+
+  *out_mib_per_sec =
+      elapsed_ns ? (double)size * 1e9 / (double)elapsed_ns / (1024.0 * 1024.0) : 0.0;
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  size_t payload_mib = 64u;
+  if (argc > 1) {
+    payload_mib = (size_t)strtoull(argv[1], NULL, 10);
+    if (payload_mib == 0 || payload_mib > 4096u) {
+      fprintf(stderr, "usage: %s [payload_mib]\n", argv[0]);
+      return 1;
+    }
+  }
+  const size_t size = payload_mib * 1024u * 1024u;
+  uint8_t *data = (uint8_t *)malloc(size);
+  if (!data) {
+    fprintf(stderr, "could not allocate a %zu MiB payload\n", payload_mib);
+    return 1;
+  }
+  for (size_t i = 0; i < size; ++i) {
+    data[i] = (uint8_t)(i * 31u + 7u);
+  }
+
+  MARU_Context_Base ctx_base;
+  memset(&ctx_base, 0, sizeof(ctx_base));
+  ctx_base.allocator.alloc_cb = _maru_default_alloc;
+  ctx_base.allocator.realloc_cb = _maru_default_realloc;
+  ctx_base.allocator.free_cb = _maru_default_free;
+
+  double rates[3];
+  bool ok = bench_run_copy_reference(data, size, &rates[0]);
+  ok = ok && bench_run_maru(&ctx_base, data, size, false, &rates[1]);
+  ok = ok && bench_run_maru(&ctx_base, data, size, true, &rates[2]);
+  free(data);
+  if (!ok) {
+    fprintf(stderr, "a receive run failed or returned a corrupt payload\n");
+    return 1;
+  }
+
+  printf("%zu MiB payload through a pipe\n", payload_mib);
+  printf("%-22s %10s\n", "path", "MiB/s");
+  printf("%-22s %10.1f\n", "4 KiB copy (former)", rates[0]);
+  printf("%-22s %10.1f\n", "buffered", rates[1]);
+  printf("%-22s %10.1f\n", "streamed", rates[2]);
+  return 0;
+}
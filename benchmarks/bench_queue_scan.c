@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Filtered maru_scanQueue() against the per-event mask test it replaced.
+//
+// A committed snapshot of BENCH_SCAN_EVENTS user events is scanned with masks
+// selecting one, three and eight event ids, at several fractions of matching
+// events. The reference loop walks a MARU_QueueView and tests every entry
+// before calling back through a function pointer, as maru_scanQueue() used to.
+//
+// Usage: maru_bench_queue_scan [iterations]
+
+#include "maru/queue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_SCAN_EVENTS 4096u
+
+typedef struct BenchScanCase {
+  const char *name;
+  MARU_EventMask mask;
+  uint32_t selected_ids;
+} BenchScanCase;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_on_event(MARU_EventId type, MARU_WindowId window_id,
+                           const MARU_Event *evt, void *userdata) {
+  (void)type;
+  (void)evt;
+  *(uint64_t *)userdata += window_id;
+}
+
+// Keeps the reference loop from inlining the callback, like the real scan.
+static MARU_QueueEventCallback volatile bench_reference_cb = bench_on_event;
+
+static void bench_reference_scan(const MARU_Queue *queue, MARU_EventMask mask,
+                                 void *userdata) {
+  MARU_QueueView view;
+  maru_getQueueView(queue, &view);
+  const MARU_QueueEventCallback cb = bench_reference_cb;
+  for (uint32_t i = 0; i < view.count; ++i) {
+    if (maru_eventMaskHas(mask, view.types[i])) {
+      cb(view.types[i], view.window_ids[i], &view.events[i], userdata);
+    }
+  }
+  maru_releaseQueueView(queue, &view);
+}
+
+// Fills the queue so that roughly `percent` of the events fall on the first
+// `selected_ids` user ids and the rest on the other user ids.
+static bool bench_fill(MARU_Queue *queue, uint32_t selected_ids, uint32_t percent) {
+  MARU_Event evt = {0};
+  uint32_t seed = 0x9e3779b9u;
+  for (uint32_t i = 0; i < BENCH_SCAN_EVENTS; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const uint32_t roll = (seed >> 8) % 100u;
+    const uint32_t pick = (seed >> 20) % 8u;
+    const uint32_t user = roll < percent ? pick % selected_ids : 8u + pick;
+    if (!maru_pushQueue(queue, (MARU_EventId)(MARU_EVENT_USER_0 + user),
+                        (MARU_WindowId)i, &evt)) {
+      return false;
+    }
+  }
+  return maru_commitQueue(queue);
+}
+
+static double bench_ns_per_event(const MARU_Queue *queue, MARU_EventMask mask,
+                                 uint32_t iterations, bool reference,
+                                 uint64_t *sink) {
+  const uint64_t start = bench_now_ns();
+  for (uint32_t it = 0; it < iterations; ++it) {
+    if (reference) {
+      bench_reference_scan(queue, mask, sink);
+    } else {
+      maru_scanQueue(queue, mask, bench_on_event, sink);
+    }
+  }
+  const uint64_t elapsed = bench_now_ns() - start;
+  return (double)elapsed / ((double)iterations * (double)BENCH_SCAN_EVENTS);
+}
+
+int main(int argc, char **argv) {
+  uint32_t iterations = 2000u;
+  if (argc > 1) {
+    iterations = (uint32_t)strtoul(argv[1], NULL, 10);
+    if (iterations == 0) {
+      fprintf(stderr, "usage: %s [iterations]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  static const BenchScanCase cases[] = {
+      {"1 id", MARU_MASK_USER_0, 1u},
+      {"3 ids", MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_USER_2, 3u},
+      {"8 ids",
+       MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_USER_2 | MARU_MASK_USER_3 |
+           MARU_MASK_USER_4 | MARU_MASK_USER_5 | MARU_MASK_USER_6 | MARU_MASK_USER_7,
+       8u},
+  };
+  static const uint32_t percents[] = {1u, 10u, 50u, 100u};
+
+  printf("%-6s %8s %14s %14s %8s\n", "mask", "match%", "reference ns", "scan ns",
+         "speedup");
+  uint64_t sink = 0;
+  for (size_t c = 0; c < sizeof(cases) / sizeof(cases[0]); ++c) {
+    for (size_t p = 0; p < sizeof(percents) / sizeof(percents[0]); ++p) {
+      MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+      create_info.capacity = BENCH_SCAN_EVENTS;
+      MARU_Queue *queue = NULL;
+      if (!maru_createQueue(&create_info, &queue) ||
+          !bench_fill(queue, cases[c].selected_ids, percents[p])) {
+        fprintf(stderr, "queue setup failed\n");
+        maru_destroyQueue(queue);
+        return 1;
+      }
+
+      // Warm up both paths before timing.
+      bench_ns_per_event(queue, cases[c].mask, iterations / 10u + 1u, true, &sink);
+      bench_ns_per_event(queue, cases[c].mask, iterations / 10u + 1u, false, &sink);
+      const double reference =
+          bench_ns_per_event(queue, cases[c].mask, iterations, true, &sink);
+      const double filtered =
+          bench_ns_per_event(queue, cases[c].mask, iterations, false, &sink);
+      printf("%-6s %7u%% %14.3f %14.3f %7.2fx\n", cases[c].name, percents[p],
+             reference, filtered, reference / filtered);
+
+      maru_destroyQueue(queue);
+    }
+  }
+  printf("(checksum %llu)\n", (unsigned long long)sink);
+  return 0;
+}
@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+// Per-window scans of one snapshot shared by BENCH_WINDOWS windows.
+//
+// Every frame commits a snapshot of events spread over the windows, then each
+// window reads its own events. The reference does what per-window subsystems
+// do without maru_scanQueueForWindow(): a full maru_scanQueue() per window
+// that drops foreign events in the callback. The indexed variant commits with
+// `index_windows` and calls maru_scanQueueForWindow() per window; its timing
+// includes the commit that builds the index.
+//
+// Usage: maru_bench_queue_window_scan [frames]
+
+#include "maru/queue.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define BENCH_WINDOWS 64u
+
+typedef struct BenchWindowState {
+  MARU_WindowId window_id;
+  uint64_t sum;
+} BenchWindowState;
+
+static uint64_t bench_now_ns(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_on_any_window(MARU_EventId type, MARU_WindowId window_id,
+                                const MARU_Event *evt, void *userdata) {
+  BenchWindowState *state = (BenchWindowState *)userdata;
+  (void)evt;
+  if (window_id == state->window_id) {
+    state->sum += (uint64_t)type;
+  }
+}
+
+static void bench_on_own_window(MARU_EventId type, MARU_WindowId window_id,
+                                const MARU_Event *evt, void *userdata) {
+  BenchWindowState *state = (BenchWindowState *)userdata;
+  (void)window_id;
+  (void)evt;
+  state->sum += (uint64_t)type;
+}
+
+static bool bench_push_frame(MARU_Queue *queue, uint32_t events) {
+  MARU_Event evt = {0};
+  uint32_t seed = 0x9e3779b9u;
+  for (uint32_t i = 0; i < events; ++i) {
+    seed = seed * 1664525u + 1013904223u;
+    const MARU_WindowId window_id = (MARU_WindowId)((seed >> 16) % BENCH_WINDOWS) + 1u;
+    if (!maru_pushQueue(queue, (MARU_EventId)(MARU_EVENT_USER_0 + (seed >> 28)),
+                        window_id, &evt)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Returns the average nanoseconds per frame spent committing and scanning.
+static double bench_frames(MARU_Queue *queue, uint32_t events, uint32_t frames,
+                           bool indexed, uint64_t *sink) {
+  BenchWindowState states[BENCH_WINDOWS];
+  for (uint32_t w = 0; w < BENCH_WINDOWS; ++w) {
+    states[w] = (BenchWindowState){.window_id = (MARU_WindowId)w + 1u, .sum = 0};
+  }
+
+  uint64_t elapsed = 0;
+  for (uint32_t f = 0; f < frames; ++f) {
+    if (!bench_push_frame(queue, events)) {
+      fprintf(stderr, "queue push failed\n");
+      exit(1);
+    }
+    const uint64_t start = bench_now_ns();
+    maru_commitQueue(queue);
+    for (uint32_t w = 0; w < BENCH_WINDOWS; ++w) {
+      if (indexed) {
+        maru_scanQueueForWindow(queue, states[w].window_id, MARU_ALL_EVENTS,
+                                bench_on_own_window, &states[w]);
+      } else {
+        maru_scanQueue(queue, MARU_ALL_EVENTS, bench_on_any_window, &states[w]);
+      }
+    }
+    elapsed += bench_now_ns() - start;
+  }
+
+  for (uint32_t w = 0; w < BENCH_WINDOWS; ++w) {
+    *sink += states[w].sum;
+  }
+  return (double)elapsed / (double)frames;
+}
+
+int main(int argc, char **argv) {
+  uint32_t frames = 2000u;
+  if (argc > 1) {
+    frames = (uint32_t)strtoul(argv[1], NULL, 10);
+    if (frames == 0) {
+      fprintf(stderr, "usage: %s [frames]\n", argv[0]);
+      return 1;
+    }
+  }
+
+  static const uint32_t event_counts[] = {256u, 1024u, 4096u};
+
+  printf("%d windows\n", (int)BENCH_WINDOWS);
+  printf("%8s %16s %16s %8s\n", "events", "reference ns", "indexed ns", "speedup");
+  uint64_t sink = 0;
+  for (size_t e = 0; e < sizeof(event_counts) / sizeof(event_counts[0]); ++e) {
+    double results[2];
+    for (int indexed = 0; indexed < 2; ++indexed) {
+      MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+      create_info.capacity = event_counts[e];
+      create_info.index_windows = indexed != 0;
+      MARU_Queue *queue = NULL;
+      if (!maru_createQueue(&create_info, &queue)) {
+        fprintf(stderr, "queue setup failed\n");
+        return 1;
+      }
+      // Warm up before timing.
+      bench_frames(queue, event_counts[e], frames / 10u + 1u, indexed != 0, &sink);
+      results[indexed] =
+          bench_frames(queue, event_counts[e], frames, indexed != 0, &sink);
+      maru_destroyQueue(queue);
+    }
+    printf("%8u %16.0f %16.0f %7.2fx\n", event_counts[e], results[0], results[1],
+           results[0] / results[1]);
+  }
+  printf("(checksum %llu)\n", (unsigned long long)sink);
+  return 0;
+}
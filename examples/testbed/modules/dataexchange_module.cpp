@@ -126,6 +126,14 @@ void DataExchangeModule::onEvent(MARU_EventId type, MARU_Window* window, const M
         return;
     }
 
+    if (type == MARU_EVENT_MIME_TYPES_READY) {
+        clipboard_mime_types_.clear();
+        for (uint32_t i = 0; i < event.mime_types_ready.mime_types.count; ++i) {
+            clipboard_mime_types_.emplace_back(event.mime_types_ready.mime_types.strings[i]);
+        }
+        return;
+    }
+
     if (type == MARU_EVENT_DATA_REQUESTED) {
         const MARU_DataRequestEvent* req = &event.data_requested;
         if (!req) return;
@@ -231,7 +239,9 @@ void DataExchangeModule::render(MARU_Context* ctx, MARU_Window* window) {
         }
 
         ImGui::Separator();
-        ImGui::Text("Last API status: %s", last_status_ == MARU_SUCCESS ? "MARU_SUCCESS" : "MARU_FAILURE");
+        ImGui::Text("Last API status: %s", last_status_ == MARU_SUCCESS   ? "MARU_SUCCESS"
+                                           : last_status_ == MARU_PENDING ? "MARU_PENDING"
+                                                                          : "MARU_FAILURE");
         if (has_received_target_) {
             ImGui::Text("Last received target: %s",
                         last_received_target_ == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD
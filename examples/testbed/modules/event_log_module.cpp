@@ -118,6 +118,12 @@ void EventLogModule::onEvent(MARU_EventId type, MARU_Window* win, const MARU_Eve
         ss << "Controller: " << (void*)e.controller_changed.controller << " Connected: " << (e.controller_changed.connected ? "YES" : "NO");
     } else if (type == MARU_EVENT_CONTROLLER_BUTTON_CHANGED) {
         ss << "Controller: " << (void*)e.controller_button_changed.controller << " Button=" << e.controller_button_changed.button_id << " State=" << (e.controller_button_changed.state == MARU_BUTTON_STATE_PRESSED ? "PR" : "RE");
+    } else if (type == MARU_EVENT_CONTROLLER_ANALOG_CHANGED) {
+        ss << "Controller: " << (void*)e.controller_analog_changed.controller << " ChangedMask=0x" << std::hex << e.controller_analog_changed.changed_mask << std::dec;
+    } else if (type == MARU_EVENT_MIME_TYPES_READY) {
+        ss << "MIME Types Ready: Target=" << (int)e.mime_types_ready.target << " Count=" << e.mime_types_ready.mime_types.count;
+    } else if (type == MARU_EVENT_DATA_CHUNK_RECEIVED) {
+        ss << "Data Chunk: Status=" << (int)e.data_chunk_received.status << " Mime=" << (e.data_chunk_received.mime_type ? e.data_chunk_received.mime_type : "N/A") << " Offset=" << e.data_chunk_received.offset << " Size=" << e.data_chunk_received.size << (e.data_chunk_received.is_final ? " Final" : "");
     } else {
         ss << "No detailed payload parser";
     }
@@ -247,6 +253,9 @@ const char* EventLogModule::typeToString(MARU_EventId type) {
     if (type == MARU_EVENT_DRAG_FINISHED) return "DRAG_FINISHED";
     if (type == MARU_EVENT_CONTROLLER_CHANGED) return "CONTROLLER_CHANGED";
     if (type == MARU_EVENT_CONTROLLER_BUTTON_CHANGED) return "CONTROLLER_BUTTON_CHANGED";
+    if (type == MARU_EVENT_CONTROLLER_ANALOG_CHANGED) return "CONTROLLER_ANALOG_CHANGED";
+    if (type == MARU_EVENT_MIME_TYPES_READY) return "MIME_TYPES_READY";
+    if (type == MARU_EVENT_DATA_CHUNK_RECEIVED) return "DATA_CHUNK_RECEIVED";
     if (type == MARU_EVENT_USER_0) return "USER_EVENT_0";
     return "UNKNOWN";
 }
@@ -48,6 +48,7 @@ void EventModule::render(MARU_Context* ctx, MARU_Window* window) {
         event_checkbox("TEXT_EDIT_COMMITTED", MARU_MASK_TEXT_EDIT_COMMITTED);
         event_checkbox("TEXT_EDIT_NAVIGATION", MARU_MASK_TEXT_EDIT_NAVIGATION);
         event_checkbox("TEXT_EDIT_ENDED", MARU_MASK_TEXT_EDIT_ENDED);
+        event_checkbox("CONTROLLER_ANALOG_CHANGED", MARU_MASK_CONTROLLER_ANALOG_CHANGED);
 
         ImGui::Separator();
         static int idle_timeout = 0;
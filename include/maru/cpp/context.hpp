@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "maru/cpp/fwd.hpp"
+#include "maru/cpp/events.hpp"
 #include "maru/cpp/expected.hpp"
 #include "maru/cpp/window.hpp"
 #include "maru/cpp/monitor.hpp"
@@ -54,10 +55,15 @@ public:
         return pumpEvents(timeout_ms, MARU_ALL_EVENTS, callback, userdata);
     }
 
+    MARU_Status pumpEventsUntil(uint64_t deadline_ns, MARU_EventMask mask, MARU_EventCallback callback, void* userdata = nullptr);
+
 #if __cplusplus >= 202002L
     template <typename Visitor>
     MARU_Status pumpEvents(EventDispatcher<Visitor>& dispatcher, uint32_t timeout_ms = 0, MARU_EventMask mask = MARU_ALL_EVENTS);
 
+    template <typename Visitor>
+    MARU_Status pumpEventsUntil(EventDispatcher<Visitor>& dispatcher, uint64_t deadline_ns, MARU_EventMask mask = MARU_ALL_EVENTS);
+
     template <typename Visitor, typename Rep, typename Period>
     MARU_Status pumpEvents(EventDispatcher<Visitor>& dispatcher, std::chrono::duration<Rep, Period> timeout, MARU_EventMask mask = MARU_ALL_EVENTS) {
         return pumpEvents(dispatcher, (uint32_t)std::chrono::duration_cast<std::chrono::milliseconds>(timeout).count(), mask);
@@ -70,6 +76,15 @@ public:
     }
 
     MARU_Status postEvent(MARU_EventId type, MARU_UserDefinedEvent evt);
+    /**
+     * @brief Posts `payload` as the raw_payload of a user event, copied once
+     * into the queued slot. Receive it with UserEvent<N, T>.
+     */
+    template <typename T>
+    MARU_Status postEvent(MARU_EventId type, const T& payload);
+    MARU_Status postEvents(const MARU_EventId* types, const MARU_UserDefinedEvent* events,
+                           uint32_t count, uint32_t* out_posted_count = nullptr);
+    MARU_UserEventQueueStats getUserEventQueueStats() const;
     MARU_Status wake();
 
 private:
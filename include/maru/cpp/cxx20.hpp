@@ -21,63 +21,19 @@ struct overloads : Ts... {
 template <class... Ts>
 overloads(Ts...) -> overloads<Ts...>;
 
+namespace details {
+// Event ids `V` has a handler for, see maru_cxx20_impl.hpp.
+template <typename V, bool Queued>
+consteval MARU_EventMask visitorMask();
+}  // namespace details
+
+/** A visitor that handles at least one live event type. */
 template <typename T>
-concept PartialEventVisitor =
-  std::invocable<std::remove_cvref_t<T>, WindowReadyEvent> ||
-  std::invocable<std::remove_cvref_t<T>, CloseRequestedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, WindowResizedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, WindowStateChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, KeyChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, MouseMovedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, MouseButtonChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, MouseScrolledEvent> ||
-  std::invocable<std::remove_cvref_t<T>, IdleEvent> ||
-  std::invocable<std::remove_cvref_t<T>, MonitorChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, MonitorModeEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DropEnteredEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DropHoveredEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DropExitedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DropDroppedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DataReceivedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DataRequestEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DataReleasedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, DragFinishedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, ControllerChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, ControllerButtonChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, WindowFrameEvent> ||
-  std::invocable<std::remove_cvref_t<T>, TextEditStartedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, TextEditUpdatedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, TextEditCommittedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, TextEditEndedEvent>;
+concept PartialEventVisitor = details::visitorMask<std::remove_cvref_t<T>, false>() != 0;
 
+/** A visitor that handles at least one queued event type. */
 template <typename T>
-concept PartialQueueEventVisitor =
-  std::invocable<std::remove_cvref_t<T>, QueuedWindowReadyEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedCloseRequestedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedWindowResizedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedWindowStateChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedKeyChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedMouseMovedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedMouseButtonChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedMouseScrolledEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedIdleEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedMonitorChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedMonitorModeEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDropEnteredEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDropHoveredEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDropExitedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDropDroppedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDataReceivedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDataRequestEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDataReleasedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedDragFinishedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedControllerChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedControllerButtonChangedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedWindowFrameEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedTextEditStartedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedTextEditUpdatedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedTextEditCommittedEvent> ||
-  std::invocable<std::remove_cvref_t<T>, QueuedTextEditEndedEvent>;
+concept PartialQueueEventVisitor = details::visitorMask<std::remove_cvref_t<T>, true>() != 0;
 
 /**
  * A helper class that can be used as event_userdata to dispatch events to visitors.
@@ -118,6 +74,13 @@ inline MARU_Status Context::pumpEvents(EventDispatcher<Visitor>& dispatcher,
   return pumpEvents(timeout_ms, mask, dispatcher.callback, &dispatcher);
 }
 
+template <typename Visitor>
+inline MARU_Status Context::pumpEventsUntil(EventDispatcher<Visitor>& dispatcher,
+                                            uint64_t deadline_ns,
+                                            MARU_EventMask mask) {
+  return pumpEventsUntil(deadline_ns, mask, dispatcher.callback, &dispatcher);
+}
+
 template <typename Visitor>
 inline void Queue::scan(EventDispatcher<Visitor>& dispatcher, MARU_EventMask mask) {
   scan(mask, dispatcher.queueCallback, &dispatcher);
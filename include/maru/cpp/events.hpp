@@ -7,6 +7,9 @@
 #include "maru/maru.h"
 #include "maru/cpp/fwd.hpp"
 
+#include <cstdint>
+#include <type_traits>
+
 namespace maru {
 
 /**
@@ -54,11 +57,15 @@ typedef Event<MARU_DataReleasedEvent> DataReleasedEvent;
 typedef Event<MARU_DragFinishedEvent> DragFinishedEvent;
 typedef Event<MARU_ControllerChangedEvent> ControllerChangedEvent;
 typedef Event<MARU_ControllerButtonChangedEvent> ControllerButtonChangedEvent;
+typedef Event<MARU_ControllerAnalogChangedEvent> ControllerAnalogChangedEvent;
+typedef Event<MARU_MimeTypesReadyEvent> MimeTypesReadyEvent;
+typedef Event<MARU_DataChunkReceivedEvent> DataChunkReceivedEvent;
 typedef Event<MARU_WindowFrameEvent> WindowFrameEvent;
 typedef Event<MARU_TextEditStartedEvent> TextEditStartedEvent;
 typedef Event<MARU_TextEditUpdatedEvent> TextEditUpdatedEvent;
 typedef Event<MARU_TextEditCommittedEvent> TextEditCommittedEvent;
 typedef Event<MARU_TextEditEndedEvent> TextEditEndedEvent;
+typedef Event<MARU_TextEditNavigationEvent> TextEditNavigationEvent;
 
 typedef QueuedEvent<MARU_WindowReadyEvent> QueuedWindowReadyEvent;
 typedef QueuedEvent<MARU_CloseRequestedEvent> QueuedCloseRequestedEvent;
@@ -81,11 +88,79 @@ typedef QueuedEvent<MARU_DataReleasedEvent> QueuedDataReleasedEvent;
 typedef QueuedEvent<MARU_DragFinishedEvent> QueuedDragFinishedEvent;
 typedef QueuedEvent<MARU_ControllerChangedEvent> QueuedControllerChangedEvent;
 typedef QueuedEvent<MARU_ControllerButtonChangedEvent> QueuedControllerButtonChangedEvent;
+typedef QueuedEvent<MARU_ControllerAnalogChangedEvent> QueuedControllerAnalogChangedEvent;
+typedef QueuedEvent<MARU_MimeTypesReadyEvent> QueuedMimeTypesReadyEvent;
+typedef QueuedEvent<MARU_DataChunkReceivedEvent> QueuedDataChunkReceivedEvent;
 typedef QueuedEvent<MARU_WindowFrameEvent> QueuedWindowFrameEvent;
 typedef QueuedEvent<MARU_TextEditStartedEvent> QueuedTextEditStartedEvent;
 typedef QueuedEvent<MARU_TextEditUpdatedEvent> QueuedTextEditUpdatedEvent;
 typedef QueuedEvent<MARU_TextEditCommittedEvent> QueuedTextEditCommittedEvent;
 typedef QueuedEvent<MARU_TextEditEndedEvent> QueuedTextEditEndedEvent;
+typedef QueuedEvent<MARU_TextEditNavigationEvent> QueuedTextEditNavigationEvent;
+
+namespace details {
+
+// What visitors receive for MARU_EVENT_USER_<N>. Handlers take a
+// UserEvent<N, T> or QueuedUserEvent<N, T>, which convert from it.
+template <typename Handle, uint32_t N>
+struct UserEventSource {
+    Handle handle;
+    const MARU_UserDefinedEvent& data;
+};
+
+template <typename T>
+constexpr void checkUserPayload() {
+    static_assert(std::is_trivially_copyable_v<T>, "User payloads are copied bytewise");
+    static_assert(sizeof(T) <= sizeof(MARU_UserDefinedEvent), "User payload does not fit");
+    static_assert(alignof(T) <= 16, "User payloads are only 16-byte aligned");
+}
+
+template <typename T>
+const T& userPayload(const MARU_UserDefinedEvent& event) {
+    checkUserPayload<T>();
+    if constexpr (std::is_same_v<T, MARU_UserDefinedEvent>) {
+        return event;
+    } else {
+        return *reinterpret_cast<const T*>(event.raw_payload);
+    }
+}
+
+} // namespace details
+
+/**
+ * @brief MARU_EVENT_USER_<N> with its payload viewed as `T`.
+ *
+ * `T` is read from the start of `raw_payload`, so it must be trivially
+ * copyable, fit in 64 bytes and need at most 16-byte alignment. Leave it as
+ * MARU_UserDefinedEvent to get the raw union.
+ */
+template <uint32_t N, typename T = MARU_UserDefinedEvent>
+struct UserEvent {
+    static_assert(N < 16, "There are 16 user event ids");
+
+    MARU_Window* window;
+    const T& data;
+
+    UserEvent(details::UserEventSource<MARU_Window*, N> source)
+        : window(source.handle), data(details::userPayload<T>(source.data)) {}
+
+    const T* operator->() const { return &data; }
+    operator const T&() const { return data; }
+};
+
+template <uint32_t N, typename T = MARU_UserDefinedEvent>
+struct QueuedUserEvent {
+    static_assert(N < 16, "There are 16 user event ids");
+
+    MARU_WindowId window_id;
+    const T& data;
+
+    QueuedUserEvent(details::UserEventSource<MARU_WindowId, N> source)
+        : window_id(source.handle), data(details::userPayload<T>(source.data)) {}
+
+    const T* operator->() const { return &data; }
+    operator const T&() const { return data; }
+};
 
 } // namespace maru
 
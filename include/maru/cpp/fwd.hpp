@@ -15,6 +15,7 @@ class Cursor;
 class Image;
 class Controller;
 class Queue;
+class QueueView;
 
 #if __cplusplus >= 202002L
 template <typename Visitor>
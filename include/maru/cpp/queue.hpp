@@ -8,8 +8,93 @@
 #include "maru/cpp/fwd.hpp"
 #include "maru/cpp/expected.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+
 namespace maru {
 
+/**
+ * @brief One entry of a queue snapshot, as yielded by QueueView iteration.
+ */
+struct QueueEntry {
+    MARU_EventId type;
+    MARU_WindowId window_id;
+    const MARU_Event& event;
+};
+
+/**
+ * @brief RAII wrapper for MARU_QueueView, released on destruction.
+ *
+ * Iterate it with a range-for, or walk the types(), windowIds() and events()
+ * columns directly in hot loops.
+ */
+class QueueView {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = QueueEntry;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = QueueEntry;
+
+        QueueEntry operator*() const {
+            return QueueEntry{m_view->types[m_index], m_view->window_ids[m_index],
+                              m_view->events[m_index]};
+        }
+        iterator& operator++() {
+            ++m_index;
+            return *this;
+        }
+        iterator operator++(int) {
+            iterator prev = *this;
+            ++m_index;
+            return prev;
+        }
+        bool operator==(const iterator& other) const { return m_index == other.m_index; }
+        bool operator!=(const iterator& other) const { return m_index != other.m_index; }
+
+    private:
+        friend class QueueView;
+        iterator(const MARU_QueueView* view, uint32_t index)
+            : m_view(view), m_index(index) {}
+        const MARU_QueueView* m_view;
+        uint32_t m_index;
+    };
+
+    ~QueueView();
+
+    QueueView(const QueueView&) = delete;
+    QueueView& operator=(const QueueView&) = delete;
+
+    QueueView(QueueView&& other) noexcept;
+    QueueView& operator=(QueueView&& other) noexcept;
+
+    const MARU_QueueView& get() const { return m_view; }
+
+    uint32_t size() const { return m_view.count; }
+    bool empty() const { return m_view.count == 0; }
+
+    const MARU_EventId* types() const { return m_view.types; }
+    const MARU_WindowId* windowIds() const { return m_view.window_ids; }
+    const MARU_Event* events() const { return m_view.events; }
+
+    QueueEntry operator[](uint32_t index) const {
+        return QueueEntry{m_view.types[index], m_view.window_ids[index],
+                          m_view.events[index]};
+    }
+
+    iterator begin() const { return iterator(&m_view, 0); }
+    iterator end() const { return iterator(&m_view, m_view.count); }
+
+private:
+    friend class Queue;
+    explicit QueueView(const MARU_Queue* queue);
+    const MARU_Queue* m_queue = nullptr;
+    MARU_QueueView m_view = {};
+};
+
 /**
  * @brief RAII wrapper for MARU_Queue.
  */
@@ -17,6 +102,9 @@ class Queue {
 public:
     [[nodiscard]] static expected<Queue, bool> create(const MARU_QueueCreateInfo& create_info = MARU_QUEUE_CREATE_INFO_DEFAULT);
     [[nodiscard]] static expected<Queue, bool> create(uint32_t capacity);
+    /** @brief Opens a recording written by record() as a replaying queue. */
+    [[nodiscard]] static expected<Queue, bool> openRecording(const char* path,
+                                                             const MARU_QueueCreateInfo& create_info = MARU_QUEUE_CREATE_INFO_DEFAULT);
 
     ~Queue();
 
@@ -37,10 +125,35 @@ public:
     void scan(MARU_EventMask mask, MARU_QueueEventCallback callback,
               void* userdata = nullptr);
 
+    void scanForWindow(MARU_WindowId window_id, MARU_EventMask mask,
+                       MARU_QueueEventCallback callback, void* userdata = nullptr) {
+        maru_scanQueueForWindow(m_handle, window_id, mask, callback, userdata);
+    }
+
+    /** @brief Returns a view of the stable snapshot, held until it is destroyed. */
+    [[nodiscard]] QueueView view() const;
+
     void setCoalesceMask(MARU_EventMask mask) {
         maru_setQueueCoalesceMask(m_handle, mask);
     }
 
+    uint32_t generation() const { return maru_getQueueGeneration(m_handle); }
+
+    /** @brief Blocks until a commit moves the generation past `last_seen`. */
+    uint32_t wait(uint32_t last_seen) const {
+        return maru_waitQueue(m_handle, last_seen, MARU_QUEUE_WAIT_FOREVER);
+    }
+
+    template <typename Rep, typename Period>
+    uint32_t wait(uint32_t last_seen, std::chrono::duration<Rep, Period> timeout) const {
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(timeout).count();
+        return maru_waitQueue(m_handle, last_seen, ns > 0 ? (uint64_t)ns : 0u);
+    }
+
+    /** @brief Records later commits to `path`; nullptr stops recording. */
+    bool record(const char* path) { return maru_recordQueue(m_handle, path); }
+    bool rewindRecording() { return maru_rewindQueueRecording(m_handle); }
+
 #if __cplusplus >= 202002L
     template <typename Visitor>
     void scan(EventDispatcher<Visitor>& dispatcher, MARU_EventMask mask = MARU_ALL_EVENTS);
@@ -4,301 +4,243 @@
 #ifndef MARU_CXX20_IMPL_HPP_INCLUDED
 #define MARU_CXX20_IMPL_HPP_INCLUDED
 
+#include <concepts>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
 #include <utility>
 
 namespace maru {
 
 namespace details {
 
+// Binds an event id to the wrapper types visitors take for it and to its
+// MARU_Event member. Ids without a binding are never dispatched.
+template <uint32_t Id>
+struct EventBinding {
+  static constexpr bool known = false;
+};
+
+template <typename LiveEvent, typename QueuedEventT, auto Member>
+struct BoundEvent {
+  static constexpr bool known = true;
+  using Live = LiveEvent;
+  using Queued = QueuedEventT;
+  static constexpr auto member = Member;
+};
+
+template <> struct EventBinding<MARU_EVENT_WINDOW_READY>
+    : BoundEvent<WindowReadyEvent, QueuedWindowReadyEvent, &MARU_Event::window_ready> {};
+template <> struct EventBinding<MARU_EVENT_CLOSE_REQUESTED>
+    : BoundEvent<CloseRequestedEvent, QueuedCloseRequestedEvent, &MARU_Event::close_requested> {};
+template <> struct EventBinding<MARU_EVENT_WINDOW_RESIZED>
+    : BoundEvent<WindowResizedEvent, QueuedWindowResizedEvent, &MARU_Event::window_resized> {};
+template <> struct EventBinding<MARU_EVENT_WINDOW_STATE_CHANGED>
+    : BoundEvent<WindowStateChangedEvent, QueuedWindowStateChangedEvent,
+                 &MARU_Event::window_state_changed> {};
+template <> struct EventBinding<MARU_EVENT_KEY_CHANGED>
+    : BoundEvent<KeyChangedEvent, QueuedKeyChangedEvent, &MARU_Event::key_changed> {};
+template <> struct EventBinding<MARU_EVENT_MOUSE_MOVED>
+    : BoundEvent<MouseMovedEvent, QueuedMouseMovedEvent, &MARU_Event::mouse_moved> {};
+template <> struct EventBinding<MARU_EVENT_MOUSE_BUTTON_CHANGED>
+    : BoundEvent<MouseButtonChangedEvent, QueuedMouseButtonChangedEvent,
+                 &MARU_Event::mouse_button_changed> {};
+template <> struct EventBinding<MARU_EVENT_MOUSE_SCROLLED>
+    : BoundEvent<MouseScrolledEvent, QueuedMouseScrolledEvent, &MARU_Event::mouse_scrolled> {};
+template <> struct EventBinding<MARU_EVENT_IDLE_CHANGED>
+    : BoundEvent<IdleEvent, QueuedIdleEvent, &MARU_Event::idle_changed> {};
+template <> struct EventBinding<MARU_EVENT_MONITOR_CHANGED>
+    : BoundEvent<MonitorChangedEvent, QueuedMonitorChangedEvent, &MARU_Event::monitor_changed> {};
+template <> struct EventBinding<MARU_EVENT_MONITOR_MODE_CHANGED>
+    : BoundEvent<MonitorModeEvent, QueuedMonitorModeEvent, &MARU_Event::monitor_mode_changed> {};
+template <> struct EventBinding<MARU_EVENT_DROP_ENTERED>
+    : BoundEvent<DropEnteredEvent, QueuedDropEnteredEvent, &MARU_Event::drop_entered> {};
+template <> struct EventBinding<MARU_EVENT_DROP_HOVERED>
+    : BoundEvent<DropHoveredEvent, QueuedDropHoveredEvent, &MARU_Event::drop_hovered> {};
+template <> struct EventBinding<MARU_EVENT_DROP_EXITED>
+    : BoundEvent<DropExitedEvent, QueuedDropExitedEvent, &MARU_Event::drop_exited> {};
+template <> struct EventBinding<MARU_EVENT_DROP_DROPPED>
+    : BoundEvent<DropDroppedEvent, QueuedDropDroppedEvent, &MARU_Event::drop_dropped> {};
+template <> struct EventBinding<MARU_EVENT_DATA_RECEIVED>
+    : BoundEvent<DataReceivedEvent, QueuedDataReceivedEvent, &MARU_Event::data_received> {};
+template <> struct EventBinding<MARU_EVENT_DATA_REQUESTED>
+    : BoundEvent<DataRequestEvent, QueuedDataRequestEvent, &MARU_Event::data_requested> {};
+template <> struct EventBinding<MARU_EVENT_DATA_RELEASED>
+    : BoundEvent<DataReleasedEvent, QueuedDataReleasedEvent, &MARU_Event::data_released> {};
+template <> struct EventBinding<MARU_EVENT_DRAG_FINISHED>
+    : BoundEvent<DragFinishedEvent, QueuedDragFinishedEvent, &MARU_Event::drag_finished> {};
+template <> struct EventBinding<MARU_EVENT_CONTROLLER_CHANGED>
+    : BoundEvent<ControllerChangedEvent, QueuedControllerChangedEvent,
+                 &MARU_Event::controller_changed> {};
+template <> struct EventBinding<MARU_EVENT_CONTROLLER_BUTTON_CHANGED>
+    : BoundEvent<ControllerButtonChangedEvent, QueuedControllerButtonChangedEvent,
+                 &MARU_Event::controller_button_changed> {};
+template <> struct EventBinding<MARU_EVENT_CONTROLLER_ANALOG_CHANGED>
+    : BoundEvent<ControllerAnalogChangedEvent, QueuedControllerAnalogChangedEvent,
+                 &MARU_Event::controller_analog_changed> {};
+template <> struct EventBinding<MARU_EVENT_MIME_TYPES_READY>
+    : BoundEvent<MimeTypesReadyEvent, QueuedMimeTypesReadyEvent, &MARU_Event::mime_types_ready> {};
+template <> struct EventBinding<MARU_EVENT_DATA_CHUNK_RECEIVED>
+    : BoundEvent<DataChunkReceivedEvent, QueuedDataChunkReceivedEvent,
+                 &MARU_Event::data_chunk_received> {};
+template <> struct EventBinding<MARU_EVENT_WINDOW_FRAME>
+    : BoundEvent<WindowFrameEvent, QueuedWindowFrameEvent, &MARU_Event::window_frame> {};
+template <> struct EventBinding<MARU_EVENT_TEXT_EDIT_STARTED>
+    : BoundEvent<TextEditStartedEvent, QueuedTextEditStartedEvent,
+                 &MARU_Event::text_edit_started> {};
+template <> struct EventBinding<MARU_EVENT_TEXT_EDIT_UPDATED>
+    : BoundEvent<TextEditUpdatedEvent, QueuedTextEditUpdatedEvent,
+                 &MARU_Event::text_edit_updated> {};
+template <> struct EventBinding<MARU_EVENT_TEXT_EDIT_COMMITTED>
+    : BoundEvent<TextEditCommittedEvent, QueuedTextEditCommittedEvent,
+                 &MARU_Event::text_edit_committed> {};
+template <> struct EventBinding<MARU_EVENT_TEXT_EDIT_ENDED>
+    : BoundEvent<TextEditEndedEvent, QueuedTextEditEndedEvent, &MARU_Event::text_edit_ended> {};
+template <> struct EventBinding<MARU_EVENT_TEXT_EDIT_NAVIGATION>
+    : BoundEvent<TextEditNavigationEvent, QueuedTextEditNavigationEvent,
+                 &MARU_Event::text_edit_navigation> {};
+
+template <uint32_t Id>
+  requires(Id >= MARU_EVENT_USER_0 && Id <= MARU_EVENT_USER_15)
+struct EventBinding<Id>
+    : BoundEvent<UserEventSource<MARU_Window *, Id - MARU_EVENT_USER_0>,
+                 UserEventSource<MARU_WindowId, Id - MARU_EVENT_USER_0>, &MARU_Event::user> {};
+
+using EventThunk = void (*)(void *visitor, MARU_Window *window, const MARU_Event &evt);
+using QueuedEventThunk = void (*)(void *visitor, MARU_WindowId window_id,
+                                  const MARU_Event &evt);
+
+template <typename V, uint32_t Id>
+void eventThunk(void *visitor, MARU_Window *window, const MARU_Event &evt) {
+  using Binding = EventBinding<Id>;
+  (*static_cast<V *>(visitor))(typename Binding::Live{window, evt.*Binding::member});
+}
+
+template <typename V, uint32_t Id>
+void queuedEventThunk(void *visitor, MARU_WindowId window_id, const MARU_Event &evt) {
+  using Binding = EventBinding<Id>;
+  (*static_cast<V *>(visitor))(typename Binding::Queued{window_id, evt.*Binding::member});
+}
+
+inline constexpr uint32_t event_id_count = sizeof(MARU_EventMask) * 8u;
+
+inline constexpr bool isUserEventId(uint32_t id) {
+  return id >= MARU_EVENT_USER_0 && id <= MARU_EVENT_USER_15;
+}
+
+// A type no handler names. A visitor callable with it has a catch-all handler,
+// which would also win over typed handlers for UserEventSource.
+struct UnrelatedEvent {};
+
+// Tells an ambiguous call from one with no viable handler: the ellipsis
+// overload loses to every viable candidate, so a call that stays ill-formed
+// with it in the set had several equally good handlers.
+struct EllipsisHandler {
+  struct NoHandler {};
+  NoHandler operator()(...) const;
+};
+
+template <typename V>
+struct EllipsisProbe : V, EllipsisHandler {
+  using V::operator();
+  using EllipsisHandler::operator();
+};
+
+// Naming operator() on this is ambiguous exactly when `V` declares one.
+struct CallOperatorMarker {
+  void operator()() const;
+};
+template <typename V>
+struct CallOperatorLookup : V, CallOperatorMarker {};
+
+template <typename V>
+concept HasCallOperator = std::is_class_v<V> && !std::is_final_v<V> &&
+                          !requires { &CallOperatorLookup<V>::operator(); };
+
+template <typename V, typename Event>
+consteval bool isAmbiguousHandler() {
+  if constexpr (!HasCallOperator<V> || std::invocable<V &, Event>) {
+    return false;
+  } else {
+    return !std::invocable<EllipsisProbe<V> &, Event>;
+  }
+}
+
+// One thunk per event id, null where the visitor has no handler. `mask` has
+// a bit set for every non-null thunk.
+template <typename Thunk>
+struct DispatchTable {
+  Thunk thunks[event_id_count] = {};
+  MARU_EventMask mask = 0;
+};
+
+template <typename V, bool Queued, uint32_t... Ids>
+consteval auto makeDispatchTable(std::integer_sequence<uint32_t, Ids...>) {
+  DispatchTable<std::conditional_t<Queued, QueuedEventThunk, EventThunk>> table;
+  (
+      [&table] {
+        using Binding = EventBinding<Ids>;
+        if constexpr (!Binding::known) {
+          return;
+        } else if constexpr (isUserEventId(Ids) && std::invocable<V &, UnrelatedEvent>) {
+          // UserEventSource is internal; only typed user handlers may see it.
+          return;
+        } else {
+          using Event =
+              std::conditional_t<Queued, typename Binding::Queued, typename Binding::Live>;
+          static_assert(!isAmbiguousHandler<V, Event>(),
+                        "Several handlers of this visitor match the same event equally well");
+          if constexpr (std::invocable<V &, Event>) {
+            if constexpr (Queued) {
+              table.thunks[Ids] = &queuedEventThunk<V, Ids>;
+            } else {
+              table.thunks[Ids] = &eventThunk<V, Ids>;
+            }
+            table.mask |= MARU_EVENT_MASK(Ids);
+          }
+        }
+      }(),
+      ...);
+  return table;
+}
+
+template <typename V, bool Queued>
+inline constexpr auto dispatch_table =
+    makeDispatchTable<V, Queued>(std::make_integer_sequence<uint32_t, event_id_count>{});
+
+template <typename V, bool Queued>
+consteval MARU_EventMask visitorMask() {
+  return dispatch_table<V, Queued>.mask;
+}
+
+template <typename V>
+void *erasedVisitor(V &visitor) {
+  return const_cast<void *>(static_cast<const void *>(std::addressof(visitor)));
+}
+
 template <typename F>
 consteval MARU_EventMask generateMask() {
-  MARU_EventMask mask = 0;
-  if constexpr (std::invocable<F, WindowReadyEvent> || std::invocable<F, QueuedWindowReadyEvent>)
-    mask |= MARU_MASK_WINDOW_READY;
-  if constexpr (std::invocable<F, CloseRequestedEvent> || std::invocable<F, QueuedCloseRequestedEvent>)
-    mask |= MARU_MASK_CLOSE_REQUESTED;
-  if constexpr (std::invocable<F, WindowResizedEvent> || std::invocable<F, QueuedWindowResizedEvent>)
-    mask |= MARU_MASK_WINDOW_RESIZED;
-  if constexpr (std::invocable<F, WindowStateChangedEvent> ||
-                std::invocable<F, QueuedWindowStateChangedEvent>)
-    mask |= MARU_MASK_WINDOW_STATE_CHANGED;
-  if constexpr (std::invocable<F, KeyChangedEvent> || std::invocable<F, QueuedKeyChangedEvent>)
-    mask |= MARU_MASK_KEY_CHANGED;
-  if constexpr (std::invocable<F, MouseMovedEvent> || std::invocable<F, QueuedMouseMovedEvent>)
-    mask |= MARU_MASK_MOUSE_MOVED;
-  if constexpr (std::invocable<F, MouseButtonChangedEvent> ||
-                std::invocable<F, QueuedMouseButtonChangedEvent>)
-    mask |= MARU_MASK_MOUSE_BUTTON_CHANGED;
-  if constexpr (std::invocable<F, MouseScrolledEvent> || std::invocable<F, QueuedMouseScrolledEvent>)
-    mask |= MARU_MASK_MOUSE_SCROLLED;
-  if constexpr (std::invocable<F, IdleEvent> || std::invocable<F, QueuedIdleEvent>)
-    mask |= MARU_MASK_IDLE_CHANGED;
-  if constexpr (std::invocable<F, MonitorChangedEvent> || std::invocable<F, QueuedMonitorChangedEvent>)
-    mask |= MARU_MASK_MONITOR_CHANGED;
-  if constexpr (std::invocable<F, MonitorModeEvent> || std::invocable<F, QueuedMonitorModeEvent>)
-    mask |= MARU_MASK_MONITOR_MODE_CHANGED;
-  if constexpr (std::invocable<F, DropEnteredEvent> || std::invocable<F, QueuedDropEnteredEvent>)
-    mask |= MARU_MASK_DROP_ENTERED;
-  if constexpr (std::invocable<F, DropHoveredEvent> || std::invocable<F, QueuedDropHoveredEvent>)
-    mask |= MARU_MASK_DROP_HOVERED;
-  if constexpr (std::invocable<F, DropExitedEvent> || std::invocable<F, QueuedDropExitedEvent>)
-    mask |= MARU_MASK_DROP_EXITED;
-  if constexpr (std::invocable<F, DropDroppedEvent> || std::invocable<F, QueuedDropDroppedEvent>)
-    mask |= MARU_MASK_DROP_DROPPED;
-  if constexpr (std::invocable<F, DataReceivedEvent> || std::invocable<F, QueuedDataReceivedEvent>)
-    mask |= MARU_EVENT_MASK(MARU_EVENT_DATA_RECEIVED);
-  if constexpr (std::invocable<F, DataRequestEvent> || std::invocable<F, QueuedDataRequestEvent>)
-    mask |= MARU_EVENT_MASK(MARU_EVENT_DATA_REQUESTED);
-  if constexpr (std::invocable<F, DataReleasedEvent> || std::invocable<F, QueuedDataReleasedEvent>)
-    mask |= MARU_EVENT_MASK(MARU_EVENT_DATA_RELEASED);
-  if constexpr (std::invocable<F, DragFinishedEvent> || std::invocable<F, QueuedDragFinishedEvent>)
-    mask |= MARU_EVENT_MASK(MARU_EVENT_DRAG_FINISHED);
-  if constexpr (std::invocable<F, ControllerChangedEvent> ||
-                std::invocable<F, QueuedControllerChangedEvent>)
-    mask |= MARU_MASK_CONTROLLER_CHANGED;
-  if constexpr (std::invocable<F, ControllerButtonChangedEvent> ||
-                std::invocable<F, QueuedControllerButtonChangedEvent>)
-    mask |= MARU_EVENT_MASK(MARU_EVENT_CONTROLLER_BUTTON_CHANGED);
-  if constexpr (std::invocable<F, WindowFrameEvent> || std::invocable<F, QueuedWindowFrameEvent>)
-    mask |= MARU_MASK_WINDOW_FRAME;
-  if constexpr (std::invocable<F, TextEditStartedEvent> ||
-                std::invocable<F, QueuedTextEditStartedEvent>)
-    mask |= MARU_MASK_TEXT_EDIT_STARTED;
-  if constexpr (std::invocable<F, TextEditUpdatedEvent> ||
-                std::invocable<F, QueuedTextEditUpdatedEvent>)
-    mask |= MARU_MASK_TEXT_EDIT_UPDATED;
-  if constexpr (std::invocable<F, TextEditCommittedEvent> ||
-                std::invocable<F, QueuedTextEditCommittedEvent>)
-    mask |= MARU_MASK_TEXT_EDIT_COMMITTED;
-  if constexpr (std::invocable<F, TextEditEndedEvent> || std::invocable<F, QueuedTextEditEndedEvent>)
-    mask |= MARU_MASK_TEXT_EDIT_ENDED;
-  return mask;
+  return visitorMask<F, false>() | visitorMask<F, true>();
 }
 
 template <typename Visitor>
 void dispatchVisitor(MARU_EventId type, MARU_Window *window, const MARU_Event &evt, Visitor &&f) {
-  using F_raw = std::remove_cvref_t<Visitor>;
-  switch (type) {
-    case MARU_EVENT_WINDOW_READY:
-      if constexpr (std::invocable<F_raw, WindowReadyEvent>)
-        f(WindowReadyEvent{window, evt.window_ready});
-      break;
-    case MARU_EVENT_CLOSE_REQUESTED:
-      if constexpr (std::invocable<F_raw, CloseRequestedEvent>)
-        f(CloseRequestedEvent{window, evt.close_requested});
-      break;
-    case MARU_EVENT_WINDOW_RESIZED:
-      if constexpr (std::invocable<F_raw, WindowResizedEvent>)
-        f(WindowResizedEvent{window, evt.window_resized});
-      break;
-    case MARU_EVENT_WINDOW_STATE_CHANGED:
-      if constexpr (std::invocable<F_raw, WindowStateChangedEvent>)
-        f(WindowStateChangedEvent{window, evt.window_state_changed});
-      break;
-    case MARU_EVENT_KEY_CHANGED:
-      if constexpr (std::invocable<F_raw, KeyChangedEvent>) 
-        f(KeyChangedEvent{window, evt.key_changed});
-      break;
-    case MARU_EVENT_MOUSE_MOVED:
-      if constexpr (std::invocable<F_raw, MouseMovedEvent>)
-        f(MouseMovedEvent{window, evt.mouse_moved});
-      break;
-    case MARU_EVENT_MOUSE_BUTTON_CHANGED:
-      if constexpr (std::invocable<F_raw, MouseButtonChangedEvent>)
-        f(MouseButtonChangedEvent{window, evt.mouse_button_changed});
-      break;
-    case MARU_EVENT_MOUSE_SCROLLED:
-      if constexpr (std::invocable<F_raw, MouseScrolledEvent>)
-        f(MouseScrolledEvent{window, evt.mouse_scrolled});
-      break;
-    case MARU_EVENT_IDLE_CHANGED:
-      if constexpr (std::invocable<F_raw, IdleEvent>) 
-        f(IdleEvent{window, evt.idle_changed});
-      break;
-    case MARU_EVENT_MONITOR_CHANGED:
-      if constexpr (std::invocable<F_raw, MonitorChangedEvent>)
-        f(MonitorChangedEvent{window, evt.monitor_changed});
-      break;
-    case MARU_EVENT_MONITOR_MODE_CHANGED:
-      if constexpr (std::invocable<F_raw, MonitorModeEvent>)
-        f(MonitorModeEvent{window, evt.monitor_mode_changed});
-      break;
-    case MARU_EVENT_DROP_ENTERED:
-      if constexpr (std::invocable<F_raw, DropEnteredEvent>)
-        f(DropEnteredEvent{window, evt.drop_entered});
-      break;
-    case MARU_EVENT_DROP_HOVERED:
-      if constexpr (std::invocable<F_raw, DropHoveredEvent>)
-        f(DropHoveredEvent{window, evt.drop_hovered});
-      break;
-    case MARU_EVENT_DROP_EXITED:
-      if constexpr (std::invocable<F_raw, DropExitedEvent>)
-        f(DropExitedEvent{window, evt.drop_exited});
-      break;
-    case MARU_EVENT_DROP_DROPPED:
-      if constexpr (std::invocable<F_raw, DropDroppedEvent>)
-        f(DropDroppedEvent{window, evt.drop_dropped});
-      break;
-    case MARU_EVENT_DATA_RECEIVED:
-      if constexpr (std::invocable<F_raw, DataReceivedEvent>)
-        f(DataReceivedEvent{window, evt.data_received});
-      break;
-    case MARU_EVENT_DATA_REQUESTED:
-      if constexpr (std::invocable<F_raw, DataRequestEvent>)
-        f(DataRequestEvent{window, evt.data_requested});
-      break;
-    case MARU_EVENT_DATA_RELEASED:
-      if constexpr (std::invocable<F_raw, DataReleasedEvent>)
-        f(DataReleasedEvent{window, evt.data_released});
-      break;
-    case MARU_EVENT_DRAG_FINISHED:
-      if constexpr (std::invocable<F_raw, DragFinishedEvent>)
-        f(DragFinishedEvent{window, evt.drag_finished});
-      break;
-    case MARU_EVENT_CONTROLLER_CHANGED:
-      if constexpr (std::invocable<F_raw, ControllerChangedEvent>)
-        f(ControllerChangedEvent{window, evt.controller_changed});
-      break;
-    case MARU_EVENT_CONTROLLER_BUTTON_CHANGED:
-      if constexpr (std::invocable<F_raw, ControllerButtonChangedEvent>)
-        f(ControllerButtonChangedEvent{window, evt.controller_button_changed});
-      break;
-    case MARU_EVENT_WINDOW_FRAME:
-      if constexpr (std::invocable<F_raw, WindowFrameEvent>)
-        f(WindowFrameEvent{window, evt.window_frame});
-      break;
-    case MARU_EVENT_TEXT_EDIT_STARTED:
-      if constexpr (std::invocable<F_raw, TextEditStartedEvent>)
-        f(TextEditStartedEvent{window, evt.text_edit_started});
-      break;
-    case MARU_EVENT_TEXT_EDIT_UPDATED:
-      if constexpr (std::invocable<F_raw, TextEditUpdatedEvent>)
-        f(TextEditUpdatedEvent{window, evt.text_edit_updated});
-      break;
-    case MARU_EVENT_TEXT_EDIT_COMMITTED:
-      if constexpr (std::invocable<F_raw, TextEditCommittedEvent>)
-        f(TextEditCommittedEvent{window, evt.text_edit_committed});
-      break;
-    case MARU_EVENT_TEXT_EDIT_ENDED:
-      if constexpr (std::invocable<F_raw, TextEditEndedEvent>)
-        f(TextEditEndedEvent{window, evt.text_edit_ended});
-      break;
-    default:
-      break;
+  using V = std::remove_reference_t<Visitor>;
+  constexpr auto &table = dispatch_table<V, false>;
+  const uint32_t id = static_cast<uint32_t>(type);
+  if (id < event_id_count && table.thunks[id]) {
+    table.thunks[id](erasedVisitor(f), window, evt);
   }
 }
 
 template <typename Visitor>
 void dispatchQueuedVisitor(MARU_EventId type, MARU_WindowId window_id,
                            const MARU_Event &evt, Visitor &&f) {
-  using F_raw = std::remove_cvref_t<Visitor>;
-  switch (type) {
-    case MARU_EVENT_WINDOW_READY:
-      if constexpr (std::invocable<F_raw, QueuedWindowReadyEvent>)
-        f(QueuedWindowReadyEvent{window_id, evt.window_ready});
-      break;
-    case MARU_EVENT_CLOSE_REQUESTED:
-      if constexpr (std::invocable<F_raw, QueuedCloseRequestedEvent>)
-        f(QueuedCloseRequestedEvent{window_id, evt.close_requested});
-      break;
-    case MARU_EVENT_WINDOW_RESIZED:
-      if constexpr (std::invocable<F_raw, QueuedWindowResizedEvent>)
-        f(QueuedWindowResizedEvent{window_id, evt.window_resized});
-      break;
-    case MARU_EVENT_WINDOW_STATE_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedWindowStateChangedEvent>)
-        f(QueuedWindowStateChangedEvent{window_id, evt.window_state_changed});
-      break;
-    case MARU_EVENT_KEY_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedKeyChangedEvent>)
-        f(QueuedKeyChangedEvent{window_id, evt.key_changed});
-      break;
-    case MARU_EVENT_MOUSE_MOVED:
-      if constexpr (std::invocable<F_raw, QueuedMouseMovedEvent>)
-        f(QueuedMouseMovedEvent{window_id, evt.mouse_moved});
-      break;
-    case MARU_EVENT_MOUSE_BUTTON_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedMouseButtonChangedEvent>)
-        f(QueuedMouseButtonChangedEvent{window_id, evt.mouse_button_changed});
-      break;
-    case MARU_EVENT_MOUSE_SCROLLED:
-      if constexpr (std::invocable<F_raw, QueuedMouseScrolledEvent>)
-        f(QueuedMouseScrolledEvent{window_id, evt.mouse_scrolled});
-      break;
-    case MARU_EVENT_IDLE_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedIdleEvent>)
-        f(QueuedIdleEvent{window_id, evt.idle_changed});
-      break;
-    case MARU_EVENT_MONITOR_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedMonitorChangedEvent>)
-        f(QueuedMonitorChangedEvent{window_id, evt.monitor_changed});
-      break;
-    case MARU_EVENT_MONITOR_MODE_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedMonitorModeEvent>)
-        f(QueuedMonitorModeEvent{window_id, evt.monitor_mode_changed});
-      break;
-    case MARU_EVENT_DROP_ENTERED:
-      if constexpr (std::invocable<F_raw, QueuedDropEnteredEvent>)
-        f(QueuedDropEnteredEvent{window_id, evt.drop_entered});
-      break;
-    case MARU_EVENT_DROP_HOVERED:
-      if constexpr (std::invocable<F_raw, QueuedDropHoveredEvent>)
-        f(QueuedDropHoveredEvent{window_id, evt.drop_hovered});
-      break;
-    case MARU_EVENT_DROP_EXITED:
-      if constexpr (std::invocable<F_raw, QueuedDropExitedEvent>)
-        f(QueuedDropExitedEvent{window_id, evt.drop_exited});
-      break;
-    case MARU_EVENT_DROP_DROPPED:
-      if constexpr (std::invocable<F_raw, QueuedDropDroppedEvent>)
-        f(QueuedDropDroppedEvent{window_id, evt.drop_dropped});
-      break;
-    case MARU_EVENT_DATA_RECEIVED:
-      if constexpr (std::invocable<F_raw, QueuedDataReceivedEvent>)
-        f(QueuedDataReceivedEvent{window_id, evt.data_received});
-      break;
-    case MARU_EVENT_DATA_REQUESTED:
-      if constexpr (std::invocable<F_raw, QueuedDataRequestEvent>)
-        f(QueuedDataRequestEvent{window_id, evt.data_requested});
-      break;
-    case MARU_EVENT_DATA_RELEASED:
-      if constexpr (std::invocable<F_raw, QueuedDataReleasedEvent>)
-        f(QueuedDataReleasedEvent{window_id, evt.data_released});
-      break;
-    case MARU_EVENT_DRAG_FINISHED:
-      if constexpr (std::invocable<F_raw, QueuedDragFinishedEvent>)
-        f(QueuedDragFinishedEvent{window_id, evt.drag_finished});
-      break;
-    case MARU_EVENT_CONTROLLER_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedControllerChangedEvent>)
-        f(QueuedControllerChangedEvent{window_id, evt.controller_changed});
-      break;
-    case MARU_EVENT_CONTROLLER_BUTTON_CHANGED:
-      if constexpr (std::invocable<F_raw, QueuedControllerButtonChangedEvent>)
-        f(QueuedControllerButtonChangedEvent{window_id, evt.controller_button_changed});
-      break;
-    case MARU_EVENT_WINDOW_FRAME:
-      if constexpr (std::invocable<F_raw, QueuedWindowFrameEvent>)
-        f(QueuedWindowFrameEvent{window_id, evt.window_frame});
-      break;
-    case MARU_EVENT_TEXT_EDIT_STARTED:
-      if constexpr (std::invocable<F_raw, QueuedTextEditStartedEvent>)
-        f(QueuedTextEditStartedEvent{window_id, evt.text_edit_started});
-      break;
-    case MARU_EVENT_TEXT_EDIT_UPDATED:
-      if constexpr (std::invocable<F_raw, QueuedTextEditUpdatedEvent>)
-        f(QueuedTextEditUpdatedEvent{window_id, evt.text_edit_updated});
-      break;
-    case MARU_EVENT_TEXT_EDIT_COMMITTED:
-      if constexpr (std::invocable<F_raw, QueuedTextEditCommittedEvent>)
-        f(QueuedTextEditCommittedEvent{window_id, evt.text_edit_committed});
-      break;
-    case MARU_EVENT_TEXT_EDIT_ENDED:
-      if constexpr (std::invocable<F_raw, QueuedTextEditEndedEvent>)
-        f(QueuedTextEditEndedEvent{window_id, evt.text_edit_ended});
-      break;
-    default:
-      break;
+  using V = std::remove_reference_t<Visitor>;
+  constexpr auto &table = dispatch_table<V, true>;
+  const uint32_t id = static_cast<uint32_t>(type);
+  if (id < event_id_count && table.thunks[id]) {
+    table.thunks[id](erasedVisitor(f), window_id, evt);
   }
 }
 
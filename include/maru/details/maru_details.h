@@ -81,6 +81,8 @@ typedef struct MARU_ContextPrefix {
   uint32_t mouse_button_count;
   const MARU_ButtonState8* keyboard_state;
   uint32_t keyboard_key_count;
+  const MARU_MouseMotionSample* mouse_motion_samples;
+  uint32_t mouse_motion_sample_count;
 } MARU_ContextPrefix;
 
 typedef struct MARU_ImagePrefix {
@@ -194,6 +196,17 @@ static inline bool maru_isMouseButtonPressed(const MARU_Context* context,
   return states ? (states[button_id] == MARU_BUTTON_STATE_PRESSED) : false;
 }
 
+static inline uint32_t maru_getMouseMotionSampleCount(const MARU_Context* context) {
+  MARU_VALIDATE_API(context != NULL);
+  return ((const MARU_ContextPrefix*)context)->mouse_motion_sample_count;
+}
+
+static inline const MARU_MouseMotionSample* maru_getMouseMotionSamples(
+    const MARU_Context* context) {
+  MARU_VALIDATE_API(context != NULL);
+  return ((const MARU_ContextPrefix*)context)->mouse_motion_samples;
+}
+
 static inline void* maru_getImageUserdata(const MARU_Image* image) {
   MARU_VALIDATE_API(image != NULL);
   return ((const MARU_ImagePrefix*)image)->userdata;
@@ -328,10 +328,34 @@ inline MARU_Status Context::pumpEvents(uint32_t timeout_ms, MARU_EventMask mask,
     return maru_pumpEvents(m_handle, timeout_ms, mask, callback, userdata);
 }
 
+inline MARU_Status Context::pumpEventsUntil(uint64_t deadline_ns, MARU_EventMask mask,
+                                            MARU_EventCallback callback,
+                                            void* userdata) {
+    return maru_pumpEventsUntil(m_handle, deadline_ns, mask, callback, userdata);
+}
+
 inline MARU_Status Context::postEvent(MARU_EventId type, MARU_UserDefinedEvent evt) {
     return maru_postEvent(m_handle, type, evt);
 }
 
+template <typename T>
+inline MARU_Status Context::postEvent(MARU_EventId type, const T& payload) {
+    details::checkUserPayload<T>();
+    return maru_postEventPayload(m_handle, type, &payload, sizeof(T));
+}
+
+inline MARU_Status Context::postEvents(const MARU_EventId* types,
+                                       const MARU_UserDefinedEvent* events,
+                                       uint32_t count, uint32_t* out_posted_count) {
+    return maru_postEvents(m_handle, types, events, count, out_posted_count);
+}
+
+inline MARU_UserEventQueueStats Context::getUserEventQueueStats() const {
+    MARU_UserEventQueueStats stats;
+    maru_getUserEventQueueStats(m_handle, &stats);
+    return stats;
+}
+
 inline MARU_Status Context::wake() {
     return maru_wakeContext(m_handle);
 }
@@ -352,6 +376,13 @@ inline expected<Queue, bool> Queue::create(uint32_t capacity) {
     return Queue(handle);
 }
 
+inline expected<Queue, bool> Queue::openRecording(const char* path,
+                                                  const MARU_QueueCreateInfo& create_info) {
+    MARU_Queue* handle = nullptr;
+    if (!maru_openQueueRecording(path, &create_info, &handle)) return unexpected<bool>(false);
+    return Queue(handle);
+}
+
 inline Queue::~Queue() {
     if (m_handle) maru_destroyQueue(m_handle);
 }
@@ -383,6 +414,33 @@ inline void Queue::scan(MARU_EventMask mask, MARU_QueueEventCallback callback,
     maru_scanQueue(m_handle, mask, callback, userdata);
 }
 
+inline QueueView Queue::view() const {
+    return QueueView(m_handle);
+}
+
+inline QueueView::QueueView(const MARU_Queue* queue) : m_queue(queue) {
+    maru_getQueueView(m_queue, &m_view);
+}
+
+inline QueueView::~QueueView() {
+    if (m_queue) maru_releaseQueueView(m_queue, &m_view);
+}
+
+inline QueueView::QueueView(QueueView&& other) noexcept
+    : m_queue(other.m_queue), m_view(other.m_view) {
+    other.m_queue = nullptr;
+}
+
+inline QueueView& QueueView::operator=(QueueView&& other) noexcept {
+    if (this != &other) {
+        if (m_queue) maru_releaseQueueView(m_queue, &m_view);
+        m_queue = other.m_queue;
+        m_view = other.m_view;
+        other.m_queue = nullptr;
+    }
+    return *this;
+}
+
 } // namespace maru
 
 #endif // MARU_HPP_IMPL_HPP_INCLUDED
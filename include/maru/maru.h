@@ -17,7 +17,8 @@
  *    and userdata accessors (`maru_get*Userdata` / `maru_set*Userdata`) can
  *    be called from any thread with external synchronization to guarantee
  *    visibility with the owner thread.
- * 4. maru_postEvent(), maru_wakeContext(), maru_retain*(), maru_release*(),
+ * 4. maru_postEvent(), maru_postEvents(), maru_getUserEventQueueStats(),
+ *    maru_wakeContext(), maru_retain*(), maru_release*(),
  *    and maru_getVersion() are globally thread-safe and can be called from
  *    any thread without external synchronization.
  * 5. Backends may use internal helper threads for blocking OS work. These
@@ -133,6 +134,7 @@ typedef enum MARU_Status {
   MARU_SUCCESS = 0,             // The operation succeeded
   MARU_FAILURE = 1,             // The operation failed, but the backend is still healthy
   MARU_CONTEXT_LOST = 2,  // The context is dead and now inert. You will have to rebuild it
+  MARU_PENDING = 3,             // Nothing to return yet; an event announces the result
 } MARU_Status;
 
 /*
@@ -268,6 +270,15 @@ typedef struct MARU_ContextTuning {
    * Non-zero values must be powers of two.
    */
   uint32_t user_event_queue_size;
+  /*
+   * When true, user events that do not fit in the queue spill into overflow
+   * segments instead of being dropped. Segments are allocated on demand
+   * through the context allocator, possibly from the posting thread, and are
+   * drained after the queue in posting order.
+   *
+   * See maru_getUserEventQueueStats() for sizing `user_event_queue_size`.
+   */
+  bool user_event_overflow;
 
   struct {
     /*
@@ -275,6 +286,13 @@ typedef struct MARU_ContextTuning {
      * that opt into decorations.
      */
     MARU_WaylandDecorationStrategy decoration_strategy;
+    /*
+     * When true, wl_pointer.motion and relative-pointer samples are held back
+     * until wl_pointer.frame and delivered as a single MARU_EVENT_MOUSE_MOVED
+     * per frame. The individual samples stay readable through
+     * maru_getMouseMotionSamples() during that callback.
+     */
+    bool batch_pointer_motion;
   } wayland;
 
   struct {
@@ -299,28 +317,45 @@ typedef struct MARU_ContextTuning {
 
   struct {
     /*
-     * X11-only timeout budget, in milliseconds, for synchronous selection /
-     * clipboard round-trips that may be needed to complete a data-exchange
-     * request during a pump.
+     * X11-only budget, in milliseconds, for another client to answer a
+     * clipboard MIME-type (TARGETS) query. Maru never blocks on that reply;
+     * a query left unanswered for longer is reported as a diagnostic and
+     * issued again by the next maru_getAvailableClipboardMIMETypes() call.
      *
-     * `0` means "do not wait": operations that would need to block for a
-     * SelectionNotify/selection-owner reply fail immediately instead.
+     * `0` or MARU_NEVER keeps waiting for the original reply.
      *
      * This tuning does not affect the lifetime of clipboard ownership after
-     * maru_announceClipboardData(); it only bounds how long Maru will block on
-     * these X11 selection handshakes when it has to wait for another party.
+     * maru_announceClipboardData().
      */
     uint32_t selection_query_timeout_ms;
   } x11;
+
+  struct {
+    /*
+     * Analog values whose magnitude is below this threshold are reported as
+     * 0 by MARU_EVENT_CONTROLLER_ANALOG_CHANGED. Must be in [0, 1).
+     *
+     * Polled analog state is not affected.
+     */
+    MARU_Scalar analog_deadzone;
+    /*
+     * Minimum change, after the deadzone is applied, for a channel to be
+     * reported by MARU_EVENT_CONTROLLER_ANALOG_CHANGED. Must be >= 0.
+     */
+    MARU_Scalar analog_epsilon;
+  } controller;
 } MARU_ContextTuning;
 
 #define MARU_CONTEXT_TUNING_DEFAULT                                            \
   {                                                                            \
       .user_event_queue_size = 256,                                            \
-      .wayland = {.decoration_strategy = MARU_WAYLAND_DECORATION_STRATEGY_AUTO}, \
+      .user_event_overflow = false,                                            \
+      .wayland = {.decoration_strategy = MARU_WAYLAND_DECORATION_STRATEGY_AUTO, \
+                  .batch_pointer_motion = false},                               \
       .cocoa = {.activation_policy = MARU_COCOA_ACTIVATION_POLICY_REGULAR,      \
                 .forward_key_events_to_appkit = false},                         \
       .x11 = {.selection_query_timeout_ms = 50},                                \
+      .controller = {.analog_deadzone = 0.0f, .analog_epsilon = 1.0f / 512.0f}, \
   }
 
 /* ----- Public handles ----- */
@@ -582,8 +617,11 @@ typedef enum MARU_EventId {
   MARU_EVENT_CONTROLLER_CHANGED = 24,
   MARU_EVENT_CONTROLLER_BUTTON_CHANGED = 25,
   MARU_EVENT_TEXT_EDIT_NAVIGATION = 26,
+  MARU_EVENT_CONTROLLER_ANALOG_CHANGED = 27,
+  MARU_EVENT_MIME_TYPES_READY = 28,
+  MARU_EVENT_DATA_CHUNK_RECEIVED = 29,
 
-  /* Ids 27 to 47 are reserved for future additions.
+  /* Ids 30 to 47 are reserved for future additions.
   * 
   * User event bits are permanently pinned to the end of the range.
   */
@@ -641,6 +679,9 @@ typedef enum MARU_EventId {
 #define MARU_MASK_CONTROLLER_CHANGED MARU_EVENT_MASK(MARU_EVENT_CONTROLLER_CHANGED)
 #define MARU_MASK_CONTROLLER_BUTTON_CHANGED MARU_EVENT_MASK(MARU_EVENT_CONTROLLER_BUTTON_CHANGED)
 #define MARU_MASK_TEXT_EDIT_NAVIGATION MARU_EVENT_MASK(MARU_EVENT_TEXT_EDIT_NAVIGATION)
+#define MARU_MASK_CONTROLLER_ANALOG_CHANGED MARU_EVENT_MASK(MARU_EVENT_CONTROLLER_ANALOG_CHANGED)
+#define MARU_MASK_MIME_TYPES_READY MARU_EVENT_MASK(MARU_EVENT_MIME_TYPES_READY)
+#define MARU_MASK_DATA_CHUNK_RECEIVED MARU_EVENT_MASK(MARU_EVENT_DATA_CHUNK_RECEIVED)
 #define MARU_MASK_USER_0 MARU_EVENT_MASK(MARU_EVENT_USER_0)
 #define MARU_MASK_USER_1 MARU_EVENT_MASK(MARU_EVENT_USER_1)
 #define MARU_MASK_USER_2 MARU_EVENT_MASK(MARU_EVENT_USER_2)
@@ -667,8 +708,10 @@ typedef enum MARU_EventId {
    MARU_MASK_DROP_EXITED | MARU_MASK_DROP_DROPPED | MARU_MASK_DATA_RECEIVED |                      \
    MARU_MASK_DATA_REQUESTED | MARU_MASK_DATA_RELEASED | MARU_MASK_DRAG_FINISHED |                  \
    MARU_MASK_CONTROLLER_CHANGED | MARU_MASK_CONTROLLER_BUTTON_CHANGED |                             \
-   MARU_MASK_TEXT_EDIT_NAVIGATION | MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_USER_2 |      \
-   MARU_MASK_USER_3 | MARU_MASK_USER_4 | MARU_MASK_USER_5 | MARU_MASK_USER_6 |                     \
+   MARU_MASK_TEXT_EDIT_NAVIGATION | MARU_MASK_CONTROLLER_ANALOG_CHANGED |                          \
+   MARU_MASK_MIME_TYPES_READY | MARU_MASK_DATA_CHUNK_RECEIVED | MARU_MASK_USER_0 |                 \
+   MARU_MASK_USER_1 | MARU_MASK_USER_2 | MARU_MASK_USER_3 | MARU_MASK_USER_4 | MARU_MASK_USER_5 |  \
+   MARU_MASK_USER_6 |                                                                              \
    MARU_MASK_USER_7 | MARU_MASK_USER_8 | MARU_MASK_USER_9 | MARU_MASK_USER_10 |                    \
    MARU_MASK_USER_11 | MARU_MASK_USER_12 | MARU_MASK_USER_13 | MARU_MASK_USER_14 |                 \
    MARU_MASK_USER_15)
@@ -715,6 +758,25 @@ typedef struct MARU_WindowFrameEvent {
    * wraparound themselves.
    */
   uint32_t timestamp_ms;
+  /*
+   * Display refresh interval in nanoseconds, or 0 if unknown or the output
+   * has no fixed refresh rate.
+   */
+  uint32_t refresh_interval_ns;
+  /*
+   * CLOCK_MONOTONIC time in nanoseconds at which the most recent content of
+   * this window reached the display, or 0 if no presentation has been
+   * reported yet. On X11 this is exact when the graphics stack presents
+   * through the Present extension. Otherwise it is the vblank that followed
+   * the previous frame event, which approximates the actual presentation.
+   */
+  uint64_t last_presentation_ns;
+  /*
+   * Display frame counter (media stream counter) matching
+   * `last_presentation_ns`. Only meaningful relative to other values from
+   * the same window; 0 if unknown.
+   */
+  uint64_t presentation_msc;
 } MARU_WindowFrameEvent;
 
 typedef struct MARU_WindowResizedEvent {
@@ -747,6 +809,15 @@ typedef struct MARU_KeyChangedEvent {
   MARU_Key key;
   MARU_ButtonState state;
   MARU_ModifierFlags modifiers;
+  /*
+   * Monotonic nanosecond time at which the input device produced this sample.
+   *
+   * Linux uses CLOCK_MONOTONIC, Windows the QueryPerformanceCounter timeline
+   * and macOS the system uptime clock. Backends without a native per-sample
+   * timestamp report the time the event was read instead. The other input
+   * events' timestamp_ns fields share this clock.
+   */
+  uint64_t timestamp_ns;
 } MARU_KeyChangedEvent;
 
 typedef struct MARU_MouseMovedEvent {
@@ -754,12 +825,23 @@ typedef struct MARU_MouseMovedEvent {
   MARU_Vec2Dip dip_delta;
   MARU_Vec2Dip raw_dip_delta;
   MARU_ModifierFlags modifiers;
+  /* Time of the most recent motion sample folded into this event. */
+  uint64_t timestamp_ns;
 } MARU_MouseMovedEvent;
 
+/* One raw motion sample folded into a batched MARU_EVENT_MOUSE_MOVED. */
+typedef struct MARU_MouseMotionSample {
+  MARU_Vec2Dip dip_position;
+  MARU_Vec2Dip dip_delta;
+  MARU_Vec2Dip raw_dip_delta;
+  uint64_t timestamp_ns;
+} MARU_MouseMotionSample;
+
 typedef struct MARU_MouseButtonChangedEvent {
   uint32_t button_id;
   MARU_ButtonState state;
   MARU_ModifierFlags modifiers;
+  uint64_t timestamp_ns;
 } MARU_MouseButtonChangedEvent;
 
 typedef struct MARU_MouseScrolledEvent {
@@ -769,6 +851,8 @@ typedef struct MARU_MouseScrolledEvent {
     int32_t y;
   } steps;
   MARU_ModifierFlags modifiers;
+  /* Time of the most recent scroll sample folded into this event. */
+  uint64_t timestamp_ns;
 } MARU_MouseScrolledEvent;
 
 typedef struct MARU_IdleChangedEvent {
@@ -860,6 +944,29 @@ typedef struct MARU_DataReceivedEvent {
   size_t size;
 } MARU_DataReceivedEvent;
 
+/*
+ * Emitted for streamed requests (maru_requestClipboardDataStream(),
+ * maru_requestDropDataStream()) instead of MARU_EVENT_DATA_RECEIVED.
+ *
+ * Chunks of one request arrive in order, and the last one has `is_final` set.
+ * Only the final chunk reports a failure; it may carry data of its own or be
+ * empty. Maru reuses the chunk storage afterwards, so the payload memory held
+ * for a stream stays bounded whatever the total size.
+ */
+typedef struct MARU_DataChunkReceivedEvent {
+  /* Opaque request token round-tripped from the streamed request call. */
+  void* userdata;
+  MARU_Status status;
+  MARU_DataExchangeTarget target;
+  /* Borrowed callback-scoped pointers. Copy what you need before returning. */
+  const char* mime_type;
+  const void* data;
+  size_t size;
+  /* Bytes of the payload delivered by earlier chunks of this request. */
+  uint64_t offset;
+  bool is_final;
+} MARU_DataChunkReceivedEvent;
+
 typedef struct MARU_DataRequestEvent {
   /* Selects whether maru_provideClipboardData() or maru_provideDropData() is valid. */
   MARU_DataExchangeTarget target;
@@ -891,6 +998,20 @@ typedef struct MARU_DataReleasedEvent {
   MARU_DropAction action;
 } MARU_DataReleasedEvent;
 
+/*
+ * Emitted when a MIME-type list that maru_getAvailableClipboardMIMETypes()
+ * could not answer right away becomes available. Calling it again from here or
+ * later returns the same list until the clipboard owner changes.
+ *
+ * `mime_types` is empty when the owner refused the query or advertised no
+ * usable type.
+ */
+typedef struct MARU_MimeTypesReadyEvent {
+  MARU_DataExchangeTarget target;
+  /* Borrowed callback-scoped pointers. Copy what you need before returning. */
+  MARU_StringList mime_types;
+} MARU_MimeTypesReadyEvent;
+
 typedef struct MARU_DragFinishedEvent {
   MARU_DropAction action;
 } MARU_DragFinishedEvent;
@@ -906,8 +1027,38 @@ typedef struct MARU_ControllerButtonChangedEvent {
   MARU_Controller* controller;
   MARU_ButtonState state;
   uint32_t button_id;
+  /* Same clock as MARU_KeyChangedEvent::timestamp_ns. */
+  uint64_t timestamp_ns;
 } MARU_ControllerButtonChangedEvent;
 
+/* Upper bound on a controller's analog channel count. */
+#define MARU_CONTROLLER_ANALOG_MAX_CHANNELS 64u
+
+/*
+ * Emitted at most once per controller input report, after every axis in the
+ * report has been applied, and only when at least one channel moved by more
+ * than `tuning.controller.analog_epsilon`.
+ */
+typedef struct MARU_ControllerAnalogChangedEvent {
+  /* Transient handle. Retain it if it must outlive the current pump cycle. */
+  MARU_Controller* controller;
+  /* Same clock as MARU_KeyChangedEvent::timestamp_ns. */
+  uint64_t timestamp_ns;
+  /*
+   * Bit N is set when analog channel N changed in this report. Controllers
+   * expose at most MARU_CONTROLLER_ANALOG_MAX_CHANNELS analog channels, so
+   * every channel has a bit.
+   */
+  uint64_t changed_mask;
+  /*
+   * Deadzone-filtered values of the standard channels, indexed by
+   * MARU_ControllerAnalog (MARU_CONTROLLER_ANALOG_STANDARD_COUNT entries).
+   * Non-standard channels are read from maru_getControllerAnalogStates()
+   * during the callback.
+   */
+  MARU_Scalar standard_values[6];
+} MARU_ControllerAnalogChangedEvent;
+
 typedef struct MARU_TextRangeUtf8 {
   /* Byte offset into the associated UTF-8 string. */
   uint32_t start_byte;
@@ -1025,6 +1176,9 @@ typedef struct MARU_Event {
     MARU_DragFinishedEvent drag_finished;
     MARU_ControllerChangedEvent controller_changed;
     MARU_ControllerButtonChangedEvent controller_button_changed;
+    MARU_ControllerAnalogChangedEvent controller_analog_changed;
+    MARU_MimeTypesReadyEvent mime_types_ready;
+    MARU_DataChunkReceivedEvent data_chunk_received;
     MARU_WindowFrameEvent window_frame;
     MARU_TextEditStartedEvent text_edit_started;
     MARU_TextEditUpdatedEvent text_edit_updated;
@@ -1074,6 +1228,21 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context* context,
                                      MARU_EventCallback callback,
                                      void* userdata);
 
+/*
+ * Same as maru_pumpEvents(), but waits at most until the absolute
+ * `deadline_ns`, expressed on the clock of the input events' timestamp_ns
+ * fields (CLOCK_MONOTONIC on Linux).
+ *
+ * Linux backends wait with nanosecond resolution. Windows and macOS round the
+ * remaining wait up to whole milliseconds. A deadline that has already passed
+ * pumps without blocking; MARU_NEVER_NS waits indefinitely.
+ */
+MARU_API MARU_Status maru_pumpEventsUntil(MARU_Context* context,
+                                          uint64_t deadline_ns,
+                                          MARU_EventMask mask,
+                                          MARU_EventCallback callback,
+                                          void* userdata);
+
 /*
  * Threading-safe user-event injection for a later pump cycle.
  *
@@ -1088,13 +1257,71 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context* context,
  * Returns:
  * - MARU_SUCCESS: if the event was successfully queued.
  * - MARU_FAILURE: if application-posted user events are disabled for the
- *   context (`user_event_queue_size == 0`) or if the queue is full.
+ *   context (`user_event_queue_size == 0`) or if the queue is full and the
+ *   event could not spill (`user_event_overflow` is off, or allocating an
+ *   overflow segment failed).
  * - MARU_CONTEXT_LOST: if the context is lost.
  */
 MARU_API MARU_Status maru_postEvent(MARU_Context* context,
                                    MARU_EventId type,
                                    MARU_UserDefinedEvent evt);
 
+/*
+ * Variant of maru_postEvent() that copies `size` bytes from `payload`
+ * directly into the queued event's `raw_payload` and zeroes the rest, instead
+ * of passing a whole MARU_UserDefinedEvent by value.
+ *
+ * `size` must not exceed sizeof(MARU_UserDefinedEvent) and `payload` may only
+ * be NULL when `size` is 0. The payload is delivered with the 16-byte
+ * alignment guaranteed for `raw_payload`. Results are those of
+ * maru_postEvent(), plus MARU_FAILURE when `size` is too large.
+ */
+MARU_API MARU_Status maru_postEventPayload(MARU_Context* context,
+                                          MARU_EventId type,
+                                          const void* payload,
+                                          size_t size);
+
+/*
+ * Threading-safe bulk variant of maru_postEvent().
+ *
+ * Queues `events[i]` with id `types[i]` for each i < `count`, in order. Space
+ * for the whole burst is reserved at once and the context is woken at most
+ * once. If the queue cannot hold every event and `user_event_overflow` is
+ * off, the leading events that fit are still queued and the rest are dropped.
+ *
+ * `out_posted_count` is optional and receives the number of events queued.
+ *
+ * Returns:
+ * - MARU_SUCCESS: if all `count` events were queued.
+ * - MARU_FAILURE: if user events are disabled for the context, or if only
+ *   `*out_posted_count` (possibly 0) events fit in the queue.
+ * - MARU_CONTEXT_LOST: if the context is lost.
+ */
+MARU_API MARU_Status maru_postEvents(MARU_Context* context,
+                                    const MARU_EventId* types,
+                                    const MARU_UserDefinedEvent* events,
+                                    uint32_t count,
+                                    uint32_t* out_posted_count);
+
+/* Counters describing the pressure on the context's user-event queue. */
+typedef struct MARU_UserEventQueueStats {
+  /* Ring capacity, including the slots reserved for backend events. */
+  uint32_t capacity;
+  /* Highest ring occupancy observed when an event was queued. */
+  uint32_t high_water_mark;
+  /* User events that went to overflow segments because the ring was full. */
+  uint64_t spilled_count;
+  /* User events that could not be queued at all. */
+  uint64_t dropped_count;
+} MARU_UserEventQueueStats;
+
+/*
+ * Threading-safe snapshot of the user-event queue counters. The fields are
+ * read independently and may be slightly out of sync with each other.
+ */
+MARU_API void maru_getUserEventQueueStats(const MARU_Context* context,
+                                          MARU_UserEventQueueStats* out_stats);
+
 /*
  * Threading-safe wakeup of a sleeping pump without having to post an event.
  *
@@ -1109,6 +1336,7 @@ MARU_API MARU_Status maru_wakeContext(MARU_Context* context);
 
 
 #define MARU_NEVER UINT32_MAX
+#define MARU_NEVER_NS UINT64_MAX
 #define MARU_CONTEXT_ATTR_INHIBIT_IDLE MARU_BIT(0)
 #define MARU_CONTEXT_ATTR_DIAGNOSTICS MARU_BIT(1)
 #define MARU_CONTEXT_ATTR_IDLE_TIMEOUT MARU_BIT(2)
@@ -1136,6 +1364,14 @@ static inline const MARU_ChannelInfo* maru_getMouseButtonChannelInfo(
     const MARU_Context* context);
 static inline bool maru_isMouseButtonPressed(const MARU_Context* context,
                                              uint32_t button_id);
+/*
+ * Samples folded into the MARU_EVENT_MOUSE_MOVED currently being dispatched,
+ * oldest first. Only meaningful inside that callback; the count is 0 anywhere
+ * else and whenever the backend delivers one event per sample.
+ */
+static inline uint32_t maru_getMouseMotionSampleCount(const MARU_Context* context);
+static inline const MARU_MouseMotionSample* maru_getMouseMotionSamples(
+    const MARU_Context* context);
 
 typedef struct MARU_ContextAttributes {
   /*
@@ -1641,6 +1877,10 @@ typedef enum MARU_ControllerAnalog {
   MARU_CONTROLLER_ANALOG_STANDARD_COUNT = 6
 } MARU_ControllerAnalog;
 
+MARU_STATIC_ASSERT(sizeof(((MARU_ControllerAnalogChangedEvent*)0)->standard_values) ==
+                       sizeof(MARU_Scalar) * MARU_CONTROLLER_ANALOG_STANDARD_COUNT,
+                   "MARU_ControllerAnalogChangedEvent::standard_values size mismatch.");
+
 typedef enum MARU_ControllerButton {
   MARU_CONTROLLER_BUTTON_SOUTH = 0,
   MARU_CONTROLLER_BUTTON_EAST = 1,
@@ -1776,6 +2016,29 @@ MARU_API MARU_Status maru_provideDropData(MARU_DataRequest* request,
                                           const void* data,
                                           size_t size,
                                           MARU_DataProvideFlags flags);
+/*
+ * Fulfills a request with `size` bytes read from `fd` at `offset`, typically
+ * a regular file or a sealed memfd. The kernel moves the bytes into the
+ * requester's pipe, so the payload never passes through application memory.
+ *
+ * `fd` is duplicated; the caller keeps ownership of it and may close it once
+ * this returns. Reads use explicit offsets and never move the file position,
+ * so one fd can serve any number of requests at once. The range must stay
+ * readable until the matching MARU_EVENT_DATA_RELEASED (with `data == NULL`)
+ * fires; a source that ends early fails the transfer.
+ *
+ * Supported on Wayland. Other backends return MARU_FAILURE and leave the
+ * request unconsumed, so the caller can still answer it with
+ * maru_provideClipboardData() or maru_provideDropData().
+ */
+MARU_API MARU_Status maru_provideClipboardDataFromFd(MARU_DataRequest* request,
+                                                     int fd,
+                                                     uint64_t offset,
+                                                     uint64_t size);
+MARU_API MARU_Status maru_provideDropDataFromFd(MARU_DataRequest* request,
+                                                int fd,
+                                                uint64_t offset,
+                                                uint64_t size);
 /*
  * Requests clipboard data for the context.
  *
@@ -1803,11 +2066,33 @@ MARU_API MARU_Status maru_requestClipboardData(MARU_Context* context,
 MARU_API MARU_Status maru_requestDropData(MARU_Window* window,
                                           const char* mime_type,
                                           void* userdata);
+/*
+ * Streaming variants of maru_requestClipboardData() and maru_requestDropData().
+ *
+ * The payload is delivered piecewise through MARU_EVENT_DATA_CHUNK_RECEIVED as
+ * it arrives, instead of being accumulated into one MARU_EVENT_DATA_RECEIVED.
+ * Use these for payloads that should go straight to disk or to a decoder.
+ *
+ * Supported on Wayland and X11. Other backends return MARU_FAILURE.
+ */
+MARU_API MARU_Status maru_requestClipboardDataStream(MARU_Context* context,
+                                                     const char* mime_type,
+                                                     void* userdata);
+/* Requires a ready window. */
+MARU_API MARU_Status maru_requestDropDataStream(MARU_Window* window,
+                                                const char* mime_type,
+                                                void* userdata);
 /*
  * Returns a borrowed snapshot of the currently available clipboard MIME types.
  * The snapshot is invalidated by the next
  * maru_getAvailableClipboardMIMETypes() call on the same context, and may also
  * be replaced by a later pump cycle that changes the clipboard offer.
+ *
+ * Backends that must ask another process for the list (X11) do not block on
+ * it: the call returns MARU_PENDING with an empty list while the query is in
+ * flight, and MARU_EVENT_MIME_TYPES_READY fires from a later pump once the
+ * answer is in. MARU_SUCCESS with an empty list means the owner offers no
+ * usable type.
  */
 MARU_API MARU_Status maru_getAvailableClipboardMIMETypes(const MARU_Context* context,
                                                          MARU_StringList* out_list);
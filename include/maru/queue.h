@@ -67,6 +67,28 @@ typedef struct MARU_QueueCreateInfo {
   void* diagnostic_userdata;
   /* Queue capacity in events. Must be greater than zero. */
   uint32_t capacity;
+  /*
+   * Opt-in growth bound. When greater than `capacity`, a full active buffer
+   * that compaction cannot relieve doubles, up to this many events, through
+   * `allocator` instead of dropping the push. 0 keeps the capacity fixed.
+   */
+  uint32_t max_capacity;
+  /*
+   * Once grown, buffers are halved back towards `capacity` after this many
+   * consecutive commits used less than a quarter of them. 0 never shrinks.
+   */
+  uint32_t shrink_after_commits;
+  /*
+   * Keeps a third buffer so maru_scanQueue() may run concurrently with
+   * maru_commitQueue(). See the threading contract below.
+   */
+  bool triple_buffered;
+  /*
+   * Indexes every snapshot by window at commit, so maru_scanQueueForWindow()
+   * only visits the events of the requested window. Costs one pass over the
+   * snapshot per commit and about 52 bytes per event of capacity.
+   */
+  bool index_windows;
 } MARU_QueueCreateInfo;
 
 #define MARU_QUEUE_CREATE_INFO_DEFAULT                                                              \
@@ -75,8 +97,43 @@ typedef struct MARU_QueueCreateInfo {
       .diagnostic_cb = NULL,                                                                        \
       .diagnostic_userdata = NULL,                                                                  \
       .capacity = 256u,                                                                             \
+      .max_capacity = 0u,                                                                           \
+      .shrink_after_commits = 120u,                                                                 \
+      .triple_buffered = false,                                                                     \
+      .index_windows = false,                                                                       \
   }
 
+/*
+ * Read-only, columnar view of a queue's stable snapshot.
+ *
+ * Entry `i` is `(types[i], window_ids[i], events[i])`, in commit order. Each
+ * column is 64-byte aligned, so loops over a view can be inlined and
+ * vectorized without the per-event indirect call of maru_scanQueue().
+ */
+typedef struct MARU_QueueView {
+  uint32_t count;
+  const MARU_EventId* types;
+  const MARU_WindowId* window_ids;
+  const MARU_Event* events;
+  /* Snapshot held by the view. Only meaningful to maru_releaseQueueView(). */
+  uint32_t buffer_index;
+} MARU_QueueView;
+
+/* Timeout of maru_waitQueue() that never expires. */
+#define MARU_QUEUE_WAIT_FOREVER UINT64_MAX
+
+/* Frame index reported before the first frame of a recording is published. */
+#define MARU_QUEUE_RECORDING_NO_FRAME UINT32_MAX
+
+/* Position within a queue recording, see maru_getQueueRecordingInfo(). */
+typedef struct MARU_QueueRecordingInfo {
+  uint32_t frame_count;
+  /* Frame currently published, or MARU_QUEUE_RECORDING_NO_FRAME. */
+  uint32_t frame_index;
+  /* Commit time of that frame, in nanoseconds of a monotonic clock. */
+  uint64_t timestamp_ns;
+} MARU_QueueRecordingInfo;
+
 /*
  * Standalone event snapshot/coalescing helper.
  *
@@ -86,11 +143,24 @@ typedef struct MARU_QueueCreateInfo {
  *
  * Threading contract:
  * - maru_createQueue() establishes a fixed owner thread for the queue.
- * - Except for maru_scanQueue(), all queue APIs are creator-thread APIs and
- *   must be called from the thread that created the queue.
+ * - Except for the scan, view and wait functions, all queue APIs are
+ *   creator-thread APIs and must be called from the thread that created the
+ *   queue.
  * - maru_scanQueue() is globally thread-safe and can be called from any
- *   thread. Application-level synchronization must ensure that a scan does not
- *   run concurrently with maru_commitQueue() for the same queue.
+ *   thread. Unless the queue was created with `triple_buffered`,
+ *   application-level synchronization must ensure that a scan does not run
+ *   concurrently with maru_commitQueue() for the same queue.
+ * - With `triple_buffered`, a scan pins the snapshot it started on and a
+ *   concurrent commit never reuses that buffer. Commits never wait on scans
+ *   or views: a commit that finds every spare buffer pinned returns false and
+ *   keeps collecting into the active buffer, so it can simply be retried
+ *   later.
+ * - maru_scanQueueForWindow(), maru_getQueueView() and maru_releaseQueueView()
+ *   follow the same rules as maru_scanQueue(). maru_getQueueGeneration() and
+ *   maru_waitQueue() may be called from any thread. A view stays valid until it is
+ *   released. Every maru_getQueueView() must be paired with one
+ *   maru_releaseQueueView(), and on a triple-buffered queue a held view pins
+ *   its snapshot like a scan does.
  * - Only queue-safe event ids may be pushed. Use MARU_QUEUE_SAFE_EVENT_MASK or
  *   maru_isQueueSafeEventId() when capturing events from maru_pumpEvents().
  * - Window-targeted events are keyed by the stable MARU_WindowId captured at
@@ -138,8 +208,86 @@ MARU_API void maru_scanQueue(const MARU_Queue* queue,
                              MARU_EventMask mask,
                              MARU_QueueEventCallback callback,
                              void* userdata);
+/*
+ * Like maru_scanQueue(), restricted to events whose window id is `window_id`.
+ * Events are visited in commit order. On a queue created with
+ * `index_windows`, only that window's events are read; otherwise the whole
+ * snapshot is walked.
+ */
+MARU_API void maru_scanQueueForWindow(const MARU_Queue* queue,
+                                      MARU_WindowId window_id,
+                                      MARU_EventMask mask,
+                                      MARU_QueueEventCallback callback,
+                                      void* userdata);
+MARU_API void maru_getQueueView(const MARU_Queue* queue,
+                                MARU_QueueView* out_view);
+MARU_API void maru_releaseQueueView(const MARU_Queue* queue,
+                                    const MARU_QueueView* view);
 MARU_API void maru_setQueueCoalesceMask(MARU_Queue* queue, MARU_EventMask mask);
 
+/*
+ * Commit notification.
+ *
+ * Every maru_commitQueue() that publishes a snapshot advances the queue's
+ * commit generation by one; it starts at 0 and wraps around.
+ * maru_getQueueGeneration() reads it. maru_waitQueue() blocks until it differs
+ * from `last_seen_generation` or `timeout_ns` nanoseconds have passed, and
+ * returns the generation it last saw. A timeout of 0 only polls, and
+ * MARU_QUEUE_WAIT_FOREVER never expires.
+ *
+ * Both are globally thread-safe. Waiters sleep in the kernel (a futex on
+ * Linux, WaitOnAddress() on Windows), and a commit only makes a wake call
+ * while some thread is waiting. A wait returning does not pin anything: scan
+ * the snapshot under the usual rules, which on a queue without
+ * `triple_buffered` means synchronizing against the next commit. The queue
+ * must outlive every wait on it.
+ */
+MARU_API uint32_t maru_getQueueGeneration(const MARU_Queue* queue);
+MARU_API uint32_t maru_waitQueue(const MARU_Queue* queue,
+                                 uint32_t last_seen_generation,
+                                 uint64_t timeout_ns);
+
+/*
+ * Queue recordings.
+ *
+ * maru_recordQueue() appends every later successful maru_commitQueue() of
+ * `queue` to the file at `path` as one frame holding the commit time and the
+ * snapshot's types, window_ids and events columns. It truncates the file and
+ * ends any recording in progress; a NULL `path` just ends it. If writing a
+ * frame fails, the queue reports a diagnostic and stops recording, but the
+ * commit itself still succeeds.
+ *
+ * maru_openQueueRecording() creates a read-only queue that replays a
+ * recording. Only the allocator and diagnostic fields of `create_info` are
+ * used, and it may be NULL. The file is memory-mapped where the platform
+ * allows and frames are scanned in place:
+ * - maru_commitQueue() publishes the next frame as the stable snapshot and
+ *   returns false once every frame has been published.
+ * - maru_scanQueue() and maru_getQueueView() read the published frame
+ *   without copying it.
+ * - maru_pushQueue() fails. maru_rewindQueueRecording() restarts from the
+ *   first frame on the next commit.
+ * - Destroy the queue with maru_destroyQueue().
+ *
+ * maru_getQueueRecordingInfo() reports the published frame of a replaying
+ * queue, or the last written frame of a recording queue. It returns false for
+ * other queues.
+ *
+ * Recordings store the active member of each payload bit for bit and zero the
+ * rest, so pointer members (user event userdata, for instance) are only
+ * meaningful to the recording process. Files written by a build with a
+ * different byte order or event layout are rejected. A recording whose last
+ * frame is incomplete, such as one still being written, replays the frames
+ * before it. All four functions are creator-thread APIs.
+ */
+MARU_API bool maru_recordQueue(MARU_Queue* queue, const char* path);
+MARU_API bool maru_openQueueRecording(const char* path,
+                                      const MARU_QueueCreateInfo* create_info,
+                                      MARU_Queue** out_queue);
+MARU_API bool maru_rewindQueueRecording(MARU_Queue* queue);
+MARU_API bool maru_getQueueRecordingInfo(const MARU_Queue* queue,
+                                         MARU_QueueRecordingInfo* out_info);
+
 #ifdef __cplusplus
 }
 #endif
@@ -51,7 +51,7 @@ void _maru_default_free(void *ptr, void *userdata) {
 MARU_Status _maru_post_event_internal(MARU_Context_Base *ctx_base, MARU_EventId type,
                                MARU_Window *window, const MARU_Event *evt) {
   if (_maru_internal_event_queue_push(&ctx_base->queued_events, type, window,
-                                      *evt, NULL, NULL)) {
+                                      evt, NULL, NULL)) {
     return MARU_SUCCESS;
   }
   return MARU_FAILURE;
@@ -62,7 +62,7 @@ MARU_Status _maru_post_event_internal_owned(
     const MARU_Event *evt, MARU_InternalQueuedEventCleanupFn cleanup_cb,
     void *cleanup_userdata) {
   if (_maru_internal_event_queue_push(&ctx_base->queued_events, type, window,
-                                      *evt, cleanup_cb, cleanup_userdata)) {
+                                      evt, cleanup_cb, cleanup_userdata)) {
     return MARU_SUCCESS;
   }
   if (cleanup_cb) {
@@ -144,6 +144,8 @@ void _maru_init_context_base(MARU_Context_Base *ctx_base,
   memset(ctx_base->keyboard_state, 0, sizeof(ctx_base->keyboard_state));
   ctx_base->pub.keyboard_state = ctx_base->keyboard_state;
   ctx_base->pub.keyboard_key_count = MARU_KEY_COUNT;
+  ctx_base->pub.mouse_motion_samples = NULL;
+  ctx_base->pub.mouse_motion_sample_count = 0;
 
 #ifdef MARU_VALIDATE_API_CALLS
   ctx_base->creator_thread = _maru_getCurrentThreadId();
@@ -162,7 +164,9 @@ void _maru_init_context_base(MARU_Context_Base *ctx_base,
                            "Failed to initialize queued event storage");
   } else if (!_maru_internal_event_queue_init(
                  &ctx_base->queued_events, ctx_base,
-                 (uint32_t)total_queue_capacity)) {
+                 (uint32_t)total_queue_capacity,
+                 ctx_base->user_events_enabled &&
+                     ctx_base->tuning.user_event_overflow)) {
     MARU_REPORT_DIAGNOSTIC((MARU_Context *)ctx_base, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
                            "Failed to initialize queued event storage");
   }
@@ -195,30 +199,53 @@ void _maru_drain_queued_events(MARU_Context_Base *ctx_base) {
     }
   }
 
+  // Events are dispatched straight out of their slots, one batch at a time, so
+  // the consumer publishes `tail` once per batch rather than once per event.
+  // User events spilled to overflow segments are merged back in push order.
   MARU_InternalEventQueue *queue = &ctx_base->queued_events;
-  MARU_EventId type;
-  MARU_Window *window;
-  MARU_Event evt;
-  MARU_InternalQueuedEventCleanupFn cleanup_cb;
-  void *cleanup_userdata;
-
-  while (_maru_internal_event_queue_pop(queue, &type, &window, &evt, &cleanup_cb,
-                                        &cleanup_userdata)) {
+  size_t first;
+  uint32_t count;
+
+  for (;;) {
+    while ((count = _maru_internal_event_queue_acquire(
+                queue, &first, MARU_INTERNAL_EVENT_QUEUE_BATCH)) != 0) {
+      uint32_t index = (uint32_t)(first % queue->capacity);
+      for (uint32_t i = 0; i < count; ++i) {
+        const MARU_InternalQueuedEventSlot *slot = &queue->slots[index];
+        const MARU_Event *evt = &queue->events[index];
 #ifdef __linux__
-    if (type >= (MARU_EventId)1000) {
-      _maru_linux_common_handle_internal_event(
-          &((MARU_Context_Linux *)ctx_base)->linux_common,
-          (MARU_InternalEventId)type, window, &evt);
-      if (cleanup_cb) {
-        cleanup_cb(ctx_base, cleanup_userdata);
+        if (slot->type >= (MARU_EventId)1000) {
+          _maru_linux_common_handle_internal_event(
+              &((MARU_Context_Linux *)ctx_base)->linux_common,
+              (MARU_InternalEventId)slot->type, slot->window, evt);
+        } else
+#endif
+        {
+          _maru_dispatch_event(ctx_base, slot->type, slot->window, evt);
+        }
+        if (atomic_load_explicit(&slot->state, memory_order_relaxed) ==
+            MARU_INTERNAL_QUEUED_EVENT_READY_OWNED) {
+          const MARU_InternalQueuedEventCleanup *cleanup = &queue->cleanups[index];
+          cleanup->cb(ctx_base, cleanup->userdata);
+        }
+        if (++index == queue->capacity) {
+          index = 0;
+        }
       }
-      continue;
+      _maru_internal_event_queue_release(queue, first, count);
     }
-#endif
-    _maru_dispatch_event(ctx_base, type, window, &evt);
-    if (cleanup_cb) {
-      cleanup_cb(ctx_base, cleanup_userdata);
+
+    const MARU_InternalQueuedEventSlot *slots;
+    const MARU_Event *events;
+    count = _maru_internal_event_queue_acquire_overflow(
+        queue, &slots, &events, MARU_INTERNAL_EVENT_QUEUE_BATCH);
+    if (count == 0) {
+      break;
     }
+    for (uint32_t i = 0; i < count; ++i) {
+      _maru_dispatch_event(ctx_base, slots[i].type, NULL, &events[i]);
+    }
+    _maru_internal_event_queue_release_overflow(queue, count);
   }
 }
 
@@ -508,28 +535,135 @@ uint32_t _maru_adjust_timeout_for_cursor_animation(const MARU_Context_Base *ctx_
   return res;
 }
 
+uint64_t _maru_adjust_deadline_for_cursor_animation(const MARU_Context_Base *ctx_base,
+                                                    uint64_t deadline_ns) {
+  // Cursor frame deadlines live on the same clock as deadline_ns, in ms.
+  uint64_t res = deadline_ns;
+  for (MARU_Cursor_Base *it = ctx_base->animated_cursor_head; it; it = it->anim_next) {
+    // Checked in ms first: a later frame could overflow the conversion.
+    if (it->anim_next_frame_deadline_ms > res / 1000000ull) {
+      continue;
+    }
+    const uint64_t frame_deadline_ns = it->anim_next_frame_deadline_ms * 1000000ull;
+    if (frame_deadline_ns < res) {
+      res = frame_deadline_ns;
+    }
+  }
+  return res;
+}
+
+uint64_t _maru_timeout_ms_to_deadline_ns(uint32_t timeout_ms, uint64_t now_ns) {
+  if (timeout_ms == MARU_NEVER) {
+    return MARU_NEVER_NS;
+  }
+  // A finite timeout saturates just short of MARU_NEVER_NS rather than wrap.
+  const uint64_t timeout_ns = (uint64_t)timeout_ms * 1000000ull;
+  if (now_ns >= MARU_NEVER_NS - timeout_ns) {
+    return MARU_NEVER_NS - 1u;
+  }
+  return now_ns + timeout_ns;
+}
+
+uint32_t _maru_deadline_ns_to_timeout_ms(uint64_t deadline_ns, uint64_t now_ns) {
+  if (deadline_ns == MARU_NEVER_NS) {
+    return MARU_NEVER;
+  }
+  if (deadline_ns <= now_ns) {
+    return 0;
+  }
+  // Round up so a millisecond-resolution wait never returns before the deadline.
+  const uint64_t remaining_ns = deadline_ns - now_ns;
+  const uint64_t timeout_ms =
+      remaining_ns / 1000000ull + (remaining_ns % 1000000ull != 0u ? 1u : 0u);
+  return (timeout_ms < (uint64_t)MARU_NEVER) ? (uint32_t)timeout_ms : MARU_NEVER - 1u;
+}
+
 MARU_API MARU_Status maru_postEvent(MARU_Context *context, MARU_EventId type,
                                     MARU_UserDefinedEvent evt) {
   MARU_API_VALIDATE(postEvent, context, type, evt);
   MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
 
   MARU_Context_Base *ctx_base = (MARU_Context_Base *)context;
-  MARU_Event internal_evt;
-  memset(&internal_evt, 0, sizeof(internal_evt));
-  internal_evt.user = evt;
-
   if (!ctx_base->user_events_enabled) {
     return MARU_FAILURE;
   }
 
-  if (_maru_internal_event_queue_push(&ctx_base->queued_events, type, NULL,
-                                      internal_evt, NULL, NULL)) {
+  if (_maru_internal_event_queue_push_user_event(&ctx_base->queued_events, type,
+                                                 &evt)) {
     return maru_wakeContext(context);
   }
 
   return MARU_FAILURE;
 }
 
+MARU_API MARU_Status maru_postEventPayload(MARU_Context *context, MARU_EventId type,
+                                           const void *payload, size_t size) {
+  MARU_API_VALIDATE(postEventPayload, context, type, payload, size);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+
+  MARU_Context_Base *ctx_base = (MARU_Context_Base *)context;
+  if (!ctx_base->user_events_enabled || size > sizeof(MARU_UserDefinedEvent) ||
+      (!payload && size != 0)) {
+    return MARU_FAILURE;
+  }
+
+  if (_maru_internal_event_queue_push_user_payload(&ctx_base->queued_events, type,
+                                                   payload, size)) {
+    return maru_wakeContext(context);
+  }
+
+  return MARU_FAILURE;
+}
+
+MARU_API MARU_Status maru_postEvents(MARU_Context *context, const MARU_EventId *types,
+                                     const MARU_UserDefinedEvent *events,
+                                     uint32_t count, uint32_t *out_posted_count) {
+  MARU_API_VALIDATE(postEvents, context, types, events, count, out_posted_count);
+  if (out_posted_count) {
+    *out_posted_count = 0;
+  }
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+
+  MARU_Context_Base *ctx_base = (MARU_Context_Base *)context;
+  if (!ctx_base->user_events_enabled) {
+    return MARU_FAILURE;
+  }
+  if (count == 0) {
+    return MARU_SUCCESS;
+  }
+
+  const uint32_t posted = _maru_internal_event_queue_push_user_events(
+      &ctx_base->queued_events, types, events, count);
+  if (out_posted_count) {
+    *out_posted_count = posted;
+  }
+  if (posted == 0) {
+    return MARU_FAILURE;
+  }
+
+  // One wake covers the whole burst.
+  const MARU_Status wake_status = maru_wakeContext(context);
+  if (wake_status != MARU_SUCCESS) {
+    return wake_status;
+  }
+  return (posted == count) ? MARU_SUCCESS : MARU_FAILURE;
+}
+
+MARU_API void maru_getUserEventQueueStats(const MARU_Context *context,
+                                          MARU_UserEventQueueStats *out_stats) {
+  MARU_API_VALIDATE(getUserEventQueueStats, context, out_stats);
+  const MARU_InternalEventQueue *queue =
+      &((const MARU_Context_Base *)context)->queued_events;
+
+  out_stats->capacity = queue->capacity;
+  out_stats->high_water_mark =
+      atomic_load_explicit(&queue->high_water_mark, memory_order_relaxed);
+  out_stats->spilled_count =
+      atomic_load_explicit(&queue->spilled_count, memory_order_relaxed);
+  out_stats->dropped_count =
+      atomic_load_explicit(&queue->dropped_count, memory_order_relaxed);
+}
+
 #ifdef MARU_INDIRECT_BACKEND
 MARU_API MARU_Status maru_wakeContext(MARU_Context *context) {
   MARU_API_VALIDATE(wakeContext, context);
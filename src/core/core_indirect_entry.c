@@ -36,6 +36,19 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context *context, uint32_t timeout_ms,
                                        userdata);
 }
 
+MARU_API MARU_Status maru_pumpEventsUntil(MARU_Context *context,
+                                          uint64_t deadline_ns,
+                                          MARU_EventMask mask,
+                                          MARU_EventCallback callback,
+                                          void *userdata) {
+  MARU_API_VALIDATE(pumpEventsUntil, context, deadline_ns, mask, callback,
+                    userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  MARU_Context_Base *ctx_base = (MARU_Context_Base *)context;
+  return ctx_base->backend->pumpEventsUntil(context, deadline_ns, mask,
+                                            callback, userdata);
+}
+
 MARU_API MARU_Status maru_createWindow(MARU_Context *context,
                                        const MARU_WindowCreateInfo *create_info,
                                        MARU_Window **out_window) {
@@ -155,6 +168,34 @@ maru_provideDropData(MARU_DataRequest *request, const void *data, size_t size,
   return handle->ctx_base->backend->provideData(request, data, size, flags);
 }
 
+MARU_API MARU_Status
+maru_provideClipboardDataFromFd(MARU_DataRequest *request, int fd,
+                                uint64_t offset, uint64_t size) {
+  MARU_API_VALIDATE(provideClipboardDataFromFd, request, fd, offset, size);
+  MARU_RETURN_ON_ERROR(_maru_status_if_request_context_lost(request));
+  const MARU_DataRequestHandleBase *handle =
+      (const MARU_DataRequestHandleBase *)request;
+  if (!handle || !handle->ctx_base || !handle->ctx_base->backend ||
+      !handle->ctx_base->backend->provideDataFromFd) {
+    return MARU_FAILURE;
+  }
+  return handle->ctx_base->backend->provideDataFromFd(request, fd, offset, size);
+}
+
+MARU_API MARU_Status
+maru_provideDropDataFromFd(MARU_DataRequest *request, int fd, uint64_t offset,
+                           uint64_t size) {
+  MARU_API_VALIDATE(provideDropDataFromFd, request, fd, offset, size);
+  MARU_RETURN_ON_ERROR(_maru_status_if_request_context_lost(request));
+  const MARU_DataRequestHandleBase *handle =
+      (const MARU_DataRequestHandleBase *)request;
+  if (!handle || !handle->ctx_base || !handle->ctx_base->backend ||
+      !handle->ctx_base->backend->provideDataFromFd) {
+    return MARU_FAILURE;
+  }
+  return handle->ctx_base->backend->provideDataFromFd(request, fd, offset, size);
+}
+
 MARU_API MARU_Status
 maru_requestClipboardData(MARU_Context *context, const char *mime_type,
                           void *userdata) {
@@ -177,6 +218,29 @@ maru_requestDropData(MARU_Window *window, const char *mime_type,
   return win_base->backend->requestDropData(window, mime_type, userdata);
 }
 
+MARU_API MARU_Status
+maru_requestClipboardDataStream(MARU_Context *context, const char *mime_type,
+                                void *userdata) {
+  MARU_API_VALIDATE(requestClipboardDataStream, context, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  MARU_API_VALIDATE_LIVE(requestClipboardDataStream, context, mime_type, userdata);
+  const MARU_Context_Base *ctx_base = (const MARU_Context_Base *)context;
+  if (!ctx_base->backend->requestClipboardDataStream) return MARU_FAILURE;
+  return ctx_base->backend->requestClipboardDataStream(context, mime_type,
+                                                       userdata);
+}
+
+MARU_API MARU_Status
+maru_requestDropDataStream(MARU_Window *window, const char *mime_type,
+                           void *userdata) {
+  MARU_API_VALIDATE(requestDropDataStream, window, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_window_context_lost(window));
+  MARU_API_VALIDATE_LIVE(requestDropDataStream, window, mime_type, userdata);
+  const MARU_Window_Base *win_base = (const MARU_Window_Base *)window;
+  if (!win_base->backend->requestDropDataStream) return MARU_FAILURE;
+  return win_base->backend->requestDropDataStream(window, mime_type, userdata);
+}
+
 MARU_API MARU_Status
 maru_getAvailableClipboardMIMETypes(const MARU_Context *context,
                                     MARU_StringList *out_list) {
@@ -5,128 +5,522 @@
 #include "maru_mem_internal.h"
 #include <stdatomic.h>
 #include <string.h>
-#include <stdio.h>
+
+static MARU_InternalEventSegment *
+_maru_internal_event_segment_create(MARU_Context_Base *ctx) {
+  // Called from posting threads: go straight to the allocator so that a
+  // failure does not report a diagnostic off the owner thread.
+  MARU_InternalEventSegment *seg = (MARU_InternalEventSegment *)ctx->allocator.alloc_cb(
+      sizeof(MARU_InternalEventSegment), ctx->allocator.userdata);
+  if (!seg) return NULL;
+
+  memset(seg, 0, sizeof(*seg));
+  atomic_init(&seg->reserved, 0u);
+  atomic_init(&seg->next, NULL);
+  for (uint32_t i = 0; i < MARU_INTERNAL_EVENT_SEGMENT_CAPACITY; ++i) {
+    atomic_init(&seg->slots[i].state, MARU_INTERNAL_QUEUED_EVENT_FREE);
+  }
+  return seg;
+}
+
+static void _maru_internal_event_segment_destroy(MARU_Context_Base *ctx,
+                                                 MARU_InternalEventSegment *seg) {
+  ctx->allocator.free_cb(seg, ctx->allocator.userdata);
+}
 
 bool _maru_internal_event_queue_init(MARU_InternalEventQueue *q,
                                      MARU_Context_Base *ctx,
-                                     uint32_t capacity) {
+                                     uint32_t capacity,
+                                     bool overflow_enabled) {
   if (!q) return false;
 
   q->capacity = capacity;
   atomic_init(&q->head, 0);
   atomic_init(&q->tail, 0);
-  q->buffer = NULL;
+  q->consumer_pos = 0;
+  q->consumer_depth = 0;
+  q->events = NULL;
+  q->slots = NULL;
+  q->cleanups = NULL;
+
+  q->ctx = ctx;
+  q->overflow_enabled = false;
+  q->overflow_head = NULL;
+  q->overflow_read = NULL;
+  q->overflow_retired = NULL;
+  q->overflow_depth = 0;
+  atomic_init(&q->overflow_tail, NULL);
+  atomic_init(&q->overflow_pending, 0);
+  atomic_init(&q->overflow_users, 0u);
+  atomic_init(&q->high_water_mark, 0u);
+  atomic_init(&q->spilled_count, 0u);
+  atomic_init(&q->dropped_count, 0u);
 
   if (capacity == 0) {
     return true;
   }
 
-  q->buffer = maru_context_alloc_aligned64(
-      ctx, sizeof(MARU_InternalQueuedEvent) * capacity);
-  if (!q->buffer) return false;
+  const size_t events_size = sizeof(MARU_Event) * capacity;
+  const size_t slots_size = sizeof(MARU_InternalQueuedEventSlot) * capacity;
+  const size_t cleanups_size = sizeof(MARU_InternalQueuedEventCleanup) * capacity;
+  unsigned char *storage = (unsigned char *)maru_context_alloc_aligned64(
+      ctx, events_size + slots_size + cleanups_size);
+  if (!storage) return false;
 
-  memset(q->buffer, 0, sizeof(MARU_InternalQueuedEvent) * capacity);
+  memset(storage, 0, events_size + slots_size + cleanups_size);
+  q->events = (MARU_Event *)storage;
+  q->slots = (MARU_InternalQueuedEventSlot *)(storage + events_size);
+  q->cleanups = (MARU_InternalQueuedEventCleanup *)(storage + events_size + slots_size);
   for (uint32_t i = 0; i < capacity; ++i) {
-    atomic_init(&q->buffer[i].state, 0);
+    atomic_init(&q->slots[i].state, MARU_INTERNAL_QUEUED_EVENT_FREE);
+  }
+
+  if (overflow_enabled) {
+    // The first segment exists up front so the consumer always knows where
+    // the list starts; later ones are only allocated under pressure.
+    MARU_InternalEventSegment *seg = _maru_internal_event_segment_create(ctx);
+    if (!seg) {
+      maru_context_free_aligned64(ctx, q->events);
+      q->events = NULL;
+      q->slots = NULL;
+      q->cleanups = NULL;
+      return false;
+    }
+    q->overflow_enabled = true;
+    q->overflow_head = seg;
+    q->overflow_read = seg;
+    atomic_store_explicit(&q->overflow_tail, seg, memory_order_relaxed);
   }
   return true;
 }
 
 void _maru_internal_event_queue_cleanup(MARU_InternalEventQueue *q,
                                         MARU_Context_Base *ctx) {
-  if (q->buffer) {
+  if (q->events) {
     for (uint32_t i = 0; i < q->capacity; ++i) {
-      MARU_InternalQueuedEvent *slot = &q->buffer[i];
-      if (atomic_load_explicit(&slot->state, memory_order_acquire) == 2 &&
-          slot->cleanup_cb) {
-        slot->cleanup_cb(ctx, slot->cleanup_userdata);
+      if (atomic_load_explicit(&q->slots[i].state, memory_order_acquire) ==
+              MARU_INTERNAL_QUEUED_EVENT_READY_OWNED &&
+          q->cleanups[i].cb) {
+        q->cleanups[i].cb(ctx, q->cleanups[i].userdata);
       }
     }
+    maru_context_free_aligned64(ctx, q->events);
+    q->events = NULL;
+    q->slots = NULL;
+    q->cleanups = NULL;
   }
-  if (q->buffer) {
-    maru_context_free_aligned64(ctx, q->buffer);
-    q->buffer = NULL;
+
+  // Overflow segments only ever carry user events, which own no resources.
+  MARU_InternalEventSegment *seg = q->overflow_head;
+  while (seg) {
+    MARU_InternalEventSegment *next =
+        atomic_load_explicit(&seg->next, memory_order_acquire);
+    _maru_internal_event_segment_destroy(ctx, seg);
+    seg = next;
+  }
+  seg = q->overflow_retired;
+  while (seg) {
+    MARU_InternalEventSegment *next = seg->retired_next;
+    _maru_internal_event_segment_destroy(ctx, seg);
+    seg = next;
   }
+  q->overflow_head = NULL;
+  q->overflow_read = NULL;
+  q->overflow_retired = NULL;
+  atomic_store_explicit(&q->overflow_tail, NULL, memory_order_relaxed);
+  q->overflow_enabled = false;
   q->capacity = 0;
 }
 
+static void _maru_internal_event_queue_note_occupancy(MARU_InternalEventQueue *q,
+                                                      size_t occupancy) {
+  uint32_t seen = atomic_load_explicit(&q->high_water_mark, memory_order_relaxed);
+  while (occupancy > seen &&
+         !atomic_compare_exchange_weak_explicit(&q->high_water_mark, &seen,
+                                                (uint32_t)occupancy,
+                                                memory_order_relaxed,
+                                                memory_order_relaxed)) {
+  }
+}
+
+// Reserves up to `count` consecutive ring slots with a single CAS. Returns how
+// many were reserved; `*out_head` receives the sequence number of the first.
+static size_t _maru_internal_event_queue_reserve(MARU_InternalEventQueue *q,
+                                                 size_t count, size_t *out_head) {
+  size_t head, tail, reserved;
+
+  for (;;) {
+    head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+
+    const size_t used = head - tail;
+    if (used > q->capacity) {
+      continue; // Stale head, the consumer moved past it
+    }
+    if (used == q->capacity) {
+      return 0; // Full
+    }
+    const size_t available = q->capacity - used;
+    reserved = (count < available) ? count : available;
+    if (atomic_compare_exchange_weak_explicit(&q->head, &head, head + reserved,
+                                              memory_order_relaxed,
+                                              memory_order_relaxed)) {
+      break;
+    }
+  }
+
+  _maru_internal_event_queue_note_occupancy(q, head + reserved - tail);
+  *out_head = head;
+  return reserved;
+}
+
 bool _maru_internal_event_queue_push(MARU_InternalEventQueue *q,
                                      MARU_EventId type,
                                      MARU_Window *window,
-                                     MARU_Event evt,
+                                     const MARU_Event *evt,
                                      MARU_InternalQueuedEventCleanupFn cleanup_cb,
                                      void *cleanup_userdata) {
-  if (!q || !q->buffer || q->capacity == 0) return false;
+  if (!q || !q->events || q->capacity == 0) return false;
+
+  size_t head;
+  if (_maru_internal_event_queue_reserve(q, 1, &head) == 0) {
+    return false;
+  }
+
+  // We reserved the slot at 'head'. The consumer resets a slot to FREE before
+  // publishing the tail that makes it reservable again, so it is free here.
+  const uint32_t index = (uint32_t)(head % q->capacity);
+  MARU_InternalQueuedEventSlot *slot = &q->slots[index];
 
-  size_t head, tail;
-  
-  do {
-    head = atomic_load_explicit(&q->head, memory_order_relaxed);
-    tail = atomic_load_explicit(&q->tail, memory_order_acquire);
-    
-    if (head - tail >= q->capacity) {
-      return false; // Full
-    }
-  } while (!atomic_compare_exchange_weak_explicit(&q->head, &head, head + 1, 
-                                                  memory_order_relaxed, memory_order_relaxed));
-
-  // We reserved the slot at 'head'
-  MARU_InternalQueuedEvent *slot = &q->buffer[head % q->capacity];
-
-  // Wait until the slot is truly free (state 0).
-  // In a correct MPSC with head/tail check above, this should be almost immediate,
-  // unless the consumer just read it but hasn't set state to 0 yet (which implies tail wasn't incremented?)
-  // Actually, consumer sets state to 0 THEN increments tail.
-  // So if head < tail + capacity, then slot MUST be 0.
-  // We can assert or just proceed.
-  // Let's verify:
-  // Consumer: 
-  //   Load state. If 2: read. Store state 0. Store tail++.
-  // Producer:
-  //   Load tail. If head < tail + cap: CAS head++. 
-  //   Since tail is only incremented AFTER state=0, we are safe.
-  
   slot->type = type;
   slot->window = window;
-  slot->evt = evt;
-  slot->cleanup_cb = cleanup_cb;
-  slot->cleanup_userdata = cleanup_userdata;
-  
+  q->events[index] = *evt;
+  int ready = MARU_INTERNAL_QUEUED_EVENT_READY;
+  if (cleanup_cb) {
+    q->cleanups[index].cb = cleanup_cb;
+    q->cleanups[index].userdata = cleanup_userdata;
+    ready = MARU_INTERNAL_QUEUED_EVENT_READY_OWNED;
+  }
+
   // Publish
-  atomic_store_explicit(&slot->state, 2, memory_order_release);
+  atomic_store_explicit(&slot->state, ready, memory_order_release);
   return true;
 }
 
-bool _maru_internal_event_queue_pop(MARU_InternalEventQueue *q,
-                                    MARU_EventId *out_type,
-                                    MARU_Window **out_window,
-                                    MARU_Event *out_evt,
-                                    MARU_InternalQueuedEventCleanupFn *out_cleanup_cb,
-                                    void **out_cleanup_userdata) {
-  if (!q || !q->buffer || q->capacity == 0) return false;
+// User event payloads to publish: `count` entries `stride` bytes apart, of
+// which the first `size` bytes are copied and the rest of the 64 are zeroed.
+typedef struct MARU_InternalUserPayloads {
+  const uint8_t *data;
+  size_t size;
+  size_t stride;
+} MARU_InternalUserPayloads;
+
+static inline void _maru_internal_user_payload_write(MARU_Event *dst,
+                                                     const MARU_InternalUserPayloads *src,
+                                                     uint32_t i) {
+  const uint8_t *payload = src->data + src->stride * i;
+  if (src->size == sizeof(MARU_UserDefinedEvent)) {
+    dst->user = *(const MARU_UserDefinedEvent *)(const void *)payload;
+    return;
+  }
+  if (src->size > 0) {
+    memcpy(dst->user.raw_payload, payload, src->size);
+  }
+  memset(dst->user.raw_payload + src->size, 0,
+         sizeof(dst->user.raw_payload) - src->size);
+}
+
+// Appends user events to the overflow segments, allocating new ones as
+// needed. Returns how many of the leading events were stored.
+static uint32_t _maru_internal_event_queue_spill(MARU_InternalEventQueue *q,
+                                                 const MARU_EventId *types,
+                                                 const MARU_InternalUserPayloads *payloads,
+                                                 uint32_t count) {
+  // Counted before anything becomes visible so that this producer's next post
+  // keeps spilling, and kept until the consumer releases the entries.
+  atomic_fetch_add_explicit(&q->overflow_pending, count, memory_order_relaxed);
 
-  size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
-  MARU_InternalQueuedEvent *slot = &q->buffer[tail % q->capacity];
+  // While registered as a user, no segment this thread can reach gets freed.
+  atomic_fetch_add(&q->overflow_users, 1u);
+  MARU_InternalEventSegment *seg = atomic_load(&q->overflow_tail);
+  // Ring events this thread pushed earlier sit below this, later ones at or
+  // above it.
+  const size_t ring_seq = atomic_load_explicit(&q->head, memory_order_relaxed);
+  uint32_t stored = 0;
 
-  int state = atomic_load_explicit(&slot->state, memory_order_acquire);
-  if (state != 2) {
-    return false; // Empty or writing in progress
+  while (stored < count) {
+    const uint32_t wanted = count - stored;
+    const uint32_t first =
+        atomic_fetch_add_explicit(&seg->reserved, wanted, memory_order_relaxed);
+    if (first < MARU_INTERNAL_EVENT_SEGMENT_CAPACITY) {
+      const uint32_t room = MARU_INTERNAL_EVENT_SEGMENT_CAPACITY - first;
+      const uint32_t n = (wanted < room) ? wanted : room;
+      for (uint32_t i = 0; i < n; ++i) {
+        MARU_InternalQueuedEventSlot *slot = &seg->slots[first + i];
+        slot->type = types[stored + i];
+        slot->window = NULL;
+        seg->ring_seq[first + i] = ring_seq;
+        _maru_internal_user_payload_write(&seg->events[first + i], payloads,
+                                          stored + i);
+        atomic_store_explicit(&slot->state, MARU_INTERNAL_QUEUED_EVENT_READY,
+                              memory_order_release);
+      }
+      stored += n;
+      if (stored == count) {
+        break;
+      }
+    }
+
+    MARU_InternalEventSegment *next =
+        atomic_load_explicit(&seg->next, memory_order_acquire);
+    if (!next) {
+      MARU_InternalEventSegment *created = _maru_internal_event_segment_create(q->ctx);
+      if (!created) {
+        break;
+      }
+      MARU_InternalEventSegment *expected = NULL;
+      if (atomic_compare_exchange_strong(&seg->next, &expected, created)) {
+        next = created;
+      } else {
+        _maru_internal_event_segment_destroy(q->ctx, created);
+        next = expected;
+      }
+    }
+    MARU_InternalEventSegment *expected = seg;
+    (void)atomic_compare_exchange_strong(&q->overflow_tail, &expected, next);
+    seg = next;
   }
 
-  *out_type = slot->type;
-  *out_window = slot->window;
-  *out_evt = slot->evt;
-  if (out_cleanup_cb) {
-    *out_cleanup_cb = slot->cleanup_cb;
+  atomic_fetch_sub(&q->overflow_users, 1u);
+  if (stored < count) {
+    atomic_fetch_sub_explicit(&q->overflow_pending, count - stored,
+                              memory_order_relaxed);
   }
-  if (out_cleanup_userdata) {
-    *out_cleanup_userdata = slot->cleanup_userdata;
+  atomic_fetch_add_explicit(&q->spilled_count, stored, memory_order_relaxed);
+  return stored;
+}
+
+static uint32_t _maru_internal_event_queue_push_user_payloads(
+    MARU_InternalEventQueue *q, const MARU_EventId *types,
+    const MARU_InternalUserPayloads *payloads, uint32_t count) {
+  if (!q || !q->events || q->capacity == 0 || count == 0) return 0;
+
+  uint32_t posted = 0;
+  if (!q->overflow_enabled ||
+      atomic_load_explicit(&q->overflow_pending, memory_order_acquire) == 0) {
+    size_t head;
+    const size_t reserved = _maru_internal_event_queue_reserve(q, count, &head);
+
+    // Slots are published front to back, so the consumer never sees a gap: it
+    // stops at the first one that is not ready yet and resumes there later.
+    uint32_t index = (uint32_t)(head % q->capacity);
+    for (size_t i = 0; i < reserved; ++i) {
+      MARU_InternalQueuedEventSlot *slot = &q->slots[index];
+      slot->type = types[i];
+      slot->window = NULL;
+      _maru_internal_user_payload_write(&q->events[index], payloads, (uint32_t)i);
+      atomic_store_explicit(&slot->state, MARU_INTERNAL_QUEUED_EVENT_READY,
+                            memory_order_release);
+      if (++index == q->capacity) {
+        index = 0;
+      }
+    }
+    posted = (uint32_t)reserved;
+  }
+
+  if (q->overflow_enabled && posted < count) {
+    const MARU_InternalUserPayloads rest = {
+        .data = payloads->data + payloads->stride * posted,
+        .size = payloads->size,
+        .stride = payloads->stride,
+    };
+    posted += _maru_internal_event_queue_spill(q, types + posted, &rest,
+                                               count - posted);
+  }
+  if (posted < count) {
+    atomic_fetch_add_explicit(&q->dropped_count, count - posted, memory_order_relaxed);
   }
-  slot->cleanup_cb = NULL;
-  slot->cleanup_userdata = NULL;
+  return posted;
+}
+
+bool _maru_internal_event_queue_push_user_event(MARU_InternalEventQueue *q,
+                                                MARU_EventId type,
+                                                const MARU_UserDefinedEvent *evt) {
+  return _maru_internal_event_queue_push_user_events(q, &type, evt, 1) == 1;
+}
 
-  atomic_store_explicit(&slot->state, 0, memory_order_release);
-  atomic_store_explicit(&q->tail, tail + 1, memory_order_release);
-  
+bool _maru_internal_event_queue_push_user_payload(MARU_InternalEventQueue *q,
+                                                  MARU_EventId type,
+                                                  const void *payload,
+                                                  size_t size) {
+  const MARU_InternalUserPayloads payloads = {
+      .data = (const uint8_t *)payload,
+      .size = size,
+      .stride = size,
+  };
+  return _maru_internal_event_queue_push_user_payloads(q, &type, &payloads, 1) == 1;
+}
+
+uint32_t _maru_internal_event_queue_push_user_events(
+    MARU_InternalEventQueue *q, const MARU_EventId *types,
+    const MARU_UserDefinedEvent *events, uint32_t count) {
+  const MARU_InternalUserPayloads payloads = {
+      .data = (const uint8_t *)events,
+      .size = sizeof(MARU_UserDefinedEvent),
+      .stride = sizeof(MARU_UserDefinedEvent),
+  };
+  return _maru_internal_event_queue_push_user_payloads(q, types, &payloads, count);
+}
+
+// Returns true when the oldest unclaimed spilled event is published, with
+// `*out_ring_seq` set to the ring position it was spilled at.
+static bool _maru_internal_event_queue_peek_overflow(MARU_InternalEventQueue *q,
+                                                     size_t *out_ring_seq) {
+  MARU_InternalEventSegment *seg = q->overflow_read;
+  if (!seg) return false;
+  if (seg->claimed == MARU_INTERNAL_EVENT_SEGMENT_CAPACITY) {
+    seg = atomic_load_explicit(&seg->next, memory_order_acquire);
+    if (!seg) return false;
+  }
+  const uint32_t index = seg->claimed;
+  if (atomic_load_explicit(&seg->slots[index].state, memory_order_acquire) ==
+      MARU_INTERNAL_QUEUED_EVENT_FREE) {
+    return false;
+  }
+  *out_ring_seq = seg->ring_seq[index];
   return true;
 }
+
+uint32_t _maru_internal_event_queue_acquire(MARU_InternalEventQueue *q,
+                                            size_t *out_first,
+                                            uint32_t max_count) {
+  if (!q || !q->events || q->capacity == 0) return 0;
+  if (max_count > q->capacity) {
+    max_count = q->capacity;
+  }
+
+  const size_t first = q->consumer_pos;
+  // Ring events reserved after a pending spilled event wait for it.
+  size_t spilled_at;
+  if (q->overflow_enabled && _maru_internal_event_queue_peek_overflow(q, &spilled_at)) {
+    if (spilled_at <= first) {
+      return 0;
+    }
+    if (spilled_at - first < max_count) {
+      max_count = (uint32_t)(spilled_at - first);
+    }
+  }
+  uint32_t index = (uint32_t)(first % q->capacity);
+  uint32_t count = 0;
+
+  // Scan with relaxed loads and pay for a single acquire fence per batch.
+  while (count < max_count &&
+         atomic_load_explicit(&q->slots[index].state, memory_order_relaxed) !=
+             MARU_INTERNAL_QUEUED_EVENT_FREE) {
+    ++count;
+    if (++index == q->capacity) {
+      index = 0;
+    }
+  }
+  if (count == 0) {
+    return 0;
+  }
+  atomic_thread_fence(memory_order_acquire);
+
+  q->consumer_pos = first + count;
+  q->consumer_depth++;
+  *out_first = first;
+  return count;
+}
+
+void _maru_internal_event_queue_release(MARU_InternalEventQueue *q,
+                                        size_t first, uint32_t count) {
+  uint32_t index = (uint32_t)(first % q->capacity);
+  for (uint32_t i = 0; i < count; ++i) {
+    atomic_store_explicit(&q->slots[index].state, MARU_INTERNAL_QUEUED_EVENT_FREE,
+                          memory_order_relaxed);
+    if (++index == q->capacity) {
+      index = 0;
+    }
+  }
+
+  // The release store orders the FREE resets above before any producer can
+  // reserve these slots again.
+  if (--q->consumer_depth == 0) {
+    atomic_store_explicit(&q->tail, q->consumer_pos, memory_order_release);
+  }
+}
+
+uint32_t _maru_internal_event_queue_acquire_overflow(
+    MARU_InternalEventQueue *q, const MARU_InternalQueuedEventSlot **out_slots,
+    const MARU_Event **out_events, uint32_t max_count) {
+  if (!q || !q->overflow_read) return 0;
+
+  MARU_InternalEventSegment *seg = q->overflow_read;
+  if (seg->claimed == MARU_INTERNAL_EVENT_SEGMENT_CAPACITY) {
+    MARU_InternalEventSegment *next =
+        atomic_load_explicit(&seg->next, memory_order_acquire);
+    if (!next) {
+      return 0;
+    }
+    seg = next;
+    q->overflow_read = seg;
+  }
+
+  const uint32_t first = seg->claimed;
+  uint32_t limit = MARU_INTERNAL_EVENT_SEGMENT_CAPACITY - first;
+  if (limit > max_count) {
+    limit = max_count;
+  }
+  // Spilled events are newer than the ring slots reserved before them, so
+  // each waits until those have been claimed.
+  uint32_t count = 0;
+  while (count < limit &&
+         atomic_load_explicit(&seg->slots[first + count].state, memory_order_acquire) !=
+             MARU_INTERNAL_QUEUED_EVENT_FREE &&
+         seg->ring_seq[first + count] <= q->consumer_pos) {
+    ++count;
+  }
+  if (count == 0) {
+    return 0;
+  }
+
+  seg->claimed = first + count;
+  q->overflow_depth++;
+  *out_slots = &seg->slots[first];
+  *out_events = &seg->events[first];
+  return count;
+}
+
+void _maru_internal_event_queue_release_overflow(MARU_InternalEventQueue *q,
+                                                 uint32_t count) {
+  atomic_fetch_sub_explicit(&q->overflow_pending, count, memory_order_release);
+  if (--q->overflow_depth != 0) {
+    return;
+  }
+
+  // Segments behind the read cursor are fully consumed. One may only be
+  // retired once the shared tail has moved past it, otherwise a new producer
+  // could still pick it up.
+  while (q->overflow_head != q->overflow_read) {
+    MARU_InternalEventSegment *seg = q->overflow_head;
+    if (atomic_load(&q->overflow_tail) == seg) {
+      break;
+    }
+    q->overflow_head = atomic_load_explicit(&seg->next, memory_order_acquire);
+    seg->retired_next = q->overflow_retired;
+    q->overflow_retired = seg;
+  }
+
+  // Producers register before loading the tail, so once none is registered
+  // nobody can hold a pointer to a retired segment.
+  if (q->overflow_retired && atomic_load(&q->overflow_users) == 0) {
+    MARU_InternalEventSegment *seg = q->overflow_retired;
+    while (seg) {
+      MARU_InternalEventSegment *next = seg->retired_next;
+      _maru_internal_event_segment_destroy(q->ctx, seg);
+      seg = next;
+    }
+    q->overflow_retired = NULL;
+  }
+}
@@ -15,32 +15,92 @@
 #define _MARU_ATOMIC(T) _Atomic(T)
 #endif
 
+// Upper bound on how many slots the consumer claims per acquire.
+#define MARU_INTERNAL_EVENT_QUEUE_BATCH 64u
+// Number of user events held by one overflow segment.
+#define MARU_INTERNAL_EVENT_SEGMENT_CAPACITY 256u
+
 typedef struct MARU_Context_Base MARU_Context_Base;
 typedef void (*MARU_InternalQueuedEventCleanupFn)(MARU_Context_Base *ctx,
                                                   void *userdata);
 
-typedef struct MARU_InternalQueuedEvent {
-  _MARU_ATOMIC(int) state; // 0: Free, 1: Writing, 2: Ready
+typedef enum MARU_InternalQueuedEventState {
+  MARU_INTERNAL_QUEUED_EVENT_FREE = 0,
+  MARU_INTERNAL_QUEUED_EVENT_READY = 2,
+  // Ready, and the matching cleanup entry must run once the event is consumed.
+  MARU_INTERNAL_QUEUED_EVENT_READY_OWNED = 3,
+} MARU_InternalQueuedEventState;
+
+// Per-slot header. Kept apart from the payload so the consumer can scan the
+// readiness of a whole batch from a handful of cache lines.
+typedef struct MARU_InternalQueuedEventSlot {
+  _MARU_ATOMIC(int) state;
   MARU_EventId type;
   MARU_Window *window;
-  MARU_Event evt;
-  MARU_InternalQueuedEventCleanupFn cleanup_cb;
-  void *cleanup_userdata;
-} MARU_InternalQueuedEvent;
+} MARU_InternalQueuedEventSlot;
+
+// Cold data, only touched for slots published as READY_OWNED.
+typedef struct MARU_InternalQueuedEventCleanup {
+  MARU_InternalQueuedEventCleanupFn cb;
+  void *userdata;
+} MARU_InternalQueuedEventCleanup;
+
+// Overflow storage for user events once the ring is full. Segments form a
+// singly linked list that producers append to and the consumer drains in order.
+typedef struct MARU_InternalEventSegment {
+  _MARU_ATOMIC(uint32_t) reserved; // Producers claim entries here; may overshoot
+  _MARU_ATOMIC(struct MARU_InternalEventSegment *) next;
+  struct MARU_InternalEventSegment *retired_next; // Consumer-only
+  uint32_t claimed;                               // Consumer-only
+  MARU_InternalQueuedEventSlot slots[MARU_INTERNAL_EVENT_SEGMENT_CAPACITY];
+  MARU_Event events[MARU_INTERNAL_EVENT_SEGMENT_CAPACITY];
+  // Ring `head` when each entry was spilled. Ring events before it are older,
+  // the ones from it onwards newer.
+  size_t ring_seq[MARU_INTERNAL_EVENT_SEGMENT_CAPACITY];
+} MARU_InternalEventSegment;
 
 typedef struct MARU_InternalEventQueue {
-  MARU_InternalQueuedEvent *buffer;
+  // All three arrays live in one 64-byte aligned allocation owned by `events`.
+  // Each MARU_Event payload occupies exactly one cache line.
+  MARU_Event *events;
+  MARU_InternalQueuedEventSlot *slots;
+  MARU_InternalQueuedEventCleanup *cleanups;
   uint32_t capacity;
-  
+
   // We use separate cache lines to avoid false sharing
   alignas(64) _MARU_ATOMIC(size_t) head; // Producers write here
   alignas(64) _MARU_ATOMIC(size_t) tail; // Consumer reads here
+  size_t consumer_pos;     // Next slot to acquire, ahead of tail while claimed
+  uint32_t consumer_depth; // Outstanding acquires; tail moves when it hits 0
+
+  // Consumer-owned overflow cursors. `overflow_head` is the oldest segment not
+  // yet retired, `overflow_read` the one being claimed from. Retired segments
+  // are freed once no producer is inside the overflow path.
+  MARU_InternalEventSegment *overflow_head;
+  MARU_InternalEventSegment *overflow_read;
+  MARU_InternalEventSegment *overflow_retired;
+  uint32_t overflow_depth;
+
+  // Opt-in user-event overflow (MARU_ContextTuning.user_event_overflow).
+  MARU_Context_Base *ctx;
+  bool overflow_enabled;
+  alignas(64) _MARU_ATOMIC(MARU_InternalEventSegment *) overflow_tail;
+  // Spilled events the consumer has not released yet. While non-zero, user
+  // events keep spilling so that none can overtake an earlier one.
+  _MARU_ATOMIC(size_t) overflow_pending;
+  _MARU_ATOMIC(uint32_t) overflow_users; // Producers inside the overflow path
+
+  // Sizing statistics, see maru_getUserEventQueueStats().
+  alignas(64) _MARU_ATOMIC(uint32_t) high_water_mark;
+  _MARU_ATOMIC(uint64_t) spilled_count;
+  _MARU_ATOMIC(uint64_t) dropped_count;
 } MARU_InternalEventQueue;
 
 // Returns true on success
 bool _maru_internal_event_queue_init(MARU_InternalEventQueue *q,
                                      MARU_Context_Base *ctx,
-                                     uint32_t capacity);
+                                     uint32_t capacity,
+                                     bool overflow_enabled);
 void _maru_internal_event_queue_cleanup(MARU_InternalEventQueue *q,
                                         MARU_Context_Base *ctx);
 
@@ -48,16 +108,53 @@ void _maru_internal_event_queue_cleanup(MARU_InternalEventQueue *q,
 bool _maru_internal_event_queue_push(MARU_InternalEventQueue *q,
                                      MARU_EventId type,
                                      MARU_Window *window,
-                                     MARU_Event evt,
+                                     const MARU_Event *evt,
                                      MARU_InternalQueuedEventCleanupFn cleanup_cb,
                                      void *cleanup_userdata);
 
-// Single-consumer pop. Returns false if empty.
-bool _maru_internal_event_queue_pop(MARU_InternalEventQueue *q,
-                                    MARU_EventId *out_type,
-                                    MARU_Window **out_window,
-                                    MARU_Event *out_evt,
-                                    MARU_InternalQueuedEventCleanupFn *out_cleanup_cb,
-                                    void **out_cleanup_userdata);
+// Thread-safe push of a context-scoped user event. Spills into an overflow
+// segment when overflow is enabled and the ring is full. Returns false if the
+// event was dropped.
+bool _maru_internal_event_queue_push_user_event(MARU_InternalEventQueue *q,
+                                                MARU_EventId type,
+                                                const MARU_UserDefinedEvent *evt);
+
+// Same as _maru_internal_event_queue_push_user_event(), but copies `size`
+// bytes from `payload` straight into the reserved slot's raw_payload and zeroes
+// the rest. `size` must not exceed sizeof(MARU_UserDefinedEvent).
+bool _maru_internal_event_queue_push_user_payload(MARU_InternalEventQueue *q,
+                                                  MARU_EventId type,
+                                                  const void *payload,
+                                                  size_t size);
+
+// Thread-safe bulk push of context-scoped user events. Reserves room for as
+// many of the leading `count` events as fit with a single CAS, spills the rest
+// when overflow is enabled, and returns how many were queued.
+uint32_t _maru_internal_event_queue_push_user_events(
+    MARU_InternalEventQueue *q, const MARU_EventId *types,
+    const MARU_UserDefinedEvent *events, uint32_t count);
+
+// Single-consumer batched pop. Claims up to `max_count` contiguous ready slots
+// in place and returns how many were claimed; `*out_first` receives the
+// sequence number of the first one. Stops short of ring slots reserved after
+// the oldest pending spilled event. Claimed slots stay untouched by producers
+// until handed back with _maru_internal_event_queue_release().
+//
+// Acquires may nest (e.g. a callback pumping again); `tail` is only published
+// once the outermost batch is released.
+uint32_t _maru_internal_event_queue_acquire(MARU_InternalEventQueue *q,
+                                            size_t *out_first,
+                                            uint32_t max_count);
+void _maru_internal_event_queue_release(MARU_InternalEventQueue *q,
+                                        size_t first, uint32_t count);
+
+// Overflow counterpart of acquire/release. Only hands out spilled events once
+// every ring slot reserved before them has been acquired, so the two merge
+// back in push order. Claimed entries are contiguous within a single segment.
+uint32_t _maru_internal_event_queue_acquire_overflow(
+    MARU_InternalEventQueue *q, const MARU_InternalQueuedEventSlot **out_slots,
+    const MARU_Event **out_events, uint32_t max_count);
+void _maru_internal_event_queue_release_overflow(MARU_InternalEventQueue *q,
+                                                 uint32_t count);
 
 #endif
@@ -13,6 +13,12 @@
 #include <sys/ioctl.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <time.h>
+
+#ifndef input_event_sec
+#define input_event_sec time.tv_sec
+#define input_event_usec time.tv_usec
+#endif
 
 #define TEST_BIT(bit, array) ((array[(size_t)(bit) / (8 * sizeof(unsigned long))] >> ((size_t)(bit) % (8 * sizeof(unsigned long)))) & 1)
 
@@ -416,6 +422,8 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
                  "Controller button count must fit int16_t");
   _Static_assert(MARU_CONTROLLER_ANALOG_STANDARD_COUNT <= INT16_MAX,
                  "Controller analog count must fit int16_t");
+  _Static_assert(MARU_CONTROLLER_ANALOG_MAX_CHANNELS <= 64u,
+                 "Every analog channel needs a bit in analog_pending_mask");
   
   unsigned long ev_bits[EV_MAX / (8 * sizeof(unsigned long)) + 1] = {0};
   unsigned long key_bits[KEY_CNT / (8 * sizeof(unsigned long)) + 1] = {0};
@@ -427,6 +435,10 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
   ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(abs_bits)), abs_bits);
   ioctl(fd, EVIOCGBIT(EV_FF, sizeof(ff_bits)), ff_bits);
 
+  // evdev stamps events with CLOCK_REALTIME unless told otherwise.
+  int clock_id = CLOCK_MONOTONIC;
+  (void)ioctl(fd, (unsigned long)EVIOCSCLOCKID, &clock_id);
+
   // 1. Identify Standard Gamepad Buttons
   static const uint16_t std_buttons[] = {
     BTN_SOUTH, BTN_EAST, BTN_WEST, BTN_NORTH,
@@ -463,7 +475,8 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
       for (uint32_t j = 0; j < MARU_CONTROLLER_ANALOG_STANDARD_COUNT; ++j) {
         if (std_abs[j] == i) { is_std = true; break; }
       }
-      if (!is_std) {
+      // Axes past the cap have no bit in changed_mask and stay unmapped.
+      if (!is_std && abs_count < MARU_CONTROLLER_ANALOG_MAX_CHANNELS) {
         abs_count++;
       }
     }
@@ -494,6 +507,9 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
   size_t abs_states_offset = total_size;
   total_size += ALIGN_UP(abs_count * sizeof(MARU_AnalogInputState));
 
+  size_t abs_reported_offset = total_size;
+  total_size += ALIGN_UP(abs_count * sizeof(MARU_Scalar));
+
   size_t abs_info_offset = total_size;
   total_size += ALIGN_UP(abs_count * sizeof(struct input_absinfo));
   
@@ -520,6 +536,7 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
   ctrl->button_states = (MARU_ButtonState8*)(base_ptr + btn_states_offset);
   ctrl->analog_channels = (MARU_ChannelInfo*)(base_ptr + abs_channels_offset);
   ctrl->analog_states = (MARU_AnalogInputState*)(base_ptr + abs_states_offset);
+  ctrl->analog_reported = (MARU_Scalar *)(base_ptr + abs_reported_offset);
   ctrl->analog_abs_info = (struct input_absinfo *)(base_ptr + abs_info_offset);
   ctrl->haptic_channels = (MARU_ChannelInfo*)(base_ptr + haptic_channels_offset);
   ctrl->allocated_names = (char**)(base_ptr + allocated_names_offset);
@@ -588,7 +605,7 @@ static MARU_LinuxController* _maru_linux_controller_create(MARU_Context_Linux_Co
       for (uint32_t j = 0; j < MARU_CONTROLLER_ANALOG_STANDARD_COUNT; ++j) {
         if (std_abs[j] == i) { is_std = true; break; }
       }
-      if (!is_std) {
+      if (!is_std && current_abs < abs_count) {
         const uint32_t idx = current_abs++;
         ctrl->evdev_to_analog[i] = (int16_t)idx;
         ioctl(fd, (unsigned long)EVIOCGABS((unsigned int)i),
@@ -991,6 +1008,19 @@ void _maru_linux_common_handle_internal_event(MARU_Context_Linux_Common *common,
   }
 }
 
+int _maru_linux_poll_until(struct pollfd *fds, nfds_t nfds, uint64_t deadline_ns) {
+  if (deadline_ns == MARU_NEVER_NS) {
+    return ppoll(fds, nfds, NULL, NULL);
+  }
+  const uint64_t now_ns = _maru_linux_get_monotonic_time_ns();
+  const uint64_t wait_ns = (deadline_ns > now_ns) ? deadline_ns - now_ns : 0;
+  const struct timespec timeout = {
+      .tv_sec = (time_t)(wait_ns / 1000000000ull),
+      .tv_nsec = (long)(wait_ns % 1000000000ull),
+  };
+  return ppoll(fds, nfds, &timeout, NULL);
+}
+
 uint32_t _maru_linux_common_fill_pollfds(MARU_Context_Linux_Common *common, struct pollfd *fds, uint32_t max_fds) {
   uint32_t count = 0;
   for (MARU_LinuxController *it = common->controllers; it && count < max_fds; it = it->next) {
@@ -1002,113 +1032,349 @@ uint32_t _maru_linux_common_fill_pollfds(MARU_Context_Linux_Common *common, stru
   return count;
 }
 
+static void _maru_linux_motion_batch_push_sample(MARU_Context_Base *ctx_base,
+                                                MARU_LinuxMotionBatch *batch,
+                                                const MARU_MouseMotionSample *sample) {
+  if (batch->count == batch->capacity) {
+    const uint32_t old_capacity = batch->capacity;
+    const uint32_t new_capacity = (old_capacity == 0) ? 16u : old_capacity * 2u;
+    MARU_MouseMotionSample *grown = (MARU_MouseMotionSample *)maru_context_realloc(
+        ctx_base, batch->samples, sizeof(MARU_MouseMotionSample) * old_capacity,
+        sizeof(MARU_MouseMotionSample) * new_capacity);
+    if (!grown) {
+      // The batched event still carries the accumulated motion.
+      return;
+    }
+    batch->samples = grown;
+    batch->capacity = new_capacity;
+  }
+  batch->samples[batch->count++] = *sample;
+}
+
+void _maru_linux_motion_batch_add(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch,
+                                  MARU_Window *window, const MARU_MouseMotionSample *sample,
+                                  bool relative) {
+  // Nothing would see the batched event, so keep neither the samples nor the deltas.
+  if (!ctx_base->pump_ctx ||
+      (ctx_base->pump_ctx->mask & MARU_MASK_MOUSE_MOVED) == 0) {
+    return;
+  }
+
+  _maru_linux_motion_batch_push_sample(ctx_base, batch, sample);
+  batch->window = window;
+  if (relative) {
+    batch->relative_delta.x += sample->dip_delta.x;
+    batch->relative_delta.y += sample->dip_delta.y;
+    batch->raw_delta.x += sample->raw_dip_delta.x;
+    batch->raw_delta.y += sample->raw_dip_delta.y;
+    batch->has_relative = true;
+  } else {
+    batch->absolute_delta.x += sample->dip_delta.x;
+    batch->absolute_delta.y += sample->dip_delta.y;
+    batch->has_absolute = true;
+  }
+  batch->timestamp_ns = sample->timestamp_ns;
+}
+
+void _maru_linux_motion_batch_flush(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch,
+                                    MARU_Window *window, MARU_Vec2Dip dip_position,
+                                    MARU_ModifierFlags modifiers) {
+  if (!batch->has_absolute && !batch->has_relative) {
+    return;
+  }
+
+  if (window) {
+    MARU_Event evt = {0};
+    evt.mouse_moved.dip_position = dip_position;
+    // Relative motion is not clipped by the surface, so it wins when a frame has both.
+    evt.mouse_moved.dip_delta =
+        batch->has_relative ? batch->relative_delta : batch->absolute_delta;
+    evt.mouse_moved.raw_dip_delta = batch->raw_delta;
+    evt.mouse_moved.modifiers = modifiers;
+    evt.mouse_moved.timestamp_ns = batch->timestamp_ns;
+
+    ctx_base->pub.mouse_motion_samples = batch->samples;
+    ctx_base->pub.mouse_motion_sample_count = batch->count;
+    _maru_dispatch_event(ctx_base, MARU_EVENT_MOUSE_MOVED, window, &evt);
+    ctx_base->pub.mouse_motion_samples = NULL;
+    ctx_base->pub.mouse_motion_sample_count = 0;
+  }
+
+  _maru_linux_motion_batch_reset(batch);
+}
+
+void _maru_linux_motion_batch_reset(MARU_LinuxMotionBatch *batch) {
+  batch->count = 0;
+  batch->window = NULL;
+  batch->absolute_delta = (MARU_Vec2Dip){0};
+  batch->relative_delta = (MARU_Vec2Dip){0};
+  batch->raw_delta = (MARU_Vec2Dip){0};
+  batch->timestamp_ns = 0;
+  batch->has_absolute = false;
+  batch->has_relative = false;
+}
+
+void _maru_linux_motion_batch_cleanup(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch) {
+  maru_context_free(ctx_base, batch->samples);
+  batch->samples = NULL;
+  batch->capacity = 0;
+  _maru_linux_motion_batch_reset(batch);
+}
+
+static MARU_Scalar _maru_linux_apply_analog_deadzone(MARU_Scalar value,
+                                                     MARU_Scalar deadzone) {
+  const MARU_Scalar magnitude = (value < (MARU_Scalar)0.0) ? -value : value;
+  return (magnitude < deadzone) ? (MARU_Scalar)0.0 : value;
+}
+
+static void _maru_linux_controller_flush_analog(MARU_Context_Linux_Common *common,
+                                                MARU_LinuxController *ctrl,
+                                                uint64_t timestamp_ns) {
+  uint64_t pending = ctrl->analog_pending_mask;
+  ctrl->analog_pending_mask = 0;
+  if (pending == 0) {
+    return;
+  }
+
+  const MARU_ContextTuning *tuning = &common->ctx_base->tuning;
+  uint64_t changed_mask = 0;
+  for (uint32_t idx = 0; pending != 0; ++idx) {
+    const uint64_t bit = (uint64_t)1 << idx;
+    if ((pending & bit) == 0) {
+      continue;
+    }
+    pending &= ~bit;
+
+    const MARU_Scalar value = _maru_linux_apply_analog_deadzone(
+        ctrl->analog_states[idx].value, tuning->controller.analog_deadzone);
+    const MARU_Scalar previous = ctrl->analog_reported[idx];
+    const MARU_Scalar diff = (value > previous) ? (value - previous) : (previous - value);
+    // Always report settling at rest, even when the last step was below epsilon.
+    if (diff > tuning->controller.analog_epsilon ||
+        (value == (MARU_Scalar)0.0 && previous != (MARU_Scalar)0.0)) {
+      ctrl->analog_reported[idx] = value;
+      changed_mask |= (uint64_t)1 << idx;
+    }
+  }
+
+  if (changed_mask == 0) {
+    return;
+  }
+
+  MARU_Event pub_evt = {0};
+  pub_evt.controller_analog_changed.controller = (MARU_Controller *)ctrl;
+  pub_evt.controller_analog_changed.timestamp_ns = timestamp_ns;
+  pub_evt.controller_analog_changed.changed_mask = changed_mask;
+  for (uint32_t i = 0; i < MARU_CONTROLLER_ANALOG_STANDARD_COUNT; ++i) {
+    pub_evt.controller_analog_changed.standard_values[i] = ctrl->analog_reported[i];
+  }
+  _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_ANALOG_CHANGED, NULL, &pub_evt);
+}
+
+static uint64_t _maru_linux_input_event_time_ns(const struct input_event *ev) {
+  return _maru_linux_map_input_time_ns(
+      (uint64_t)ev->input_event_sec * 1000000000ULL +
+      (uint64_t)ev->input_event_usec * 1000ULL);
+}
+
+static void _maru_linux_controller_resync(MARU_Context_Linux_Common *common,
+                                          MARU_LinuxController *it);
+
+static void _maru_linux_controller_handle_event(MARU_Context_Linux_Common *common,
+                                                MARU_LinuxController *it,
+                                                const struct input_event *ev) {
+  if (ev->type == EV_SYN && ev->code == SYN_DROPPED) {
+    it->syn_dropped = true;
+    return;
+  }
+  if (it->syn_dropped) {
+    // The kernel buffer overflowed: everything up to the next report is stale.
+    if (ev->type == EV_SYN && ev->code == SYN_REPORT) {
+      it->syn_dropped = false;
+      it->analog_pending_mask = 0;
+      _maru_linux_controller_resync(common, it);
+    }
+    return;
+  }
+
+  if (ev->type == EV_KEY) {
+    if (ev->code >= KEY_CNT) {
+      return;
+    }
+    int idx = it->evdev_to_button[ev->code];
+    if (idx >= 0) {
+      MARU_ButtonState8 new_state = (MARU_ButtonState8)((ev->value != 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
+      if (it->button_states[idx] != new_state) {
+        it->button_states[idx] = new_state;
+        const uint64_t timestamp_ns = _maru_linux_input_event_time_ns(ev);
+
+        MARU_Event pub_evt = {0};
+        pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
+        pub_evt.controller_button_changed.button_id = (uint32_t)idx;
+        pub_evt.controller_button_changed.state = (MARU_ButtonState)new_state;
+        pub_evt.controller_button_changed.timestamp_ns = timestamp_ns;
+        _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
+      }
+    }
+  } else if (ev->type == EV_ABS) {
+    if (ev->code >= ABS_CNT) {
+      return;
+    }
+    int idx = it->evdev_to_analog[ev->code];
+    if (idx >= 0) {
+      struct input_absinfo *info = &it->analog_abs_info[idx];
+      MARU_Scalar value = (MARU_Scalar)0.0;
+      if (info->maximum != info->minimum) {
+        value = (MARU_Scalar)(ev->value - info->minimum) / (MARU_Scalar)(info->maximum - info->minimum);
+        
+        if (idx == MARU_CONTROLLER_ANALOG_LEFT_X || idx == MARU_CONTROLLER_ANALOG_RIGHT_X) {
+          value = value * (MARU_Scalar)2.0 - (MARU_Scalar)1.0;
+        } else if (idx == MARU_CONTROLLER_ANALOG_LEFT_Y || idx == MARU_CONTROLLER_ANALOG_RIGHT_Y) {
+          // Invert Y: evdev is Up=Negative, Maru is Up=Positive
+          value = (MARU_Scalar)1.0 - (value * (MARU_Scalar)2.0);
+        }
+        // Triggers (4, 5) and non-standard axes remain in 0..1 or their raw normalized range.
+      }
+      it->analog_states[idx].value = value;
+      it->analog_pending_mask |= (uint64_t)1 << idx;
+    }
+  } else if (ev->type == EV_SYN && ev->code == SYN_REPORT) {
+    if (it->analog_pending_mask != 0) {
+      _maru_linux_controller_flush_analog(common, it, _maru_linux_input_event_time_ns(ev));
+    }
+  }
+
+  // Special handling for Hat -> DPAD
+  if (ev->type == EV_ABS && (ev->code == ABS_HAT0X || ev->code == ABS_HAT0Y)) {
+    const uint64_t timestamp_ns = _maru_linux_input_event_time_ns(ev);
+    // Only map if the corresponding buttons were NOT found during discovery
+    if (ev->code == ABS_HAT0X) {
+      uint32_t left_id = MARU_CONTROLLER_BUTTON_DPAD_LEFT;
+      uint32_t right_id = MARU_CONTROLLER_BUTTON_DPAD_RIGHT;
+      
+      if (it->evdev_to_button[BTN_DPAD_LEFT] == -1) {
+        MARU_ButtonState8 left_state = (MARU_ButtonState8)((ev->value < 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
+        MARU_ButtonState8 right_state = (MARU_ButtonState8)((ev->value > 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
+        
+        if (it->button_states[left_id] != left_state) {
+          it->button_states[left_id] = left_state;
+          MARU_Event pub_evt = {0};
+          pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
+          pub_evt.controller_button_changed.button_id = left_id;
+          pub_evt.controller_button_changed.state = (MARU_ButtonState)left_state;
+          pub_evt.controller_button_changed.timestamp_ns = timestamp_ns;
+          _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
+        }
+        if (it->button_states[right_id] != right_state) {
+          it->button_states[right_id] = right_state;
+          MARU_Event pub_evt = {0};
+          pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
+          pub_evt.controller_button_changed.button_id = right_id;
+          pub_evt.controller_button_changed.state = (MARU_ButtonState)right_state;
+          pub_evt.controller_button_changed.timestamp_ns = timestamp_ns;
+          _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
+        }
+      }
+    } else if (ev->code == ABS_HAT0Y) {
+      uint32_t up_id = MARU_CONTROLLER_BUTTON_DPAD_UP;
+      uint32_t down_id = MARU_CONTROLLER_BUTTON_DPAD_DOWN;
+
+      if (it->evdev_to_button[BTN_DPAD_UP] == -1) {
+        MARU_ButtonState8 up_state = (MARU_ButtonState8)((ev->value < 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
+        MARU_ButtonState8 down_state = (MARU_ButtonState8)((ev->value > 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
+
+        if (it->button_states[up_id] != up_state) {
+          it->button_states[up_id] = up_state;
+          MARU_Event pub_evt = {0};
+          pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
+          pub_evt.controller_button_changed.button_id = up_id;
+          pub_evt.controller_button_changed.state = (MARU_ButtonState)up_state;
+          pub_evt.controller_button_changed.timestamp_ns = timestamp_ns;
+          _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
+        }
+        if (it->button_states[down_id] != down_state) {
+          it->button_states[down_id] = down_state;
+          MARU_Event pub_evt = {0};
+          pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
+          pub_evt.controller_button_changed.button_id = down_id;
+          pub_evt.controller_button_changed.state = (MARU_ButtonState)down_state;
+          pub_evt.controller_button_changed.timestamp_ns = timestamp_ns;
+          _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
+        }
+      }
+    }
+  }
+}
+
+static void _maru_linux_controller_resync(MARU_Context_Linux_Common *common,
+                                          MARU_LinuxController *it) {
+  // Replay the current device state through the normal path so that any
+  // transitions lost in the overflow still produce events.
+  struct input_event synth;
+  memset(&synth, 0, sizeof(synth));
+
+  unsigned long key_bits[KEY_CNT / (8 * sizeof(unsigned long)) + 1] = {0};
+  if (ioctl(it->fd, (unsigned long)EVIOCGKEY(sizeof(key_bits)), key_bits) >= 0) {
+    synth.type = EV_KEY;
+    for (int code = 0; code < KEY_CNT; ++code) {
+      if (it->evdev_to_button[code] >= 0) {
+        synth.code = (uint16_t)code;
+        synth.value = (int32_t)TEST_BIT(code, key_bits);
+        _maru_linux_controller_handle_event(common, it, &synth);
+      }
+    }
+  }
+
+  synth.type = EV_ABS;
+  for (int code = 0; code < ABS_CNT; ++code) {
+    if (it->evdev_to_analog[code] < 0) {
+      continue;
+    }
+    struct input_absinfo info;
+    if (ioctl(it->fd, (unsigned long)EVIOCGABS((unsigned int)code), &info) >= 0) {
+      synth.code = (uint16_t)code;
+      synth.value = info.value;
+      _maru_linux_controller_handle_event(common, it, &synth);
+    }
+  }
+
+  synth.type = EV_SYN;
+  synth.code = SYN_REPORT;
+  synth.value = 0;
+  _maru_linux_controller_handle_event(common, it, &synth);
+}
+
 void _maru_linux_common_process_pollfds(MARU_Context_Linux_Common *common, const struct pollfd *fds, uint32_t count) {
-  for (MARU_LinuxController *it = common->controllers; it; it = it->next) {
+  // fill_pollfds() wrote one entry per controller in list order, so walk both in
+  // lockstep and only fall back to a search if the list changed in between.
+  uint32_t fd_index = 0;
+  for (MARU_LinuxController *it = common->controllers; it; it = it->next, ++fd_index) {
     const struct pollfd *pfd = NULL;
-    for (uint32_t i = 0; i < count; ++i) {
-      if (fds[i].fd == it->fd) {
-        pfd = &fds[i];
-        break;
+    if (fd_index < count && fds[fd_index].fd == it->fd) {
+      pfd = &fds[fd_index];
+    } else {
+      for (uint32_t i = 0; i < count; ++i) {
+        if (fds[i].fd == it->fd) {
+          pfd = &fds[i];
+          break;
+        }
       }
     }
 
     if (pfd && (pfd->revents & POLLIN)) {
-      struct input_event ev;
-      while (read(it->fd, &ev, sizeof(ev)) > 0) {
-        if (ev.type == EV_KEY) {
-          if (ev.code >= KEY_CNT) {
-            continue;
-          }
-          int idx = it->evdev_to_button[ev.code];
-          if (idx >= 0) {
-            MARU_ButtonState8 new_state = (MARU_ButtonState8)((ev.value != 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
-            if (it->button_states[idx] != new_state) {
-              it->button_states[idx] = new_state;
-              
-              MARU_Event pub_evt = {0};
-              pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
-              pub_evt.controller_button_changed.button_id = (uint32_t)idx;
-              pub_evt.controller_button_changed.state = (MARU_ButtonState)new_state;
-              _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
-            }
-          }
-        } else if (ev.type == EV_ABS) {
-          if (ev.code >= ABS_CNT) {
-            continue;
-          }
-          int idx = it->evdev_to_analog[ev.code];
-          if (idx >= 0) {
-            struct input_absinfo *info = &it->analog_abs_info[idx];
-            MARU_Scalar value = (MARU_Scalar)0.0;
-            if (info->maximum != info->minimum) {
-              value = (MARU_Scalar)(ev.value - info->minimum) / (MARU_Scalar)(info->maximum - info->minimum);
-              
-              if (idx == MARU_CONTROLLER_ANALOG_LEFT_X || idx == MARU_CONTROLLER_ANALOG_RIGHT_X) {
-                value = value * (MARU_Scalar)2.0 - (MARU_Scalar)1.0;
-              } else if (idx == MARU_CONTROLLER_ANALOG_LEFT_Y || idx == MARU_CONTROLLER_ANALOG_RIGHT_Y) {
-                // Invert Y: evdev is Up=Negative, Maru is Up=Positive
-                value = (MARU_Scalar)1.0 - (value * (MARU_Scalar)2.0);
-              }
-              // Triggers (4, 5) and non-standard axes remain in 0..1 or their raw normalized range.
-            }
-            it->analog_states[idx].value = value;
-          }
+      struct input_event events[MARU_LINUX_CONTROLLER_READ_BATCH];
+      for (;;) {
+        const ssize_t bytes = read(it->fd, events, sizeof(events));
+        if (bytes <= 0) {
+          break;
         }
-
-        // Special handling for Hat -> DPAD
-        if (ev.type == EV_ABS && (ev.code == ABS_HAT0X || ev.code == ABS_HAT0Y)) {
-          // Only map if the corresponding buttons were NOT found during discovery
-          if (ev.code == ABS_HAT0X) {
-            uint32_t left_id = MARU_CONTROLLER_BUTTON_DPAD_LEFT;
-            uint32_t right_id = MARU_CONTROLLER_BUTTON_DPAD_RIGHT;
-            
-            if (it->evdev_to_button[BTN_DPAD_LEFT] == -1) {
-              MARU_ButtonState8 left_state = (MARU_ButtonState8)((ev.value < 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
-              MARU_ButtonState8 right_state = (MARU_ButtonState8)((ev.value > 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
-              
-              if (it->button_states[left_id] != left_state) {
-                it->button_states[left_id] = left_state;
-                MARU_Event pub_evt = {0};
-                pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
-                pub_evt.controller_button_changed.button_id = left_id;
-                pub_evt.controller_button_changed.state = (MARU_ButtonState)left_state;
-                _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
-              }
-              if (it->button_states[right_id] != right_state) {
-                it->button_states[right_id] = right_state;
-                MARU_Event pub_evt = {0};
-                pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
-                pub_evt.controller_button_changed.button_id = right_id;
-                pub_evt.controller_button_changed.state = (MARU_ButtonState)right_state;
-                _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
-              }
-            }
-          } else if (ev.code == ABS_HAT0Y) {
-            uint32_t up_id = MARU_CONTROLLER_BUTTON_DPAD_UP;
-            uint32_t down_id = MARU_CONTROLLER_BUTTON_DPAD_DOWN;
-
-            if (it->evdev_to_button[BTN_DPAD_UP] == -1) {
-              MARU_ButtonState8 up_state = (MARU_ButtonState8)((ev.value < 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
-              MARU_ButtonState8 down_state = (MARU_ButtonState8)((ev.value > 0) ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED);
-
-              if (it->button_states[up_id] != up_state) {
-                it->button_states[up_id] = up_state;
-                MARU_Event pub_evt = {0};
-                pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
-                pub_evt.controller_button_changed.button_id = up_id;
-                pub_evt.controller_button_changed.state = (MARU_ButtonState)up_state;
-                _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
-              }
-              if (it->button_states[down_id] != down_state) {
-                it->button_states[down_id] = down_state;
-                MARU_Event pub_evt = {0};
-                pub_evt.controller_button_changed.controller = (MARU_Controller*)it;
-                pub_evt.controller_button_changed.button_id = down_id;
-                pub_evt.controller_button_changed.state = (MARU_ButtonState)down_state;
-                _maru_dispatch_event(common->ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &pub_evt);
-              }
-            }
-          }
+        const size_t event_count = (size_t)bytes / sizeof(events[0]);
+        for (size_t i = 0; i < event_count; ++i) {
+          _maru_linux_controller_handle_event(common, it, &events[i]);
+        }
+        // evdev only returns whole events; a short read means the queue is drained.
+        if ((size_t)bytes < sizeof(events)) {
+          break;
         }
       }
     }
@@ -1,11 +1,15 @@
 // SPDX-License-Identifier: Zlib
 // Copyright (c) 2026 François Chabot
 
+#define _GNU_SOURCE
 #include "linux_dataexchange.h"
 
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <string.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
 #include <unistd.h>
 
 #include "maru_mem_internal.h"
@@ -26,7 +30,8 @@ MARU_Status maru_linux_dataexchange_queueTransfer(MARU_Context_Base *ctx_base,
                                                   MARU_Window *window,
                                                   MARU_DataExchangeTarget target,
                                                   const char *mime_type,
-                                                  void *userdata) {
+                                                  void *userdata,
+                                                  bool stream) {
   if (!ctx_base || !head || fd < 0 || !mime_type) {
     if (fd >= 0) close(fd);
     return MARU_FAILURE;
@@ -51,6 +56,8 @@ MARU_Status maru_linux_dataexchange_queueTransfer(MARU_Context_Base *ctx_base,
   transfer->window = window;
   transfer->target = target;
   transfer->userdata = userdata;
+  transfer->is_stream = stream;
+  transfer->source_fd = -1;
   transfer->next = *head;
   *head = transfer;
   return MARU_SUCCESS;
@@ -91,6 +98,7 @@ MARU_Status maru_linux_dataexchange_queueWriteTransfer(MARU_Context_Base *ctx_ba
   transfer->is_write = true;
   transfer->is_zero_copy = zero_copy;
   transfer->size = size;
+  transfer->source_fd = -1;
 
   if (zero_copy) {
     transfer->buffer = (uint8_t *)data;
@@ -111,6 +119,58 @@ MARU_Status maru_linux_dataexchange_queueWriteTransfer(MARU_Context_Base *ctx_ba
   return MARU_SUCCESS;
 }
 
+MARU_Status maru_linux_dataexchange_queueFdWriteTransfer(MARU_Context_Base *ctx_base,
+                                                         MARU_LinuxDataTransfer **head,
+                                                         int fd,
+                                                         MARU_Window *window,
+                                                         MARU_DataExchangeTarget target,
+                                                         const char *mime_type,
+                                                         int source_fd,
+                                                         uint64_t source_offset,
+                                                         size_t size) {
+  if (!ctx_base || !head || fd < 0 || source_fd < 0 || !mime_type) {
+    if (fd >= 0) close(fd);
+    if (source_fd >= 0) close(source_fd);
+    return MARU_FAILURE;
+  }
+
+  MARU_LinuxDataTransfer *transfer =
+      (MARU_LinuxDataTransfer *)maru_context_alloc(ctx_base, sizeof(*transfer));
+  if (!transfer) {
+    close(fd);
+    close(source_fd);
+    return MARU_FAILURE;
+  }
+  memset(transfer, 0, sizeof(*transfer));
+
+  transfer->mime_type = maru_linux_dataexchange_copyString(ctx_base, mime_type);
+  if (!transfer->mime_type) {
+    maru_context_free(ctx_base, transfer);
+    close(fd);
+    close(source_fd);
+    return MARU_FAILURE;
+  }
+
+  // splice() is told not to block on the pipe; the sendfile() fallback needs
+  // the descriptor itself to be non-blocking.
+  const int flags = fcntl(fd, F_GETFL, 0);
+  if (flags >= 0) {
+    (void)fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+  }
+
+  transfer->fd = fd;
+  transfer->window = window;
+  transfer->target = target;
+  transfer->is_write = true;
+  transfer->size = size;
+  transfer->source_fd = source_fd;
+  transfer->source_offset = source_offset;
+
+  transfer->next = *head;
+  *head = transfer;
+  return MARU_SUCCESS;
+}
+
 int maru_linux_dataexchange_fillPollFds(const MARU_LinuxDataTransfer *head,
                                         struct pollfd *pfds, int max_count) {
   int count = 0;
@@ -139,6 +199,62 @@ static bool _maru_linux_dataexchange_grow_buffer(MARU_Context_Base *ctx_base,
   return true;
 }
 
+// Moves the next part of a file-backed write into the pipe without a trip
+// through user space. Some sources or destinations refuse splice(); those fall
+// back to sendfile() for the rest of the transfer.
+static ssize_t _maru_linux_dataexchange_send_from_fd(MARU_LinuxDataTransfer *transfer,
+                                                     size_t remaining) {
+  off_t offset = (off_t)(transfer->source_offset + transfer->processed);
+  if (!transfer->source_no_splice) {
+    const ssize_t n = splice(transfer->source_fd, &offset, transfer->fd, NULL,
+                             remaining, SPLICE_F_NONBLOCK);
+    if (n >= 0 || (errno != EINVAL && errno != ENOSYS)) return n;
+    transfer->source_no_splice = true;
+  }
+  return sendfile(transfer->fd, transfer->source_fd, &offset, remaining);
+}
+
+// Makes room for the next read of a buffered transfer, so the kernel copies
+// straight into the payload buffer. FIONREAD tells how much is pending; the
+// buffer grows to take all of it in one read, by at least
+// MARU_LINUX_DATAEXCHANGE_MIN_READ, and its capacity still doubles.
+static bool _maru_linux_dataexchange_reserve_read(MARU_Context_Base *ctx_base,
+                                                  MARU_LinuxDataTransfer *transfer) {
+  int pending = 0;
+  if (ioctl(transfer->fd, FIONREAD, &pending) != 0 || pending < 0) {
+    pending = 0;
+  }
+  // A zero-length read() would look like EOF, so keep at least a byte free.
+  const size_t need = (pending > 0) ? (size_t)pending : 1u;
+  if (transfer->capacity - transfer->size >= need) return true;
+  const size_t want =
+      (need > MARU_LINUX_DATAEXCHANGE_MIN_READ) ? need : MARU_LINUX_DATAEXCHANGE_MIN_READ;
+  if (transfer->size > SIZE_MAX - want) return false;
+  return _maru_linux_dataexchange_grow_buffer(ctx_base, transfer,
+                                              transfer->size + want);
+}
+
+// Hands the buffered bytes of a streamed read to the application and empties
+// the buffer for the next chunk.
+static void _maru_linux_dataexchange_dispatch_chunk(MARU_Context_Base *ctx_base,
+                                                    MARU_LinuxDataTransfer *transfer,
+                                                    MARU_Status status,
+                                                    bool is_final) {
+  MARU_Event evt = {0};
+  evt.data_chunk_received.userdata = transfer->userdata;
+  evt.data_chunk_received.status = status;
+  evt.data_chunk_received.target = transfer->target;
+  evt.data_chunk_received.mime_type = transfer->mime_type;
+  evt.data_chunk_received.data = transfer->buffer;
+  evt.data_chunk_received.size = transfer->size;
+  evt.data_chunk_received.offset = transfer->streamed;
+  evt.data_chunk_received.is_final = is_final;
+  _maru_dispatch_event(ctx_base, MARU_EVENT_DATA_CHUNK_RECEIVED, transfer->window,
+                       &evt);
+  transfer->streamed += transfer->size;
+  transfer->size = 0;
+}
+
 static void _maru_linux_dataexchange_dispatch_complete(MARU_Context_Base *ctx_base,
                                                        MARU_LinuxDataTransfer *transfer,
                                                        MARU_Status status) {
@@ -153,6 +269,11 @@ static void _maru_linux_dataexchange_dispatch_complete(MARU_Context_Base *ctx_ba
     return;
   }
 
+  if (transfer->is_stream) {
+    _maru_linux_dataexchange_dispatch_chunk(ctx_base, transfer, status, true);
+    return;
+  }
+
   if (transfer->userdata == (void *)1) {
 #ifdef MARU_INDIRECT_BACKEND
     if (ctx_base->pub.backend_type == MARU_BACKEND_WAYLAND) {
@@ -203,14 +324,19 @@ void maru_linux_dataexchange_processTransfers(MARU_Context_Base *ctx_base,
             done = true;
             break;
           }
-          const ssize_t n = write(curr->fd, curr->buffer + curr->processed, remaining);
+          const ssize_t n =
+              curr->source_fd >= 0
+                  ? _maru_linux_dataexchange_send_from_fd(curr, remaining)
+                  : write(curr->fd, curr->buffer + curr->processed, remaining);
           if (n > 0) {
             curr->processed += (size_t)n;
             continue;
           }
           if (n == 0) {
-            // Should not happen for write?
-            done = true;
+            // For file-backed writes this means the source ended before the
+            // announced range did.
+            error = curr->source_fd >= 0;
+            done = !error;
             break;
           }
           if (errno == EINTR) continue;
@@ -219,17 +345,46 @@ void maru_linux_dataexchange_processTransfers(MARU_Context_Base *ctx_base,
           break;
         }
       }
+    } else if (!error && curr->is_stream && (revents & (POLLIN | POLLHUP)) != 0) {
+      // Read straight into the fixed chunk buffer; a full buffer goes out
+      // before reading on, so memory stays bounded whatever the payload size.
+      if (!_maru_linux_dataexchange_grow_buffer(ctx_base, curr,
+                                                MARU_LINUX_DATAEXCHANGE_CHUNK_SIZE)) {
+        error = true;
+      }
+      while (!error) {
+        if (curr->size == curr->capacity) {
+          _maru_linux_dataexchange_dispatch_chunk(ctx_base, curr, MARU_SUCCESS, false);
+        }
+        const ssize_t n =
+            read(curr->fd, curr->buffer + curr->size, curr->capacity - curr->size);
+        if (n > 0) {
+          curr->size += (size_t)n;
+          continue;
+        }
+        if (n == 0) {
+          done = true;
+          break;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+          // Don't sit on a partial chunk while the source is slow.
+          if (curr->size > 0) {
+            _maru_linux_dataexchange_dispatch_chunk(ctx_base, curr, MARU_SUCCESS, false);
+          }
+          break;
+        }
+        error = true;
+      }
     } else if (!error && (revents & (POLLIN | POLLHUP)) != 0) {
       for (;;) {
-        uint8_t tmp[4096];
-        const ssize_t n = read(curr->fd, tmp, sizeof(tmp));
+        if (!_maru_linux_dataexchange_reserve_read(ctx_base, curr)) {
+          error = true;
+          break;
+        }
+        const ssize_t n =
+            read(curr->fd, curr->buffer + curr->size, curr->capacity - curr->size);
         if (n > 0) {
-          const size_t needed = curr->size + (size_t)n;
-          if (!_maru_linux_dataexchange_grow_buffer(ctx_base, curr, needed)) {
-            error = true;
-            break;
-          }
-          memcpy(curr->buffer + curr->size, tmp, (size_t)n);
           curr->size += (size_t)n;
           continue;
         }
@@ -248,6 +403,7 @@ void maru_linux_dataexchange_processTransfers(MARU_Context_Base *ctx_base,
       _maru_linux_dataexchange_dispatch_complete(ctx_base, curr,
                                                  error ? MARU_FAILURE : MARU_SUCCESS);
       close(curr->fd);
+      if (curr->source_fd >= 0) close(curr->source_fd);
       *link = next;
       if (!curr->is_zero_copy) {
           maru_context_free(ctx_base, curr->buffer);
@@ -271,6 +427,7 @@ void maru_linux_dataexchange_destroyTransfers(MARU_Context_Base *ctx_base,
   while (curr) {
     MARU_LinuxDataTransfer *next = curr->next;
     if (curr->fd >= 0) close(curr->fd);
+    if (curr->source_fd >= 0) close(curr->source_fd);
     if (!curr->is_zero_copy) {
       maru_context_free(ctx_base, curr->buffer);
     }
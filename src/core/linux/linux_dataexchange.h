@@ -11,18 +11,33 @@
 #include "maru/maru.h"
 #include "maru_internal.h"
 
+// Payload bytes a streamed read transfer holds before handing them out as a
+// MARU_EVENT_DATA_CHUNK_RECEIVED.
+#define MARU_LINUX_DATAEXCHANGE_CHUNK_SIZE 65536u
+// Smallest growth step of a buffered read transfer. Larger steps come from
+// the bytes FIONREAD reports as pending, so short payloads stay small.
+#define MARU_LINUX_DATAEXCHANGE_MIN_READ 4096u
+
 typedef struct MARU_LinuxDataTransfer {
   int fd;
   uint8_t *buffer;
   size_t size;
   size_t capacity;
   size_t processed;
+  // Bytes already delivered by earlier chunks of a streamed read.
+  uint64_t streamed;
   MARU_Window *window;
   MARU_DataExchangeTarget target;
   const char *mime_type;
   void *userdata;
   bool is_write;
   bool is_zero_copy;
+  bool is_stream;
+  // File-backed writes: the kernel copies `size` bytes from `source_fd`,
+  // starting at `source_offset`, straight into `fd`. -1 otherwise.
+  int source_fd;
+  uint64_t source_offset;
+  bool source_no_splice;
   struct MARU_LinuxDataTransfer *next;
 } MARU_LinuxDataTransfer;
 
@@ -32,7 +47,8 @@ MARU_Status maru_linux_dataexchange_queueTransfer(MARU_Context_Base *ctx_base,
                                                   MARU_Window *window,
                                                   MARU_DataExchangeTarget target,
                                                   const char *mime_type,
-                                                  void *userdata);
+                                                  void *userdata,
+                                                  bool stream);
 
 MARU_Status maru_linux_dataexchange_queueWriteTransfer(MARU_Context_Base *ctx_base,
                                                        MARU_LinuxDataTransfer **head,
@@ -43,6 +59,16 @@ MARU_Status maru_linux_dataexchange_queueWriteTransfer(MARU_Context_Base *ctx_ba
                                                        const void *data,
                                                        size_t size,
                                                        bool zero_copy);
+// Takes ownership of both `fd` and `source_fd`, closing them on failure.
+MARU_Status maru_linux_dataexchange_queueFdWriteTransfer(MARU_Context_Base *ctx_base,
+                                                         MARU_LinuxDataTransfer **head,
+                                                         int fd,
+                                                         MARU_Window *window,
+                                                         MARU_DataExchangeTarget target,
+                                                         const char *mime_type,
+                                                         int source_fd,
+                                                         uint64_t source_offset,
+                                                         size_t size);
 int maru_linux_dataexchange_fillPollFds(const MARU_LinuxDataTransfer *head,
                                         struct pollfd *pfds, int max_count);
 void maru_linux_dataexchange_processTransfers(
@@ -12,6 +12,32 @@ uint64_t _maru_linux_get_monotonic_time_ns(void) {
   return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
 }
 
+// Compositor, X server and evdev timestamps are CLOCK_MONOTONIC in practice,
+// but none of them guarantee it. Anything that does not land shortly before
+// "now" is treated as a foreign time base and replaced with the current time.
+#define MARU_LINUX_INPUT_TIME_MAX_AGE_NS (10ULL * 1000000000ULL)
+
+uint64_t _maru_linux_map_input_time_ns(uint64_t native_ns) {
+  const uint64_t now_ns = _maru_linux_get_monotonic_time_ns();
+  if (native_ns == 0 || native_ns > now_ns ||
+      now_ns - native_ns > MARU_LINUX_INPUT_TIME_MAX_AGE_NS) {
+    return now_ns;
+  }
+  return native_ns;
+}
+
+uint64_t _maru_linux_map_input_time_ms(uint32_t native_ms) {
+  const uint64_t now_ns = _maru_linux_get_monotonic_time_ns();
+  const uint64_t now_ms = now_ns / 1000000ULL;
+  // Unsigned 32-bit subtraction keeps the age correct across wraparound.
+  const uint64_t age_ms = (uint64_t)(uint32_t)((uint32_t)now_ms - native_ms);
+  if (age_ms > now_ms ||
+      age_ms * 1000000ULL > MARU_LINUX_INPUT_TIME_MAX_AGE_NS) {
+    return now_ns;
+  }
+  return (now_ms - age_ms) * 1000000ULL;
+}
+
 bool _maru_linux_map_native_mouse_button(uint32_t native_code,
                                          uint32_t *out_channel) {
   switch (native_code) {
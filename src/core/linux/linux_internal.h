@@ -18,6 +18,21 @@ typedef enum MARU_LinuxWorkerMessage {
   MARU_LINUX_WORKER_MSG_TERMINATE,
 } MARU_LinuxWorkerMessage;
 
+// Pointer motion held back until the end of an input frame and dispatched as
+// one MARU_EVENT_MOUSE_MOVED carrying the raw samples.
+typedef struct MARU_LinuxMotionBatch {
+  MARU_MouseMotionSample *samples;
+  uint32_t count;
+  uint32_t capacity;
+  MARU_Window *window;
+  MARU_Vec2Dip absolute_delta;
+  MARU_Vec2Dip relative_delta;
+  MARU_Vec2Dip raw_delta;
+  uint64_t timestamp_ns;
+  bool has_absolute;
+  bool has_relative;
+} MARU_LinuxMotionBatch;
+
 typedef struct MARU_LinuxController {
   MARU_ControllerPrefix base;
   int fd;
@@ -39,6 +54,12 @@ typedef struct MARU_LinuxController {
   MARU_ButtonState8 *button_states;
   MARU_ChannelInfo *analog_channels;
   MARU_AnalogInputState *analog_states;
+  // Last values reported through MARU_EVENT_CONTROLLER_ANALOG_CHANGED, and the
+  // channels written since the previous SYN_REPORT.
+  MARU_Scalar *analog_reported;
+  uint64_t analog_pending_mask;
+  // Set on SYN_DROPPED; events are discarded until the next SYN_REPORT.
+  bool syn_dropped;
 
   MARU_ChannelInfo *haptic_channels;
   int effect_id; // -1 if no effect uploaded
@@ -71,6 +92,8 @@ typedef enum MARU_LinuxHotplugOpType {
 } MARU_LinuxHotplugOpType;
 
 #define MARU_LINUX_HOTPLUG_QUEUE_CAPACITY 8u
+// input_events pulled from a controller per read() call.
+#define MARU_LINUX_CONTROLLER_READ_BATCH 64u
 #define MARU_LINUX_MAX_SYSPATH_BYTES 512u
 #define MARU_LINUX_MAX_DEVNODE_BYTES 512u
 
@@ -140,9 +163,25 @@ bool _maru_linux_common_run(MARU_Context_Linux_Common* common);
 void _maru_linux_common_cleanup(MARU_Context_Linux_Common* common);
 
 uint64_t _maru_linux_get_monotonic_time_ns(void);
+/** @brief Maps a native nanosecond input timestamp onto the _maru_linux_get_monotonic_time_ns() clock. */
+uint64_t _maru_linux_map_input_time_ns(uint64_t native_ns);
+/** @brief Maps a wrapping 32-bit millisecond input timestamp onto the _maru_linux_get_monotonic_time_ns() clock. */
+uint64_t _maru_linux_map_input_time_ms(uint32_t native_ms);
 bool _maru_linux_map_native_mouse_button(uint32_t native_code, uint32_t *out_channel);
 MARU_Key _maru_linux_scancode_to_maru_key(uint32_t scancode);
 
+/** @brief Folds one motion sample into the batch. Skipped while MARU_EVENT_MOUSE_MOVED is masked. */
+void _maru_linux_motion_batch_add(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch,
+                                  MARU_Window *window, const MARU_MouseMotionSample *sample,
+                                  bool relative);
+/** @brief Dispatches the batch to `window` (dropped when NULL) and resets it. */
+void _maru_linux_motion_batch_flush(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch,
+                                    MARU_Window *window, MARU_Vec2Dip dip_position,
+                                    MARU_ModifierFlags modifiers);
+/** @brief Discards any pending motion, keeping the sample storage. */
+void _maru_linux_motion_batch_reset(MARU_LinuxMotionBatch *batch);
+void _maru_linux_motion_batch_cleanup(MARU_Context_Base *ctx_base, MARU_LinuxMotionBatch *batch);
+
 MARU_Status _maru_linux_common_get_controllers(MARU_Context_Linux_Common *common, MARU_ControllerList *out_list);
 void _maru_linux_common_retain_controller(MARU_Controller *controller);
 void _maru_linux_common_release_controller(MARU_Controller *controller);
@@ -157,6 +196,8 @@ void _maru_linux_controller_destroy(MARU_Context_Base* ctx_base, MARU_LinuxContr
 uint32_t _maru_linux_common_fill_pollfds(MARU_Context_Linux_Common *common, struct pollfd *fds, uint32_t max_fds);
 /** @brief Processes any pending controller input from the poll result. */
 void _maru_linux_common_process_pollfds(MARU_Context_Linux_Common *common, const struct pollfd *fds, uint32_t count);
+/** @brief ppoll() until an absolute _maru_linux_get_monotonic_time_ns() deadline; MARU_NEVER_NS blocks indefinitely. */
+int _maru_linux_poll_until(struct pollfd *fds, nfds_t nfds, uint64_t deadline_ns);
 
 MARU_Status _maru_linux_common_set_haptic_levels(MARU_Context_Linux_Common *common, MARU_LinuxController *ctrl, uint32_t first_haptic, uint32_t count, const MARU_Scalar *intensities);
 
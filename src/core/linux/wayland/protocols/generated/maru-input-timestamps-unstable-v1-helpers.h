@@ -0,0 +1,107 @@
+/* Generated from input-timestamps-unstable-v1.xml */
+
+#ifndef MARU_WAYLAND_HELPERS_INPUT_TIMESTAMPS_UNSTABLE_V1_H
+#define MARU_WAYLAND_HELPERS_INPUT_TIMESTAMPS_UNSTABLE_V1_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct MARU_Context_WL MARU_Context_WL;
+
+struct zwp_input_timestamps_manager_v1;
+struct zwp_input_timestamps_manager_v1_listener;
+struct zwp_input_timestamps_v1;
+struct wl_keyboard;
+struct zwp_input_timestamps_v1;
+struct wl_pointer;
+struct zwp_input_timestamps_v1;
+struct wl_touch;
+/* interface zwp_input_timestamps_manager_v1 */
+static inline void
+maru_zwp_input_timestamps_manager_v1_set_user_data(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1, void *user_data)
+{
+	ctx->dlib.wl.proxy_set_user_data((struct wl_proxy *) zwp_input_timestamps_manager_v1, user_data);
+}
+
+static inline void *
+maru_zwp_input_timestamps_manager_v1_get_user_data(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1)
+{
+	return ctx->dlib.wl.proxy_get_user_data((struct wl_proxy *) zwp_input_timestamps_manager_v1);
+}
+
+static inline uint32_t
+maru_zwp_input_timestamps_manager_v1_get_version(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1)
+{
+	return ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_manager_v1);
+}
+
+static inline int
+maru_zwp_input_timestamps_manager_v1_add_listener(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1, const struct zwp_input_timestamps_manager_v1_listener *listener, void *data)
+{
+	return ctx->dlib.wl.proxy_add_listener((struct wl_proxy *) zwp_input_timestamps_manager_v1, (void (**)(void)) listener, data);
+}
+
+static inline void
+maru_zwp_input_timestamps_manager_v1_destroy(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1)
+{
+	ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) zwp_input_timestamps_manager_v1, ZWP_INPUT_TIMESTAMPS_MANAGER_V1_DESTROY, NULL, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_manager_v1), WL_MARSHAL_FLAG_DESTROY);
+}
+
+static inline struct zwp_input_timestamps_v1 *
+maru_zwp_input_timestamps_manager_v1_get_keyboard_timestamps(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1, struct wl_keyboard *keyboard)
+{
+	struct wl_proxy *id;
+	id = ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) zwp_input_timestamps_manager_v1, ZWP_INPUT_TIMESTAMPS_MANAGER_V1_GET_KEYBOARD_TIMESTAMPS, &zwp_input_timestamps_v1_interface, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_manager_v1), 0, NULL, keyboard);
+	return (struct zwp_input_timestamps_v1 *) id;
+}
+
+static inline struct zwp_input_timestamps_v1 *
+maru_zwp_input_timestamps_manager_v1_get_pointer_timestamps(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1, struct wl_pointer *pointer)
+{
+	struct wl_proxy *id;
+	id = ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) zwp_input_timestamps_manager_v1, ZWP_INPUT_TIMESTAMPS_MANAGER_V1_GET_POINTER_TIMESTAMPS, &zwp_input_timestamps_v1_interface, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_manager_v1), 0, NULL, pointer);
+	return (struct zwp_input_timestamps_v1 *) id;
+}
+
+static inline struct zwp_input_timestamps_v1 *
+maru_zwp_input_timestamps_manager_v1_get_touch_timestamps(MARU_Context_WL *ctx, struct zwp_input_timestamps_manager_v1 *zwp_input_timestamps_manager_v1, struct wl_touch *touch)
+{
+	struct wl_proxy *id;
+	id = ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) zwp_input_timestamps_manager_v1, ZWP_INPUT_TIMESTAMPS_MANAGER_V1_GET_TOUCH_TIMESTAMPS, &zwp_input_timestamps_v1_interface, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_manager_v1), 0, NULL, touch);
+	return (struct zwp_input_timestamps_v1 *) id;
+}
+
+struct zwp_input_timestamps_v1;
+struct zwp_input_timestamps_v1_listener;
+/* interface zwp_input_timestamps_v1 */
+static inline void
+maru_zwp_input_timestamps_v1_set_user_data(MARU_Context_WL *ctx, struct zwp_input_timestamps_v1 *zwp_input_timestamps_v1, void *user_data)
+{
+	ctx->dlib.wl.proxy_set_user_data((struct wl_proxy *) zwp_input_timestamps_v1, user_data);
+}
+
+static inline void *
+maru_zwp_input_timestamps_v1_get_user_data(MARU_Context_WL *ctx, struct zwp_input_timestamps_v1 *zwp_input_timestamps_v1)
+{
+	return ctx->dlib.wl.proxy_get_user_data((struct wl_proxy *) zwp_input_timestamps_v1);
+}
+
+static inline uint32_t
+maru_zwp_input_timestamps_v1_get_version(MARU_Context_WL *ctx, struct zwp_input_timestamps_v1 *zwp_input_timestamps_v1)
+{
+	return ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_v1);
+}
+
+static inline int
+maru_zwp_input_timestamps_v1_add_listener(MARU_Context_WL *ctx, struct zwp_input_timestamps_v1 *zwp_input_timestamps_v1, const struct zwp_input_timestamps_v1_listener *listener, void *data)
+{
+	return ctx->dlib.wl.proxy_add_listener((struct wl_proxy *) zwp_input_timestamps_v1, (void (**)(void)) listener, data);
+}
+
+static inline void
+maru_zwp_input_timestamps_v1_destroy(MARU_Context_WL *ctx, struct zwp_input_timestamps_v1 *zwp_input_timestamps_v1)
+{
+	ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) zwp_input_timestamps_v1, ZWP_INPUT_TIMESTAMPS_V1_DESTROY, NULL, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) zwp_input_timestamps_v1), WL_MARSHAL_FLAG_DESTROY);
+}
+
+#endif
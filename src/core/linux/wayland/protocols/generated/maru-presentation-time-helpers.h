@@ -0,0 +1,87 @@
+/* Generated from presentation-time.xml */
+
+#ifndef MARU_WAYLAND_HELPERS_PRESENTATION_TIME_H
+#define MARU_WAYLAND_HELPERS_PRESENTATION_TIME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+typedef struct MARU_Context_WL MARU_Context_WL;
+
+struct wp_presentation;
+struct wp_presentation_listener;
+struct wl_surface;
+struct wp_presentation_feedback;
+/* interface wp_presentation */
+static inline void
+maru_wp_presentation_set_user_data(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation, void *user_data)
+{
+	ctx->dlib.wl.proxy_set_user_data((struct wl_proxy *) wp_presentation, user_data);
+}
+
+static inline void *
+maru_wp_presentation_get_user_data(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation)
+{
+	return ctx->dlib.wl.proxy_get_user_data((struct wl_proxy *) wp_presentation);
+}
+
+static inline uint32_t
+maru_wp_presentation_get_version(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation)
+{
+	return ctx->dlib.wl.proxy_get_version((struct wl_proxy *) wp_presentation);
+}
+
+static inline int
+maru_wp_presentation_add_listener(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation, const struct wp_presentation_listener *listener, void *data)
+{
+	return ctx->dlib.wl.proxy_add_listener((struct wl_proxy *) wp_presentation, (void (**)(void)) listener, data);
+}
+
+static inline void
+maru_wp_presentation_destroy(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation)
+{
+	ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) wp_presentation, WP_PRESENTATION_DESTROY, NULL, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) wp_presentation), WL_MARSHAL_FLAG_DESTROY);
+}
+
+static inline struct wp_presentation_feedback *
+maru_wp_presentation_feedback(MARU_Context_WL *ctx, struct wp_presentation *wp_presentation, struct wl_surface *surface)
+{
+	struct wl_proxy *id;
+	id = ctx->dlib.wl.proxy_marshal_flags((struct wl_proxy *) wp_presentation, WP_PRESENTATION_FEEDBACK, &wp_presentation_feedback_interface, ctx->dlib.wl.proxy_get_version((struct wl_proxy *) wp_presentation), 0, surface, NULL);
+	return (struct wp_presentation_feedback *) id;
+}
+
+struct wp_presentation_feedback;
+struct wp_presentation_feedback_listener;
+/* interface wp_presentation_feedback */
+static inline void
+maru_wp_presentation_feedback_set_user_data(MARU_Context_WL *ctx, struct wp_presentation_feedback *wp_presentation_feedback, void *user_data)
+{
+	ctx->dlib.wl.proxy_set_user_data((struct wl_proxy *) wp_presentation_feedback, user_data);
+}
+
+static inline void *
+maru_wp_presentation_feedback_get_user_data(MARU_Context_WL *ctx, struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	return ctx->dlib.wl.proxy_get_user_data((struct wl_proxy *) wp_presentation_feedback);
+}
+
+static inline uint32_t
+maru_wp_presentation_feedback_get_version(MARU_Context_WL *ctx, struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	return ctx->dlib.wl.proxy_get_version((struct wl_proxy *) wp_presentation_feedback);
+}
+
+static inline int
+maru_wp_presentation_feedback_add_listener(MARU_Context_WL *ctx, struct wp_presentation_feedback *wp_presentation_feedback, const struct wp_presentation_feedback_listener *listener, void *data)
+{
+	return ctx->dlib.wl.proxy_add_listener((struct wl_proxy *) wp_presentation_feedback, (void (**)(void)) listener, data);
+}
+
+static inline void
+maru_wp_presentation_feedback_destroy(MARU_Context_WL *ctx, struct wp_presentation_feedback *wp_presentation_feedback)
+{
+	ctx->dlib.wl.proxy_destroy((struct wl_proxy *) wp_presentation_feedback);
+}
+
+#endif
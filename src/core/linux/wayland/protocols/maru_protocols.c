@@ -15,4 +15,6 @@
 #include "generated/ext-idle-notify-v1-client-protocol.inc.h"
 #include "generated/xdg-activation-v1-client-protocol.inc.h"
 #include "generated/content-type-v1-client-protocol.inc.h"
+#include "generated/input-timestamps-unstable-v1-client-protocol.inc.h"
+#include "generated/presentation-time-client-protocol.inc.h"
 #include "generated/tablet-v2-client-protocol.inc.h"
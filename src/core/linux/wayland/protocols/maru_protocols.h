@@ -21,9 +21,12 @@
 #include "generated/ext-idle-notify-v1-client-protocol.h"
 #include "generated/xdg-activation-v1-client-protocol.h"
 #include "generated/content-type-v1-client-protocol.h"
+#include "generated/input-timestamps-unstable-v1-client-protocol.h"
+#include "generated/presentation-time-client-protocol.h"
 
 extern const struct xdg_wm_base_listener _maru_xdg_wm_base_listener;
 extern const struct wl_seat_listener _maru_wayland_seat_listener;
+extern const struct wp_presentation_listener _maru_wayland_presentation_listener;
 
 // Required interfaces
 #define MARU_WL_REGISTRY_REQUIRED_BINDINGS                                 \
@@ -46,6 +49,8 @@ extern const struct wl_seat_listener _maru_wayland_seat_listener;
   MARU_WL_REGISTRY_BINDING_ENTRY(wp_fractional_scale_manager_v1, 1, NULL)   \
   MARU_WL_REGISTRY_BINDING_ENTRY(zwp_relative_pointer_manager_v1, 1, NULL)  \
   MARU_WL_REGISTRY_BINDING_ENTRY(zwp_pointer_constraints_v1, 1, NULL)       \
+  MARU_WL_REGISTRY_BINDING_ENTRY(zwp_input_timestamps_manager_v1, 1, NULL)  \
+  MARU_WL_REGISTRY_BINDING_ENTRY(wp_presentation, 1, &_maru_wayland_presentation_listener) \
   MARU_WL_REGISTRY_BINDING_ENTRY(ext_idle_notifier_v1, 1, NULL)             \
   MARU_WL_REGISTRY_BINDING_ENTRY(zwp_text_input_manager_v3, 1, NULL)       \
 
@@ -45,9 +45,9 @@ static MARU_Status maru_announceClipboardData_WL_ctx(MARU_Context *context,
                               mime_types, 0);
 }
 
-static MARU_Status maru_requestClipboardData_WL_ctx(MARU_Context *context,
-                                                    const char *mime_type,
-                                                    void *userdata) {
+static MARU_Status _maru_requestClipboardData_WL(MARU_Context *context,
+                                                 const char *mime_type,
+                                                 void *userdata, bool stream) {
   MARU_Window_WL *win = maru_getClipboardWindow_WL(context);
   if (!win) {
     MARU_REPORT_DIAGNOSTIC(context, MARU_DIAGNOSTIC_FEATURE_UNSUPPORTED,
@@ -55,7 +55,19 @@ static MARU_Status maru_requestClipboardData_WL_ctx(MARU_Context *context,
     return MARU_FAILURE;
   }
   return maru_requestData_WL((MARU_Window *)win, MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
-                             mime_type, userdata);
+                             mime_type, userdata, stream);
+}
+
+static MARU_Status maru_requestClipboardData_WL_ctx(MARU_Context *context,
+                                                    const char *mime_type,
+                                                    void *userdata) {
+  return _maru_requestClipboardData_WL(context, mime_type, userdata, false);
+}
+
+static MARU_Status maru_requestClipboardDataStream_WL_ctx(MARU_Context *context,
+                                                          const char *mime_type,
+                                                          void *userdata) {
+  return _maru_requestClipboardData_WL(context, mime_type, userdata, true);
 }
 
 static MARU_Status
@@ -85,7 +97,14 @@ static MARU_Status maru_requestDropData_WL_win(MARU_Window *window,
                                                const char *mime_type,
                                                void *userdata) {
   return maru_requestData_WL(window, MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
-                             mime_type, userdata);
+                             mime_type, userdata, false);
+}
+
+static MARU_Status maru_requestDropDataStream_WL_win(MARU_Window *window,
+                                                     const char *mime_type,
+                                                     void *userdata) {
+  return maru_requestData_WL(window, MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
+                             mime_type, userdata, true);
 }
 
 static MARU_Status
@@ -101,6 +120,7 @@ const MARU_Backend maru_backend_WL = {
   .destroyContext = maru_destroyContext_WL,
   .updateContext = maru_updateContext_WL,
   .pumpEvents = maru_pumpEvents_WL,
+  .pumpEventsUntil = maru_pumpEventsUntil_WL,
   .createWindow = maru_createWindow_WL,
   .destroyWindow = maru_destroyWindow_WL,
   .updateWindow = maru_updateWindow_WL,
@@ -118,8 +138,11 @@ const MARU_Backend maru_backend_WL = {
   .announceClipboardData = maru_announceClipboardData_WL_ctx,
   .announceDragData = maru_announceDragData_WL_win,
   .provideData = maru_provideData_WL,
+  .provideDataFromFd = maru_provideDataFromFd_WL,
   .requestClipboardData = maru_requestClipboardData_WL_ctx,
   .requestDropData = maru_requestDropData_WL_win,
+  .requestClipboardDataStream = maru_requestClipboardDataStream_WL_ctx,
+  .requestDropDataStream = maru_requestDropDataStream_WL_win,
   .getAvailableClipboardMIMETypes = maru_getAvailableClipboardMIMETypes_WL_ctx,
   .getAvailableDropMIMETypes = maru_getAvailableDropMIMETypes_WL_win,
   .wakeContext = maru_wakeContext_WL,
@@ -159,6 +182,18 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context *context, uint32_t timeout_ms,
   return maru_pumpEvents_WL(context, timeout_ms, mask, callback, userdata);
 }
 
+MARU_API MARU_Status maru_pumpEventsUntil(MARU_Context *context,
+                                          uint64_t deadline_ns,
+                                          MARU_EventMask mask,
+                                          MARU_EventCallback callback,
+                                          void *userdata) {
+  MARU_API_VALIDATE(pumpEventsUntil, context, deadline_ns, mask, callback,
+                    userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  return maru_pumpEventsUntil_WL(context, deadline_ns, mask, callback,
+                                 userdata);
+}
+
 MARU_API MARU_Status maru_createWindow(MARU_Context *context,
                                        const MARU_WindowCreateInfo *create_info,
                                        MARU_Window **out_window) {
@@ -274,6 +309,22 @@ MARU_API MARU_Status maru_provideDropData(MARU_DataRequest *request,
   return maru_provideData_WL(request, data, size, flags);
 }
 
+MARU_API MARU_Status maru_provideClipboardDataFromFd(MARU_DataRequest *request,
+                                                     int fd, uint64_t offset,
+                                                     uint64_t size) {
+  MARU_API_VALIDATE(provideClipboardDataFromFd, request, fd, offset, size);
+  MARU_RETURN_ON_ERROR(_maru_status_if_request_context_lost(request));
+  return maru_provideDataFromFd_WL(request, fd, offset, size);
+}
+
+MARU_API MARU_Status maru_provideDropDataFromFd(MARU_DataRequest *request,
+                                                int fd, uint64_t offset,
+                                                uint64_t size) {
+  MARU_API_VALIDATE(provideDropDataFromFd, request, fd, offset, size);
+  MARU_RETURN_ON_ERROR(_maru_status_if_request_context_lost(request));
+  return maru_provideDataFromFd_WL(request, fd, offset, size);
+}
+
 MARU_API MARU_Status maru_requestClipboardData(MARU_Context *context,
                                                const char *mime_type,
                                                void *userdata) {
@@ -292,6 +343,24 @@ MARU_API MARU_Status maru_requestDropData(MARU_Window *window,
   return maru_requestDropData_WL_win(window, mime_type, userdata);
 }
 
+MARU_API MARU_Status maru_requestClipboardDataStream(MARU_Context *context,
+                                                     const char *mime_type,
+                                                     void *userdata) {
+  MARU_API_VALIDATE(requestClipboardDataStream, context, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  MARU_API_VALIDATE_LIVE(requestClipboardDataStream, context, mime_type, userdata);
+  return maru_requestClipboardDataStream_WL_ctx(context, mime_type, userdata);
+}
+
+MARU_API MARU_Status maru_requestDropDataStream(MARU_Window *window,
+                                                const char *mime_type,
+                                                void *userdata) {
+  MARU_API_VALIDATE(requestDropDataStream, window, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_window_context_lost(window));
+  MARU_API_VALIDATE_LIVE(requestDropDataStream, window, mime_type, userdata);
+  return maru_requestDropDataStream_WL_win(window, mime_type, userdata);
+}
+
 MARU_API MARU_Status maru_getAvailableClipboardMIMETypes(
     const MARU_Context *context, MARU_StringList *out_list) {
   MARU_API_VALIDATE(getAvailableClipboardMIMETypes, context, out_list);
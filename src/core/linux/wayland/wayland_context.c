@@ -49,6 +49,42 @@ static void _wl_update_cursor_shape_device(MARU_Context_WL *ctx) {
   }
 }
 
+static void _wl_update_input_timestamps(MARU_Context_WL *ctx) {
+  struct zwp_input_timestamps_manager_v1 *manager =
+      ctx->protocols.opt.zwp_input_timestamps_manager_v1;
+
+  if (ctx->wl.pointer_timestamps && (!ctx->wl.pointer || !manager)) {
+    maru_zwp_input_timestamps_v1_destroy(ctx, ctx->wl.pointer_timestamps);
+    ctx->wl.pointer_timestamps = NULL;
+    ctx->pending_input_time.pointer_ns = 0;
+  }
+  if (ctx->wl.keyboard_timestamps && (!ctx->wl.keyboard || !manager)) {
+    maru_zwp_input_timestamps_v1_destroy(ctx, ctx->wl.keyboard_timestamps);
+    ctx->wl.keyboard_timestamps = NULL;
+    ctx->pending_input_time.keyboard_ns = 0;
+  }
+  if (!manager) {
+    return;
+  }
+
+  if (!ctx->wl.pointer_timestamps && ctx->wl.pointer) {
+    ctx->wl.pointer_timestamps =
+        maru_zwp_input_timestamps_manager_v1_get_pointer_timestamps(ctx, manager, ctx->wl.pointer);
+    if (ctx->wl.pointer_timestamps) {
+      maru_zwp_input_timestamps_v1_add_listener(ctx, ctx->wl.pointer_timestamps,
+                                                &_maru_wayland_pointer_timestamps_listener, ctx);
+    }
+  }
+  if (!ctx->wl.keyboard_timestamps && ctx->wl.keyboard) {
+    ctx->wl.keyboard_timestamps =
+        maru_zwp_input_timestamps_manager_v1_get_keyboard_timestamps(ctx, manager, ctx->wl.keyboard);
+    if (ctx->wl.keyboard_timestamps) {
+      maru_zwp_input_timestamps_v1_add_listener(ctx, ctx->wl.keyboard_timestamps,
+                                                &_maru_wayland_keyboard_timestamps_listener, ctx);
+    }
+  }
+}
+
 static void _wl_refresh_locked_window_pointers(MARU_Context_WL *ctx) {
   for (MARU_Window_Base *it = ctx->base.window_list_head; it; it = it->ctx_next) {
     MARU_Window_WL *window = (MARU_Window_WL *)it;
@@ -106,6 +142,7 @@ static void _wl_seat_handle_capabilities(void *data, struct wl_seat *wl_seat, ui
     ctx->repeat.interval_ns = 0;
   }
 
+  _wl_update_input_timestamps(ctx);
   _maru_wayland_dataexchange_onSeatCapabilities(ctx, wl_seat, caps);
 
   // Seat capabilities often arrive after windows are created; refresh text-input objects/state.
@@ -124,6 +161,18 @@ const struct wl_seat_listener _maru_wayland_seat_listener = {
   .name = _wl_seat_handle_name,
 };
 
+static void _wl_presentation_handle_clock_id(void *data,
+                                             struct wp_presentation *presentation,
+                                             uint32_t clk_id) {
+  MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+  (void)presentation;
+  ctx->presentation_clock_id = (clockid_t)clk_id;
+}
+
+const struct wp_presentation_listener _maru_wayland_presentation_listener = {
+  .clock_id = _wl_presentation_handle_clock_id,
+};
+
 static void _maru_wayland_drain_wake_fd(MARU_Context_WL *ctx) {
   uint64_t pending = 0;
   while (read(ctx->wake_fd, &pending, sizeof(pending)) == (ssize_t)sizeof(pending)) {
@@ -211,6 +260,7 @@ static void _wl_teardown_seat_state(MARU_Context_WL *ctx) {
     maru_wl_keyboard_destroy(ctx, ctx->wl.keyboard);
     ctx->wl.keyboard = NULL;
   }
+  _wl_update_input_timestamps(ctx);
 
   for (MARU_Window_Base *it = ctx->base.window_list_head; it; it = it->ctx_next) {
     MARU_Window_WL *window = (MARU_Window_WL *)it;
@@ -229,6 +279,7 @@ static void _wl_teardown_seat_state(MARU_Context_WL *ctx) {
     _maru_wayland_clear_text_input_pending(window);
   }
 
+  _maru_linux_motion_batch_reset(&ctx->motion_batch);
   ctx->linux_common.pointer.focused_window = NULL;
   ctx->linux_common.pointer.x = 0.0;
   ctx->linux_common.pointer.y = 0.0;
@@ -297,6 +348,11 @@ static void _wl_handle_optional_global_removed(MARU_Context_WL *ctx,
         maru_zxdg_toplevel_decoration_v1_destroy(ctx, window->xdg.decoration);
         window->xdg.decoration = NULL;
       }
+    } else if (strcmp(iface_name, "wp_presentation") == 0) {
+      if (window->presentation.feedback) {
+        maru_wp_presentation_feedback_destroy(ctx, window->presentation.feedback);
+        window->presentation.feedback = NULL;
+      }
     } else if (strcmp(iface_name, "zwp_idle_inhibit_manager_v1") == 0) {
       if (window->ext.idle_inhibitor) {
         maru_zwp_idle_inhibitor_v1_destroy(ctx, window->ext.idle_inhibitor);
@@ -313,6 +369,8 @@ static void _wl_handle_optional_global_removed(MARU_Context_WL *ctx,
       ctx->wl.cursor_shape_device = NULL;
     }
     _wl_update_cursor_shape_device(ctx);
+  } else if (strcmp(iface_name, "zwp_input_timestamps_manager_v1") == 0) {
+    _wl_update_input_timestamps(ctx);
   } else if (strcmp(iface_name, "ext_idle_notifier_v1") == 0) {
     _wl_clear_idle_notification_only(ctx);
   } else if (strcmp(iface_name, "xdg_activation_v1") == 0) {
@@ -390,6 +448,16 @@ static void _registry_handle_global(void *data, struct wl_registry *registry,
   MARU_WL_REGISTRY_REQUIRED_BINDINGS
 #undef MARU_WL_REGISTRY_BINDING_ENTRY
 
+  if (strcmp(interface, "zwp_input_timestamps_manager_v1") == 0) {
+    // Seat devices may already exist when the manager is announced late.
+    (void)_maru_wl_registry_try_bind(
+        ctx, registry, name, interface, version, "zwp_input_timestamps_manager_v1",
+        &zwp_input_timestamps_manager_v1_interface, 1,
+        (void **)&ctx->protocols.opt.zwp_input_timestamps_manager_v1, NULL, ctx);
+    _wl_update_input_timestamps(ctx);
+    return;
+  }
+
 #define MARU_WL_REGISTRY_BINDING_ENTRY(iface_name, iface_version, listener)    \
   if (_maru_wl_registry_try_bind(                                              \
           ctx, registry, name, interface, version, #iface_name,                \
@@ -467,6 +535,7 @@ MARU_Status maru_createContext_WL(const MARU_ContextCreateInfo *create_info,
   }
 
   ctx->wake_fd = -1;
+  ctx->presentation_clock_id = CLOCK_MONOTONIC;
  
   ctx->base.pub.backend_type = MARU_BACKEND_WAYLAND;
   ctx->base.tuning = create_info->tuning;
@@ -635,6 +704,7 @@ void maru_destroyContext_WL(MARU_Context *context) {
   }
 
   _maru_wayland_cancel_activation(ctx);
+  _maru_linux_motion_batch_cleanup(&ctx->base, &ctx->motion_batch);
   maru_context_free(&ctx->base, ctx->pump_pollfds.fds);
   ctx->pump_pollfds.fds = NULL;
   ctx->pump_pollfds.capacity = 0;
@@ -648,6 +718,14 @@ void maru_destroyContext_WL(MARU_Context *context) {
     _maru_wayland_cleanup_libdecor(ctx);
   }
 
+  if (ctx->wl.pointer_timestamps) {
+    maru_zwp_input_timestamps_v1_destroy(ctx, ctx->wl.pointer_timestamps);
+    ctx->wl.pointer_timestamps = NULL;
+  }
+  if (ctx->wl.keyboard_timestamps) {
+    maru_zwp_input_timestamps_v1_destroy(ctx, ctx->wl.keyboard_timestamps);
+    ctx->wl.keyboard_timestamps = NULL;
+  }
   if (ctx->wl.pointer) {
     if (ctx->wl.cursor_shape_device) {
       maru_wp_cursor_shape_device_v1_destroy(ctx, ctx->wl.cursor_shape_device);
@@ -863,37 +941,22 @@ static bool _maru_wayland_pump_prepare_wayland_read(MARU_Context_WL *ctx,
   return true;
 }
 
-static int _maru_wayland_pump_compute_timeout_ms(MARU_Context_WL *ctx,
-                                                 uint32_t timeout_ms) {
-  // Poll timeout is clamped by synthetic deadlines (key-repeat and cursor animation).
-  int timeout = (timeout_ms == MARU_NEVER) ? -1 : (int)timeout_ms;
-  const uint64_t now_ms = _maru_linux_get_monotonic_time_ns() / 1000000ull;
-
+static uint64_t _maru_wayland_pump_compute_deadline_ns(MARU_Context_WL *ctx,
+                                                       uint64_t deadline_ns) {
+  // The wait is clamped by synthetic deadlines (key-repeat and cursor animation).
+  uint64_t deadline = deadline_ns;
   if (ctx->repeat.repeat_key != 0 && ctx->repeat.rate > 0 &&
-      ctx->repeat.next_repeat_ns != 0) {
-    const uint64_t now_ns = now_ms * 1000000ull;
-    if (now_ns != 0) {
-      if (ctx->repeat.next_repeat_ns <= now_ns) {
-        timeout = 0;
-      } else {
-        const uint64_t wait_ns = ctx->repeat.next_repeat_ns - now_ns;
-        const int repeat_timeout_ms = (int)((wait_ns + 999999ull) / 1000000ull);
-        if (timeout < 0 || repeat_timeout_ms < timeout) {
-          timeout = repeat_timeout_ms;
-        }
-      }
-    }
+      ctx->repeat.next_repeat_ns != 0 && ctx->repeat.next_repeat_ns < deadline) {
+    deadline = ctx->repeat.next_repeat_ns;
   }
-  
-  uint32_t adjusted_timeout = _maru_adjust_timeout_for_cursor_animation(&ctx->base, (timeout < 0) ? MARU_NEVER : (uint32_t)timeout, now_ms);
-  return (adjusted_timeout == MARU_NEVER) ? -1 : (int)adjusted_timeout;
+  return _maru_adjust_deadline_for_cursor_animation(&ctx->base, deadline);
 }
 
 static bool _maru_wayland_pump_poll_and_consume(MARU_Context_WL *ctx,
                                                 const MARU_WLPumpStepState *step,
-                                                int timeout_ms,
+                                                uint64_t deadline_ns,
                                                 MARU_Status *status) {
-  int poll_result = poll(step->fds, step->nfds, timeout_ms);
+  int poll_result = _maru_linux_poll_until(step->fds, step->nfds, deadline_ns);
   if (poll_result > 0) {
     const short display_revents = step->fds[0].revents;
     if ((display_revents & (POLLERR | POLLHUP | POLLNVAL)) != 0) {
@@ -1108,6 +1171,14 @@ static void _maru_wayland_pump_post_tick(MARU_Context_WL *ctx) {
 MARU_Status maru_pumpEvents_WL(MARU_Context *context, uint32_t timeout_ms,
                                MARU_EventMask mask,
                                MARU_EventCallback callback, void *userdata) {
+  const uint64_t deadline_ns = _maru_timeout_ms_to_deadline_ns(
+      timeout_ms, _maru_linux_get_monotonic_time_ns());
+  return maru_pumpEventsUntil_WL(context, deadline_ns, mask, callback, userdata);
+}
+
+MARU_Status maru_pumpEventsUntil_WL(MARU_Context *context, uint64_t deadline_ns,
+                                    MARU_EventMask mask,
+                                    MARU_EventCallback callback, void *userdata) {
   MARU_Context_WL *ctx = (MARU_Context_WL *)context;
   const uint64_t pump_start_ns = _maru_linux_get_monotonic_time_ns();
   MARU_Status status = MARU_SUCCESS;
@@ -1125,8 +1196,9 @@ MARU_Status maru_pumpEvents_WL(MARU_Context *context, uint32_t timeout_ms,
   if (!_maru_wayland_pump_prepare_wayland_read(ctx, &status)) {
     goto pump_exit;
   }
-  const int timeout = _maru_wayland_pump_compute_timeout_ms(ctx, timeout_ms);
-  if (!_maru_wayland_pump_poll_and_consume(ctx, &step, timeout, &status)) {
+  const uint64_t poll_deadline_ns =
+      _maru_wayland_pump_compute_deadline_ns(ctx, deadline_ns);
+  if (!_maru_wayland_pump_poll_and_consume(ctx, &step, poll_deadline_ns, &status)) {
     goto pump_exit;
   }
   if (!_maru_wayland_pump_dispatch_and_validate(ctx, &step, &status)) {
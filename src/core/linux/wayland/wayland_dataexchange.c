@@ -603,7 +603,7 @@ static void _clipboard_data_device_drop(void *data, struct wl_data_device *data_
     
     // We use (void*)1 as a special userdata to identify internal pre-fetch
     maru_requestData_WL((MARU_Window *)window, MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
-                         "text/uri-list", (void *)1);
+                         "text/uri-list", (void *)1, false);
   } else {
     MARU_DropAction action = ctx->clipboard.dnd_target_action;
     if (meta->current_action != MARU_DROP_ACTION_NONE) {
@@ -844,7 +844,7 @@ MARU_Status maru_announceData_WL(MARU_Window *window, MARU_DataExchangeTarget ta
 }
 
 MARU_Status maru_requestData_WL(MARU_Window *window, MARU_DataExchangeTarget target,
-                                const char *mime_type, void *userdata) {
+                                const char *mime_type, void *userdata, bool stream) {
   MARU_Window_WL *wl_window = (MARU_Window_WL *)window;
   MARU_Context_WL *ctx = (MARU_Context_WL *)wl_window->base.ctx_base;
   if (!_maru_wl_dataexchange_target_supported(ctx, target)) {
@@ -892,7 +892,7 @@ MARU_Status maru_requestData_WL(MARU_Window *window, MARU_DataExchangeTarget tar
   return maru_linux_dataexchange_queueTransfer(
       &ctx->base, &ctx->data_transfers, pipefd[0],
       target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD ? NULL : window, target,
-      mime_type, userdata);
+      mime_type, userdata, stream);
 }
 
 MARU_Status maru_getAvailableMIMETypes_WL(const MARU_Window *window,
@@ -997,6 +997,35 @@ MARU_Status maru_provideData_WL(MARU_DataRequest *request,
   return status;
 }
 
+MARU_Status maru_provideDataFromFd_WL(MARU_DataRequest *request, int fd,
+                                      uint64_t offset, uint64_t size) {
+  MARU_WaylandDataRequestHandle *handle =
+      (MARU_WaylandDataRequestHandle *)request;
+  if (handle->magic != MARU_WL_DATA_REQUEST_MAGIC || handle->fd < 0 ||
+      handle->consumed) {
+    return MARU_FAILURE;
+  }
+
+  if (size > (uint64_t)SIZE_MAX || offset + size > (uint64_t)INT64_MAX) {
+    return MARU_FAILURE;
+  }
+  // Failing here leaves the request open for a plain provide call.
+  const int source_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
+  if (source_fd < 0) {
+    return MARU_FAILURE;
+  }
+
+  MARU_Context_WL *ctx = (MARU_Context_WL *)handle->base.ctx_base;
+  MARU_Status status = maru_linux_dataexchange_queueFdWriteTransfer(
+      &ctx->base, &ctx->data_transfers, handle->fd, handle->window,
+      handle->target, handle->mime_type, source_fd, offset, (size_t)size);
+
+  // Both fds belong to the transfer queue now, even when queuing failed.
+  handle->fd = -1;
+  handle->consumed = true;
+  return status;
+}
+
 void _maru_wayland_dataexchange_handle_internal_transfer_complete(
     void *ctx_ptr, MARU_Window *window, MARU_DataExchangeTarget target,
     const char *mime_type, const void *data, size_t size, MARU_Status status) {
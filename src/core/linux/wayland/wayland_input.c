@@ -220,6 +220,59 @@ void _maru_wayland_update_cursor(MARU_Context_WL *ctx, MARU_Window_WL *window, u
     }
 }
 
+static uint64_t _maru_wayland_take_input_time_ns(uint64_t *pending_ns,
+                                                 uint32_t time_ms) {
+    const uint64_t precise_ns = *pending_ns;
+    *pending_ns = 0;
+    if (precise_ns != 0) {
+        return _maru_linux_map_input_time_ns(precise_ns);
+    }
+    return _maru_linux_map_input_time_ms(time_ms);
+}
+
+static uint64_t _maru_wayland_timestamp_to_ns(uint32_t tv_sec_hi, uint32_t tv_sec_lo,
+                                              uint32_t tv_nsec) {
+    const uint64_t tv_sec = ((uint64_t)tv_sec_hi << 32) | (uint64_t)tv_sec_lo;
+    return tv_sec * 1000000000ull + (uint64_t)tv_nsec;
+}
+
+static void _pointer_timestamps_handle_timestamp(void *data,
+                                                 struct zwp_input_timestamps_v1 *timestamps,
+                                                 uint32_t tv_sec_hi, uint32_t tv_sec_lo,
+                                                 uint32_t tv_nsec) {
+    MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    ctx->pending_input_time.pointer_ns =
+        _maru_wayland_timestamp_to_ns(tv_sec_hi, tv_sec_lo, tv_nsec);
+}
+
+static void _keyboard_timestamps_handle_timestamp(void *data,
+                                                  struct zwp_input_timestamps_v1 *timestamps,
+                                                  uint32_t tv_sec_hi, uint32_t tv_sec_lo,
+                                                  uint32_t tv_nsec) {
+    MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    ctx->pending_input_time.keyboard_ns =
+        _maru_wayland_timestamp_to_ns(tv_sec_hi, tv_sec_lo, tv_nsec);
+}
+
+const struct zwp_input_timestamps_v1_listener _maru_wayland_pointer_timestamps_listener = {
+    .timestamp = _pointer_timestamps_handle_timestamp,
+};
+
+const struct zwp_input_timestamps_v1_listener _maru_wayland_keyboard_timestamps_listener = {
+    .timestamp = _keyboard_timestamps_handle_timestamp,
+};
+
+static void _maru_wayland_flush_motion_batch(MARU_Context_WL *ctx) {
+    MARU_Window_WL *window =
+        _maru_wayland_resolve_registered_window(ctx, ctx->motion_batch.window);
+    const MARU_Vec2Dip position = {
+        (MARU_Scalar)ctx->linux_common.pointer.x,
+        (MARU_Scalar)ctx->linux_common.pointer.y,
+    };
+    _maru_linux_motion_batch_flush(&ctx->base, &ctx->motion_batch, (MARU_Window *)window,
+                                   position, _maru_wayland_get_modifiers(ctx));
+}
+
 static void _pointer_handle_enter(void *data, struct wl_pointer *pointer,
                                   uint32_t serial, struct wl_surface *surface,
                                   wl_fixed_t sx, wl_fixed_t sy) {
@@ -250,6 +303,8 @@ static void _pointer_handle_leave(void *data, struct wl_pointer *pointer,
 static void _pointer_handle_motion(void *data, struct wl_pointer *pointer,
                                    uint32_t time, wl_fixed_t sx, wl_fixed_t sy) {
     MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    const uint64_t timestamp_ns =
+        _maru_wayland_take_input_time_ns(&ctx->pending_input_time.pointer_ns, time);
     MARU_Window_WL *window = _maru_wayland_resolve_registered_window(
         ctx, ctx->linux_common.pointer.focused_window);
 
@@ -267,9 +322,22 @@ static void _pointer_handle_motion(void *data, struct wl_pointer *pointer,
     evt.mouse_moved.raw_dip_delta.x = 0.0;
     evt.mouse_moved.raw_dip_delta.y = 0.0;
     evt.mouse_moved.modifiers = _maru_wayland_get_modifiers(ctx);
+    evt.mouse_moved.timestamp_ns = timestamp_ns;
     
     ctx->linux_common.pointer.x = (double)evt.mouse_moved.dip_position.x;
     ctx->linux_common.pointer.y = (double)evt.mouse_moved.dip_position.y;
+
+    if (ctx->base.tuning.wayland.batch_pointer_motion) {
+        const MARU_MouseMotionSample sample = {
+            .dip_position = evt.mouse_moved.dip_position,
+            .dip_delta = evt.mouse_moved.dip_delta,
+            .raw_dip_delta = evt.mouse_moved.raw_dip_delta,
+            .timestamp_ns = timestamp_ns,
+        };
+        _maru_linux_motion_batch_add(&ctx->base, &ctx->motion_batch, (MARU_Window *)window,
+                                     &sample, false);
+        return;
+    }
     
     _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_MOVED, (MARU_Window *)window, &evt);
 }
@@ -278,6 +346,8 @@ static void _pointer_handle_button(void *data, struct wl_pointer *pointer,
                                    uint32_t serial, uint32_t time, uint32_t button,
                                    uint32_t state) {
     MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    const uint64_t timestamp_ns =
+        _maru_wayland_take_input_time_ns(&ctx->pending_input_time.pointer_ns, time);
     MARU_Window_WL *window = _maru_wayland_resolve_registered_window(
         ctx, ctx->linux_common.pointer.focused_window);
 
@@ -306,6 +376,7 @@ static void _pointer_handle_button(void *data, struct wl_pointer *pointer,
     evt.mouse_button_changed.button_id = channel;
     evt.mouse_button_changed.state = btn_state;
     evt.mouse_button_changed.modifiers = _maru_wayland_get_modifiers(ctx);
+    evt.mouse_button_changed.timestamp_ns = timestamp_ns;
     _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_BUTTON_CHANGED,
                          (MARU_Window *)window, &evt);
 }
@@ -319,6 +390,8 @@ static void _pointer_handle_axis(void *data, struct wl_pointer *pointer,
     } else {
         ctx->scroll.delta.x -= (MARU_Scalar)wl_fixed_to_double(value);
     }
+    ctx->scroll.timestamp_ns =
+        _maru_wayland_take_input_time_ns(&ctx->pending_input_time.pointer_ns, time);
     ctx->scroll.active = true;
 }
 
@@ -330,6 +403,8 @@ static void _pointer_handle_frame(void *data, struct wl_pointer *wl_pointer) {
         ctx->linux_common.pointer.focused_window = NULL;
     }
 
+    _maru_wayland_flush_motion_batch(ctx);
+
     if (ctx->scroll.active) {
         if (window) {
             MARU_Event evt = {0};
@@ -337,13 +412,21 @@ static void _pointer_handle_frame(void *data, struct wl_pointer *wl_pointer) {
             evt.mouse_scrolled.steps.x = ctx->scroll.steps.x;
             evt.mouse_scrolled.steps.y = ctx->scroll.steps.y;
             evt.mouse_scrolled.modifiers = _maru_wayland_get_modifiers(ctx);
+            // Discrete-only frames carry no time argument.
+            evt.mouse_scrolled.timestamp_ns = (ctx->scroll.timestamp_ns != 0)
+                                                  ? ctx->scroll.timestamp_ns
+                                                  : _maru_linux_get_monotonic_time_ns();
             _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_SCROLLED, (MARU_Window *)window, &evt);
         }
         memset(&ctx->scroll, 0, sizeof(ctx->scroll));
     }
 }
 static void _pointer_handle_axis_source(void *data, struct wl_pointer *wl_pointer, uint32_t axis_source) {}
-static void _pointer_handle_axis_stop(void *data, struct wl_pointer *wl_pointer, uint32_t time, uint32_t axis) {}
+static void _pointer_handle_axis_stop(void *data, struct wl_pointer *wl_pointer, uint32_t time, uint32_t axis) {
+    MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    // axis_stop carries a timestamp too, so it consumes the pending high-resolution one.
+    ctx->pending_input_time.pointer_ns = 0;
+}
 static void _pointer_handle_axis_discrete(void *data, struct wl_pointer *wl_pointer, uint32_t axis, int32_t discrete) {
     MARU_Context_WL *ctx = (MARU_Context_WL *)data;
     if (axis == WL_POINTER_AXIS_VERTICAL_SCROLL) {
@@ -389,6 +472,20 @@ static void _relative_pointer_handle_relative_motion(void *data, struct zwp_rela
     evt.mouse_moved.raw_dip_delta.x = (MARU_Scalar)wl_fixed_to_double(dx_unaccel);
     evt.mouse_moved.raw_dip_delta.y = (MARU_Scalar)wl_fixed_to_double(dy_unaccel);
     evt.mouse_moved.modifiers = _maru_wayland_get_modifiers(ctx);
+    const uint64_t utime = ((uint64_t)utime_hi << 32) | (uint64_t)utime_lo;
+    evt.mouse_moved.timestamp_ns = _maru_linux_map_input_time_ns(utime * 1000ull);
+
+    if (ctx->base.tuning.wayland.batch_pointer_motion) {
+        const MARU_MouseMotionSample sample = {
+            .dip_position = evt.mouse_moved.dip_position,
+            .dip_delta = evt.mouse_moved.dip_delta,
+            .raw_dip_delta = evt.mouse_moved.raw_dip_delta,
+            .timestamp_ns = evt.mouse_moved.timestamp_ns,
+        };
+        _maru_linux_motion_batch_add(&ctx->base, &ctx->motion_batch, (MARU_Window *)window,
+                                     &sample, true);
+        return;
+    }
 
     _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_MOVED, (MARU_Window *)window, &evt);
 }
@@ -514,6 +611,8 @@ static void _keyboard_handle_key(void *data, struct wl_keyboard *wl_keyboard,
                                  uint32_t serial, uint32_t time, uint32_t key,
                                  uint32_t state) {
     MARU_Context_WL *ctx = (MARU_Context_WL *)data;
+    const uint64_t timestamp_ns =
+        _maru_wayland_take_input_time_ns(&ctx->pending_input_time.keyboard_ns, time);
     MARU_Window_WL *window = (MARU_Window_WL *)ctx->linux_common.xkb.focused_window;
     if (!window || !ctx->linux_common.xkb.state) return;
 
@@ -545,6 +644,7 @@ static void _keyboard_handle_key(void *data, struct wl_keyboard *wl_keyboard,
         evt.key_changed.key = maru_key;
         evt.key_changed.state = maru_state;
         evt.key_changed.modifiers = _maru_wayland_get_modifiers(ctx);
+        evt.key_changed.timestamp_ns = timestamp_ns;
 
         _maru_dispatch_event(&ctx->base, MARU_EVENT_KEY_CHANGED, (MARU_Window *)window, &evt);
     }
@@ -11,6 +11,7 @@
 #include "dlib/libdecor.h"
 #include "protocols/maru_protocols.h"
 #include <errno.h>
+#include <time.h>
 
 #define MARU_WL_SEAT_CAPABILITY_POINTER 1u
 #define MARU_WL_SEAT_CAPABILITY_KEYBOARD 2u
@@ -95,6 +96,8 @@ typedef struct MARU_Context_WL {
     struct wl_pointer *pointer;
     struct wp_cursor_shape_device_v1 *cursor_shape_device;
     struct wl_keyboard *keyboard;
+    struct zwp_input_timestamps_v1 *pointer_timestamps;
+    struct zwp_input_timestamps_v1 *keyboard_timestamps;
     struct zwp_text_input_manager_v3 *text_input_manager;
     struct ext_idle_notification_v1 *idle_notification;
     struct wl_cursor_theme *cursor_theme;
@@ -113,15 +116,29 @@ typedef struct MARU_Context_WL {
 
   uint32_t last_interaction_serial;
 
+  // zwp_input_timestamps_v1 sends its timestamp right before the input event
+  // it refines. 0 means no high-resolution timestamp is pending.
+  struct {
+    uint64_t pointer_ns;
+    uint64_t keyboard_ns;
+  } pending_input_time;
+
+  // Clock domain of wp_presentation timestamps, from wp_presentation.clock_id.
+  clockid_t presentation_clock_id;
+
   struct {
     MARU_Vec2Dip delta;
     struct {
       int32_t x;
       int32_t y;
     } steps;
+    uint64_t timestamp_ns;
     bool active;
   } scroll;
 
+  // Motion held back until wl_pointer.frame when tuning.wayland.batch_pointer_motion is set.
+  MARU_LinuxMotionBatch motion_batch;
+
   struct {
     uint32_t codes[16];
     uint32_t count;
@@ -164,6 +181,15 @@ typedef struct MARU_Window_WL {
     struct wl_callback *frame_callback;
   } wl;
 
+  // Latest wp_presentation_feedback.presented data for this surface. At most
+  // one feedback object is outstanding at a time.
+  struct {
+    struct wp_presentation_feedback *feedback;
+    uint64_t last_ns;
+    uint64_t msc;
+    uint32_t refresh_ns;
+  } presentation;
+
   struct {
     struct wp_fractional_scale_v1 *fractional_scale;
     struct wp_viewport *viewport;
@@ -392,6 +418,9 @@ MARU_Status maru_wakeContext_WL(MARU_Context *context);
 MARU_Status maru_pumpEvents_WL(MARU_Context *context, uint32_t timeout_ms,
                                MARU_EventMask mask,
                                MARU_EventCallback callback, void *userdata);
+MARU_Status maru_pumpEventsUntil_WL(MARU_Context *context, uint64_t deadline_ns,
+                                    MARU_EventMask mask,
+                                    MARU_EventCallback callback, void *userdata);
 MARU_Status maru_createWindow_WL(MARU_Context *context,
                                 const MARU_WindowCreateInfo *create_info,
                                 MARU_Window **out_window);
@@ -435,8 +464,10 @@ MARU_Status maru_announceData_WL(MARU_Window *window, MARU_DataExchangeTarget ta
 MARU_Status maru_provideData_WL(MARU_DataRequest *request,
                                 const void *data, size_t size,
                                 MARU_DataProvideFlags flags);
+MARU_Status maru_provideDataFromFd_WL(MARU_DataRequest *request, int fd,
+                                      uint64_t offset, uint64_t size);
 MARU_Status maru_requestData_WL(MARU_Window *window, MARU_DataExchangeTarget target,
-                                const char *mime_type, void *userdata);
+                                const char *mime_type, void *userdata, bool stream);
 MARU_Status maru_getAvailableMIMETypes_WL(const MARU_Window *window,
                                           MARU_DataExchangeTarget target,
                                           MARU_StringList *out_list);
@@ -468,6 +499,8 @@ void _maru_wayland_clear_text_input_pending(MARU_Window_WL *window);
 void _maru_wayland_enforce_aspect_ratio(uint32_t *width, uint32_t *height,
                                         const MARU_Window_WL *window);
 extern const struct zwp_relative_pointer_v1_listener _maru_wayland_relative_pointer_listener;
+extern const struct zwp_input_timestamps_v1_listener _maru_wayland_pointer_timestamps_listener;
+extern const struct zwp_input_timestamps_v1_listener _maru_wayland_keyboard_timestamps_listener;
 extern const struct zwp_locked_pointer_v1_listener _maru_wayland_locked_pointer_listener;
 void _maru_wayland_mark_lost(MARU_Context_WL *ctx, const char *message);
 
@@ -677,5 +710,7 @@ static inline void *maru_libdecor_get_userdata(MARU_Context_WL *ctx, struct libd
 #include "protocols/generated/maru-ext-idle-notify-v1-helpers.h"
 #include "protocols/generated/maru-xdg-activation-v1-helpers.h"
 #include "protocols/generated/maru-content-type-v1-helpers.h"
+#include "protocols/generated/maru-input-timestamps-unstable-v1-helpers.h"
+#include "protocols/generated/maru-presentation-time-helpers.h"
 
 #endif
@@ -472,6 +472,9 @@ static void _wl_frame_callback_done(void *data, struct wl_callback *callback,
 
   MARU_Event evt = {0};
   evt.window_frame.timestamp_ms = callback_data;
+  evt.window_frame.refresh_interval_ns = window->presentation.refresh_ns;
+  evt.window_frame.last_presentation_ns = window->presentation.last_ns;
+  evt.window_frame.presentation_msc = window->presentation.msc;
   _maru_dispatch_event(&ctx->base, MARU_EVENT_WINDOW_FRAME, (MARU_Window *)window, &evt);
 }
 
@@ -479,6 +482,81 @@ static const struct wl_callback_listener _maru_wayland_frame_listener = {
     .done = _wl_frame_callback_done,
 };
 
+static uint64_t _maru_wayland_presentation_time_to_monotonic_ns(MARU_Context_WL *ctx,
+                                                                uint64_t native_ns) {
+  if (ctx->presentation_clock_id == CLOCK_MONOTONIC) {
+    return native_ns;
+  }
+
+  // Rebase foreign clocks (e.g. CLOCK_MONOTONIC_RAW) through a paired sample.
+  struct timespec ts;
+  if (clock_gettime(ctx->presentation_clock_id, &ts) != 0) {
+    return 0;
+  }
+  const uint64_t native_now_ns =
+      (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+  const uint64_t now_ns = _maru_linux_get_monotonic_time_ns();
+  if (native_ns > native_now_ns) {
+    return now_ns;
+  }
+  const uint64_t age_ns = native_now_ns - native_ns;
+  return (age_ns < now_ns) ? now_ns - age_ns : 0;
+}
+
+static void _wp_presentation_feedback_handle_sync_output(
+    void *data, struct wp_presentation_feedback *feedback, struct wl_output *output) {
+  (void)data; (void)feedback; (void)output;
+}
+
+static void _wp_presentation_feedback_handle_presented(
+    void *data, struct wp_presentation_feedback *feedback, uint32_t tv_sec_hi,
+    uint32_t tv_sec_lo, uint32_t tv_nsec, uint32_t refresh, uint32_t seq_hi,
+    uint32_t seq_lo, uint32_t flags) {
+  MARU_Window_WL *window = (MARU_Window_WL *)data;
+  MARU_Context_WL *ctx = (MARU_Context_WL *)window->base.ctx_base;
+  (void)flags;
+
+  const uint64_t tv_sec = ((uint64_t)tv_sec_hi << 32) | (uint64_t)tv_sec_lo;
+  window->presentation.last_ns = _maru_wayland_presentation_time_to_monotonic_ns(
+      ctx, tv_sec * 1000000000ULL + (uint64_t)tv_nsec);
+  window->presentation.msc = ((uint64_t)seq_hi << 32) | (uint64_t)seq_lo;
+  window->presentation.refresh_ns = refresh;
+
+  window->presentation.feedback = NULL;
+  maru_wp_presentation_feedback_destroy(ctx, feedback);
+}
+
+static void _wp_presentation_feedback_handle_discarded(
+    void *data, struct wp_presentation_feedback *feedback) {
+  MARU_Window_WL *window = (MARU_Window_WL *)data;
+  MARU_Context_WL *ctx = (MARU_Context_WL *)window->base.ctx_base;
+
+  window->presentation.feedback = NULL;
+  maru_wp_presentation_feedback_destroy(ctx, feedback);
+}
+
+static const struct wp_presentation_feedback_listener _maru_wayland_presentation_feedback_listener = {
+    .sync_output = _wp_presentation_feedback_handle_sync_output,
+    .presented = _wp_presentation_feedback_handle_presented,
+    .discarded = _wp_presentation_feedback_handle_discarded,
+};
+
+static void _maru_wayland_request_presentation_feedback(MARU_Window_WL *window) {
+  MARU_Context_WL *ctx = (MARU_Context_WL *)window->base.ctx_base;
+  struct wp_presentation *presentation = ctx->protocols.opt.wp_presentation;
+  if (!presentation || window->presentation.feedback) {
+    return;
+  }
+
+  window->presentation.feedback =
+      maru_wp_presentation_feedback(ctx, presentation, window->wl.surface);
+  if (window->presentation.feedback) {
+    maru_wp_presentation_feedback_add_listener(
+        ctx, window->presentation.feedback,
+        &_maru_wayland_presentation_feedback_listener, window);
+  }
+}
+
 void _maru_wayland_request_frame(MARU_Window_WL *window) {
   if (!window || !window->wl.surface || window->wl.frame_callback) {
     return;
@@ -493,6 +571,10 @@ void _maru_wayland_request_frame(MARU_Window_WL *window) {
   maru_wl_callback_add_listener(ctx, window->wl.frame_callback,
                                 &_maru_wayland_frame_listener, window);
   maru_wl_surface_commit(ctx, window->wl.surface);
+
+  // Requested after our own commit so it tracks the renderer's next content
+  // commit rather than the empty one above.
+  _maru_wayland_request_presentation_feedback(window);
 }
 
 bool _maru_wayland_create_xdg_shell_objects(MARU_Window_WL *window,
@@ -1011,6 +1093,10 @@ MARU_Status maru_destroyWindow_WL(MARU_Window *window_handle) {
     maru_wl_callback_destroy(ctx, window->wl.frame_callback);
     window->wl.frame_callback = NULL;
   }
+  if (window->presentation.feedback) {
+    maru_wp_presentation_feedback_destroy(ctx, window->presentation.feedback);
+    window->presentation.feedback = NULL;
+  }
 
   if (window->decor_mode == MARU_WAYLAND_DECORATION_STRATEGY_CSD) {
     _maru_wayland_destroy_libdecor_frame(window);
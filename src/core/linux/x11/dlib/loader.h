@@ -12,6 +12,7 @@
 #include "xrandr.h"
 #include "xfixes.h"
 #include "xss.h"
+#include "xpresent.h"
 
 struct MARU_Context_Base;
 
@@ -29,5 +30,7 @@ bool maru_load_xfixes_symbols(struct MARU_Context_Base *ctx, MARU_Lib_Xfixes *xf
 void maru_unload_xfixes_symbols(MARU_Lib_Xfixes *xfixes);
 bool maru_load_xss_symbols(struct MARU_Context_Base *ctx, MARU_Lib_Xss *xss);
 void maru_unload_xss_symbols(MARU_Lib_Xss *xss);
+bool maru_load_xpresent_symbols(struct MARU_Context_Base *ctx, MARU_Lib_Xpresent *xpresent);
+void maru_unload_xpresent_symbols(MARU_Lib_Xpresent *xpresent);
 
 #endif
@@ -13,7 +13,8 @@
   MARU_LIB_FN(XFixesQueryVersion)     \
   MARU_LIB_FN(XFixesCreatePointerBarrier) \
   MARU_LIB_FN(XFixesDestroyPointerBarrier) \
-  MARU_LIB_FN(XFixesSetWindowShapeRegion)
+  MARU_LIB_FN(XFixesSetWindowShapeRegion) \
+  MARU_LIB_FN(XFixesSelectSelectionInput)
 
 typedef struct MARU_Lib_Xfixes {
   MARU_External_Lib_Base base;
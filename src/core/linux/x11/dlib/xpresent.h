@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+#ifndef MARU_X11_DLIB_XPRESENT_H_INCLUDED
+#define MARU_X11_DLIB_XPRESENT_H_INCLUDED
+
+#include "maru_internal.h"
+#include <X11/Xlib.h>
+#include <X11/extensions/presenttokens.h>
+#include <stdint.h>
+
+extern Bool XPresentQueryExtension(Display *display, int *major_opcode_return,
+                                   int *event_base_return,
+                                   int *error_base_return);
+extern XID XPresentSelectInput(Display *display, Window window,
+                               unsigned event_mask);
+extern void XPresentFreeInput(Display *display, Window window, XID event_id);
+extern void XPresentNotifyMSC(Display *display, Window window, uint32_t serial,
+                              uint64_t target_msc, uint64_t divisor,
+                              uint64_t remainder);
+
+// Mirrors XPresentCompleteNotifyEvent from <X11/extensions/Xpresent.h>, which
+// is not required at build time.
+typedef struct MARU_XPresentCompleteNotifyEvent {
+  int type;
+  unsigned long serial;
+  Bool send_event;
+  Display *display;
+  int extension;
+  int evtype;
+  XID eid;
+  Window window;
+  uint32_t serial_number;
+  uint64_t ust;
+  uint64_t msc;
+  uint8_t kind;
+  uint8_t mode;
+} MARU_XPresentCompleteNotifyEvent;
+
+#define MARU_XPRESENT_FUNCTIONS_TABLE  \
+  MARU_LIB_FN(XPresentQueryExtension)  \
+  MARU_LIB_FN(XPresentSelectInput)     \
+  MARU_LIB_FN(XPresentFreeInput)       \
+  MARU_LIB_FN(XPresentNotifyMSC)
+
+typedef struct MARU_Lib_Xpresent {
+  MARU_External_Lib_Base base;
+#define MARU_LIB_FN(name) __typeof__(name) *name;
+  MARU_XPRESENT_FUNCTIONS_TABLE
+#undef MARU_LIB_FN
+} MARU_Lib_Xpresent;
+
+#endif
@@ -18,7 +18,10 @@
   MARU_LIB_FN(XRRGetCrtcInfo)            \
   MARU_LIB_FN(XRRFreeCrtcInfo)           \
   MARU_LIB_FN(XRRGetOutputPrimary)       \
-  MARU_LIB_FN(XRRSetCrtcConfig)
+  MARU_LIB_FN(XRRSetCrtcConfig)          \
+  MARU_LIB_FN(XRRQueryExtension)         \
+  MARU_LIB_FN(XRRSelectInput)            \
+  MARU_LIB_FN(XRRUpdateConfiguration)
 
 typedef struct MARU_Lib_Xrandr {
   MARU_External_Lib_Base base;
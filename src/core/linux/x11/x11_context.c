@@ -7,7 +7,6 @@
 #include "maru_internal.h"
 #include "maru_mem_internal.h"
 #include "x11_internal.h"
-#include <limits.h>
 #include <poll.h>
 #include <stdatomic.h>
 #include <stdlib.h>
@@ -123,6 +122,7 @@ MARU_Status maru_createContext_X11(const MARU_ContextCreateInfo *create_info,
   (void)maru_load_xrandr_symbols(&ctx->base, &ctx->xrandr_lib);
   (void)maru_load_xfixes_symbols(&ctx->base, &ctx->xfixes_lib);
   (void)maru_load_xss_symbols(&ctx->base, &ctx->xss_lib);
+  (void)maru_load_xpresent_symbols(&ctx->base, &ctx->xpresent_lib);
 
   ctx->display = ctx->x11_lib.XOpenDisplay(NULL);
   if (!ctx->display) {
@@ -132,6 +132,7 @@ MARU_Status maru_createContext_X11(const MARU_ContextCreateInfo *create_info,
     maru_unload_xi2_symbols(&ctx->xi2_lib);
     maru_unload_xcursor_symbols(&ctx->xcursor_lib);
     maru_unload_xss_symbols(&ctx->xss_lib);
+    maru_unload_xpresent_symbols(&ctx->xpresent_lib);
     maru_unload_x11_symbols(&ctx->x11_lib);
     _maru_cleanup_context_base(&ctx->base);
     maru_context_free(&ctx->base, ctx);
@@ -224,6 +225,14 @@ MARU_Status maru_createContext_X11(const MARU_ContextCreateInfo *create_info,
       ctx->x11_lib.XInternAtom(ctx->display, "XdndActionMove", False);
   ctx->xdnd_action_link =
       ctx->x11_lib.XInternAtom(ctx->display, "XdndActionLink", False);
+  ctx->present_available = false;
+  if (ctx->xpresent_lib.base.available) {
+    int present_event_base = 0;
+    int present_error_base = 0;
+    ctx->present_available = ctx->xpresent_lib.XPresentQueryExtension(
+                                 ctx->display, &ctx->present_opcode,
+                                 &present_event_base, &present_error_base) != False;
+  }
   ctx->compositor_supports_extended_frame_sync = false;
   if (ctx->net_supported != None && ctx->net_wm_frame_drawn != None &&
       ctx->net_wm_frame_timings != None) {
@@ -252,8 +261,10 @@ MARU_Status maru_createContext_X11(const MARU_ContextCreateInfo *create_info,
       ctx->x11_lib.XFree(prop);
     }
   }
+  _maru_x11_init_monitor_events(ctx);
   (void)_maru_x11_enable_xi2_raw_motion(ctx);
   _maru_x11_detect_pointer_barrier_support(ctx);
+  _maru_x11_init_selection_events(ctx);
 
   if (!_maru_linux_common_init(&ctx->linux_common, &ctx->base)) {
     if (ctx->xim) {
@@ -267,6 +278,7 @@ MARU_Status maru_createContext_X11(const MARU_ContextCreateInfo *create_info,
     maru_unload_xi2_symbols(&ctx->xi2_lib);
     maru_unload_xcursor_symbols(&ctx->xcursor_lib);
     maru_unload_xss_symbols(&ctx->xss_lib);
+    maru_unload_xpresent_symbols(&ctx->xpresent_lib);
     maru_unload_x11_symbols(&ctx->x11_lib);
     _maru_cleanup_context_base(&ctx->base);
     maru_context_free(&ctx->base, ctx);
@@ -302,6 +314,8 @@ void maru_destroyContext_X11(MARU_Context *context) {
 
   _maru_linux_common_cleanup(&ctx->linux_common);
   _maru_x11_clear_mime_query_cache(ctx);
+  _maru_x11_clear_selection_targets(ctx, &ctx->clipboard_targets);
+  _maru_x11_clear_selection_targets(ctx, &ctx->primary_targets);
   _maru_x11_clear_pending_request(ctx, &ctx->clipboard_request);
   _maru_x11_clear_pending_request(ctx, &ctx->primary_request);
   _maru_x11_clear_pending_request(ctx, &ctx->dnd_request);
@@ -354,6 +368,7 @@ void maru_destroyContext_X11(MARU_Context *context) {
   maru_unload_xcursor_symbols(&ctx->xcursor_lib);
   maru_unload_xi2_symbols(&ctx->xi2_lib);
   maru_unload_xss_symbols(&ctx->xss_lib);
+  maru_unload_xpresent_symbols(&ctx->xpresent_lib);
   maru_unload_x11_symbols(&ctx->x11_lib);
 
   _maru_cleanup_context_base(&ctx->base);
@@ -515,25 +530,18 @@ MARU_Scalar _maru_x11_get_global_scale(MARU_Context_X11 *ctx) {
   return (fallback > (MARU_Scalar)0.0) ? fallback : (MARU_Scalar)1.0;
 }
 
-static int _maru_x11_compute_poll_timeout_ms(MARU_Context_X11 *ctx,
-                                             uint32_t timeout_ms) {
-  const uint64_t now_ms = _maru_x11_get_monotonic_time_ms();
-  uint32_t effective_timeout = timeout_ms;
-  if (now_ms != 0u) {
-    effective_timeout =
-        _maru_adjust_timeout_for_cursor_animation(&ctx->base, timeout_ms, now_ms);
-  }
-
-  if (effective_timeout == MARU_NEVER) {
-    return -1;
-  }
-  if (effective_timeout > (uint32_t)INT_MAX) {
-    return INT_MAX;
-  }
-  return (int)effective_timeout;
+static uint64_t _maru_x11_compute_poll_deadline_ns(MARU_Context_X11 *ctx,
+                                                   uint64_t deadline_ns) {
+  return _maru_adjust_deadline_for_cursor_animation(&ctx->base, deadline_ns);
 }
 
 void _maru_x11_process_event(MARU_Context_X11 *ctx, XEvent *ev) {
+  if (ev->type == GenericEvent && ctx->present_available &&
+      ev->xcookie.extension == ctx->present_opcode) {
+    _maru_x11_process_present_event(ctx, ev);
+    return;
+  }
+
   if (ev->type == GenericEvent && ctx->xi2_raw_motion_enabled &&
       ev->xcookie.extension == ctx->xi2_opcode &&
       ctx->x11_lib.XGetEventData(ctx->display, &ev->xcookie)) {
@@ -560,17 +568,6 @@ void _maru_x11_process_event(MARU_Context_X11 *ctx, XEvent *ev) {
         }
         if (raw_dx != (MARU_Scalar)0.0 || raw_dy != (MARU_Scalar)0.0) {
           if (locked_window->lock_pointer_barriers_active) {
-            unsigned int state = 0u;
-            Window root_ret = 0;
-            Window child_ret = 0;
-            int root_x = 0;
-            int root_y = 0;
-            int win_x = 0;
-            int win_y = 0;
-            (void)ctx->x11_lib.XQueryPointer(
-                ctx->display, locked_window->handle, &root_ret, &child_ret,
-                &root_x, &root_y, &win_x, &win_y, &state);
-
             MARU_Event mevt = {0};
             mevt.mouse_moved.dip_position.x =
                 (MARU_Scalar)ctx->linux_common.pointer.x;
@@ -580,7 +577,10 @@ void _maru_x11_process_event(MARU_Context_X11 *ctx, XEvent *ev) {
             mevt.mouse_moved.dip_delta.y = raw_dy;
             mevt.mouse_moved.raw_dip_delta.x = raw_dx;
             mevt.mouse_moved.raw_dip_delta.y = raw_dy;
-            mevt.mouse_moved.modifiers = _maru_x11_get_modifiers(state);
+            mevt.mouse_moved.modifiers =
+                _maru_x11_get_modifiers(ctx->input_state);
+            mevt.mouse_moved.timestamp_ns =
+                _maru_linux_map_input_time_ms((uint32_t)raw->time);
             ctx->linux_common.pointer.focused_window =
                 (MARU_Window *)locked_window;
             _maru_x11_clear_locked_raw_accum(ctx);
@@ -593,10 +593,19 @@ void _maru_x11_process_event(MARU_Context_X11 *ctx, XEvent *ev) {
           }
         }
       }
+    } else if (ev->xcookie.evtype == XI_Motion ||
+               ev->xcookie.evtype == XI_ButtonPress ||
+               ev->xcookie.evtype == XI_ButtonRelease) {
+      const XIDeviceEvent *dev = (const XIDeviceEvent *)ev->xcookie.data;
+      if (dev) {
+        (void)_maru_x11_process_xi2_pointer_event(ctx, dev);
+      }
     }
     ctx->x11_lib.XFreeEventData(ctx->display, &ev->xcookie);
   }
 
+  if (_maru_x11_process_monitor_event(ctx, ev))
+    return;
   if (_maru_x11_process_window_event(ctx, ev))
     return;
   if (_maru_x11_process_input_event(ctx, ev))
@@ -622,6 +631,14 @@ static bool _maru_x11_pop_next_event(MARU_Context_X11 *ctx, XEvent *out_ev) {
 MARU_Status maru_pumpEvents_X11(MARU_Context *context, uint32_t timeout_ms,
                                 MARU_EventMask mask,
                                 MARU_EventCallback callback, void *userdata) {
+  const uint64_t deadline_ns = _maru_timeout_ms_to_deadline_ns(
+      timeout_ms, _maru_linux_get_monotonic_time_ns());
+  return maru_pumpEventsUntil_X11(context, deadline_ns, mask, callback, userdata);
+}
+
+MARU_Status maru_pumpEventsUntil_X11(MARU_Context *context, uint64_t deadline_ns,
+                                     MARU_EventMask mask,
+                                     MARU_EventCallback callback, void *userdata) {
   MARU_Context_X11 *ctx = (MARU_Context_X11 *)context;
   const uint64_t pump_start_ns = _maru_linux_get_monotonic_time_ns();
   MARU_PumpContext pump_ctx = {.mask = mask, .callback = callback, .userdata = userdata};
@@ -641,6 +658,7 @@ MARU_Status maru_pumpEvents_X11(MARU_Context *context, uint32_t timeout_ms,
       _maru_x11_process_event(ctx, &ev);
     }
   }
+  _maru_x11_dispatch_monitor_changes(ctx);
 
   {
     const uint64_t now_ms = _maru_x11_get_monotonic_time_ms();
@@ -667,8 +685,9 @@ MARU_Status maru_pumpEvents_X11(MARU_Context *context, uint32_t timeout_ms,
   uint32_t ctrl_start_idx = nfds;
   nfds += ctrl_count;
 
-  int poll_timeout = _maru_x11_compute_poll_timeout_ms(ctx, timeout_ms);
-  int ret = poll(pfds, nfds, poll_timeout);
+  const uint64_t poll_deadline_ns =
+      _maru_x11_compute_poll_deadline_ns(ctx, deadline_ns);
+  int ret = _maru_linux_poll_until(pfds, nfds, poll_deadline_ns);
 
   if (ret > 0) {
     if (pfds[0].revents & POLLIN) {
@@ -694,6 +713,7 @@ MARU_Status maru_pumpEvents_X11(MARU_Context *context, uint32_t timeout_ms,
       _maru_x11_process_event(ctx, &ev);
     }
   }
+  _maru_x11_dispatch_monitor_changes(ctx);
 
   {
     const uint64_t now_ms = _maru_x11_get_monotonic_time_ms();
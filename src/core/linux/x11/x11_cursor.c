@@ -169,6 +169,7 @@ bool _maru_x11_apply_window_cursor_mode(MARU_Context_X11 *ctx, MARU_Window_X11 *
         }
         ctx->locked_window = win;
         _maru_x11_clear_locked_raw_accum(ctx);
+        _maru_x11_refresh_input_state(ctx, win->handle);
       }
       (void)_maru_x11_create_pointer_barriers(ctx, win);
     } else {
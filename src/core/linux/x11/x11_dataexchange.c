@@ -5,9 +5,7 @@
 #include "maru_api_constraints.h"
 #include "maru_mem_internal.h"
 #include "x11_internal.h"
-#include <errno.h>
 #include <limits.h>
-#include <poll.h>
 #include <string.h>
 
 Atom _maru_x11_target_to_selection_atom(const MARU_Context_X11 *ctx,
@@ -77,19 +75,11 @@ MARU_X11DataRequestPending *_maru_x11_get_pending_request(
 }
 
 void _maru_x11_clear_mime_query_cache(MARU_Context_X11 *ctx) {
-  if (ctx->clipboard_mime_query_storage) {
-    maru_context_free(&ctx->base, ctx->clipboard_mime_query_storage);
-    ctx->clipboard_mime_query_storage = NULL;
-  }
   if (ctx->clipboard_mime_query_ptr) {
     maru_context_free(&ctx->base, (void *)ctx->clipboard_mime_query_ptr);
     ctx->clipboard_mime_query_ptr = NULL;
     ctx->clipboard_mime_query_count = 0;
   }
-  if (ctx->primary_mime_query_storage) {
-    maru_context_free(&ctx->base, ctx->primary_mime_query_storage);
-    ctx->primary_mime_query_storage = NULL;
-  }
   if (ctx->primary_mime_query_ptr) {
     maru_context_free(&ctx->base, (void *)ctx->primary_mime_query_ptr);
     ctx->primary_mime_query_ptr = NULL;
@@ -106,79 +96,79 @@ void _maru_x11_clear_mime_query_cache(MARU_Context_X11 *ctx) {
   }
 }
 
-typedef struct MARU_X11SelectionNotifyMatch {
-  Window requestor;
-  Atom selection;
-  Atom property;
-} MARU_X11SelectionNotifyMatch;
-
-static int _maru_x11_selection_notify_matches(Display *display, XEvent *ev,
-                                              XPointer arg) {
-  (void)display;
-  const MARU_X11SelectionNotifyMatch *match =
-      (const MARU_X11SelectionNotifyMatch *)arg;
-  if (!ev || !match || ev->type != SelectionNotify) {
-    return False;
-  }
-  return ev->xselection.requestor == match->requestor &&
-         ev->xselection.selection == match->selection &&
-         (ev->xselection.property == match->property ||
-          ev->xselection.property == None);
-}
-
-static bool _maru_x11_wait_for_selection_notify(MARU_Context_X11 *ctx,
-                                                Window requestor,
-                                                Atom selection_atom,
-                                                Atom property_atom,
-                                                uint32_t timeout_ms,
-                                                XEvent *out_event) {
-  MARU_X11SelectionNotifyMatch match = {
-      .requestor = requestor,
-      .selection = selection_atom,
-      .property = property_atom,
-  };
-
-  for (;;) {
-    if (!ctx->x11_lib.XCheckIfEvent) {
-      return false;
-    }
-    if (ctx->x11_lib.XCheckIfEvent &&
-        ctx->x11_lib.XCheckIfEvent(ctx->display, out_event,
-                                   _maru_x11_selection_notify_matches,
-                                   (XPointer)&match)) {
-      return true;
-    }
+static MARU_X11SelectionTargetsCache *
+_maru_x11_get_targets_cache(MARU_Context_X11 *ctx, MARU_DataExchangeTarget target) {
+  if (target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD) {
+    return &ctx->clipboard_targets;
+  }
+  if (target == MARU_LINUX_PRIVATE_TARGET_PRIMARY) {
+    return &ctx->primary_targets;
+  }
+  return NULL;
+}
 
-    if (timeout_ms == 0) {
-      return false;
-    }
+void _maru_x11_clear_selection_targets(MARU_Context_X11 *ctx,
+                                       MARU_X11SelectionTargetsCache *cache) {
+  if (cache->storage) {
+    maru_context_free(&ctx->base, cache->storage);
+    cache->storage = NULL;
+  }
+  if (cache->mime_types) {
+    maru_context_free(&ctx->base, (void *)cache->mime_types);
+    cache->mime_types = NULL;
+  }
+  cache->mime_count = 0;
+  cache->valid = false;
+  cache->pending = false;
+  cache->owner = None;
+  cache->requestor = None;
+}
 
-    int poll_timeout = -1;
-    if (timeout_ms != MARU_NEVER) {
-      poll_timeout = (timeout_ms > (uint32_t)INT_MAX) ? INT_MAX : (int)timeout_ms;
-    }
-    if (!ctx->x11_lib.XConnectionNumber) {
-      return false;
-    }
+static Atom _maru_x11_targets_property(const MARU_Context_X11 *ctx) {
+  return ctx->maru_selection_targets_property != None
+             ? ctx->maru_selection_targets_property
+             : ctx->maru_selection_property;
+}
 
-    struct pollfd pfd = {
-        .fd = ctx->x11_lib.XConnectionNumber(ctx->display),
-        .events = POLLIN,
-        .revents = 0,
-    };
+void _maru_x11_init_selection_events(MARU_Context_X11 *ctx) {
+  ctx->xfixes_selection_events_available = false;
+  if (!ctx->xfixes_lib.base.available) {
+    return;
+  }
+  int error_base = 0;
+  if (!ctx->xfixes_lib.XFixesQueryExtension(ctx->display, &ctx->xfixes_event_base,
+                                            &error_base)) {
+    return;
+  }
+  const unsigned long mask = XFixesSetSelectionOwnerNotifyMask |
+                             XFixesSelectionWindowDestroyNotifyMask |
+                             XFixesSelectionClientCloseNotifyMask;
+  ctx->xfixes_lib.XFixesSelectSelectionInput(ctx->display, ctx->root,
+                                             ctx->selection_clipboard, mask);
+  ctx->xfixes_lib.XFixesSelectSelectionInput(ctx->display, ctx->root,
+                                             ctx->selection_primary, mask);
+  ctx->xfixes_selection_events_available = true;
+}
 
-    const int poll_result = poll(&pfd, 1, poll_timeout);
-    if (poll_result > 0) {
-      continue;
-    }
-    if (poll_result == 0) {
-      return false;
-    }
-    if (errno == EINTR) {
-      continue;
-    }
+static bool _maru_x11_process_selection_owner_event(MARU_Context_X11 *ctx,
+                                                    XEvent *ev) {
+  if (!ctx->xfixes_selection_events_available ||
+      ev->type != ctx->xfixes_event_base + XFixesSelectionNotify) {
     return false;
   }
+  const XFixesSelectionNotifyEvent *notify = (const XFixesSelectionNotifyEvent *)ev;
+  MARU_DataExchangeTarget target = MARU_DATA_EXCHANGE_TARGET_CLIPBOARD;
+  if (!_maru_x11_selection_atom_to_target(ctx, notify->selection, &target)) {
+    return true;
+  }
+  MARU_X11SelectionTargetsCache *cache = _maru_x11_get_targets_cache(ctx, target);
+  if (cache) {
+    // Any ownership change, even by the same window, may change the targets.
+    _maru_x11_clear_selection_targets(ctx, cache);
+    cache->owner_time =
+        notify->owner != None ? notify->selection_timestamp : CurrentTime;
+  }
+  return true;
 }
 
 static bool _maru_x11_is_selection_meta_atom(const MARU_Context_X11 *ctx,
@@ -188,9 +178,11 @@ static bool _maru_x11_is_selection_meta_atom(const MARU_Context_X11 *ctx,
          atom == ctx->selection_incr;
 }
 
-static MARU_Status _maru_x11_store_external_mime_query(
-    MARU_Context_X11 *ctx, MARU_DataExchangeTarget target, const Atom *atoms,
-    uint32_t count, MARU_StringList *out_list) {
+// Fills `cache` with the MIME names of `atoms`, minus meta targets and
+// duplicates. Leaves the list empty when nothing usable is left.
+static void _maru_x11_store_selection_targets(MARU_Context_X11 *ctx,
+                                              MARU_X11SelectionTargetsCache *cache,
+                                              const Atom *atoms, uint32_t count) {
   uint32_t kept_count = 0;
   size_t storage_size = 0;
 
@@ -219,9 +211,7 @@ static MARU_Status _maru_x11_store_external_mime_query(
   }
 
   if (kept_count == 0) {
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
+    return;
   }
 
   const char **query =
@@ -234,9 +224,7 @@ static MARU_Status _maru_x11_store_external_mime_query(
     if (storage) {
       maru_context_free(&ctx->base, storage);
     }
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
+    return;
   }
 
   uint32_t out_count = 0;
@@ -272,85 +260,125 @@ static MARU_Status _maru_x11_store_external_mime_query(
   if (out_count == 0) {
     maru_context_free(&ctx->base, storage);
     maru_context_free(&ctx->base, (void *)query);
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
-  }
-
-  if (target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD) {
-    ctx->clipboard_mime_query_storage = storage;
-    ctx->clipboard_mime_query_ptr = query;
-    ctx->clipboard_mime_query_count = out_count;
-    out_list->strings = ctx->clipboard_mime_query_ptr;
-    out_list->count = ctx->clipboard_mime_query_count;
-  } else {
-    ctx->primary_mime_query_storage = storage;
-    ctx->primary_mime_query_ptr = query;
-    ctx->primary_mime_query_count = out_count;
-    out_list->strings = ctx->primary_mime_query_ptr;
-    out_list->count = ctx->primary_mime_query_count;
+    return;
   }
 
-  return MARU_SUCCESS;
+  cache->storage = storage;
+  cache->mime_types = query;
+  cache->mime_count = out_count;
 }
 
+// Never blocks. Returns the cached TARGETS list of `owner` when there is one,
+// empty if the owner offered nothing usable. Otherwise makes sure a conversion
+// is in flight and returns MARU_PENDING; MARU_EVENT_MIME_TYPES_READY follows
+// once the owner answers.
 static MARU_Status _maru_x11_query_external_selection_mime_types(
     MARU_Context_X11 *ctx, MARU_Window_X11 *win, MARU_DataExchangeTarget target,
-    Atom selection_atom, MARU_StringList *out_list) {
+    Atom selection_atom, Window owner, MARU_StringList *out_list) {
   MARU_ASSUME(selection_atom != None);
-  const Atom property_atom = ctx->maru_selection_targets_property != None
-                                 ? ctx->maru_selection_targets_property
-                                 : ctx->maru_selection_property;
-  XEvent notify = {0};
+  out_list->strings = NULL;
+  out_list->count = 0;
 
-  ctx->x11_lib.XDeleteProperty(ctx->display, win->handle, property_atom);
-  ctx->x11_lib.XConvertSelection(ctx->display, selection_atom, ctx->selection_targets,
-                                 property_atom, win->handle, CurrentTime);
-  ctx->x11_lib.XFlush(ctx->display);
+  MARU_X11SelectionTargetsCache *cache = _maru_x11_get_targets_cache(ctx, target);
+  if (!cache) {
+    return MARU_FAILURE;
+  }
+  if ((cache->valid || cache->pending) && cache->owner != owner) {
+    // The owner changed before (or without) an XFixes notification, so its
+    // ownership time is not known yet.
+    _maru_x11_clear_selection_targets(ctx, cache);
+    cache->owner_time = CurrentTime;
+  }
+
+  if (cache->valid) {
+    out_list->strings = cache->mime_types;
+    out_list->count = cache->mime_count;
+    return MARU_SUCCESS;
+  }
 
-  if (!_maru_x11_wait_for_selection_notify(
-          ctx, win->handle, selection_atom, property_atom,
-          ctx->base.tuning.x11.selection_query_timeout_ms, &notify)) {
+  const uint64_t now_ms = _maru_x11_get_monotonic_time_ms();
+  if (cache->pending) {
+    const uint32_t timeout_ms = ctx->base.tuning.x11.selection_query_timeout_ms;
+    if (timeout_ms == 0 || timeout_ms == MARU_NEVER ||
+        now_ms - cache->request_ms < (uint64_t)timeout_ms) {
+      return MARU_PENDING;
+    }
     MARU_REPORT_DIAGNOSTIC(
         (MARU_Context *)ctx, MARU_DIAGNOSTIC_BACKEND_FAILURE,
         "X11 clipboard MIME query timed out while waiting for TARGETS.");
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
   }
 
-  if (notify.xselection.property == None) {
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
+  const Atom property_atom = _maru_x11_targets_property(ctx);
+  ctx->x11_lib.XDeleteProperty(ctx->display, win->handle, property_atom);
+  ctx->x11_lib.XConvertSelection(ctx->display, selection_atom, ctx->selection_targets,
+                                 property_atom, win->handle, cache->owner_time);
+  ctx->x11_lib.XFlush(ctx->display);
+
+  cache->pending = true;
+  cache->owner = owner;
+  cache->requestor = win->handle;
+  cache->request_time = cache->owner_time;
+  cache->request_ms = now_ms;
+  return MARU_PENDING;
+}
+
+// Consumes the SelectionNotify answering an in-flight TARGETS query, if
+// `notify` is one.
+static bool _maru_x11_complete_selection_targets_query(
+    MARU_Context_X11 *ctx, MARU_DataExchangeTarget target,
+    const XSelectionEvent *notify) {
+  MARU_X11SelectionTargetsCache *cache = _maru_x11_get_targets_cache(ctx, target);
+  const Atom property_atom = _maru_x11_targets_property(ctx);
+  if (!cache || notify->target != ctx->selection_targets ||
+      (notify->property != property_atom && notify->property != None)) {
+    return false;
+  }
+  if (!cache->pending || notify->requestor != cache->requestor ||
+      (cache->request_time != CurrentTime && notify->time != cache->request_time)) {
+    // Answer to an abandoned query, or to one issued for a previous owner.
+    // Swallow it unless a data request for TARGETS itself is waiting.
+    const MARU_X11DataRequestPending *request =
+        _maru_x11_get_pending_request(ctx, target);
+    return notify->property == property_atom || !request || !request->pending ||
+           request->target_atom != ctx->selection_targets;
   }
 
-  Atom actual_type = None;
-  int actual_format = 0;
-  unsigned long item_count = 0;
-  unsigned long bytes_after = 0;
-  unsigned char *property_data = NULL;
-  const int xres = ctx->x11_lib.XGetWindowProperty(
-      ctx->display, win->handle, property_atom, 0, 0x1FFFFFFF, True, XA_ATOM,
-      &actual_type, &actual_format, &item_count, &bytes_after, &property_data);
-  (void)bytes_after;
-  if (xres != Success || actual_type != XA_ATOM || actual_format != 32 ||
-      item_count == 0 || !property_data) {
+  cache->pending = false;
+  cache->valid = true;
+  if (notify->property != None) {
+    Atom actual_type = None;
+    int actual_format = 0;
+    unsigned long item_count = 0;
+    unsigned long bytes_after = 0;
+    unsigned char *property_data = NULL;
+    const int xres = ctx->x11_lib.XGetWindowProperty(
+        ctx->display, cache->requestor, property_atom, 0, 0x1FFFFFFF, True,
+        XA_ATOM, &actual_type, &actual_format, &item_count, &bytes_after,
+        &property_data);
+    (void)bytes_after;
+    if (xres == Success && actual_type == XA_ATOM && actual_format == 32 &&
+        item_count > 0 && property_data) {
+      _maru_x11_store_selection_targets(ctx, cache, (const Atom *)property_data,
+                                        (uint32_t)item_count);
+    } else {
+      MARU_REPORT_DIAGNOSTIC(
+          (MARU_Context *)ctx, MARU_DIAGNOSTIC_BACKEND_FAILURE,
+          "X11 clipboard MIME query received an invalid TARGETS reply.");
+    }
     if (property_data) {
       ctx->x11_lib.XFree(property_data);
     }
-    MARU_REPORT_DIAGNOSTIC(
-        (MARU_Context *)ctx, MARU_DIAGNOSTIC_BACKEND_FAILURE,
-        "X11 clipboard MIME query received an invalid TARGETS reply.");
-    out_list->strings = NULL;
-    out_list->count = 0;
-    return MARU_FAILURE;
   }
 
-  const MARU_Status status = _maru_x11_store_external_mime_query(
-      ctx, target, (const Atom *)property_data, (uint32_t)item_count, out_list);
-  ctx->x11_lib.XFree(property_data);
-  return status;
+  // PRIMARY is private to the backend and has no public event target.
+  if (target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD) {
+    MARU_Event evt = {0};
+    evt.mime_types_ready.target = target;
+    evt.mime_types_ready.mime_types.strings = cache->mime_types;
+    evt.mime_types_ready.mime_types.count = cache->mime_count;
+    _maru_dispatch_event(&ctx->base, MARU_EVENT_MIME_TYPES_READY, NULL, &evt);
+  }
+  return true;
 }
 
 void _maru_x11_clear_offer(MARU_Context_X11 *ctx, MARU_X11DataOffer *offer) {
@@ -394,6 +422,8 @@ void _maru_x11_clear_pending_request(MARU_Context_X11 *ctx,
   }
   request->incr_size = 0;
   request->incr_capacity = 0;
+  request->stream = false;
+  request->streamed = 0;
   request->userdata = NULL;
 }
 
@@ -992,6 +1022,20 @@ static void _maru_x11_dispatch_data_received(MARU_Context_X11 *ctx,
       (target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD) ? NULL
                                                       : (MARU_Window *)request->window;
   MARU_Event evt = {0};
+  if (request->stream) {
+    // A streamed request ends with its final chunk, never a DATA_RECEIVED.
+    evt.data_chunk_received.userdata = request->userdata;
+    evt.data_chunk_received.status = status;
+    evt.data_chunk_received.target = target;
+    evt.data_chunk_received.mime_type = request->mime_type ? request->mime_type : "";
+    evt.data_chunk_received.data = data;
+    evt.data_chunk_received.size = size;
+    evt.data_chunk_received.offset = request->streamed;
+    evt.data_chunk_received.is_final = true;
+    _maru_dispatch_event(&ctx->base, MARU_EVENT_DATA_CHUNK_RECEIVED, event_window,
+                         &evt);
+    return;
+  }
   evt.data_received.userdata = request->userdata;
   evt.data_received.status = status;
   evt.data_received.target = target;
@@ -1147,6 +1191,27 @@ static bool _maru_x11_append_incr_data(MARU_Context_X11 *ctx,
   return true;
 }
 
+static void _maru_x11_dispatch_incr_chunk(MARU_Context_X11 *ctx,
+                                          MARU_X11DataRequestPending *request,
+                                          MARU_DataExchangeTarget target,
+                                          const void *data, size_t size) {
+  MARU_Event evt = {0};
+  evt.data_chunk_received.userdata = request->userdata;
+  evt.data_chunk_received.status = MARU_SUCCESS;
+  evt.data_chunk_received.target = target;
+  evt.data_chunk_received.mime_type = request->mime_type ? request->mime_type : "";
+  evt.data_chunk_received.data = data;
+  evt.data_chunk_received.size = size;
+  evt.data_chunk_received.offset = request->streamed;
+  evt.data_chunk_received.is_final = false;
+  _maru_dispatch_event(&ctx->base, MARU_EVENT_DATA_CHUNK_RECEIVED,
+                       (target == MARU_DATA_EXCHANGE_TARGET_CLIPBOARD)
+                           ? NULL
+                           : (MARU_Window *)request->window,
+                       &evt);
+  request->streamed += size;
+}
+
 static bool _maru_x11_process_incr_property_notify(MARU_Context_X11 *ctx,
                                                    const XPropertyEvent *prop) {
   if (!prop || prop->state != PropertyNewValue) {
@@ -1207,6 +1272,13 @@ static bool _maru_x11_process_incr_property_notify(MARU_Context_X11 *ctx,
       return true;
     }
 
+    if (request->stream) {
+      // The owner bounds each INCR chunk, so nothing accumulates on our side.
+      _maru_x11_dispatch_incr_chunk(ctx, request, target, property_data, chunk_size);
+      ctx->x11_lib.XFree(property_data);
+      return true;
+    }
+
     const bool ok = _maru_x11_append_incr_data(ctx, request, property_data,
                                                chunk_size);
     if (property_data) {
@@ -1462,7 +1534,8 @@ MARU_Status _maru_x11_announceData(MARU_Window *window,
 
 MARU_Status _maru_x11_requestData(MARU_Window *window,
                                   MARU_DataExchangeTarget target,
-                                  const char *mime_type, void *userdata) {
+                                  const char *mime_type, void *userdata,
+                                  bool stream) {
   MARU_Window_X11 *win = (MARU_Window_X11 *)window;
   MARU_Context_X11 *ctx = (MARU_Context_X11 *)win->base.ctx_base;
   if (target == MARU_DATA_EXCHANGE_TARGET_DRAG_DROP) {
@@ -1493,6 +1566,8 @@ MARU_Status _maru_x11_requestData(MARU_Window *window,
   request->target_atom = target_atom;
   request->property_atom = None;
   request->incr_active = false;
+  request->stream = stream;
+  request->streamed = 0;
   request->userdata = userdata;
   Time request_time = CurrentTime;
   if (target == MARU_DATA_EXCHANGE_TARGET_DRAG_DROP &&
@@ -1578,8 +1653,8 @@ MARU_Status _maru_x11_getAvailableMIMETypes(const MARU_Window *window,
   }
 
   if (owner != None) {
-    return _maru_x11_query_external_selection_mime_types(ctx, win, target,
-                                                         selection_atom, out_list);
+    return _maru_x11_query_external_selection_mime_types(
+        ctx, win, target, selection_atom, owner, out_list);
   }
 
   out_list->strings = NULL;
@@ -1720,6 +1795,12 @@ void _maru_x11_clear_window_dataexchange_refs(MARU_Context_X11 *ctx, MARU_Window
   if (ctx->dnd_request.pending && ctx->dnd_request.window == win) {
     _maru_x11_clear_pending_request(ctx, &ctx->dnd_request);
   }
+  if (ctx->clipboard_targets.pending && ctx->clipboard_targets.requestor == win->handle) {
+    ctx->clipboard_targets.pending = false;
+  }
+  if (ctx->primary_targets.pending && ctx->primary_targets.requestor == win->handle) {
+    ctx->primary_targets.pending = false;
+  }
   if (ctx->dnd_session.active && ctx->dnd_session.target_window == win) {
     _maru_x11_send_xdnd_finished(ctx, &ctx->dnd_session, false);
     _maru_x11_clear_dnd_session(ctx);
@@ -1755,6 +1836,9 @@ void _maru_x11_process_selection_notify(MARU_Context_X11 *ctx, XEvent *ev) {
   if (!_maru_x11_selection_atom_to_target(ctx, notify->selection, &target)) {
     return;
   }
+  if (_maru_x11_complete_selection_targets_query(ctx, target, notify)) {
+    return;
+  }
   MARU_X11DataRequestPending *request =
       _maru_x11_get_pending_request(ctx, target);
   if (!request || !request->pending || !request->window ||
@@ -1818,8 +1902,9 @@ maru_provideData_X11(MARU_DataRequest *request, const void *data,
 
 MARU_Status maru_requestData_X11(MARU_Window *window,
                                         MARU_DataExchangeTarget target,
-                                        const char *mime_type, void *userdata) {
-  return _maru_x11_requestData(window, target, mime_type, userdata);
+                                        const char *mime_type, void *userdata,
+                                        bool stream) {
+  return _maru_x11_requestData(window, target, mime_type, userdata, stream);
 }
 
 MARU_Status maru_getAvailableMIMETypes_X11(
@@ -1829,6 +1914,9 @@ MARU_Status maru_getAvailableMIMETypes_X11(
 }
 
 bool _maru_x11_process_dataexchange_event(MARU_Context_X11 *ctx, XEvent *ev) {
+  if (_maru_x11_process_selection_owner_event(ctx, ev)) {
+    return true;
+  }
   switch (ev->type) {
     case SelectionRequest: {
       const XSelectionRequestEvent *req = &ev->xselectionrequest;
@@ -2176,7 +2264,8 @@ bool _maru_x11_process_dataexchange_event(MARU_Context_X11 *ctx, XEvent *ev) {
           if (session->selected_mime &&
               _maru_x11_requestData((MARU_Window *)session->target_window,
                                     MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
-                                    session->selected_mime, (void *)1) ==
+                                    session->selected_mime, (void *)1,
+                                    false) ==
                   MARU_SUCCESS) {
             return true;
           }
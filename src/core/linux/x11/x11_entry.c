@@ -58,15 +58,27 @@ static MARU_Status maru_announceClipboardData_X11_ctx(MARU_Context *context,
                                mime_types, 0);
 }
 
-static MARU_Status maru_requestClipboardData_X11_ctx(MARU_Context *context,
-                                                     const char *mime_type,
-                                                     void *userdata) {
+static MARU_Status _maru_requestClipboardData_X11(MARU_Context *context,
+                                                  const char *mime_type,
+                                                  void *userdata, bool stream) {
   MARU_Window_X11 *win = maru_getClipboardWindow_X11(context);
   if (!win) {
     return MARU_FAILURE;
   }
   return maru_requestData_X11((MARU_Window *)win, MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
-                              mime_type, userdata);
+                              mime_type, userdata, stream);
+}
+
+static MARU_Status maru_requestClipboardData_X11_ctx(MARU_Context *context,
+                                                     const char *mime_type,
+                                                     void *userdata) {
+  return _maru_requestClipboardData_X11(context, mime_type, userdata, false);
+}
+
+static MARU_Status maru_requestClipboardDataStream_X11_ctx(MARU_Context *context,
+                                                           const char *mime_type,
+                                                           void *userdata) {
+  return _maru_requestClipboardData_X11(context, mime_type, userdata, true);
 }
 
 static MARU_Status
@@ -94,7 +106,14 @@ static MARU_Status maru_requestDropData_X11_win(MARU_Window *window,
                                                 const char *mime_type,
                                                 void *userdata) {
   return maru_requestData_X11(window, MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
-                              mime_type, userdata);
+                              mime_type, userdata, false);
+}
+
+static MARU_Status maru_requestDropDataStream_X11_win(MARU_Window *window,
+                                                      const char *mime_type,
+                                                      void *userdata) {
+  return maru_requestData_X11(window, MARU_DATA_EXCHANGE_TARGET_DRAG_DROP,
+                              mime_type, userdata, true);
 }
 
 static MARU_Status
@@ -113,6 +132,7 @@ const MARU_Backend maru_backend_X11 = {
   .destroyContext = maru_destroyContext_X11,
   .updateContext = maru_updateContext_X11,
   .pumpEvents = maru_pumpEvents_X11,
+  .pumpEventsUntil = maru_pumpEventsUntil_X11,
   .wakeContext = maru_wakeContext_X11,
   .createWindow = maru_createWindow_X11,
   .destroyWindow = maru_destroyWindow_X11,
@@ -133,6 +153,8 @@ const MARU_Backend maru_backend_X11 = {
   .provideData = maru_provideData_X11,
   .requestClipboardData = maru_requestClipboardData_X11_ctx,
   .requestDropData = maru_requestDropData_X11_win,
+  .requestClipboardDataStream = maru_requestClipboardDataStream_X11_ctx,
+  .requestDropDataStream = maru_requestDropDataStream_X11_win,
   .getAvailableClipboardMIMETypes = maru_getAvailableClipboardMIMETypes_X11_ctx,
   .getAvailableDropMIMETypes = maru_getAvailableDropMIMETypes_X11_win,
   .getMonitors = maru_getMonitors_X11,
@@ -171,6 +193,18 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context *context, uint32_t timeout_ms,
   return maru_pumpEvents_X11(context, timeout_ms, mask, callback, userdata);
 }
 
+MARU_API MARU_Status maru_pumpEventsUntil(MARU_Context *context,
+                                          uint64_t deadline_ns,
+                                          MARU_EventMask mask,
+                                          MARU_EventCallback callback,
+                                          void *userdata) {
+  MARU_API_VALIDATE(pumpEventsUntil, context, deadline_ns, mask, callback,
+                    userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  return maru_pumpEventsUntil_X11(context, deadline_ns, mask, callback,
+                                  userdata);
+}
+
 MARU_API MARU_Status maru_createWindow(MARU_Context *context,
                                        const MARU_WindowCreateInfo *create_info,
                                        MARU_Window **out_window) {
@@ -285,6 +319,30 @@ MARU_API MARU_Status maru_provideDropData(MARU_DataRequest *request,
   return maru_provideData_X11(request, data, size, flags);
 }
 
+// Selections travel through window properties, not pipes, so there is
+// nothing for the kernel to splice into.
+MARU_API MARU_Status maru_provideClipboardDataFromFd(MARU_DataRequest *request,
+                                                     int fd, uint64_t offset,
+                                                     uint64_t size) {
+  MARU_API_VALIDATE(provideClipboardDataFromFd, request, fd, offset, size);
+  (void)request;
+  (void)fd;
+  (void)offset;
+  (void)size;
+  return MARU_FAILURE;
+}
+
+MARU_API MARU_Status maru_provideDropDataFromFd(MARU_DataRequest *request,
+                                                int fd, uint64_t offset,
+                                                uint64_t size) {
+  MARU_API_VALIDATE(provideDropDataFromFd, request, fd, offset, size);
+  (void)request;
+  (void)fd;
+  (void)offset;
+  (void)size;
+  return MARU_FAILURE;
+}
+
 MARU_API MARU_Status maru_requestClipboardData(MARU_Context *context,
                                                const char *mime_type,
                                                void *userdata) {
@@ -303,6 +361,24 @@ MARU_API MARU_Status maru_requestDropData(MARU_Window *window,
   return maru_requestDropData_X11_win(window, mime_type, userdata);
 }
 
+MARU_API MARU_Status maru_requestClipboardDataStream(MARU_Context *context,
+                                                     const char *mime_type,
+                                                     void *userdata) {
+  MARU_API_VALIDATE(requestClipboardDataStream, context, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  MARU_API_VALIDATE_LIVE(requestClipboardDataStream, context, mime_type, userdata);
+  return maru_requestClipboardDataStream_X11_ctx(context, mime_type, userdata);
+}
+
+MARU_API MARU_Status maru_requestDropDataStream(MARU_Window *window,
+                                                const char *mime_type,
+                                                void *userdata) {
+  MARU_API_VALIDATE(requestDropDataStream, window, mime_type, userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_window_context_lost(window));
+  MARU_API_VALIDATE_LIVE(requestDropDataStream, window, mime_type, userdata);
+  return maru_requestDropDataStream_X11_win(window, mime_type, userdata);
+}
+
 MARU_API MARU_Status maru_getAvailableClipboardMIMETypes(
     const MARU_Context *context, MARU_StringList *out_list) {
   MARU_API_VALIDATE(getAvailableClipboardMIMETypes, context, out_list);
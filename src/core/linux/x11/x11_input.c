@@ -62,6 +62,80 @@ bool _maru_x11_enable_xi2_raw_motion(MARU_Context_X11 *ctx) {
   return true;
 }
 
+// Pointer events on our windows come through XI2 when it is available, so
+// they carry the device event time. Keys stay on core events, which XIM
+// filtering and the autorepeat lookahead depend on.
+bool _maru_x11_select_xi2_pointer_events(MARU_Context_X11 *ctx, Window window) {
+  if (!ctx->xi2_raw_motion_enabled) {
+    return false;
+  }
+
+  unsigned char mask[(XI_LASTEVENT + 7) / 8];
+  memset(mask, 0, sizeof(mask));
+  XISetMask(mask, XI_Motion);
+  XISetMask(mask, XI_ButtonPress);
+  XISetMask(mask, XI_ButtonRelease);
+
+  XIEventMask event_mask;
+  event_mask.deviceid = XIAllMasterDevices;
+  event_mask.mask_len = (int)sizeof(mask);
+  event_mask.mask = mask;
+  return ctx->xi2_lib.XISelectEvents(ctx->display, window, &event_mask, 1) == Success;
+}
+
+bool _maru_x11_process_xi2_pointer_event(MARU_Context_X11 *ctx, const XIDeviceEvent *dev) {
+  unsigned int state = (unsigned int)dev->mods.effective;
+  const int button_bits = dev->buttons.mask_len * 8;
+  for (int button = 1; button <= 5 && button < button_bits; ++button) {
+    if (XIMaskIsSet(dev->buttons.mask, button)) {
+      state |= (unsigned int)Button1Mask << (button - 1);
+    }
+  }
+
+  XEvent core;
+  memset(&core, 0, sizeof(core));
+  switch (dev->evtype) {
+    case XI_Motion:
+      core.xmotion.type = MotionNotify;
+      core.xmotion.serial = dev->serial;
+      core.xmotion.send_event = dev->send_event;
+      core.xmotion.display = dev->display;
+      core.xmotion.window = dev->event;
+      core.xmotion.root = dev->root;
+      core.xmotion.subwindow = dev->child;
+      core.xmotion.time = dev->time;
+      core.xmotion.x = (int)dev->event_x;
+      core.xmotion.y = (int)dev->event_y;
+      core.xmotion.x_root = (int)dev->root_x;
+      core.xmotion.y_root = (int)dev->root_y;
+      core.xmotion.state = state;
+      core.xmotion.is_hint = NotifyNormal;
+      core.xmotion.same_screen = True;
+      break;
+    case XI_ButtonPress:
+    case XI_ButtonRelease:
+      core.xbutton.type = (dev->evtype == XI_ButtonPress) ? ButtonPress : ButtonRelease;
+      core.xbutton.serial = dev->serial;
+      core.xbutton.send_event = dev->send_event;
+      core.xbutton.display = dev->display;
+      core.xbutton.window = dev->event;
+      core.xbutton.root = dev->root;
+      core.xbutton.subwindow = dev->child;
+      core.xbutton.time = dev->time;
+      core.xbutton.x = (int)dev->event_x;
+      core.xbutton.y = (int)dev->event_y;
+      core.xbutton.x_root = (int)dev->root_x;
+      core.xbutton.y_root = (int)dev->root_y;
+      core.xbutton.state = state;
+      core.xbutton.button = (unsigned int)dev->detail;
+      core.xbutton.same_screen = True;
+      break;
+    default:
+      return false;
+  }
+  return _maru_x11_process_input_event(ctx, &core);
+}
+
 MARU_ModifierFlags _maru_x11_get_modifiers(unsigned int state) {
   MARU_ModifierFlags mods = 0;
   if (state & ShiftMask) mods |= MARU_MODIFIER_SHIFT;
@@ -73,6 +147,38 @@ MARU_ModifierFlags _maru_x11_get_modifiers(unsigned int state) {
   return mods;
 }
 
+void _maru_x11_refresh_input_state(MARU_Context_X11 *ctx, Window window) {
+  Window root_ret = 0;
+  Window child_ret = 0;
+  int root_x = 0;
+  int root_y = 0;
+  int win_x = 0;
+  int win_y = 0;
+  unsigned int state = 0u;
+  if (ctx->x11_lib.XQueryPointer(ctx->display, window, &root_ret, &child_ret,
+                                 &root_x, &root_y, &win_x, &win_y, &state)) {
+    ctx->input_state = state;
+  }
+}
+
+// Core key events carry the state from before the key, so fold the key itself in.
+static unsigned int _maru_x11_apply_modifier_key(unsigned int state, KeySym keysym,
+                                                 bool is_press) {
+  unsigned int mask = 0u;
+  switch (keysym) {
+    case XK_Shift_L: case XK_Shift_R: mask = ShiftMask; break;
+    case XK_Control_L: case XK_Control_R: mask = ControlMask; break;
+    case XK_Alt_L: case XK_Alt_R: case XK_Meta_L: case XK_Meta_R: mask = Mod1Mask; break;
+    case XK_Super_L: case XK_Super_R: mask = Mod4Mask; break;
+    case XK_Caps_Lock:
+      return is_press ? (state ^ (unsigned int)LockMask) : state;
+    case XK_Num_Lock:
+      return is_press ? (state ^ (unsigned int)Mod2Mask) : state;
+    default: return state;
+  }
+  return is_press ? (state | mask) : (state & ~mask);
+}
+
 MARU_Key _maru_x11_map_keysym(KeySym keysym) {
   switch (keysym) {
     case XK_space: return MARU_KEY_SPACE;
@@ -501,6 +607,7 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
   switch (ev->type) {
     case MotionNotify: {
       MARU_Window_X11 *win = _maru_x11_find_window(ctx, ev->xmotion.window);
+      ctx->input_state = ev->xmotion.state;
       if (ctx->dnd_source.active) {
         _maru_x11_update_dnd_source_target(ctx, ev->xmotion.time, ev->xmotion.x_root,
                                            ev->xmotion.y_root, true);
@@ -547,6 +654,8 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
             }
             _maru_x11_clear_locked_raw_accum(ctx);
             mevt.mouse_moved.modifiers = _maru_x11_get_modifiers(ev->xmotion.state);
+            mevt.mouse_moved.timestamp_ns =
+                _maru_linux_map_input_time_ms((uint32_t)ev->xmotion.time);
             _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_MOVED,
                                  (MARU_Window *)win, &mevt);
             _maru_x11_recenter_locked_pointer(ctx, win);
@@ -568,6 +677,8 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
         mevt.mouse_moved.raw_dip_delta.x = (MARU_Scalar)0.0;
         mevt.mouse_moved.raw_dip_delta.y = (MARU_Scalar)0.0;
         mevt.mouse_moved.modifiers = _maru_x11_get_modifiers(ev->xmotion.state);
+        mevt.mouse_moved.timestamp_ns =
+            _maru_linux_map_input_time_ms((uint32_t)ev->xmotion.time);
 
         ctx->linux_common.pointer.focused_window = (MARU_Window *)win;
         ctx->linux_common.pointer.x = (double)x;
@@ -580,6 +691,7 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
     case ButtonPress:
     case ButtonRelease: {
       MARU_Window_X11 *win = _maru_x11_find_window(ctx, ev->xbutton.window);
+      ctx->input_state = ev->xbutton.state;
       if (ev->type == ButtonRelease && ctx->dnd_source.active) {
         MARU_X11DnDSourceSession *src = &ctx->dnd_source;
         _maru_x11_update_dnd_source_target(ctx, ev->xbutton.time, ev->xbutton.x_root,
@@ -606,6 +718,8 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
       if (is_press && (btn >= 4 && btn <= 7)) {
         MARU_Event mevt = {0};
         mevt.mouse_scrolled.modifiers = _maru_x11_get_modifiers(ev->xbutton.state);
+        mevt.mouse_scrolled.timestamp_ns =
+            _maru_linux_map_input_time_ms((uint32_t)ev->xbutton.time);
         if (btn == 4) {
           mevt.mouse_scrolled.dip_delta.y = (MARU_Scalar)1.0;
           mevt.mouse_scrolled.steps.y = 1;
@@ -637,6 +751,8 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
       mevt.mouse_button_changed.button_id = button_id;
       mevt.mouse_button_changed.state = state;
       mevt.mouse_button_changed.modifiers = _maru_x11_get_modifiers(ev->xbutton.state);
+      mevt.mouse_button_changed.timestamp_ns =
+          _maru_linux_map_input_time_ms((uint32_t)ev->xbutton.time);
       _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_BUTTON_CHANGED, (MARU_Window *)win, &mevt);
       return true;
     }
@@ -688,6 +804,7 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
                                               &keysym, NULL);
         emit_text = is_press && text_input_enabled && (text_len > 0);
       }
+      ctx->input_state = _maru_x11_apply_modifier_key(ev->xkey.state, keysym, is_press);
       const MARU_Key key = _maru_x11_map_keysym(keysym);
       const MARU_ButtonState state =
           is_press ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED;
@@ -703,6 +820,8 @@ bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev) {
         mevt.key_changed.key = key;
         mevt.key_changed.state = state;
         mevt.key_changed.modifiers = _maru_x11_get_modifiers(ev->xkey.state);
+        mevt.key_changed.timestamp_ns =
+            _maru_linux_map_input_time_ms((uint32_t)ev->xkey.time);
         _maru_dispatch_event(&ctx->base, MARU_EVENT_KEY_CHANGED, (MARU_Window *)win, &mevt);
       }
 
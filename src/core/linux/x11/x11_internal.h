@@ -12,6 +12,7 @@
 #include "dlib/xrandr.h"
 #include "dlib/xfixes.h"
 #include "dlib/xss.h"
+#include "dlib/xpresent.h"
 #include "maru/maru.h"
 
 typedef struct MARU_Cursor_X11 MARU_Cursor_X11;
@@ -38,9 +39,31 @@ typedef struct MARU_X11DataRequestPending {
   unsigned char *incr_data;
   size_t incr_size;
   size_t incr_capacity;
+  // Streamed requests hand each INCR chunk out as it arrives instead of
+  // accumulating it; `streamed` counts the bytes already delivered.
+  bool stream;
+  uint64_t streamed;
   void *userdata;
 } MARU_X11DataRequestPending;
 
+// Clipboard/primary TARGETS list of an external owner. The conversion is
+// issued from maru_getAvailable*MIMETypes() and completed by the pump that
+// receives its SelectionNotify; the result is kept until the owner changes.
+typedef struct MARU_X11SelectionTargetsCache {
+  bool pending;
+  bool valid;
+  Window owner;
+  // Ownership timestamp from XFixes, or CurrentTime when it is unknown. Used
+  // as the conversion time so stale replies can be told apart.
+  Time owner_time;
+  Window requestor;
+  Time request_time;
+  uint64_t request_ms;
+  char *storage;
+  const char **mime_types;
+  uint32_t mime_count;
+} MARU_X11SelectionTargetsCache;
+
 typedef struct MARU_X11DnDSession {
   bool active;
   bool drop_pending;
@@ -111,6 +134,7 @@ typedef struct MARU_Context_X11 {
   MARU_Lib_Xrandr xrandr_lib;
   MARU_Lib_Xfixes xfixes_lib;
   MARU_Lib_Xss xss_lib;
+  MARU_Lib_Xpresent xpresent_lib;
   Display *display;
   int screen;
   Window root;
@@ -121,10 +145,24 @@ typedef struct MARU_Context_X11 {
   bool xi2_pointer_barriers_available;
   bool xfixes_pointer_barriers_available;
   bool xss_idle_inhibit_active;
+  bool present_available;
+  // RandR change notifications are selected on the root window, so the
+  // monitor cache is only refreshed after the server reports a change.
+  bool xrandr_events_available;
+  bool monitors_valid;
+  bool monitors_dirty;
+  int xrandr_event_base;
+  // XFixes selection-owner notifications drive MIME query cache invalidation.
+  bool xfixes_selection_events_available;
+  int xfixes_event_base;
   int xi2_opcode;
+  int present_opcode;
   MARU_Scalar locked_raw_dx_accum;
   MARU_Scalar locked_raw_dy_accum;
   bool locked_raw_pending;
+  // Core modifier/button mask from the latest pointer and key events, so the
+  // locked raw-motion path can report modifiers without querying the server.
+  unsigned int input_state;
   bool has_buffered_event;
   XEvent buffered_event;
   
@@ -180,10 +218,10 @@ typedef struct MARU_Context_X11 {
   MARU_X11DataRequestPending dnd_request;
   MARU_X11DnDSession dnd_session;
   MARU_X11DnDSourceSession dnd_source;
-  void *clipboard_mime_query_storage;
+  MARU_X11SelectionTargetsCache clipboard_targets;
+  MARU_X11SelectionTargetsCache primary_targets;
   const char **clipboard_mime_query_ptr;
   uint32_t clipboard_mime_query_count;
-  void *primary_mime_query_storage;
   const char **primary_mime_query_ptr;
   uint32_t primary_mime_query_count;
   void *dnd_mime_query_storage;
@@ -215,6 +253,17 @@ struct MARU_Window_X11 {
 
   uint64_t last_frame_dispatch_ms;
   uint64_t frame_id;
+
+  // Present extension timing. Completions of the window's own buffer swaps
+  // are exact; until one is seen, one PresentNotifyMSC at a time samples the
+  // vblank instead.
+  XID present_event_id;
+  uint32_t present_serial;
+  bool present_notify_pending;
+  bool present_swaps_seen;
+  uint64_t last_presentation_ns;
+  uint64_t presentation_msc;
+  uint32_t refresh_interval_ns;
   XSyncCounter basic_sync_counter;
   XSyncCounter extended_sync_counter;
   XSyncValue extended_frame_value;
@@ -238,12 +287,16 @@ struct MARU_Monitor_X11 {
   Rotation current_rotation;
   MARU_VideoMode *modes;
   uint32_t mode_count;
+  bool mode_changed_pending;
 };
 
 // Internal helpers shared across X11 modules
 bool _maru_x11_copy_string(MARU_Context_X11 *ctx, const char *src, char **out_str);
 MARU_Window_X11 *_maru_x11_find_window(MARU_Context_X11 *ctx, Window handle);
-void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx);
+void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx, bool notify);
+void _maru_x11_init_monitor_events(MARU_Context_X11 *ctx);
+bool _maru_x11_process_monitor_event(MARU_Context_X11 *ctx, XEvent *ev);
+void _maru_x11_dispatch_monitor_changes(MARU_Context_X11 *ctx);
 uint64_t _maru_x11_get_monotonic_time_ms(void);
 void _maru_x11_record_pump_duration_ns(MARU_Context_X11 *ctx, uint64_t duration_ns);
 MARU_Scalar _maru_x11_get_global_scale(MARU_Context_X11 *ctx);
@@ -252,7 +305,11 @@ MARU_Scalar _maru_x11_scale_from_metrics(MARU_Scalar pixel_width,
                                          MARU_Scalar mm_width,
                                          MARU_Scalar mm_height);
 void _maru_x11_clear_mime_query_cache(MARU_Context_X11 *ctx);
+void _maru_x11_init_selection_events(MARU_Context_X11 *ctx);
+void _maru_x11_clear_selection_targets(MARU_Context_X11 *ctx,
+                                       MARU_X11SelectionTargetsCache *cache);
 void _maru_x11_process_event(MARU_Context_X11 *ctx, XEvent *ev);
+void _maru_x11_process_present_event(MARU_Context_X11 *ctx, XEvent *ev);
 bool _maru_x11_process_window_event(MARU_Context_X11 *ctx, XEvent *ev);
 bool _maru_x11_process_input_event(MARU_Context_X11 *ctx, XEvent *ev);
 bool _maru_x11_process_dataexchange_event(MARU_Context_X11 *ctx, XEvent *ev);
@@ -263,7 +320,10 @@ bool _maru_x11_is_text_mime(const char *mime);
 uint32_t _maru_x11_find_offer_mime_index(MARU_Context_X11 *ctx, const MARU_X11DataOffer *offer, Atom requested_target);
 bool _maru_x11_init_context_mouse_channels(MARU_Context_X11 *ctx);
 bool _maru_x11_enable_xi2_raw_motion(MARU_Context_X11 *ctx);
+bool _maru_x11_select_xi2_pointer_events(MARU_Context_X11 *ctx, Window window);
+bool _maru_x11_process_xi2_pointer_event(MARU_Context_X11 *ctx, const XIDeviceEvent *dev);
 MARU_ModifierFlags _maru_x11_get_modifiers(unsigned int state);
+void _maru_x11_refresh_input_state(MARU_Context_X11 *ctx, Window window);
 MARU_Key _maru_x11_map_keysym(KeySym keysym);
 uint32_t _maru_x11_button_to_native_code(unsigned int x_button);
 uint32_t _maru_x11_find_mouse_button_id(const MARU_Context_X11 *ctx, uint32_t native_code);
@@ -298,6 +358,7 @@ static inline bool _maru_x11_sync_value_is_zero(XSyncValue v) {
 // DnD internal helpers shared between modules
 void _maru_x11_send_xdnd_status(MARU_Context_X11 *ctx, const MARU_X11DnDSession *session, bool accept);
 MARU_DropAction _maru_x11_atom_to_drop_action(const MARU_Context_X11 *ctx, Atom atom);
+Atom _maru_x11_drop_action_to_atom(const MARU_Context_X11 *ctx, MARU_DropAction action);
 void _maru_x11_send_xdnd_enter_source(MARU_Context_X11 *ctx, Window target, Window source, uint32_t version, const MARU_X11DataOffer *offer);
 void _maru_x11_send_xdnd_leave_source(MARU_Context_X11 *ctx, Window target, Window source);
 void _maru_x11_send_xdnd_position_source(MARU_Context_X11 *ctx, Window target, Window source, int x_root, int y_root, Time time, Atom action_atom);
@@ -319,6 +380,9 @@ MARU_Status maru_updateContext_X11(MARU_Context *context, uint64_t field_mask, c
 MARU_Status maru_pumpEvents_X11(MARU_Context *context, uint32_t timeout_ms,
                                 MARU_EventMask mask,
                                 MARU_EventCallback callback, void *userdata);
+MARU_Status maru_pumpEventsUntil_X11(MARU_Context *context, uint64_t deadline_ns,
+                                     MARU_EventMask mask,
+                                     MARU_EventCallback callback, void *userdata);
 MARU_Status maru_wakeContext_X11(MARU_Context *context);
 void *maru_getContextNativeHandle_X11(MARU_Context *context);
 
@@ -342,7 +406,7 @@ MARU_Status maru_setMonitorMode_X11(MARU_Monitor *monitor, MARU_VideoMode mode);
 
 MARU_Status maru_announceData_X11(MARU_Window *window, MARU_DataExchangeTarget target, MARU_StringList mime_types, MARU_DropActionMask allowed_actions);
 MARU_Status maru_provideData_X11(MARU_DataRequest *request, const void *data, size_t size, MARU_DataProvideFlags flags);
-MARU_Status maru_requestData_X11(MARU_Window *window, MARU_DataExchangeTarget target, const char *mime_type, void *userdata);
+MARU_Status maru_requestData_X11(MARU_Window *window, MARU_DataExchangeTarget target, const char *mime_type, void *userdata, bool stream);
 MARU_Status maru_getAvailableMIMETypes_X11(const MARU_Window *window, MARU_DataExchangeTarget target, MARU_StringList *out_list);
 
 MARU_Status maru_getVkExtensions_X11(const MARU_Context *context, MARU_StringList *out_list);
@@ -361,7 +425,7 @@ MARU_Status _maru_x11_announceData(MARU_Window *window, MARU_DataExchangeTarget
 MARU_Status _maru_x11_provideData(MARU_DataRequest *request, const void *data,
                                   size_t size, MARU_DataProvideFlags flags);
 MARU_Status _maru_x11_requestData(MARU_Window *window, MARU_DataExchangeTarget target,
-                                  const char *mime_type, void *userdata);
+                                  const char *mime_type, void *userdata, bool stream);
 MARU_Status _maru_x11_getAvailableMIMETypes(const MARU_Window *window,
                                             MARU_DataExchangeTarget target,
                                             MARU_StringList *out_list);
@@ -43,7 +43,9 @@ static void _maru_x11_destroy_monitor(MARU_Monitor_X11 *monitor) {
   maru_context_free(monitor->base.ctx_base, monitor);
 }
 
-void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
+// Rebuilds the monitor cache from the server. With `notify`, monitors that
+// appeared, disappeared or changed mode are reported to the current pump.
+void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx, bool notify) {
   if (!ctx->xrandr_lib.base.available) {
     return;
   }
@@ -57,6 +59,8 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
   if (!resources) {
     return;
   }
+  ctx->monitors_valid = true;
+  const uint32_t known_count = ctx->base.monitor_cache_count;
 
   int nmonitors = 0;
   XRRMonitorInfo *monitors = ctx->xrandr_lib.XRRGetMonitors(
@@ -187,6 +191,7 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
         }
       }
 
+      const MARU_VideoMode previous_mode = monitor->base.pub.current_mode;
       monitor->crtc = output_info->crtc;
       if (output_info->crtc) {
         XRRCrtcInfo *crtc_info = ctx->xrandr_lib.XRRGetCrtcInfo(
@@ -206,6 +211,10 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
           ctx->xrandr_lib.XRRFreeCrtcInfo(crtc_info);
         }
       }
+      if (memcmp(&previous_mode, &monitor->base.pub.current_mode,
+                 sizeof(previous_mode)) != 0) {
+        monitor->mode_changed_pending = true;
+      }
 
       ctx->xrandr_lib.XRRFreeOutputInfo(output_info);
     }
@@ -214,6 +223,24 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
 
   ctx->xrandr_lib.XRRFreeScreenResources(resources);
 
+  for (uint32_t i = 0; i < ctx->base.monitor_cache_count; ++i) {
+    MARU_Monitor_X11 *monitor = (MARU_Monitor_X11 *)ctx->base.monitor_cache[i];
+    const bool changed = monitor->mode_changed_pending;
+    monitor->mode_changed_pending = false;
+    if (!notify || !monitor->base.is_active) {
+      continue;
+    }
+    MARU_Event evt = {0};
+    if (i >= known_count) {
+      evt.monitor_changed.monitor = (MARU_Monitor *)monitor;
+      evt.monitor_changed.connected = true;
+      _maru_dispatch_event(&ctx->base, MARU_EVENT_MONITOR_CHANGED, NULL, &evt);
+    } else if (changed) {
+      evt.monitor_mode_changed.monitor = (MARU_Monitor *)monitor;
+      _maru_dispatch_event(&ctx->base, MARU_EVENT_MONITOR_MODE_CHANGED, NULL, &evt);
+    }
+  }
+
   for (uint32_t i = 0; i < ctx->base.monitor_cache_count;) {
     MARU_Monitor_Base *monitor = (MARU_Monitor_Base *)ctx->base.monitor_cache[i];
     if (monitor->is_active) {
@@ -221,6 +248,12 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
       continue;
     }
     monitor->pub.flags |= MARU_MONITOR_STATE_LOST;
+    if (notify) {
+      MARU_Event evt = {0};
+      evt.monitor_changed.monitor = (MARU_Monitor *)monitor;
+      evt.monitor_changed.connected = false;
+      _maru_dispatch_event(&ctx->base, MARU_EVENT_MONITOR_CHANGED, NULL, &evt);
+    }
     for (uint32_t j = i; j + 1u < ctx->base.monitor_cache_count; ++j) {
       ctx->base.monitor_cache[j] = ctx->base.monitor_cache[j + 1u];
     }
@@ -229,9 +262,54 @@ void _maru_x11_refresh_monitors(MARU_Context_X11 *ctx) {
   }
 }
 
+void _maru_x11_init_monitor_events(MARU_Context_X11 *ctx) {
+  ctx->xrandr_events_available = false;
+  if (!ctx->xrandr_lib.base.available) {
+    return;
+  }
+  int error_base = 0;
+  if (!ctx->xrandr_lib.XRRQueryExtension(ctx->display, &ctx->xrandr_event_base,
+                                         &error_base)) {
+    return;
+  }
+  ctx->xrandr_lib.XRRSelectInput(ctx->display, ctx->root,
+                                 RRScreenChangeNotifyMask | RRCrtcChangeNotifyMask |
+                                     RROutputChangeNotifyMask);
+  ctx->xrandr_events_available = true;
+  // Built after selecting input so the first notification already has a
+  // baseline to report changes against.
+  _maru_x11_refresh_monitors(ctx, false);
+}
+
+bool _maru_x11_process_monitor_event(MARU_Context_X11 *ctx, XEvent *ev) {
+  if (!ctx->xrandr_events_available) {
+    return false;
+  }
+  if (ev->type == ctx->xrandr_event_base + RRScreenChangeNotify) {
+    // Keeps Xlib's idea of the screen size current.
+    ctx->xrandr_lib.XRRUpdateConfiguration(ev);
+  } else if (ev->type != ctx->xrandr_event_base + RRNotify) {
+    return false;
+  }
+  // A single reconfiguration sends a burst of these; refresh once after it.
+  ctx->monitors_dirty = true;
+  return true;
+}
+
+void _maru_x11_dispatch_monitor_changes(MARU_Context_X11 *ctx) {
+  if (!ctx->monitors_dirty) {
+    return;
+  }
+  ctx->monitors_dirty = false;
+  // Without a baseline every monitor would read as newly connected.
+  _maru_x11_refresh_monitors(ctx, ctx->monitors_valid);
+}
+
 MARU_Status maru_getMonitors_X11(const MARU_Context *context, MARU_MonitorList *out_list) {
   MARU_Context_X11 *ctx = (MARU_Context_X11 *)context;
-  _maru_x11_refresh_monitors(ctx);
+  if (!ctx->xrandr_events_available || !ctx->monitors_valid) {
+    _maru_x11_refresh_monitors(ctx, false);
+  }
   out_list->monitors = ctx->base.monitor_cache;
   out_list->count = ctx->base.monitor_cache_count;
   return MARU_SUCCESS;
@@ -317,6 +395,6 @@ MARU_Status maru_setMonitorMode_X11(MARU_Monitor *monitor, MARU_VideoMode mode)
   mon->current_mode_id = target_mode;
   mon->base.pub.current_mode = mode;
   ctx->x11_lib.XSync(ctx->display, False);
-  _maru_x11_refresh_monitors(ctx);
+  _maru_x11_refresh_monitors(ctx, false);
   return MARU_SUCCESS;
 }
@@ -682,6 +682,13 @@ MARU_Status maru_createWindow_X11(MARU_Context *context,
   ctx->x11_lib.XSetWMProtocols(ctx->display, win->handle, protocols,
                                protocol_count);
 
+  (void)_maru_x11_select_xi2_pointer_events(ctx, win->handle);
+
+  if (ctx->present_available) {
+    win->present_event_id = ctx->xpresent_lib.XPresentSelectInput(
+        ctx->display, win->handle, PresentCompleteNotifyMask);
+  }
+
   _maru_register_window(&ctx->base, (MARU_Window *)win);
 
   win->base.pub.flags = MARU_WINDOW_STATE_READY;
@@ -754,6 +761,12 @@ MARU_Status maru_destroyWindow_X11(MARU_Window *window) {
     _maru_x11_release_pointer_lock(ctx, win);
   }
 
+  if (win->handle && win->present_event_id != None) {
+    ctx->xpresent_lib.XPresentFreeInput(ctx->display, win->handle,
+                                        win->present_event_id);
+    win->present_event_id = None;
+  }
+
   if (win->handle) {
     ctx->x11_lib.XUnmapWindow(ctx->display, win->handle);
     ctx->x11_lib.XDestroyWindow(ctx->display, win->handle);
@@ -1019,6 +1032,49 @@ bool _maru_x11_process_window_event(MARU_Context_X11 *ctx, XEvent *ev) {
   }
 }
 
+static void _maru_x11_record_presentation(MARU_Window_X11 *win, uint64_t ust_us,
+                                          uint64_t msc) {
+  // UST is CLOCK_MONOTONIC microseconds.
+  const uint64_t ust_ns = ust_us * 1000u;
+  if (win->presentation_msc != 0 && msc > win->presentation_msc &&
+      ust_ns > win->last_presentation_ns) {
+    const uint64_t interval_ns =
+        (ust_ns - win->last_presentation_ns) / (msc - win->presentation_msc);
+    win->refresh_interval_ns =
+        (interval_ns <= UINT32_MAX) ? (uint32_t)interval_ns : 0u;
+  }
+  win->last_presentation_ns = ust_ns;
+  win->presentation_msc = msc;
+}
+
+void _maru_x11_process_present_event(MARU_Context_X11 *ctx, XEvent *ev) {
+  if (!ctx->x11_lib.XGetEventData(ctx->display, &ev->xcookie)) {
+    return;
+  }
+
+  const MARU_XPresentCompleteNotifyEvent *complete =
+      (const MARU_XPresentCompleteNotifyEvent *)ev->xcookie.data;
+  if (ev->xcookie.evtype == PresentCompleteNotify && complete) {
+    MARU_Window_X11 *win = _maru_x11_find_window(ctx, complete->window);
+    if (win && complete->kind == PresentCompleteKindPixmap) {
+      // A swap of the window's content, presented by the graphics stack on
+      // our behalf. Skipped swaps never reached the display.
+      if (complete->mode != PresentCompleteModeSkip) {
+        win->present_swaps_seen = true;
+        _maru_x11_record_presentation(win, complete->ust, complete->msc);
+      }
+    } else if (win && complete->kind == PresentCompleteKindNotifyMSC &&
+               complete->serial_number == win->present_serial) {
+      win->present_notify_pending = false;
+      if (!win->present_swaps_seen) {
+        _maru_x11_record_presentation(win, complete->ust, complete->msc);
+      }
+    }
+  }
+
+  ctx->x11_lib.XFreeEventData(ctx->display, &ev->xcookie);
+}
+
 void _maru_x11_dispatch_pending_frames(MARU_Context_X11 *ctx) {
   MARU_Window_Base *base = ctx->base.window_list_head;
   const uint64_t now_ms = _maru_x11_get_monotonic_time_ms();
@@ -1056,9 +1112,22 @@ void _maru_x11_dispatch_pending_frames(MARU_Context_X11 *ctx) {
 
         MARU_Event evt = {0};
         evt.window_frame.timestamp_ms = (uint32_t)now_ms;
+        evt.window_frame.refresh_interval_ns = win->refresh_interval_ns;
+        evt.window_frame.last_presentation_ns = win->last_presentation_ns;
+        evt.window_frame.presentation_msc = win->presentation_msc;
         _maru_dispatch_event(&ctx->base, MARU_EVENT_WINDOW_FRAME,
                              (MARU_Window *)win, &evt);
 
+        if (win->present_event_id != None && !win->present_swaps_seen &&
+            !win->present_notify_pending) {
+          // No swap reports its own completion, so sample the next vblank
+          // instead. It only bounds when the frame reached the display.
+          win->present_notify_pending = true;
+          ctx->xpresent_lib.XPresentNotifyMSC(ctx->display, win->handle,
+                                              ++win->present_serial, 0, 0, 0);
+          ctx->x11_lib.XFlush(ctx->display);
+        }
+
         if (win->has_extended_frame_sync &&
             win->extended_sync_counter != None) {
           const uint64_t end_value =
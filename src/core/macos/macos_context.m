@@ -52,6 +52,15 @@ static uint64_t _maru_cocoa_now_ms(void) {
     return (uint64_t)(uptime * 1000.0);
 }
 
+static uint64_t _maru_cocoa_event_time_ns(NSEvent *nsEvent) {
+    // NSEvent timestamps are seconds of system uptime, the same clock as _maru_cocoa_now_ms().
+    const NSTimeInterval timestamp = [nsEvent timestamp];
+    if (timestamp <= 0.0) {
+        return 0u;
+    }
+    return (uint64_t)(timestamp * 1000000000.0);
+}
+
 static void _maru_cocoa_init_mouse_button_channels(MARU_Context_Cocoa *ctx) {
     const uint32_t count = MARU_MOUSE_DEFAULT_COUNT;
     ctx->base.mouse_button_channels = (MARU_ChannelInfo *)maru_context_alloc(
@@ -240,6 +249,7 @@ static void _maru_cocoa_process_event(MARU_Context_Cocoa *active_ctx,
             event.key_changed.key = key;
             event.key_changed.state = state;
             event.key_changed.modifiers = _maru_cocoa_translate_modifiers([nsEvent modifierFlags]);
+            event.key_changed.timestamp_ns = _maru_cocoa_event_time_ns(nsEvent);
             
             _maru_cocoa_dispatch_window_event(active_ctx, window,
                                               MARU_EVENT_KEY_CHANGED, &event);
@@ -265,6 +275,7 @@ static void _maru_cocoa_process_event(MARU_Context_Cocoa *active_ctx,
             event.key_changed.key = key;
             event.key_changed.state = pressed ? MARU_BUTTON_STATE_PRESSED : MARU_BUTTON_STATE_RELEASED;
             event.key_changed.modifiers = _maru_cocoa_translate_modifiers(new_mods);
+            event.key_changed.timestamp_ns = _maru_cocoa_event_time_ns(nsEvent);
             
             _maru_cocoa_dispatch_window_event(active_ctx, window,
                                               MARU_EVENT_KEY_CHANGED, &event);
@@ -289,6 +300,7 @@ static void _maru_cocoa_process_event(MARU_Context_Cocoa *active_ctx,
             event.mouse_button_changed.button_id = channel;
             event.mouse_button_changed.state = state;
             event.mouse_button_changed.modifiers = _maru_cocoa_translate_modifiers([nsEvent modifierFlags]);
+            event.mouse_button_changed.timestamp_ns = _maru_cocoa_event_time_ns(nsEvent);
             
             _maru_cocoa_dispatch_window_event(active_ctx, window,
                                               MARU_EVENT_MOUSE_BUTTON_CHANGED,
@@ -311,6 +323,7 @@ static void _maru_cocoa_process_event(MARU_Context_Cocoa *active_ctx,
             event.mouse_moved.raw_dip_delta.x = (MARU_Scalar)[nsEvent deltaX];
             event.mouse_moved.raw_dip_delta.y = (MARU_Scalar)[nsEvent deltaY];
             event.mouse_moved.modifiers = _maru_cocoa_translate_modifiers([nsEvent modifierFlags]);
+            event.mouse_moved.timestamp_ns = _maru_cocoa_event_time_ns(nsEvent);
             
             _maru_cocoa_dispatch_window_event(active_ctx, window,
                                               MARU_EVENT_MOUSE_MOVED, &event);
@@ -327,6 +340,7 @@ static void _maru_cocoa_process_event(MARU_Context_Cocoa *active_ctx,
                 event.mouse_scrolled.dip_delta.y *= (MARU_Scalar)10.0;
             }
             event.mouse_scrolled.modifiers = _maru_cocoa_translate_modifiers([nsEvent modifierFlags]);
+            event.mouse_scrolled.timestamp_ns = _maru_cocoa_event_time_ns(nsEvent);
             
             _maru_cocoa_dispatch_window_event(active_ctx, window,
                                               MARU_EVENT_MOUSE_SCROLLED, &event);
@@ -617,6 +631,17 @@ MARU_Status maru_pumpEvents_Cocoa(MARU_Context *context, uint32_t timeout_ms,
     return MARU_SUCCESS;
 }
 
+MARU_Status maru_pumpEventsUntil_Cocoa(MARU_Context *context,
+                                        uint64_t deadline_ns,
+                                        MARU_EventMask mask,
+                                        MARU_EventCallback callback,
+                                        void *userdata) {
+    // Deadlines share the NSEvent timestamp clock (system uptime).
+    const uint64_t now_ns = _maru_cocoa_now_ms() * 1000000ull;
+    const uint32_t timeout_ms = _maru_deadline_ns_to_timeout_ms(deadline_ns, now_ns);
+    return maru_pumpEvents_Cocoa(context, timeout_ms, mask, callback, userdata);
+}
+
 MARU_Status maru_wakeContext_Cocoa(MARU_Context *context) {
     if (maru_isContextLost(context)) {
         return MARU_CONTEXT_LOST;
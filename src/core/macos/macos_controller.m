@@ -121,6 +121,8 @@ static void _maru_cocoa_dispatch_button_event(MARU_Controller_Cocoa *c, uint32_t
     event.controller_button_changed.controller = (MARU_Controller *)c;
     event.controller_button_changed.button_id = button_id;
     event.controller_button_changed.state = state;
+    event.controller_button_changed.timestamp_ns =
+        (uint64_t)([NSProcessInfo processInfo].systemUptime * 1000000000.0);
     _maru_post_event_internal(c->base.ctx_base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED, NULL, &event);
 }
 
@@ -62,6 +62,7 @@ const MARU_Backend maru_backend_Cocoa = {
   .destroyContext = maru_destroyContext_Cocoa,
   .updateContext = maru_updateContext_Cocoa,
   .pumpEvents = maru_pumpEvents_Cocoa,
+  .pumpEventsUntil = maru_pumpEventsUntil_Cocoa,
   .wakeContext = maru_wakeContext_Cocoa,
 
   .createWindow = maru_createWindow_Cocoa,
@@ -130,6 +131,18 @@ MARU_API MARU_Status maru_pumpEvents(MARU_Context *context, uint32_t timeout_ms,
   return maru_pumpEvents_Cocoa(context, timeout_ms, mask, callback, userdata);
 }
 
+MARU_API MARU_Status maru_pumpEventsUntil(MARU_Context *context,
+                                          uint64_t deadline_ns,
+                                          MARU_EventMask mask,
+                                          MARU_EventCallback callback,
+                                          void *userdata) {
+  MARU_API_VALIDATE(pumpEventsUntil, context, deadline_ns, mask, callback,
+                    userdata);
+  MARU_RETURN_ON_ERROR(_maru_status_if_context_lost(context));
+  return maru_pumpEventsUntil_Cocoa(context, deadline_ns, mask, callback,
+                                    userdata);
+}
+
 MARU_API MARU_Status maru_wakeContext(MARU_Context *context) {
   MARU_API_VALIDATE(wakeContext, context);
   return maru_wakeContext_Cocoa(context);
@@ -267,6 +280,28 @@ MARU_API MARU_Status maru_provideDropData(MARU_DataRequest *request,
   return maru_provideData_Cocoa(request, data, size, flags);
 }
 
+MARU_API MARU_Status maru_provideClipboardDataFromFd(MARU_DataRequest *request,
+                                                     int fd, uint64_t offset,
+                                                     uint64_t size) {
+  MARU_API_VALIDATE(provideClipboardDataFromFd, request, fd, offset, size);
+  (void)request;
+  (void)fd;
+  (void)offset;
+  (void)size;
+  return MARU_FAILURE;
+}
+
+MARU_API MARU_Status maru_provideDropDataFromFd(MARU_DataRequest *request,
+                                                int fd, uint64_t offset,
+                                                uint64_t size) {
+  MARU_API_VALIDATE(provideDropDataFromFd, request, fd, offset, size);
+  (void)request;
+  (void)fd;
+  (void)offset;
+  (void)size;
+  return MARU_FAILURE;
+}
+
 MARU_API MARU_Status maru_requestClipboardData(MARU_Context *context,
                                                const char *mime_type,
                                                void *userdata) {
@@ -285,6 +320,26 @@ MARU_API MARU_Status maru_requestDropData(MARU_Window *window,
   return maru_requestDropData_Cocoa_win(window, mime_type, userdata);
 }
 
+MARU_API MARU_Status maru_requestClipboardDataStream(MARU_Context *context,
+                                                     const char *mime_type,
+                                                     void *userdata) {
+  MARU_API_VALIDATE(requestClipboardDataStream, context, mime_type, userdata);
+  (void)context;
+  (void)mime_type;
+  (void)userdata;
+  return MARU_FAILURE;
+}
+
+MARU_API MARU_Status maru_requestDropDataStream(MARU_Window *window,
+                                                const char *mime_type,
+                                                void *userdata) {
+  MARU_API_VALIDATE(requestDropDataStream, window, mime_type, userdata);
+  (void)window;
+  (void)mime_type;
+  (void)userdata;
+  return MARU_FAILURE;
+}
+
 MARU_API MARU_Status maru_getAvailableClipboardMIMETypes(
     const MARU_Context *context, MARU_StringList *out_list) {
   MARU_API_VALIDATE(getAvailableClipboardMIMETypes, context, out_list);
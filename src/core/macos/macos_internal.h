@@ -141,6 +141,11 @@ MARU_Status maru_pumpEvents_Cocoa(MARU_Context *context, uint32_t timeout_ms,
                                    MARU_EventMask mask,
                                    MARU_EventCallback callback,
                                    void *userdata);
+MARU_Status maru_pumpEventsUntil_Cocoa(MARU_Context *context,
+                                        uint64_t deadline_ns,
+                                        MARU_EventMask mask,
+                                        MARU_EventCallback callback,
+                                        void *userdata);
 MARU_Status maru_wakeContext_Cocoa(MARU_Context *context);
 void *_maru_getContextNativeHandle_Cocoa(MARU_Context *context);
 
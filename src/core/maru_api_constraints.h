@@ -404,6 +404,9 @@ _maru_validate_createContext(const MARU_ContextCreateInfo *create_info,
       _maru_validate_allocator_complete(create_info->allocator));
   MARU_CONSTRAINT_CHECK(_maru_validate_optional_power_of_two_u32(
       create_info->tuning.user_event_queue_size));
+  MARU_CONSTRAINT_CHECK(create_info->tuning.controller.analog_deadzone >= (MARU_Scalar)0.0 &&
+                        create_info->tuning.controller.analog_deadzone < (MARU_Scalar)1.0);
+  MARU_CONSTRAINT_CHECK(create_info->tuning.controller.analog_epsilon >= (MARU_Scalar)0.0);
 }
 
 static inline void _maru_validate_destroyContext(MARU_Context *context) {
@@ -437,6 +440,15 @@ static inline void _maru_validate_pumpEvents(MARU_Context *context,
   (void)userdata;
 }
 
+static inline void _maru_validate_pumpEventsUntil(MARU_Context *context,
+                                                  uint64_t deadline_ns,
+                                                  MARU_EventMask mask,
+                                                  MARU_EventCallback callback,
+                                                  void *userdata) {
+  _maru_validate_pumpEvents(context, 0, mask, callback, userdata);
+  (void)deadline_ns;
+}
+
 static inline void
 _maru_validate_createWindow(MARU_Context *context,
                             const MARU_WindowCreateInfo *create_info,
@@ -575,6 +587,8 @@ _maru_validate_createQueue(const MARU_QueueCreateInfo *create_info,
   MARU_CONSTRAINT_CHECK(create_info != NULL);
   MARU_CONSTRAINT_CHECK(out_queue != NULL);
   MARU_CONSTRAINT_CHECK(create_info->capacity > 0u);
+  MARU_CONSTRAINT_CHECK(create_info->max_capacity == 0u ||
+                        create_info->max_capacity >= create_info->capacity);
   MARU_CONSTRAINT_CHECK(
       _maru_validate_allocator_complete(create_info->allocator));
 }
@@ -613,6 +627,73 @@ static inline void _maru_validate_scanQueue(const MARU_Queue *queue,
   (void)userdata;
 }
 
+static inline void
+_maru_validate_scanQueueForWindow(const MARU_Queue *queue,
+                                  MARU_WindowId window_id,
+                                  MARU_EventMask mask,
+                                  MARU_QueueEventCallback callback,
+                                  void *userdata) {
+  _maru_validate_scanQueue(queue, mask, callback, userdata);
+  (void)window_id;
+}
+
+static inline void _maru_validate_getQueueGeneration(const MARU_Queue *queue) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+}
+
+static inline void _maru_validate_waitQueue(const MARU_Queue *queue,
+                                            uint32_t last_seen_generation,
+                                            uint64_t timeout_ns) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  (void)last_seen_generation;
+  (void)timeout_ns;
+}
+
+static inline void _maru_validate_getQueueView(const MARU_Queue *queue,
+                                               MARU_QueueView *out_view) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  MARU_CONSTRAINT_CHECK(out_view != NULL);
+}
+
+static inline void _maru_validate_releaseQueueView(const MARU_Queue *queue,
+                                                   const MARU_QueueView *view) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  MARU_CONSTRAINT_CHECK(view != NULL);
+  MARU_CONSTRAINT_CHECK(view->buffer_index < 3u);
+}
+
+static inline void _maru_validate_recordQueue(MARU_Queue *queue,
+                                              const char *path) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  _maru_validate_queue_creator_thread(queue);
+  (void)path;
+}
+
+static inline void
+_maru_validate_openQueueRecording(const char *path,
+                                  const MARU_QueueCreateInfo *create_info,
+                                  MARU_Queue **out_queue) {
+  MARU_CONSTRAINT_CHECK(path != NULL);
+  MARU_CONSTRAINT_CHECK(out_queue != NULL);
+  if (create_info) {
+    MARU_CONSTRAINT_CHECK(
+        _maru_validate_allocator_complete(create_info->allocator));
+  }
+}
+
+static inline void _maru_validate_rewindQueueRecording(MARU_Queue *queue) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  _maru_validate_queue_creator_thread(queue);
+}
+
+static inline void
+_maru_validate_getQueueRecordingInfo(const MARU_Queue *queue,
+                                     MARU_QueueRecordingInfo *out_info) {
+  MARU_CONSTRAINT_CHECK(queue != NULL);
+  _maru_validate_queue_creator_thread(queue);
+  MARU_CONSTRAINT_CHECK(out_info != NULL);
+}
+
 static inline void _maru_validate_setQueueCoalesceMask(MARU_Queue *queue, MARU_EventMask mask) {
   MARU_CONSTRAINT_CHECK(queue != NULL);
   _maru_validate_queue_creator_thread(queue);
@@ -799,6 +880,35 @@ _maru_validate_provideDropData(MARU_DataRequest *request, const void *data,
       MARU_DATA_EXCHANGE_TARGET_DRAG_DROP);
 }
 
+static inline void _maru_validate_provideDataFromFd(MARU_DataRequest *request,
+                                                    int fd, uint64_t offset,
+                                                    uint64_t size) {
+  MARU_CONSTRAINT_CHECK(request != NULL);
+  const MARU_DataRequestHandleBase *handle =
+      (const MARU_DataRequestHandleBase *)request;
+  _maru_validate_thread(handle->ctx_base);
+  MARU_CONSTRAINT_CHECK(fd >= 0);
+  MARU_CONSTRAINT_CHECK(offset <= UINT64_MAX - size);
+}
+
+static inline void
+_maru_validate_provideClipboardDataFromFd(MARU_DataRequest *request, int fd,
+                                          uint64_t offset, uint64_t size) {
+  _maru_validate_provideDataFromFd(request, fd, offset, size);
+  MARU_CONSTRAINT_CHECK(
+      ((const MARU_DataRequestHandleBase *)request)->target ==
+      MARU_DATA_EXCHANGE_TARGET_CLIPBOARD);
+}
+
+static inline void
+_maru_validate_provideDropDataFromFd(MARU_DataRequest *request, int fd,
+                                     uint64_t offset, uint64_t size) {
+  _maru_validate_provideDataFromFd(request, fd, offset, size);
+  MARU_CONSTRAINT_CHECK(
+      ((const MARU_DataRequestHandleBase *)request)->target ==
+      MARU_DATA_EXCHANGE_TARGET_DRAG_DROP);
+}
+
 static inline void _maru_validate_requestData(MARU_Window *window,
                                               MARU_DataExchangeTarget target,
                                               const char *mime_type,
@@ -828,6 +938,18 @@ static inline void _maru_validate_requestDropData(MARU_Window *window,
                              mime_type, userdata);
 }
 
+static inline void
+_maru_validate_requestClipboardDataStream(MARU_Context *context,
+                                          const char *mime_type, void *userdata) {
+  _maru_validate_requestClipboardData(context, mime_type, userdata);
+}
+
+static inline void _maru_validate_requestDropDataStream(MARU_Window *window,
+                                                        const char *mime_type,
+                                                        void *userdata) {
+  _maru_validate_requestDropData(window, mime_type, userdata);
+}
+
 static inline void
 _maru_validate_getAvailableMIMETypes(const MARU_Window *window,
                                      MARU_DataExchangeTarget target,
@@ -867,6 +989,43 @@ static inline void _maru_validate_postEvent(MARU_Context *context,
   (void)evt;
 }
 
+static inline void _maru_validate_postEventPayload(MARU_Context *context,
+                                                   MARU_EventId type,
+                                                   const void *payload,
+                                                   size_t size) {
+  MARU_CONSTRAINT_CHECK(context != NULL);
+  MARU_CONSTRAINT_CHECK(maru_isUserEventId(type));
+  MARU_CONSTRAINT_CHECK(((const MARU_Context_Base *)context)->user_events_enabled);
+  MARU_CONSTRAINT_CHECK(payload != NULL || size == 0);
+  MARU_CONSTRAINT_CHECK(size <= sizeof(MARU_UserDefinedEvent));
+  (void)type;
+  (void)payload;
+  (void)size;
+}
+
+static inline void _maru_validate_postEvents(MARU_Context *context,
+                                             const MARU_EventId *types,
+                                             const MARU_UserDefinedEvent *events,
+                                             uint32_t count,
+                                             uint32_t *out_posted_count) {
+  MARU_CONSTRAINT_CHECK(context != NULL);
+  MARU_CONSTRAINT_CHECK(count == 0 || (types != NULL && events != NULL));
+  MARU_CONSTRAINT_CHECK(((const MARU_Context_Base *)context)->user_events_enabled);
+  for (uint32_t i = 0; i < count; ++i) {
+    MARU_CONSTRAINT_CHECK(maru_isUserEventId(types[i]));
+  }
+  (void)types;
+  (void)events;
+  (void)out_posted_count;
+}
+
+static inline void
+_maru_validate_getUserEventQueueStats(const MARU_Context *context,
+                                      MARU_UserEventQueueStats *out_stats) {
+  MARU_CONSTRAINT_CHECK(context != NULL);
+  MARU_CONSTRAINT_CHECK(out_stats != NULL);
+}
+
 static inline void _maru_validate_getMonitors(const MARU_Context *context,
                                               MARU_MonitorList *out_list) {
   MARU_CONSTRAINT_CHECK(context != NULL);
@@ -1066,6 +1225,18 @@ static inline void _maru_validate_live_requestDropData(MARU_Window *window,
                                   mime_type, userdata);
 }
 
+static inline void
+_maru_validate_live_requestClipboardDataStream(MARU_Context *context,
+                                               const char *mime_type,
+                                               void *userdata) {
+  _maru_validate_live_requestClipboardData(context, mime_type, userdata);
+}
+
+static inline void _maru_validate_live_requestDropDataStream(
+    MARU_Window *window, const char *mime_type, void *userdata) {
+  _maru_validate_live_requestDropData(window, mime_type, userdata);
+}
+
 static inline void _maru_validate_live_getAvailableMIMETypes(
     const MARU_Window *window, MARU_DataExchangeTarget target,
     MARU_StringList *out_list) {
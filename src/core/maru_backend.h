@@ -12,6 +12,7 @@ typedef struct MARU_Backend {
   __typeof__(maru_updateContext) *updateContext;
 
   __typeof__(maru_pumpEvents) *pumpEvents;
+  __typeof__(maru_pumpEventsUntil) *pumpEventsUntil;
   __typeof__(maru_wakeContext) *wakeContext;
 
   __typeof__(maru_createWindow) *createWindow;
@@ -34,8 +35,11 @@ typedef struct MARU_Backend {
   __typeof__(maru_announceClipboardData) *announceClipboardData;
   __typeof__(maru_announceDragData) *announceDragData;
   __typeof__(maru_provideClipboardData) *provideData;
+  __typeof__(maru_provideClipboardDataFromFd) *provideDataFromFd;
   __typeof__(maru_requestClipboardData) *requestClipboardData;
   __typeof__(maru_requestDropData) *requestDropData;
+  __typeof__(maru_requestClipboardDataStream) *requestClipboardDataStream;
+  __typeof__(maru_requestDropDataStream) *requestDropDataStream;
   __typeof__(maru_getAvailableClipboardMIMETypes) *getAvailableClipboardMIMETypes;
   __typeof__(maru_getAvailableDropMIMETypes) *getAvailableDropMIMETypes;
   
@@ -0,0 +1,186 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+#ifndef MARU_EVENT_FILTER_H_INCLUDED
+#define MARU_EVENT_FILTER_H_INCLUDED
+
+#include "maru/maru.h"
+
+// Kernel selection is compile-time. AVX2 handles any mask; the SSE2 and NEON
+// kernels compare against a short list of ids and leave wide masks to the
+// scalar loop.
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define MARU_EVENT_FILTER_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define MARU_EVENT_FILTER_SSE2
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define MARU_EVENT_FILTER_NEON
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Number of events classified by one _maru_event_filter_block() call.
+#define MARU_EVENT_FILTER_BLOCK 64u
+// Masks selecting at most this many ids can use the compare kernels.
+#define MARU_EVENT_FILTER_MAX_IDS 4u
+
+_Static_assert(sizeof(MARU_EventId) == sizeof(uint32_t),
+               "The filter kernels load event ids as 32-bit lanes");
+
+typedef struct MARU_EventFilter {
+  MARU_EventMask mask;
+  // Ids selected by `mask`, padded by repeating the first one. Only valid
+  // when `use_ids` is set.
+  uint32_t ids[MARU_EVENT_FILTER_MAX_IDS];
+  bool use_ids;
+} MARU_EventFilter;
+
+static inline uint32_t _maru_event_filter_ctz64(uint64_t bits) {
+#if defined(__GNUC__) || defined(__clang__)
+  return (uint32_t)__builtin_ctzll(bits);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index;
+  _BitScanForward64(&index, bits);
+  return (uint32_t)index;
+#else
+  uint32_t index = 0;
+  while ((bits & 1u) == 0u) {
+    bits >>= 1;
+    ++index;
+  }
+  return index;
+#endif
+}
+
+static inline void _maru_event_filter_init(MARU_EventFilter *filter,
+                                           MARU_EventMask mask) {
+  *filter = (MARU_EventFilter){.mask = mask, .use_ids = mask != 0};
+
+  uint32_t id_count = 0;
+  for (MARU_EventMask rest = mask; rest != 0; rest &= rest - 1u) {
+    if (id_count == MARU_EVENT_FILTER_MAX_IDS) {
+      filter->use_ids = false;
+      return;
+    }
+    filter->ids[id_count++] = _maru_event_filter_ctz64(rest);
+  }
+  for (uint32_t i = id_count; i < MARU_EVENT_FILTER_MAX_IDS; ++i) {
+    filter->ids[i] = filter->ids[0];
+  }
+}
+
+static inline uint64_t
+_maru_event_filter_scalar(const MARU_EventFilter *filter,
+                          const MARU_EventId *types, uint32_t first,
+                          uint32_t count) {
+  uint64_t bits = 0;
+  for (uint32_t i = first; i < count; ++i) {
+    bits |= (uint64_t)maru_eventMaskHas(filter->mask, types[i]) << i;
+  }
+  return bits;
+}
+
+#if defined(MARU_EVENT_FILTER_AVX2)
+static inline uint64_t _maru_event_filter_avx2(const MARU_EventFilter *filter,
+                                               const MARU_EventId *types,
+                                               uint32_t count) {
+  const __m256i mask_lo = _mm256_set1_epi32((int)(uint32_t)filter->mask);
+  const __m256i mask_hi = _mm256_set1_epi32((int)(uint32_t)(filter->mask >> 32));
+  const __m256i half = _mm256_set1_epi32(32);
+  uint64_t bits = 0;
+  uint32_t i = 0;
+  for (; i + 8u <= count; i += 8u) {
+    const __m256i ids = _mm256_loadu_si256((const __m256i *)(const void *)(types + i));
+    // Variable shifts by 32 or more yield 0, so each half of the mask only
+    // answers for its own ids, and out of range ids match neither.
+    __m256i hit = _mm256_or_si256(
+        _mm256_srlv_epi32(mask_lo, ids),
+        _mm256_srlv_epi32(mask_hi, _mm256_sub_epi32(ids, half)));
+    hit = _mm256_slli_epi32(hit, 31);
+    bits |= (uint64_t)(uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hit)) << i;
+  }
+  return bits | _maru_event_filter_scalar(filter, types, i, count);
+}
+#elif defined(MARU_EVENT_FILTER_SSE2)
+static inline uint64_t _maru_event_filter_sse2(const MARU_EventFilter *filter,
+                                               const MARU_EventId *types,
+                                               uint32_t count) {
+  const __m128i id0 = _mm_set1_epi32((int)filter->ids[0]);
+  const __m128i id1 = _mm_set1_epi32((int)filter->ids[1]);
+  const __m128i id2 = _mm_set1_epi32((int)filter->ids[2]);
+  const __m128i id3 = _mm_set1_epi32((int)filter->ids[3]);
+  uint64_t bits = 0;
+  uint32_t i = 0;
+  for (; i + 4u <= count; i += 4u) {
+    const __m128i ids = _mm_loadu_si128((const __m128i *)(const void *)(types + i));
+    const __m128i hit =
+        _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi32(ids, id0), _mm_cmpeq_epi32(ids, id1)),
+                     _mm_or_si128(_mm_cmpeq_epi32(ids, id2), _mm_cmpeq_epi32(ids, id3)));
+    bits |= (uint64_t)(uint32_t)_mm_movemask_ps(_mm_castsi128_ps(hit)) << i;
+  }
+  return bits | _maru_event_filter_scalar(filter, types, i, count);
+}
+#elif defined(MARU_EVENT_FILTER_NEON)
+static inline uint64_t _maru_event_filter_neon(const MARU_EventFilter *filter,
+                                               const MARU_EventId *types,
+                                               uint32_t count) {
+  static const uint32_t lane_bits[4] = {1u, 2u, 4u, 8u};
+  const uint32x4_t weights = vld1q_u32(lane_bits);
+  const uint32x4_t id0 = vdupq_n_u32(filter->ids[0]);
+  const uint32x4_t id1 = vdupq_n_u32(filter->ids[1]);
+  const uint32x4_t id2 = vdupq_n_u32(filter->ids[2]);
+  const uint32x4_t id3 = vdupq_n_u32(filter->ids[3]);
+  uint64_t bits = 0;
+  uint32_t i = 0;
+  for (; i + 4u <= count; i += 4u) {
+    const uint32x4_t ids = vld1q_u32((const uint32_t *)(const void *)(types + i));
+    const uint32x4_t hit =
+        vorrq_u32(vorrq_u32(vceqq_u32(ids, id0), vceqq_u32(ids, id1)),
+                  vorrq_u32(vceqq_u32(ids, id2), vceqq_u32(ids, id3)));
+    // NEON has no movemask; weigh each lane by its bit and sum across.
+    bits |= (uint64_t)vaddvq_u32(vandq_u32(hit, weights)) << i;
+  }
+  return bits | _maru_event_filter_scalar(filter, types, i, count);
+}
+#endif
+
+// False when no kernel covers the filter's mask. Building bitmaps one entry at
+// a time is slower than testing entries inline, so callers should loop over
+// maru_eventMaskHas() themselves in that case.
+static inline bool _maru_event_filter_is_vectorized(const MARU_EventFilter *filter) {
+#if defined(MARU_EVENT_FILTER_AVX2)
+  return filter->mask != 0;
+#elif defined(MARU_EVENT_FILTER_SSE2) || defined(MARU_EVENT_FILTER_NEON)
+  return filter->use_ids;
+#else
+  (void)filter;
+  return false;
+#endif
+}
+
+// Returns a bitmap of the entries of `types[0..count)` selected by the filter,
+// bit `i` standing for `types[i]`. `count` must not exceed
+// MARU_EVENT_FILTER_BLOCK.
+static inline uint64_t _maru_event_filter_block(const MARU_EventFilter *filter,
+                                                const MARU_EventId *types,
+                                                uint32_t count) {
+#if defined(MARU_EVENT_FILTER_AVX2)
+  return _maru_event_filter_avx2(filter, types, count);
+#elif defined(MARU_EVENT_FILTER_SSE2)
+  if (filter->use_ids) {
+    return _maru_event_filter_sse2(filter, types, count);
+  }
+#elif defined(MARU_EVENT_FILTER_NEON)
+  if (filter->use_ids) {
+    return _maru_event_filter_neon(filter, types, count);
+  }
+#endif
+  return _maru_event_filter_scalar(filter, types, 0, count);
+}
+
+#endif
@@ -212,6 +212,10 @@ bool _maru_advance_animated_cursors(MARU_Context_Base *ctx_base, uint64_t now_ms
 uint32_t _maru_adjust_timeout_for_cursor_animation(const MARU_Context_Base *ctx_base,
                                                    uint32_t timeout_ms,
                                                    uint64_t now_ms);
+uint64_t _maru_adjust_deadline_for_cursor_animation(const MARU_Context_Base *ctx_base,
+                                                    uint64_t deadline_ns);
+uint64_t _maru_timeout_ms_to_deadline_ns(uint32_t timeout_ms, uint64_t now_ns);
+uint32_t _maru_deadline_ns_to_timeout_ms(uint64_t deadline_ns, uint64_t now_ns);
 
 /** @brief Posts an event to the internal thread-safe queue. 
  *
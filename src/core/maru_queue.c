@@ -3,49 +3,17 @@
 
 #include "maru/queue.h"
 #include "maru_api_constraints.h"
+#include "maru_event_filter.h"
 #include "maru_internal.h"
+#include "maru_queue_internal.h"
 #include <limits.h>
 #include <stdlib.h>
 #include <string.h>
 
-typedef struct MARU_QueueBuffer {
-    MARU_EventId *types;
-    MARU_WindowId *window_ids;
-    MARU_Event *events;
-    void *bulk_ptr;
-} MARU_QueueBuffer;
-
-typedef struct MARU_Queue {
-    MARU_Allocator allocator;
-    MARU_DiagnosticCallback diagnostic_cb;
-    void *diagnostic_userdata;
-    MARU_QueueBuffer active;
-    MARU_QueueBuffer stable;
-
-    uint32_t active_count;
-    uint32_t stable_count;
-    uint32_t capacity;
-
-    MARU_EventMask coalesce_mask;
-
-    MARU_QueueBuffer buffers[2];
-#ifdef MARU_VALIDATE_API_CALLS
-    MARU_ThreadId creator_thread;
-#endif
-} MARU_Queue;
-
-#define MARU_QUEUE_COMPACT_MAP_CAPACITY 64u
 #define MARU_QUEUE_EVENT_BUCKET_COUNT ((uint32_t)MARU_EVENT_USER_15 + 1u)
 #define MARU_QUEUE_INVALID_EVENT_ID ((MARU_EventId)-1)
 
-typedef struct MARU_QueueCompactMapEntry {
-    MARU_EventId type;
-    MARU_WindowId window_id;
-    uint32_t survivor_idx;
-    bool used;
-} MARU_QueueCompactMapEntry;
-
-static MARU_Allocator _maru_queue_resolve_allocator(const MARU_Allocator *allocator) {
+MARU_Allocator _maru_queue_resolve_allocator(const MARU_Allocator *allocator) {
     if (allocator && allocator->alloc_cb) {
         return *allocator;
     }
@@ -57,17 +25,17 @@ static MARU_Allocator _maru_queue_resolve_allocator(const MARU_Allocator *alloca
     };
 }
 
-static void *_maru_queue_alloc_raw(const MARU_Allocator *allocator, size_t size) {
+void *_maru_queue_alloc_raw(const MARU_Allocator *allocator, size_t size) {
     return allocator->alloc_cb(size, allocator->userdata);
 }
 
-static void _maru_queue_free_raw(const MARU_Allocator *allocator, void *ptr) {
+void _maru_queue_free_raw(const MARU_Allocator *allocator, void *ptr) {
     if (ptr) {
         allocator->free_cb(ptr, allocator->userdata);
     }
 }
 
-static void *_maru_queue_alloc_aligned64(const MARU_Allocator *allocator, size_t size) {
+void *_maru_queue_alloc_aligned64(const MARU_Allocator *allocator, size_t size) {
     const size_t alignment = 64u;
     void *ptr = _maru_queue_alloc_raw(allocator, size + alignment + sizeof(void *));
     if (!ptr) {
@@ -80,14 +48,14 @@ static void *_maru_queue_alloc_aligned64(const MARU_Allocator *allocator, size_t
     return aligned_ptr;
 }
 
-static void _maru_queue_free_aligned64(const MARU_Allocator *allocator, void *ptr) {
+void _maru_queue_free_aligned64(const MARU_Allocator *allocator, void *ptr) {
     if (ptr) {
         void *original_ptr = ((void **)ptr)[-1];
         _maru_queue_free_raw(allocator, original_ptr);
     }
 }
 
-static void _maru_queue_report_diagnostic_raw(MARU_DiagnosticCallback cb,
+void _maru_queue_report_diagnostic_raw(MARU_DiagnosticCallback cb,
                                               void *userdata,
                                               MARU_Diagnostic diagnostic,
                                               const char *message) {
@@ -104,7 +72,7 @@ static void _maru_queue_report_diagnostic_raw(MARU_DiagnosticCallback cb,
     cb(&info, userdata);
 }
 
-static void _maru_queue_report_diagnostic(MARU_Queue *queue,
+void _maru_queue_report_diagnostic(MARU_Queue *queue,
                                           MARU_Diagnostic diagnostic,
                                           const char *message) {
     if (!queue) {
@@ -116,7 +84,7 @@ static void _maru_queue_report_diagnostic(MARU_Queue *queue,
 }
 
 #ifdef MARU_VALIDATE_API_CALLS
-static void _maru_queue_validate_thread(const MARU_Queue *queue) {
+void _maru_queue_validate_thread(const MARU_Queue *queue) {
     MARU_CONSTRAINT_CHECK(queue->creator_thread == _maru_getCurrentThreadId());
 }
 
@@ -124,7 +92,7 @@ void _maru_validate_queue_creator_thread(const MARU_Queue *queue) {
     _maru_queue_validate_thread(queue);
 }
 #else
-static void _maru_queue_validate_thread(const MARU_Queue *queue) {
+void _maru_queue_validate_thread(const MARU_Queue *queue) {
     (void)queue;
 }
 
@@ -142,6 +110,7 @@ static void _maru_queue_coalesce_latest(MARU_EventId type, MARU_Event *dst, cons
             dst->mouse_moved.raw_dip_delta.x += src->mouse_moved.raw_dip_delta.x;
             dst->mouse_moved.raw_dip_delta.y += src->mouse_moved.raw_dip_delta.y;
             dst->mouse_moved.modifiers = src->mouse_moved.modifiers;
+            dst->mouse_moved.timestamp_ns = src->mouse_moved.timestamp_ns;
             break;
         case MARU_EVENT_MOUSE_SCROLLED:
             dst->mouse_scrolled.dip_delta.x += src->mouse_scrolled.dip_delta.x;
@@ -149,6 +118,7 @@ static void _maru_queue_coalesce_latest(MARU_EventId type, MARU_Event *dst, cons
             dst->mouse_scrolled.steps.x += src->mouse_scrolled.steps.x;
             dst->mouse_scrolled.steps.y += src->mouse_scrolled.steps.y;
             dst->mouse_scrolled.modifiers = src->mouse_scrolled.modifiers;
+            dst->mouse_scrolled.timestamp_ns = src->mouse_scrolled.timestamp_ns;
             break;
         case MARU_EVENT_WINDOW_RESIZED:
             dst->window_resized.geometry = src->window_resized.geometry;
@@ -191,53 +161,71 @@ static uint32_t _maru_queue_compact_hash(MARU_EventId type,
     return h;
 }
 
-static bool _maru_queue_compact_map_find(const MARU_QueueCompactMapEntry *map, uint32_t cap,
-                                         MARU_EventId type,
-                                         MARU_WindowId window_id,
-                                         uint32_t *out_survivor_idx) {
-    uint32_t idx = _maru_queue_compact_hash(type, window_id) & (cap - 1u);
-    for (uint32_t probe = 0; probe < cap; ++probe) {
-        const MARU_QueueCompactMapEntry *entry = &map[idx];
-        if (!entry->used) return false;
-        if (entry->type == type && entry->window_id == window_id) {
-            *out_survivor_idx = entry->survivor_idx;
-            return true;
-        }
-        idx = (idx + 1u) & (cap - 1u);
-    }
-    return false;
-}
-
-static bool _maru_queue_compact_map_insert(MARU_QueueCompactMapEntry *map, uint32_t cap,
-                                           MARU_EventId type,
-                                           MARU_WindowId window_id,
-                                           uint32_t survivor_idx) {
-    uint32_t idx = _maru_queue_compact_hash(type, window_id) & (cap - 1u);
-    for (uint32_t probe = 0; probe < cap; ++probe) {
-        MARU_QueueCompactMapEntry *entry = &map[idx];
-        if (!entry->used) {
-            entry->used = true;
-            entry->type = type;
-            entry->window_id = window_id;
-            entry->survivor_idx = survivor_idx;
-            return true;
-        }
-        if (entry->type == type && entry->window_id == window_id) {
-            entry->survivor_idx = survivor_idx;
-            return true;
+static uint32_t _maru_queue_compact_map_capacity_for(uint32_t buffer_capacity) {
+    uint32_t cap = 16u;
+    while ((uint64_t)cap < (uint64_t)buffer_capacity * 2u && cap < 0x80000000u) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+// Makes sure the compaction index fits a buffer of `buffer_capacity` events,
+// and replaces an oversized one. Returns false only when a larger index is
+// needed and cannot be allocated.
+static bool _maru_queue_reserve_compact_map(MARU_Queue *q, uint32_t buffer_capacity) {
+    const uint32_t wanted = _maru_queue_compact_map_capacity_for(buffer_capacity);
+    if (q->compact_map && q->compact_map_capacity >= wanted &&
+        q->compact_map_capacity <= wanted * 4u) {
+        return true;
+    }
+
+    const size_t size = sizeof(MARU_QueueCompactMapEntry) * wanted;
+    MARU_QueueCompactMapEntry *map =
+        (MARU_QueueCompactMapEntry *)_maru_queue_alloc_raw(&q->allocator, size);
+    if (!map) {
+        return q->compact_map && q->compact_map_capacity >= wanted;
+    }
+    memset(map, 0, size);
+    _maru_queue_free_raw(&q->allocator, q->compact_map);
+    q->compact_map = map;
+    q->compact_map_capacity = wanted;
+    q->compact_generation = 0;
+    return true;
+}
+
+// Returns the live entry for the key, or the free slot where it belongs.
+static MARU_QueueCompactMapEntry *_maru_queue_compact_map_slot(MARU_Queue *q,
+                                                              MARU_EventId type,
+                                                              MARU_WindowId window_id) {
+    const uint32_t cap_mask = q->compact_map_capacity - 1u;
+    uint32_t idx = _maru_queue_compact_hash(type, window_id) & cap_mask;
+    for (;;) {
+        MARU_QueueCompactMapEntry *entry = &q->compact_map[idx];
+        if (entry->generation != q->compact_generation ||
+            (entry->type == type && entry->window_id == window_id)) {
+            return entry;
         }
-        idx = (idx + 1u) & (cap - 1u);
+        idx = (idx + 1u) & cap_mask;
     }
-    return false;
 }
 
 static uint32_t _maru_queue_compact_active(MARU_Queue *q) {
     uint32_t count = q->active_count;
-    if (count == 0) return 0;
+    if (count == 0 || q->coalesce_mask == 0) return 0;
+
+    if (!_maru_queue_reserve_compact_map(q, q->buffer_capacities[q->active_index])) {
+        _maru_queue_report_diagnostic(
+            q, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
+            "Queue compaction skipped because the index allocation failed");
+        return 0;
+    }
 
-    MARU_QueueCompactMapEntry map[MARU_QUEUE_COMPACT_MAP_CAPACITY];
-    memset(map, 0, sizeof(map));
-    bool map_saturated = false;
+    // A new generation empties the index without touching it.
+    if (++q->compact_generation == 0u) {
+        memset(q->compact_map, 0,
+               sizeof(MARU_QueueCompactMapEntry) * q->compact_map_capacity);
+        q->compact_generation = 1u;
+    }
     uint32_t removed = 0;
 
     for (uint32_t i = count; i-- > 0;) {
@@ -245,33 +233,20 @@ static uint32_t _maru_queue_compact_active(MARU_Queue *q) {
         if (!maru_eventMaskHas(q->coalesce_mask, type)) continue;
 
         MARU_WindowId window_id = q->active.window_ids[i];
-        uint32_t survivor_idx = UINT32_MAX;
-        bool found = _maru_queue_compact_map_find(
-            map, MARU_QUEUE_COMPACT_MAP_CAPACITY, type, window_id,
-            &survivor_idx);
-
-        if (!found && map_saturated) {
-            for (uint32_t j = i + 1u; j < count; ++j) {
-                if (q->active.types[j] == type &&
-                    q->active.window_ids[j] == window_id) {
-                    survivor_idx = j;
-                    found = true;
-                    break;
-                }
-            }
-        }
+        MARU_QueueCompactMapEntry *entry =
+            _maru_queue_compact_map_slot(q, type, window_id);
 
-        if (found) {
-            _maru_queue_fold_older_into_survivor(type, &q->active.events[i], &q->active.events[survivor_idx]);
+        if (entry->generation == q->compact_generation) {
+            _maru_queue_fold_older_into_survivor(type, &q->active.events[i], &q->active.events[entry->survivor_idx]);
             q->active.types[i] = MARU_QUEUE_INVALID_EVENT_ID;
             removed++;
             continue;
         }
 
-        if (!_maru_queue_compact_map_insert(
-                map, MARU_QUEUE_COMPACT_MAP_CAPACITY, type, window_id, i)) {
-            map_saturated = true;
-        }
+        entry->generation = q->compact_generation;
+        entry->type = type;
+        entry->window_id = window_id;
+        entry->survivor_idx = i;
     }
 
     if (removed == 0) return 0;
@@ -291,6 +266,117 @@ static uint32_t _maru_queue_compact_active(MARU_Queue *q) {
     return removed;
 }
 
+static bool _maru_queue_buffer_init(const MARU_Allocator *allocator, MARU_QueueBuffer *buf,
+                                    uint32_t capacity, bool index_windows);
+static void _maru_queue_buffer_cleanup(const MARU_Allocator *allocator, MARU_QueueBuffer *buf);
+
+// Doubles the active buffer, up to `max_capacity`, keeping its events.
+static bool _maru_queue_grow_active(MARU_Queue *q) {
+    const uint32_t old_capacity = q->buffer_capacities[q->active_index];
+    uint32_t new_capacity = (old_capacity > q->max_capacity / 2u)
+                                ? q->max_capacity
+                                : old_capacity * 2u;
+    if (new_capacity < q->capacity) {
+        new_capacity = q->capacity;
+    }
+
+    MARU_QueueBuffer grown;
+    if (!_maru_queue_buffer_init(&q->allocator, &grown, new_capacity, q->index_windows)) {
+        _maru_queue_report_diagnostic(
+            q, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
+            "Queue growth failed because the buffer allocation failed");
+        return false;
+    }
+
+    const uint32_t count = q->active_count;
+    memcpy(grown.types, q->active.types, sizeof(MARU_EventId) * count);
+    memcpy(grown.window_ids, q->active.window_ids, sizeof(MARU_WindowId) * count);
+    memcpy(grown.events, q->active.events, sizeof(MARU_Event) * count);
+
+    _maru_queue_buffer_cleanup(&q->allocator, &q->buffers[q->active_index]);
+    q->buffers[q->active_index] = grown;
+    q->active = grown;
+    q->buffer_capacities[q->active_index] = new_capacity;
+    if (new_capacity > q->capacity) {
+        q->capacity = new_capacity;
+    }
+    q->idle_commits = 0;
+    return true;
+}
+
+// Brings an unpublished, empty buffer to the current target capacity. The old
+// buffer is kept if the allocation fails; pushes will retry growing it.
+static void _maru_queue_resize_idle_buffer(MARU_Queue *q, uint32_t index) {
+    MARU_QueueBuffer resized;
+    if (!_maru_queue_buffer_init(&q->allocator, &resized, q->capacity, q->index_windows)) {
+        return;
+    }
+    _maru_queue_buffer_cleanup(&q->allocator, &q->buffers[index]);
+    q->buffers[index] = resized;
+    q->buffer_capacities[index] = q->capacity;
+}
+
+// Halves the target capacity once enough consecutive commits stayed under a
+// quarter of it.
+static void _maru_queue_track_usage(MARU_Queue *q, uint32_t committed_count) {
+    if (q->shrink_after_commits == 0u || q->capacity <= q->min_capacity ||
+        committed_count >= q->capacity / 4u) {
+        q->idle_commits = 0;
+        return;
+    }
+    if (++q->idle_commits >= q->shrink_after_commits) {
+        const uint32_t half = q->capacity / 2u;
+        q->capacity = half > q->min_capacity ? half : q->min_capacity;
+        q->idle_commits = 0;
+    }
+}
+
+static uint32_t _maru_queue_window_hash(MARU_WindowId window_id) {
+    const uint64_t id_bits = (uint64_t)window_id;
+    return ((uint32_t)id_bits ^ (uint32_t)(id_bits >> 32u)) * 0x9E3779B1u;
+}
+
+// Returns the live slot for `window_id`, or the free slot where it belongs.
+static MARU_QueueWindowSlot *_maru_queue_window_slot(const MARU_QueueBuffer *buf,
+                                                     MARU_WindowId window_id) {
+    const uint32_t slot_mask = buf->window_slot_count - 1u;
+    uint32_t idx = _maru_queue_window_hash(window_id) & slot_mask;
+    for (;;) {
+        MARU_QueueWindowSlot *slot = &buf->window_slots[idx];
+        if (slot->generation != buf->window_generation || slot->window_id == window_id) {
+            return slot;
+        }
+        idx = (idx + 1u) & slot_mask;
+    }
+}
+
+// Links each event of an unpublished buffer to the next one of its window.
+static void _maru_queue_index_windows(MARU_QueueBuffer *buf, uint32_t count) {
+    if (++buf->window_generation == 0u) {
+        memset(buf->window_slots, 0, sizeof(MARU_QueueWindowSlot) * buf->window_slot_count);
+        buf->window_generation = 1u;
+    }
+
+    MARU_QueueWindowSlot *slot = NULL;
+    for (uint32_t i = 0; i < count; ++i) {
+        const MARU_WindowId window_id = buf->window_ids[i];
+        buf->window_next[i] = MARU_QUEUE_WINDOW_END;
+        // Events of one window tend to arrive in runs; skip the lookup then.
+        if (!slot || slot->window_id != window_id) {
+            slot = _maru_queue_window_slot(buf, window_id);
+            if (slot->generation != buf->window_generation) {
+                slot->generation = buf->window_generation;
+                slot->window_id = window_id;
+                slot->first = i;
+                slot->last = i;
+                continue;
+            }
+        }
+        buf->window_next[slot->last] = i;
+        slot->last = i;
+    }
+}
+
 static bool _maru_queue_push_internal(MARU_Queue *q, MARU_EventId type,
                                       MARU_WindowId window_id,
                                       const MARU_Event *evt) {
@@ -303,11 +389,16 @@ static bool _maru_queue_push_internal(MARU_Queue *q, MARU_EventId type,
         }
     }
 
-    if (q->active_count >= q->capacity) {
+    if (q->active_count >= q->buffer_capacities[q->active_index]) {
         _maru_queue_compact_active(q);
     }
 
-    if (q->active_count < q->capacity) {
+    if (q->active_count >= q->buffer_capacities[q->active_index] &&
+        q->buffer_capacities[q->active_index] < q->max_capacity) {
+        _maru_queue_grow_active(q);
+    }
+
+    if (q->active_count < q->buffer_capacities[q->active_index]) {
         uint32_t idx = q->active_count++;
         q->active.types[idx] = type;
         q->active.window_ids[idx] = window_id;
@@ -321,16 +412,24 @@ static bool _maru_queue_push_internal(MARU_Queue *q, MARU_EventId type,
     }
 }
 
-static bool _maru_queue_buffer_init(const MARU_Allocator *allocator, MARU_QueueBuffer *buf, uint32_t capacity) {
+static bool _maru_queue_buffer_init(const MARU_Allocator *allocator, MARU_QueueBuffer *buf,
+                                    uint32_t capacity, bool index_windows) {
     size_t types_size = sizeof(MARU_EventId) * capacity;
     size_t window_ids_size = sizeof(MARU_WindowId) * capacity;
     size_t events_size = sizeof(MARU_Event) * capacity;
+    const uint32_t slot_count =
+        index_windows ? _maru_queue_compact_map_capacity_for(capacity) : 0u;
+    size_t window_next_size = index_windows ? sizeof(uint32_t) * capacity : 0u;
+    size_t window_slots_size = sizeof(MARU_QueueWindowSlot) * slot_count;
 
     size_t types_offset = 0;
     size_t window_ids_offset = (types_offset + types_size + 63) & ~(size_t)63;
     size_t events_offset =
         (window_ids_offset + window_ids_size + 63) & ~(size_t)63;
-    size_t total_size = events_offset + events_size;
+    size_t window_next_offset = events_offset + events_size;
+    size_t window_slots_offset =
+        (window_next_offset + window_next_size + 63) & ~(size_t)63;
+    size_t total_size = window_slots_offset + window_slots_size;
 
     void *ptr = _maru_queue_alloc_aligned64(allocator, total_size);
     if (!ptr) {
@@ -341,6 +440,16 @@ static bool _maru_queue_buffer_init(const MARU_Allocator *allocator, MARU_QueueB
     buf->window_ids =
         (MARU_WindowId *)(void *)((uint8_t *)ptr + window_ids_offset);
     buf->events = (MARU_Event *)(void *)((uint8_t *)ptr + events_offset);
+    buf->window_next = NULL;
+    buf->window_slots = NULL;
+    buf->window_slot_count = slot_count;
+    buf->window_generation = 0;
+    if (index_windows) {
+        buf->window_next = (uint32_t *)(void *)((uint8_t *)ptr + window_next_offset);
+        buf->window_slots =
+            (MARU_QueueWindowSlot *)(void *)((uint8_t *)ptr + window_slots_offset);
+        memset(buf->window_slots, 0, window_slots_size);
+    }
     buf->bulk_ptr = ptr;
     
     return true;
@@ -369,6 +478,14 @@ bool maru_createQueue(const MARU_QueueCreateInfo *create_info, MARU_Queue **out_
         }
         return false;
     }
+    if (create_info->max_capacity != 0u &&
+        create_info->max_capacity < create_info->capacity) {
+        _maru_queue_report_diagnostic_raw(
+            create_info->diagnostic_cb, create_info->diagnostic_userdata,
+            MARU_DIAGNOSTIC_INVALID_ARGUMENT,
+            "Queue creation failed because max_capacity is smaller than capacity");
+        return false;
+    }
     const bool any_custom = create_info->allocator.alloc_cb != NULL || create_info->allocator.realloc_cb != NULL || create_info->allocator.free_cb != NULL;
     if (any_custom && (create_info->allocator.alloc_cb == NULL || create_info->allocator.realloc_cb == NULL || create_info->allocator.free_cb == NULL)) {
         _maru_queue_report_diagnostic_raw(
@@ -393,32 +510,40 @@ bool maru_createQueue(const MARU_QueueCreateInfo *create_info, MARU_Queue **out_
     q->diagnostic_cb = create_info->diagnostic_cb;
     q->diagnostic_userdata = create_info->diagnostic_userdata;
     q->capacity = create_info->capacity;
+    q->min_capacity = create_info->capacity;
+    q->max_capacity = create_info->max_capacity != 0u ? create_info->max_capacity
+                                                      : create_info->capacity;
+    q->shrink_after_commits = create_info->shrink_after_commits;
+    q->buffer_count = create_info->triple_buffered ? 3u : 2u;
+    q->index_windows = create_info->index_windows;
     q->active_count = 0;
-    q->stable_count = 0;
     q->coalesce_mask = 0;
 #ifdef MARU_VALIDATE_API_CALLS
     q->creator_thread = _maru_getCurrentThreadId();
 #endif
 
-    if (!_maru_queue_buffer_init(&q->allocator, &q->buffers[0], q->capacity)) {
-        _maru_queue_report_diagnostic(
-            q, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
-            "Queue creation failed because the active buffer allocation failed");
-        _maru_queue_free_raw(&q->allocator, q);
-        return false;
-    }
-
-    if (!_maru_queue_buffer_init(&q->allocator, &q->buffers[1], q->capacity)) {
-        _maru_queue_report_diagnostic(
-            q, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
-            "Queue creation failed because the stable buffer allocation failed");
-        _maru_queue_buffer_cleanup(&q->allocator, &q->buffers[0]);
-        _maru_queue_free_raw(&q->allocator, q);
-        return false;
+    for (uint32_t i = 0; i < q->buffer_count; ++i) {
+        if (!_maru_queue_buffer_init(&q->allocator, &q->buffers[i], q->capacity,
+                                     q->index_windows)) {
+            _maru_queue_report_diagnostic(
+                q, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
+                "Queue creation failed because a buffer allocation failed");
+            while (i-- > 0) {
+                _maru_queue_buffer_cleanup(&q->allocator, &q->buffers[i]);
+            }
+            _maru_queue_free_raw(&q->allocator, q);
+            return false;
+        }
+        q->buffer_event_counts[i] = 0;
+        q->buffer_capacities[i] = q->capacity;
+        atomic_init(&q->buffer_readers[i], 0u);
     }
 
+    q->active_index = 0;
     q->active = q->buffers[0];
-    q->stable = q->buffers[1];
+    atomic_init(&q->stable_index, 1u);
+    atomic_init(&q->commit_generation, 0u);
+    atomic_init(&q->commit_waiters, 0u);
 
     *out_queue = q;
     return true;
@@ -430,8 +555,11 @@ void maru_destroyQueue(MARU_Queue *queue) {
 
     _maru_queue_validate_thread(queue);
     MARU_Allocator allocator = queue->allocator;
-    _maru_queue_buffer_cleanup(&queue->allocator, &queue->buffers[0]);
-    _maru_queue_buffer_cleanup(&queue->allocator, &queue->buffers[1]);
+    for (uint32_t i = 0; i < queue->buffer_count; ++i) {
+        _maru_queue_buffer_cleanup(&queue->allocator, &queue->buffers[i]);
+    }
+    _maru_queue_recording_cleanup(queue);
+    _maru_queue_free_raw(&queue->allocator, queue->compact_map);
     _maru_queue_free_raw(&allocator, queue);
 }
 
@@ -442,6 +570,13 @@ bool maru_pushQueue(MARU_Queue *queue, MARU_EventId type,
     if (!queue || !event) return false;
     _maru_queue_validate_thread(queue);
 
+    if (queue->playback) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_INVALID_ARGUMENT,
+            "Queue push failed because the queue replays a recording");
+        return false;
+    }
+
     return _maru_queue_push_internal(queue, type, window_id, event);
 }
 
@@ -451,18 +586,101 @@ bool maru_commitQueue(MARU_Queue *queue) {
     if (!queue) return false;
     _maru_queue_validate_thread(queue);
 
-    // O(1) swap
-    MARU_QueueBuffer tmp_buf = queue->active;
-    queue->stable = tmp_buf;
-    queue->stable_count = queue->active_count;
+    if (queue->playback) {
+        if (!_maru_queue_playback_commit(queue)) {
+            return false;
+        }
+        _maru_queue_notify_commit(queue);
+        return true;
+    }
+
+    const uint32_t committed = queue->active_index;
+    const uint32_t previous =
+        atomic_load_explicit(&queue->stable_index, memory_order_relaxed);
+    uint32_t next = previous;
+
+    if (queue->buffer_count == 3u) {
+        const uint32_t spare = 3u - committed - previous;
+        if (atomic_load(&queue->buffer_readers[spare]) == 0u) {
+            // Not published, so a scan pinning it now fails its recheck and
+            // never reads it.
+            next = spare;
+        } else {
+            // Claim the previous stable buffer so no new scan can pin it while
+            // it is being retired. If a scan already holds it, every other
+            // buffer is being scanned: keep collecting into the active buffer
+            // rather than waiting on the readers. Nothing is lost, so this is
+            // not reported as a diagnostic.
+            uint32_t idle = 0u;
+            if (!atomic_compare_exchange_strong(&queue->buffer_readers[previous], &idle,
+                                                MARU_QUEUE_BUFFER_CLAIMED)) {
+                return false;
+            }
+        }
+        if (queue->index_windows) {
+            _maru_queue_index_windows(&queue->buffers[committed], queue->active_count);
+        }
+        queue->buffer_event_counts[committed] = queue->active_count;
+        atomic_store(&queue->stable_index, committed);
+
+        if (next == previous) {
+            // Scans that loaded the old index back off on the claim and pick
+            // up the new one, so the buffer is free once the claim is dropped.
+            atomic_fetch_sub(&queue->buffer_readers[previous], MARU_QUEUE_BUFFER_CLAIMED);
+        }
+    } else {
+        // O(1) swap, plus one pass when the snapshot is indexed by window
+        if (queue->index_windows) {
+            _maru_queue_index_windows(&queue->buffers[committed], queue->active_count);
+        }
+        queue->buffer_event_counts[committed] = queue->active_count;
+        atomic_store_explicit(&queue->stable_index, committed, memory_order_release);
+    }
+
+    if (queue->recorder) {
+        _maru_queue_record_commit(queue, committed);
+    }
+    _maru_queue_track_usage(queue, queue->buffer_event_counts[committed]);
+    if (queue->buffer_capacities[next] != queue->capacity) {
+        _maru_queue_resize_idle_buffer(queue, next);
+    }
 
     // Use the other buffer for next active collection
-    queue->active = (tmp_buf.types == queue->buffers[0].types) ? queue->buffers[1] : queue->buffers[0];
+    queue->active_index = next;
+    queue->active = queue->buffers[next];
     queue->active_count = 0;
 
+    _maru_queue_notify_commit(queue);
     return true;
 }
 
+// Returns the index of the stable buffer, pinned against commits when the
+// queue is triple-buffered. Pair with _maru_queue_unpin_stable().
+static uint32_t _maru_queue_pin_stable(MARU_Queue *q) {
+    uint32_t index = atomic_load_explicit(&q->stable_index, memory_order_acquire);
+    if (q->buffer_count == 3u) {
+        // Pin, then confirm the buffer is still the published one. A commit
+        // either sees this pin and defers, or has claimed the buffer and is
+        // about to publish a newer index, in which case this scan retries.
+        for (;;) {
+            const uint32_t pins = atomic_fetch_add(&q->buffer_readers[index], 1u);
+            const uint32_t current = atomic_load(&q->stable_index);
+            if (current == index && (pins & MARU_QUEUE_BUFFER_CLAIMED) == 0u) {
+                break;
+            }
+            atomic_fetch_sub(&q->buffer_readers[index], 1u);
+            index = current;
+        }
+    }
+    return index;
+}
+
+static void _maru_queue_unpin_stable(MARU_Queue *q, uint32_t index) {
+    if (q->buffer_count == 3u) {
+        atomic_fetch_sub_explicit(&q->buffer_readers[index], 1u, memory_order_release);
+    }
+}
+
 void maru_scanQueue(const MARU_Queue *queue,
                     MARU_EventMask mask,
                     MARU_QueueEventCallback callback,
@@ -470,15 +688,102 @@ void maru_scanQueue(const MARU_Queue *queue,
     MARU_API_VALIDATE(scanQueue, queue, mask, callback, userdata);
     if (!queue || !callback) return;
 
-    MARU_QueueBuffer stable = queue->stable;
-    uint32_t count = queue->stable_count;
+    MARU_Queue *q = (MARU_Queue *)queue;
+    const uint32_t index = _maru_queue_pin_stable(q);
+    const MARU_QueueBuffer *stable = &q->buffers[index];
+    const uint32_t count = q->buffer_event_counts[index];
+
+    MARU_EventFilter filter;
+    _maru_event_filter_init(&filter, mask);
+    if (!_maru_event_filter_is_vectorized(&filter)) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (maru_eventMaskHas(mask, stable->types[i])) {
+                callback(stable->types[i], stable->window_ids[i], &stable->events[i],
+                         userdata);
+            }
+        }
+        _maru_queue_unpin_stable(q, index);
+        return;
+    }
 
-    for (uint32_t i = 0; i < count; ++i) {
-        if (maru_eventMaskHas(mask, stable.types[i])) {
-            callback(stable.types[i], stable.window_ids[i], &stable.events[i],
+    // Classify a block of types at a time, then only visit the matches.
+    for (uint32_t base = 0; base < count; base += MARU_EVENT_FILTER_BLOCK) {
+        const uint32_t remaining = count - base;
+        const uint32_t block = remaining < MARU_EVENT_FILTER_BLOCK
+                                   ? remaining
+                                   : MARU_EVENT_FILTER_BLOCK;
+        uint64_t hits =
+            _maru_event_filter_block(&filter, stable->types + base, block);
+        while (hits != 0) {
+            const uint32_t i = base + _maru_event_filter_ctz64(hits);
+            hits &= hits - 1u;
+            callback(stable->types[i], stable->window_ids[i], &stable->events[i],
                      userdata);
         }
     }
+
+    _maru_queue_unpin_stable(q, index);
+}
+
+void maru_scanQueueForWindow(const MARU_Queue *queue,
+                             MARU_WindowId window_id,
+                             MARU_EventMask mask,
+                             MARU_QueueEventCallback callback,
+                             void *userdata) {
+    MARU_API_VALIDATE(scanQueueForWindow, queue, window_id, mask, callback, userdata);
+    if (!queue || !callback) return;
+
+    MARU_Queue *q = (MARU_Queue *)queue;
+    const uint32_t index = _maru_queue_pin_stable(q);
+    const MARU_QueueBuffer *stable = &q->buffers[index];
+    const uint32_t count = q->buffer_event_counts[index];
+
+    if (!stable->window_slots) {
+        for (uint32_t i = 0; i < count; ++i) {
+            if (stable->window_ids[i] == window_id &&
+                maru_eventMaskHas(mask, stable->types[i])) {
+                callback(stable->types[i], window_id, &stable->events[i], userdata);
+            }
+        }
+        _maru_queue_unpin_stable(q, index);
+        return;
+    }
+
+    // A buffer that never held a commit has no index yet, but it is empty.
+    const MARU_QueueWindowSlot *slot =
+        count > 0 ? _maru_queue_window_slot(stable, window_id) : NULL;
+    if (slot && slot->generation == stable->window_generation) {
+        for (uint32_t i = slot->first; i != MARU_QUEUE_WINDOW_END;
+             i = stable->window_next[i]) {
+            if (maru_eventMaskHas(mask, stable->types[i])) {
+                callback(stable->types[i], window_id, &stable->events[i], userdata);
+            }
+        }
+    }
+
+    _maru_queue_unpin_stable(q, index);
+}
+
+void maru_getQueueView(const MARU_Queue *queue, MARU_QueueView *out_view) {
+    MARU_API_VALIDATE(getQueueView, queue, out_view);
+    if (!queue || !out_view) return;
+
+    MARU_Queue *q = (MARU_Queue *)queue;
+    const uint32_t index = _maru_queue_pin_stable(q);
+    const MARU_QueueBuffer *stable = &q->buffers[index];
+
+    out_view->count = q->buffer_event_counts[index];
+    out_view->types = stable->types;
+    out_view->window_ids = stable->window_ids;
+    out_view->events = stable->events;
+    out_view->buffer_index = index;
+}
+
+void maru_releaseQueueView(const MARU_Queue *queue, const MARU_QueueView *view) {
+    MARU_API_VALIDATE(releaseQueueView, queue, view);
+    if (!queue || !view) return;
+
+    _maru_queue_unpin_stable((MARU_Queue *)queue, view->buffer_index);
 }
 
 void maru_setQueueCoalesceMask(MARU_Queue *queue, MARU_EventMask mask) {
@@ -0,0 +1,125 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+#ifndef MARU_QUEUE_INTERNAL_H_INCLUDED
+#define MARU_QUEUE_INTERNAL_H_INCLUDED
+
+#include "maru/queue.h"
+#include "maru_internal.h"
+
+#include <stdatomic.h>
+
+typedef struct MARU_QueueRecorder MARU_QueueRecorder;
+typedef struct MARU_QueuePlayback MARU_QueuePlayback;
+
+// Per-window index slot, live when `generation` matches its buffer's.
+typedef struct MARU_QueueWindowSlot {
+    MARU_WindowId window_id;
+    uint32_t first;
+    uint32_t last;
+    uint32_t generation;
+} MARU_QueueWindowSlot;
+
+#define MARU_QUEUE_WINDOW_END UINT32_MAX
+
+typedef struct MARU_QueueBuffer {
+    MARU_EventId *types;
+    MARU_WindowId *window_ids;
+    MARU_Event *events;
+    // Per-window index of the committed events, only allocated for queues
+    // created with `index_windows`. `window_next[i]` is the next event of the
+    // same window after event `i`, or MARU_QUEUE_WINDOW_END.
+    uint32_t *window_next;
+    MARU_QueueWindowSlot *window_slots;
+    uint32_t window_slot_count;
+    uint32_t window_generation;
+    void *bulk_ptr;
+} MARU_QueueBuffer;
+
+#define MARU_QUEUE_MAX_BUFFERS 3u
+// Set in `buffer_readers` while a commit retires that buffer.
+#define MARU_QUEUE_BUFFER_CLAIMED 0x80000000u
+
+// Compaction index slot, live when `generation` matches the queue's.
+typedef struct MARU_QueueCompactMapEntry {
+    MARU_EventId type;
+    uint32_t survivor_idx;
+    MARU_WindowId window_id;
+    uint32_t generation;
+} MARU_QueueCompactMapEntry;
+
+typedef struct MARU_Queue {
+    MARU_Allocator allocator;
+    MARU_DiagnosticCallback diagnostic_cb;
+    void *diagnostic_userdata;
+    MARU_QueueBuffer active;
+
+    uint32_t active_count;
+    uint32_t active_index;
+    uint32_t buffer_count;
+
+    // Growth policy. `capacity` is the size buffers are brought to when they
+    // become active; it only moves within [min_capacity, max_capacity].
+    uint32_t capacity;
+    uint32_t min_capacity;
+    uint32_t max_capacity;
+    uint32_t shrink_after_commits;
+    uint32_t idle_commits; // Consecutive commits that used under a quarter of `capacity`
+
+    MARU_EventMask coalesce_mask;
+    bool index_windows;
+
+    MARU_QueueBuffer buffers[MARU_QUEUE_MAX_BUFFERS];
+    // Event count of each buffer, written while it is active and frozen once
+    // it gets published through `stable_index`.
+    uint32_t buffer_event_counts[MARU_QUEUE_MAX_BUFFERS];
+    uint32_t buffer_capacities[MARU_QUEUE_MAX_BUFFERS];
+
+    // Open-addressing (type, window_id) index used by compaction, allocated on
+    // first use. Sized to at least twice the active capacity, rounded to a
+    // power of two, so it never fills.
+    MARU_QueueCompactMapEntry *compact_map;
+    uint32_t compact_map_capacity;
+    uint32_t compact_generation;
+    _Atomic(uint32_t) stable_index;
+    // Scans in progress per buffer. Only maintained in triple-buffered mode.
+    _Atomic(uint32_t) buffer_readers[MARU_QUEUE_MAX_BUFFERS];
+
+    // Bumped by every commit that publishes a snapshot, see maru_waitQueue().
+    // Commits only make a wake call while `commit_waiters` is non-zero.
+    _Atomic(uint32_t) commit_generation;
+    _Atomic(uint32_t) commit_waiters;
+
+    // Recording state, see maru_queue_recording.c. A queue opened from a
+    // recording has `playback` set and replays frames instead of collecting.
+    MARU_QueueRecorder *recorder;
+    MARU_QueuePlayback *playback;
+#ifdef MARU_VALIDATE_API_CALLS
+    MARU_ThreadId creator_thread;
+#endif
+} MARU_Queue;
+
+MARU_Allocator _maru_queue_resolve_allocator(const MARU_Allocator *allocator);
+void *_maru_queue_alloc_raw(const MARU_Allocator *allocator, size_t size);
+void _maru_queue_free_raw(const MARU_Allocator *allocator, void *ptr);
+void *_maru_queue_alloc_aligned64(const MARU_Allocator *allocator, size_t size);
+void _maru_queue_free_aligned64(const MARU_Allocator *allocator, void *ptr);
+void _maru_queue_report_diagnostic_raw(MARU_DiagnosticCallback cb,
+                                       void *userdata,
+                                       MARU_Diagnostic diagnostic,
+                                       const char *message);
+void _maru_queue_report_diagnostic(MARU_Queue *queue,
+                                   MARU_Diagnostic diagnostic,
+                                   const char *message);
+void _maru_queue_validate_thread(const MARU_Queue *queue);
+
+// Publishes a new commit generation and wakes maru_waitQueue() callers.
+void _maru_queue_notify_commit(MARU_Queue *queue);
+// Appends the buffer just published by maru_commitQueue() to the recording.
+void _maru_queue_record_commit(MARU_Queue *queue, uint32_t index);
+// maru_commitQueue() for a queue opened from a recording.
+bool _maru_queue_playback_commit(MARU_Queue *queue);
+// Closes the recording and releases the playback mapping, if any.
+void _maru_queue_recording_cleanup(MARU_Queue *queue);
+
+#endif
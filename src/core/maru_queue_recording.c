@@ -0,0 +1,573 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+#include "maru/queue.h"
+#include "maru_api_constraints.h"
+#include "maru_internal.h"
+#include "maru_queue_internal.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MARU_QUEUE_RECORDING_MMAP
+#endif
+
+/*
+ * File layout, all sections 64-byte aligned so that a mapping of the file can
+ * back MARU_QueueBuffer columns directly:
+ *
+ *   MARU_QueueRecordingHeader
+ *   frame*: MARU_QueueRecordingFrameHeader
+ *           MARU_EventId  types[count]       (padded to 64 bytes)
+ *           MARU_WindowId window_ids[count]  (padded to 64 bytes)
+ *           MARU_Event    events[count]
+ *
+ * Values are stored in the recorder's byte order; the header records it along
+ * with the type sizes so that incompatible files are rejected, not misread.
+ */
+#define MARU_QUEUE_RECORDING_MAGIC "MARUQREC"
+#define MARU_QUEUE_RECORDING_VERSION 1u
+#define MARU_QUEUE_RECORDING_BYTE_ORDER 0x01020304u
+#define MARU_QUEUE_RECORDING_FRAME_MAGIC 0x5246514Du // "MQFR"
+#define MARU_QUEUE_RECORDING_ALIGNMENT 64u
+
+typedef struct MARU_QueueRecordingHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t header_size;
+    uint32_t frame_header_size;
+    uint32_t event_id_size;
+    uint32_t window_id_size;
+    uint32_t event_size;
+    uint8_t reserved[28];
+} MARU_QueueRecordingHeader;
+
+typedef struct MARU_QueueRecordingFrameHeader {
+    uint32_t magic;
+    uint32_t count;
+    uint64_t timestamp_ns;
+    uint64_t size; // Whole frame, header included
+    uint8_t reserved[40];
+} MARU_QueueRecordingFrameHeader;
+
+_Static_assert(sizeof(MARU_QueueRecordingHeader) == MARU_QUEUE_RECORDING_ALIGNMENT,
+               "Recording header must keep frames aligned");
+_Static_assert(sizeof(MARU_QueueRecordingFrameHeader) == MARU_QUEUE_RECORDING_ALIGNMENT,
+               "Frame header must keep columns aligned");
+
+struct MARU_QueueRecorder {
+    FILE *file;
+    uint32_t frame_count;
+    uint64_t last_timestamp_ns;
+};
+
+struct MARU_QueuePlayback {
+    const uint8_t *data;
+    size_t size;
+    bool mapped; // Otherwise `data` is an aligned allocation holding the file
+    uint64_t *frame_offsets;
+    uint32_t frame_count;
+    uint32_t frame_index;
+};
+
+static uint64_t _maru_queue_recording_now_ns(void) {
+    struct timespec ts;
+#if defined(_WIN32)
+    timespec_get(&ts, TIME_UTC);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t _maru_queue_recording_align(uint64_t size) {
+    return (size + MARU_QUEUE_RECORDING_ALIGNMENT - 1u) &
+           ~(uint64_t)(MARU_QUEUE_RECORDING_ALIGNMENT - 1u);
+}
+
+static uint64_t _maru_queue_recording_types_size(uint32_t count) {
+    return _maru_queue_recording_align((uint64_t)sizeof(MARU_EventId) * count);
+}
+
+static uint64_t _maru_queue_recording_window_ids_size(uint32_t count) {
+    return _maru_queue_recording_align((uint64_t)sizeof(MARU_WindowId) * count);
+}
+
+static uint64_t _maru_queue_recording_frame_size(uint32_t count) {
+    return sizeof(MARU_QueueRecordingFrameHeader) +
+           _maru_queue_recording_types_size(count) +
+           _maru_queue_recording_window_ids_size(count) +
+           (uint64_t)sizeof(MARU_Event) * count;
+}
+
+// Pads a section of `size` bytes up to the next alignment boundary.
+static bool _maru_queue_recording_write_padding(FILE *file, size_t size) {
+    static const uint8_t zeros[MARU_QUEUE_RECORDING_ALIGNMENT];
+    const size_t padding = (size_t)(_maru_queue_recording_align(size) - size);
+    return padding == 0 || fwrite(zeros, 1, padding, file) == padding;
+}
+
+static bool _maru_queue_recording_write_padded(FILE *file, const void *data,
+                                               size_t size) {
+    if (size > 0 && fwrite(data, 1, size, file) != size) {
+        return false;
+    }
+    return _maru_queue_recording_write_padding(file, size);
+}
+
+// Bytes of the union member that `type` uses. The rest of a recorded event is
+// written as zeros rather than whatever the pusher left there.
+static size_t _maru_queue_recording_event_size(MARU_EventId type) {
+    switch (type) {
+    case MARU_EVENT_CLOSE_REQUESTED: return sizeof(MARU_CloseRequestedEvent);
+    case MARU_EVENT_WINDOW_RESIZED: return sizeof(MARU_WindowResizedEvent);
+    case MARU_EVENT_KEY_CHANGED: return sizeof(MARU_KeyChangedEvent);
+    case MARU_EVENT_WINDOW_READY: return sizeof(MARU_WindowReadyEvent);
+    case MARU_EVENT_MOUSE_MOVED: return sizeof(MARU_MouseMovedEvent);
+    case MARU_EVENT_MOUSE_BUTTON_CHANGED: return sizeof(MARU_MouseButtonChangedEvent);
+    case MARU_EVENT_MOUSE_SCROLLED: return sizeof(MARU_MouseScrolledEvent);
+    case MARU_EVENT_IDLE_CHANGED: return sizeof(MARU_IdleChangedEvent);
+    case MARU_EVENT_MONITOR_CHANGED: return sizeof(MARU_MonitorChangedEvent);
+    case MARU_EVENT_MONITOR_MODE_CHANGED: return sizeof(MARU_MonitorModeChangedEvent);
+    case MARU_EVENT_WINDOW_FRAME: return sizeof(MARU_WindowFrameEvent);
+    case MARU_EVENT_WINDOW_STATE_CHANGED: return sizeof(MARU_WindowStateChangedEvent);
+    case MARU_EVENT_TEXT_EDIT_STARTED: return sizeof(MARU_TextEditStartedEvent);
+    case MARU_EVENT_TEXT_EDIT_UPDATED: return sizeof(MARU_TextEditUpdatedEvent);
+    case MARU_EVENT_TEXT_EDIT_COMMITTED: return sizeof(MARU_TextEditCommittedEvent);
+    case MARU_EVENT_TEXT_EDIT_ENDED: return sizeof(MARU_TextEditEndedEvent);
+    case MARU_EVENT_DROP_ENTERED:
+    case MARU_EVENT_DROP_HOVERED:
+    case MARU_EVENT_DROP_DROPPED: return sizeof(MARU_DropEvent);
+    case MARU_EVENT_DROP_EXITED: return sizeof(MARU_DropExitedEvent);
+    case MARU_EVENT_DATA_RECEIVED: return sizeof(MARU_DataReceivedEvent);
+    case MARU_EVENT_DATA_REQUESTED: return sizeof(MARU_DataRequestEvent);
+    case MARU_EVENT_DATA_RELEASED: return sizeof(MARU_DataReleasedEvent);
+    case MARU_EVENT_DRAG_FINISHED: return sizeof(MARU_DragFinishedEvent);
+    case MARU_EVENT_CONTROLLER_CHANGED: return sizeof(MARU_ControllerChangedEvent);
+    case MARU_EVENT_CONTROLLER_BUTTON_CHANGED:
+        return sizeof(MARU_ControllerButtonChangedEvent);
+    case MARU_EVENT_TEXT_EDIT_NAVIGATION: return sizeof(MARU_TextEditNavigationEvent);
+    case MARU_EVENT_CONTROLLER_ANALOG_CHANGED:
+        return sizeof(MARU_ControllerAnalogChangedEvent);
+    case MARU_EVENT_MIME_TYPES_READY: return sizeof(MARU_MimeTypesReadyEvent);
+    case MARU_EVENT_DATA_CHUNK_RECEIVED: return sizeof(MARU_DataChunkReceivedEvent);
+    default: return sizeof(MARU_Event); // User events use the whole payload
+    }
+}
+
+// Writes the events column through a zeroed staging batch, copying only the
+// active member of each event.
+static bool _maru_queue_recording_write_events(FILE *file, const MARU_EventId *types,
+                                               const MARU_Event *events,
+                                               uint32_t count) {
+    MARU_Event batch[32];
+    const uint32_t batch_capacity = (uint32_t)(sizeof(batch) / sizeof(batch[0]));
+    for (uint32_t first = 0; first < count; first += batch_capacity) {
+        const uint32_t n =
+            (count - first < batch_capacity) ? count - first : batch_capacity;
+        memset(batch, 0, sizeof(MARU_Event) * n);
+        for (uint32_t i = 0; i < n; ++i) {
+            memcpy(&batch[i], &events[first + i],
+                   _maru_queue_recording_event_size(types[first + i]));
+        }
+        if (fwrite(batch, sizeof(MARU_Event), n, file) != n) {
+            return false;
+        }
+    }
+    return _maru_queue_recording_write_padding(file, sizeof(MARU_Event) * (size_t)count);
+}
+
+static void _maru_queue_recorder_close(MARU_Queue *queue) {
+    MARU_QueueRecorder *recorder = queue->recorder;
+    if (!recorder) {
+        return;
+    }
+    if (fclose(recorder->file) != 0) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE,
+            "Queue recording may be incomplete because closing the file failed");
+    }
+    _maru_queue_free_raw(&queue->allocator, recorder);
+    queue->recorder = NULL;
+}
+
+void _maru_queue_record_commit(MARU_Queue *queue, uint32_t index) {
+    MARU_QueueRecorder *recorder = queue->recorder;
+    const MARU_QueueBuffer *buffer = &queue->buffers[index];
+    const uint32_t count = queue->buffer_event_counts[index];
+
+    MARU_QueueRecordingFrameHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MARU_QUEUE_RECORDING_FRAME_MAGIC;
+    header.count = count;
+    header.timestamp_ns = _maru_queue_recording_now_ns();
+    header.size = _maru_queue_recording_frame_size(count);
+
+    if (!_maru_queue_recording_write_padded(recorder->file, &header, sizeof(header)) ||
+        !_maru_queue_recording_write_padded(recorder->file, buffer->types,
+                                            sizeof(MARU_EventId) * count) ||
+        !_maru_queue_recording_write_padded(recorder->file, buffer->window_ids,
+                                            sizeof(MARU_WindowId) * count) ||
+        !_maru_queue_recording_write_events(recorder->file, buffer->types,
+                                            buffer->events, count)) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE,
+            "Queue recording stopped because writing a frame failed");
+        _maru_queue_recorder_close(queue);
+        return;
+    }
+
+    recorder->frame_count++;
+    recorder->last_timestamp_ns = header.timestamp_ns;
+}
+
+bool maru_recordQueue(MARU_Queue *queue, const char *path) {
+    MARU_API_VALIDATE(recordQueue, queue, path);
+    if (!queue) return false;
+    _maru_queue_validate_thread(queue);
+
+    if (queue->playback) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_INVALID_ARGUMENT,
+            "Queue recording failed because the queue replays a recording");
+        return false;
+    }
+
+    _maru_queue_recorder_close(queue);
+    if (!path) {
+        return true;
+    }
+
+    MARU_QueueRecorder *recorder = (MARU_QueueRecorder *)_maru_queue_alloc_raw(
+        &queue->allocator, sizeof(MARU_QueueRecorder));
+    if (!recorder) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_OUT_OF_MEMORY,
+            "Queue recording failed because the recorder allocation failed");
+        return false;
+    }
+    memset(recorder, 0, sizeof(*recorder));
+
+    recorder->file = fopen(path, "wb");
+    if (!recorder->file) {
+        _maru_queue_free_raw(&queue->allocator, recorder);
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE,
+            "Queue recording failed because the file could not be created");
+        return false;
+    }
+
+    MARU_QueueRecordingHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MARU_QUEUE_RECORDING_MAGIC, sizeof(header.magic));
+    header.version = MARU_QUEUE_RECORDING_VERSION;
+    header.byte_order = MARU_QUEUE_RECORDING_BYTE_ORDER;
+    header.header_size = sizeof(MARU_QueueRecordingHeader);
+    header.frame_header_size = sizeof(MARU_QueueRecordingFrameHeader);
+    header.event_id_size = sizeof(MARU_EventId);
+    header.window_id_size = sizeof(MARU_WindowId);
+    header.event_size = sizeof(MARU_Event);
+
+    queue->recorder = recorder;
+    if (!_maru_queue_recording_write_padded(recorder->file, &header, sizeof(header))) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE,
+            "Queue recording failed because writing the header failed");
+        _maru_queue_recorder_close(queue);
+        return false;
+    }
+    return true;
+}
+
+static bool _maru_queue_playback_load(MARU_QueuePlayback *playback,
+                                      const MARU_Allocator *allocator,
+                                      const char *path) {
+#if defined(MARU_QUEUE_RECORDING_MMAP)
+    (void)allocator;
+    const int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return false;
+    }
+    playback->data = (const uint8_t *)data;
+    playback->size = (size_t)st.st_size;
+    playback->mapped = true;
+    return true;
+#else
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    long size = -1;
+    if (fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size <= 0 || fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return false;
+    }
+    uint8_t *data = (uint8_t *)_maru_queue_alloc_aligned64(allocator, (size_t)size);
+    if (!data) {
+        fclose(file);
+        return false;
+    }
+    const bool ok = fread(data, 1, (size_t)size, file) == (size_t)size;
+    fclose(file);
+    if (!ok) {
+        _maru_queue_free_aligned64(allocator, data);
+        return false;
+    }
+    playback->data = data;
+    playback->size = (size_t)size;
+    playback->mapped = false;
+    return true;
+#endif
+}
+
+static void _maru_queue_playback_unload(MARU_QueuePlayback *playback,
+                                        const MARU_Allocator *allocator) {
+    if (!playback->data) {
+        return;
+    }
+#if defined(MARU_QUEUE_RECORDING_MMAP)
+    (void)allocator;
+    munmap((void *)playback->data, playback->size);
+#else
+    _maru_queue_free_aligned64(allocator, (void *)playback->data);
+#endif
+    playback->data = NULL;
+}
+
+// Walks the frames once, counting them, and records their offsets when
+// `out_offsets` is set. Returns false on any malformed header. A last frame
+// cut short, as in a recording still being written, ends the walk instead.
+static bool _maru_queue_playback_index(const MARU_QueuePlayback *playback,
+                                       uint64_t *out_offsets,
+                                       uint32_t *out_count) {
+    const MARU_QueueRecordingHeader *header =
+        (const MARU_QueueRecordingHeader *)(const void *)playback->data;
+    if (playback->size < sizeof(*header) ||
+        memcmp(header->magic, MARU_QUEUE_RECORDING_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != MARU_QUEUE_RECORDING_VERSION ||
+        header->byte_order != MARU_QUEUE_RECORDING_BYTE_ORDER ||
+        header->header_size != sizeof(MARU_QueueRecordingHeader) ||
+        header->frame_header_size != sizeof(MARU_QueueRecordingFrameHeader) ||
+        header->event_id_size != sizeof(MARU_EventId) ||
+        header->window_id_size != sizeof(MARU_WindowId) ||
+        header->event_size != sizeof(MARU_Event)) {
+        return false;
+    }
+
+    uint32_t count = 0;
+    uint64_t offset = sizeof(MARU_QueueRecordingHeader);
+    while (offset < playback->size) {
+        if (playback->size - offset < sizeof(MARU_QueueRecordingFrameHeader)) {
+            break;
+        }
+        const MARU_QueueRecordingFrameHeader *frame =
+            (const MARU_QueueRecordingFrameHeader *)(const void *)(playback->data +
+                                                                    offset);
+        if (frame->magic != MARU_QUEUE_RECORDING_FRAME_MAGIC ||
+            frame->size != _maru_queue_recording_frame_size(frame->count) ||
+            count == UINT32_MAX) {
+            return false;
+        }
+        if (frame->size > playback->size - offset) {
+            break;
+        }
+        if (out_offsets) {
+            out_offsets[count] = offset;
+        }
+        count++;
+        offset += frame->size;
+    }
+    *out_count = count;
+    return true;
+}
+
+bool maru_openQueueRecording(const char *path,
+                             const MARU_QueueCreateInfo *create_info,
+                             MARU_Queue **out_queue) {
+    MARU_API_VALIDATE(openQueueRecording, path, create_info, out_queue);
+    if (out_queue) {
+        *out_queue = NULL;
+    }
+    if (!path || !out_queue) {
+        return false;
+    }
+
+    const MARU_QueueCreateInfo default_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    if (!create_info) {
+        create_info = &default_info;
+    }
+    const MARU_Allocator allocator =
+        _maru_queue_resolve_allocator(&create_info->allocator);
+
+    MARU_QueuePlayback playback;
+    memset(&playback, 0, sizeof(playback));
+    if (!_maru_queue_playback_load(&playback, &allocator, path)) {
+        _maru_queue_report_diagnostic_raw(
+            create_info->diagnostic_cb, create_info->diagnostic_userdata,
+            MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE,
+            "Queue recording could not be opened");
+        return false;
+    }
+
+    uint32_t frame_count = 0;
+    if (!_maru_queue_playback_index(&playback, NULL, &frame_count)) {
+        _maru_queue_playback_unload(&playback, &allocator);
+        _maru_queue_report_diagnostic_raw(
+            create_info->diagnostic_cb, create_info->diagnostic_userdata,
+            MARU_DIAGNOSTIC_INVALID_ARGUMENT,
+            "Queue recording is malformed or was written by an incompatible build");
+        return false;
+    }
+
+    MARU_Queue *q = (MARU_Queue *)_maru_queue_alloc_raw(&allocator, sizeof(MARU_Queue));
+    MARU_QueuePlayback *state = (MARU_QueuePlayback *)_maru_queue_alloc_raw(
+        &allocator, sizeof(MARU_QueuePlayback));
+    uint64_t *offsets = (uint64_t *)_maru_queue_alloc_raw(
+        &allocator, sizeof(uint64_t) * (frame_count > 0 ? frame_count : 1u));
+    if (!q || !state || !offsets) {
+        _maru_queue_free_raw(&allocator, offsets);
+        _maru_queue_free_raw(&allocator, state);
+        _maru_queue_free_raw(&allocator, q);
+        _maru_queue_playback_unload(&playback, &allocator);
+        _maru_queue_report_diagnostic_raw(
+            create_info->diagnostic_cb, create_info->diagnostic_userdata,
+            MARU_DIAGNOSTIC_OUT_OF_MEMORY,
+            "Queue recording could not be opened because an allocation failed");
+        return false;
+    }
+    _maru_queue_playback_index(&playback, offsets, &frame_count);
+    playback.frame_offsets = offsets;
+    playback.frame_count = frame_count;
+    playback.frame_index = MARU_QUEUE_RECORDING_NO_FRAME;
+    *state = playback;
+
+    memset(q, 0, sizeof(*q));
+    q->allocator = allocator;
+    q->diagnostic_cb = create_info->diagnostic_cb;
+    q->diagnostic_userdata = create_info->diagnostic_userdata;
+    q->buffer_count = 2u;
+    q->playback = state;
+    for (uint32_t i = 0; i < MARU_QUEUE_MAX_BUFFERS; ++i) {
+        atomic_init(&q->buffer_readers[i], 0u);
+    }
+    atomic_init(&q->stable_index, 1u);
+    atomic_init(&q->commit_generation, 0u);
+    atomic_init(&q->commit_waiters, 0u);
+#ifdef MARU_VALIDATE_API_CALLS
+    q->creator_thread = _maru_getCurrentThreadId();
+#endif
+
+    *out_queue = q;
+    return true;
+}
+
+static void _maru_queue_playback_publish(MARU_Queue *queue, uint32_t frame_index) {
+    MARU_QueuePlayback *playback = queue->playback;
+    const uint8_t *base = playback->data + playback->frame_offsets[frame_index];
+    const MARU_QueueRecordingFrameHeader *frame =
+        (const MARU_QueueRecordingFrameHeader *)(const void *)base;
+    const uint8_t *types = base + sizeof(MARU_QueueRecordingFrameHeader);
+    const uint8_t *window_ids = types + _maru_queue_recording_types_size(frame->count);
+    const uint8_t *events =
+        window_ids + _maru_queue_recording_window_ids_size(frame->count);
+
+    // Alternate buffers like a live commit. The columns point into the file;
+    // pushes are rejected, so nothing ever writes through them.
+    const uint32_t index =
+        1u - atomic_load_explicit(&queue->stable_index, memory_order_relaxed);
+    MARU_QueueBuffer *buffer = &queue->buffers[index];
+    buffer->types = (MARU_EventId *)(void *)(uintptr_t)types;
+    buffer->window_ids = (MARU_WindowId *)(void *)(uintptr_t)window_ids;
+    buffer->events = (MARU_Event *)(void *)(uintptr_t)events;
+    queue->buffer_event_counts[index] = frame->count;
+    atomic_store_explicit(&queue->stable_index, index, memory_order_release);
+
+    playback->frame_index = frame_index;
+}
+
+bool _maru_queue_playback_commit(MARU_Queue *queue) {
+    const MARU_QueuePlayback *playback = queue->playback;
+    const uint32_t next = playback->frame_index == MARU_QUEUE_RECORDING_NO_FRAME
+                              ? 0u
+                              : playback->frame_index + 1u;
+    if (next >= playback->frame_count) {
+        return false;
+    }
+    _maru_queue_playback_publish(queue, next);
+    return true;
+}
+
+bool maru_rewindQueueRecording(MARU_Queue *queue) {
+    MARU_API_VALIDATE(rewindQueueRecording, queue);
+    if (!queue) return false;
+    _maru_queue_validate_thread(queue);
+
+    if (!queue->playback) {
+        _maru_queue_report_diagnostic(
+            queue, MARU_DIAGNOSTIC_INVALID_ARGUMENT,
+            "Queue rewind failed because the queue does not replay a recording");
+        return false;
+    }
+    queue->playback->frame_index = MARU_QUEUE_RECORDING_NO_FRAME;
+    return true;
+}
+
+bool maru_getQueueRecordingInfo(const MARU_Queue *queue,
+                                MARU_QueueRecordingInfo *out_info) {
+    MARU_API_VALIDATE(getQueueRecordingInfo, queue, out_info);
+    if (!queue || !out_info) return false;
+    _maru_queue_validate_thread(queue);
+
+    if (queue->playback) {
+        const MARU_QueuePlayback *playback = queue->playback;
+        out_info->frame_count = playback->frame_count;
+        out_info->frame_index = playback->frame_index;
+        out_info->timestamp_ns = 0;
+        if (playback->frame_index != MARU_QUEUE_RECORDING_NO_FRAME) {
+            const MARU_QueueRecordingFrameHeader *frame =
+                (const MARU_QueueRecordingFrameHeader *)(const void *)(
+                    playback->data + playback->frame_offsets[playback->frame_index]);
+            out_info->timestamp_ns = frame->timestamp_ns;
+        }
+        return true;
+    }
+    if (queue->recorder) {
+        const MARU_QueueRecorder *recorder = queue->recorder;
+        out_info->frame_count = recorder->frame_count;
+        out_info->frame_index = recorder->frame_count > 0
+                                    ? recorder->frame_count - 1u
+                                    : MARU_QUEUE_RECORDING_NO_FRAME;
+        out_info->timestamp_ns = recorder->last_timestamp_ns;
+        return true;
+    }
+    return false;
+}
+
+void _maru_queue_recording_cleanup(MARU_Queue *queue) {
+    _maru_queue_recorder_close(queue);
+    if (queue->playback) {
+        _maru_queue_playback_unload(queue->playback, &queue->allocator);
+        _maru_queue_free_raw(&queue->allocator, queue->playback->frame_offsets);
+        _maru_queue_free_raw(&queue->allocator, queue->playback);
+        queue->playback = NULL;
+    }
+}
@@ -0,0 +1,176 @@
+// SPDX-License-Identifier: Zlib
+// Copyright (c) 2026 François Chabot
+
+#include "maru/queue.h"
+#include "maru_api_constraints.h"
+#include "maru_internal.h"
+#include "maru_queue_internal.h"
+
+#if defined(__linux__)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+// Waiters block on the generation word itself where the platform allows it.
+_Static_assert(sizeof(_Atomic(uint32_t)) == sizeof(uint32_t),
+               "Queue generations are waited on as plain 32-bit words");
+
+static uint64_t _maru_queue_wait_now_ns(void) {
+#if defined(_WIN32)
+    return (uint64_t)GetTickCount64() * 1000000ull;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+#if defined(__linux__)
+
+// Sleeps until the generation may have moved past `seen`, for at most
+// `timeout_ns`. Wakes up spuriously at times; callers recheck.
+static void _maru_queue_wait_block(MARU_Queue *queue, uint32_t seen,
+                                   uint64_t timeout_ns) {
+    struct timespec ts = {
+        .tv_sec = (time_t)(timeout_ns / 1000000000ull),
+        .tv_nsec = (long)(timeout_ns % 1000000000ull),
+    };
+    // Returns at once with EAGAIN when the generation already changed.
+    syscall(SYS_futex, (void *)&queue->commit_generation, FUTEX_WAIT_PRIVATE,
+            seen, timeout_ns == MARU_QUEUE_WAIT_FOREVER ? NULL : &ts, NULL, 0);
+}
+
+static void _maru_queue_wait_wake(MARU_Queue *queue) {
+    syscall(SYS_futex, (void *)&queue->commit_generation, FUTEX_WAKE_PRIVATE,
+            INT_MAX, NULL, NULL, 0);
+}
+
+#elif defined(_WIN32)
+
+static void _maru_queue_wait_block(MARU_Queue *queue, uint32_t seen,
+                                   uint64_t timeout_ns) {
+    DWORD timeout_ms = INFINITE;
+    if (timeout_ns != MARU_QUEUE_WAIT_FOREVER) {
+        const uint64_t ms = (timeout_ns + 999999ull) / 1000000ull;
+        timeout_ms = ms < (uint64_t)INFINITE ? (DWORD)ms : INFINITE - 1u;
+    }
+    WaitOnAddress((volatile VOID *)&queue->commit_generation, &seen, sizeof(seen),
+                  timeout_ms);
+}
+
+static void _maru_queue_wait_wake(MARU_Queue *queue) {
+    WakeByAddressAll((PVOID)&queue->commit_generation);
+}
+
+#else
+
+// No address-based wait here. One condition variable serves every queue:
+// waiters recheck their own generation, so a wake meant for another queue is
+// only a spurious wakeup.
+static pthread_mutex_t _maru_queue_wait_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t _maru_queue_wait_cond = PTHREAD_COND_INITIALIZER;
+
+static void _maru_queue_wait_block(MARU_Queue *queue, uint32_t seen,
+                                   uint64_t timeout_ns) {
+    pthread_mutex_lock(&_maru_queue_wait_mutex);
+    if (atomic_load(&queue->commit_generation) == seen) {
+        if (timeout_ns == MARU_QUEUE_WAIT_FOREVER) {
+            pthread_cond_wait(&_maru_queue_wait_cond, &_maru_queue_wait_mutex);
+        } else {
+            // Long waits are cut into hours so the absolute deadline cannot
+            // overflow; the caller loops until its own deadline.
+            const uint64_t hour_ns = 3600ull * 1000000000ull;
+            if (timeout_ns > hour_ns) {
+                timeout_ns = hour_ns;
+            }
+            struct timeval now;
+            gettimeofday(&now, NULL);
+            const uint64_t when_ns = (uint64_t)now.tv_sec * 1000000000ull +
+                                     (uint64_t)now.tv_usec * 1000ull + timeout_ns;
+            const struct timespec deadline = {
+                .tv_sec = (time_t)(when_ns / 1000000000ull),
+                .tv_nsec = (long)(when_ns % 1000000000ull),
+            };
+            pthread_cond_timedwait(&_maru_queue_wait_cond, &_maru_queue_wait_mutex,
+                                   &deadline);
+        }
+    }
+    pthread_mutex_unlock(&_maru_queue_wait_mutex);
+}
+
+static void _maru_queue_wait_wake(MARU_Queue *queue) {
+    (void)queue;
+    // A waiter checks the generation under the mutex, so taking it here
+    // orders this wake after that check.
+    pthread_mutex_lock(&_maru_queue_wait_mutex);
+    pthread_mutex_unlock(&_maru_queue_wait_mutex);
+    pthread_cond_broadcast(&_maru_queue_wait_cond);
+}
+
+#endif
+
+void _maru_queue_notify_commit(MARU_Queue *queue) {
+    // Sequentially consistent on both sides: either a waiter registered
+    // before this increment is seen below, or it sees the new generation
+    // before blocking.
+    atomic_fetch_add(&queue->commit_generation, 1u);
+    if (atomic_load(&queue->commit_waiters) != 0u) {
+        _maru_queue_wait_wake(queue);
+    }
+}
+
+uint32_t maru_getQueueGeneration(const MARU_Queue *queue) {
+    MARU_API_VALIDATE(getQueueGeneration, queue);
+    if (!queue) return 0u;
+
+    return atomic_load_explicit(&queue->commit_generation, memory_order_acquire);
+}
+
+uint32_t maru_waitQueue(const MARU_Queue *queue, uint32_t last_seen_generation,
+                        uint64_t timeout_ns) {
+    MARU_API_VALIDATE(waitQueue, queue, last_seen_generation, timeout_ns);
+    if (!queue) return 0u;
+
+    MARU_Queue *q = (MARU_Queue *)queue;
+    uint32_t generation =
+        atomic_load_explicit(&q->commit_generation, memory_order_acquire);
+    if (generation != last_seen_generation || timeout_ns == 0u) {
+        return generation;
+    }
+
+    uint64_t deadline = MARU_QUEUE_WAIT_FOREVER;
+    if (timeout_ns != MARU_QUEUE_WAIT_FOREVER) {
+        const uint64_t now = _maru_queue_wait_now_ns();
+        if (timeout_ns < MARU_QUEUE_WAIT_FOREVER - now) {
+            deadline = now + timeout_ns;
+        }
+    }
+
+    atomic_fetch_add(&q->commit_waiters, 1u);
+    for (;;) {
+        generation = atomic_load(&q->commit_generation);
+        if (generation != last_seen_generation) {
+            break;
+        }
+        uint64_t remaining = MARU_QUEUE_WAIT_FOREVER;
+        if (deadline != MARU_QUEUE_WAIT_FOREVER) {
+            const uint64_t now = _maru_queue_wait_now_ns();
+            if (now >= deadline) {
+                break;
+            }
+            remaining = deadline - now;
+        }
+        _maru_queue_wait_block(q, last_seen_generation, remaining);
+    }
+    atomic_fetch_sub(&q->commit_waiters, 1u);
+    return generation;
+}
@@ -445,6 +445,7 @@ static void _maru_windows_emit_controller_button_event(
   evt.controller_button_changed.controller = (MARU_Controller *)ctrl;
   evt.controller_button_changed.button_id = button_id;
   evt.controller_button_changed.state = (MARU_ButtonState)new_state;
+  evt.controller_button_changed.timestamp_ns = _maru_windows_get_time_ns();
   _maru_dispatch_event(&ctx->base, MARU_EVENT_CONTROLLER_BUTTON_CHANGED,
                        NULL, &evt);
 }
@@ -161,6 +161,17 @@ uint64_t _maru_windows_get_time_ns(void) {
   return (uint64_t)((counter.QuadPart * 1000000000) / frequency.QuadPart);
 }
 
+uint64_t _maru_windows_get_message_time_ns(void) {
+  // GetMessageTime() lives on the GetTickCount() timeline; rebase it onto QPC.
+  const uint64_t now_ns = _maru_windows_get_time_ns();
+  const DWORD age_ms = GetTickCount() - (DWORD)GetMessageTime();
+  const uint64_t age_ns = (uint64_t)age_ms * 1000000ull;
+  if (age_ms > 10000u || age_ns > now_ns) {
+    return now_ns;
+  }
+  return now_ns - age_ns;
+}
+
 uint64_t _maru_windows_get_time_ms(void) {
   return _maru_windows_get_time_ns() / 1000000;
 }
@@ -279,6 +290,17 @@ MARU_Status maru_pumpEvents_Windows(MARU_Context *context, uint32_t timeout_ms,
   return MARU_SUCCESS;
 }
 
+MARU_Status maru_pumpEventsUntil_Windows(MARU_Context *context,
+                                         uint64_t deadline_ns,
+                                         MARU_EventMask mask,
+                                         MARU_EventCallback callback,
+                                         void *userdata) {
+  // MsgWaitForMultipleObjectsEx only takes milliseconds.
+  const uint32_t timeout_ms =
+      _maru_deadline_ns_to_timeout_ms(deadline_ns, _maru_windows_get_time_ns());
+  return maru_pumpEvents_Windows(context, timeout_ms, mask, callback, userdata);
+}
+
 MARU_Status maru_wakeContext_Windows(MARU_Context *context) {
   MARU_Context_Windows *ctx = (MARU_Context_Windows *)context;
   if (maru_isContextLost(context)) {
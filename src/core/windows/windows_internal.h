@@ -220,6 +220,11 @@ MARU_Status maru_pumpEvents_Windows(MARU_Context *context, uint32_t timeout_ms,
                                     MARU_EventMask mask,
                                     MARU_EventCallback callback,
                                     void *userdata);
+MARU_Status maru_pumpEventsUntil_Windows(MARU_Context *context,
+                                         uint64_t deadline_ns,
+                                         MARU_EventMask mask,
+                                         MARU_EventCallback callback,
+                                         void *userdata);
 MARU_Status maru_wakeContext_Windows(MARU_Context *context);
 
 // windows.h
@@ -289,6 +294,7 @@ LRESULT CALLBACK _maru_window_proc(HWND hwnd, UINT uMsg, WPARAM wParam,
 
 uint64_t _maru_windows_get_time_ms(void);
 uint64_t _maru_windows_get_time_ns(void);
+uint64_t _maru_windows_get_message_time_ns(void);
 
 const char *_maru_clipboard_format_to_mime(UINT format);
 
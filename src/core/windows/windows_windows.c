@@ -196,6 +196,7 @@ LRESULT CALLBACK _maru_window_proc(HWND hwnd, UINT uMsg, WPARAM wParam,
         evt.key_changed.key = key;
         evt.key_changed.state = state;
         evt.key_changed.modifiers = _maru_get_modifiers_windows();
+        evt.key_changed.timestamp_ns = _maru_windows_get_message_time_ns();
         _maru_dispatch_event(&ctx->base, MARU_EVENT_KEY_CHANGED, (MARU_Window *)win, &evt);
       }
       return 0;
@@ -295,6 +296,7 @@ LRESULT CALLBACK _maru_window_proc(HWND hwnd, UINT uMsg, WPARAM wParam,
       evt.mouse_button.button_id = button_id;
       evt.mouse_button.state = state;
       evt.mouse_button.modifiers = _maru_get_modifiers_windows();
+      evt.mouse_button.timestamp_ns = _maru_windows_get_message_time_ns();
       _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_BUTTON_CHANGED, (MARU_Window *)win, &evt);
 
       if (uMsg == WM_LBUTTONDOWN || uMsg == WM_RBUTTONDOWN || uMsg == WM_MBUTTONDOWN || uMsg == WM_XBUTTONDOWN) {
@@ -356,6 +358,7 @@ LRESULT CALLBACK _maru_window_proc(HWND hwnd, UINT uMsg, WPARAM wParam,
 
       evt.mouse_moved.raw_dip_delta = evt.mouse_moved.dip_delta; // TODO: handle raw input
       evt.mouse_moved.modifiers = _maru_get_modifiers_windows();
+      evt.mouse_moved.timestamp_ns = _maru_windows_get_message_time_ns();
 
       _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_MOVED, (MARU_Window *)win, &evt);
       return 0;
@@ -382,6 +385,7 @@ LRESULT CALLBACK _maru_window_proc(HWND hwnd, UINT uMsg, WPARAM wParam,
         evt.mouse_scrolled.dip_delta.x = value * 10.0f; // TODO: use system settings
       }
       evt.mouse_scrolled.modifiers = _maru_get_modifiers_windows();
+      evt.mouse_scrolled.timestamp_ns = _maru_windows_get_message_time_ns();
 
       _maru_dispatch_event(&ctx->base, MARU_EVENT_MOUSE_SCROLLED, (MARU_Window *)win, &evt);
       return 0;
@@ -53,6 +53,8 @@
 #include "../core/core.c"
 #include "../core/internal_event_queue.c"
 #include "../core/maru_queue.c"
+#include "../core/maru_queue_recording.c"
+#include "../core/maru_queue_wait.c"
 
 #ifdef MARU_INDIRECT_BACKEND
 #include "../core/core_indirect_entry.c"
@@ -1,6 +1,12 @@
 #include "doctest/doctest.h"
 #include "maru/maru.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <utility>
+
 TEST_CASE("Queue C++ API - Basic") {
     auto queue_res = maru::Queue::create(16);
     REQUIRE(queue_res.has_value());
@@ -19,6 +25,35 @@ TEST_CASE("Queue C++ API - Basic") {
     CHECK(count == 1);
 }
 
+TEST_CASE("Queue C++ API - View") {
+    auto queue_res = maru::Queue::create(16);
+    REQUIRE(queue_res.has_value());
+    maru::Queue& queue = *queue_res;
+
+    MARU_Event move_evt = {};
+    move_evt.mouse_moved.dip_delta.x = 1.5;
+    queue.push(MARU_EVENT_MOUSE_MOVED, 3, move_evt);
+    queue.push(MARU_EVENT_MOUSE_MOVED, 4, move_evt);
+    queue.push(MARU_EVENT_MOUSE_MOVED, 3, move_evt);
+    queue.commit();
+
+    double sum = 0.0;
+    int count = 0;
+    for (maru::QueueEntry entry : queue.view()) {
+        if (entry.type == MARU_EVENT_MOUSE_MOVED && entry.window_id == 3) {
+            sum += entry.event.mouse_moved.dip_delta.x;
+        }
+        count++;
+    }
+    CHECK(count == 3);
+    CHECK(sum == doctest::Approx(3.0));
+
+    maru::QueueView view = queue.view();
+    REQUIRE(view.size() == 3);
+    CHECK(view.windowIds()[1] == 4);
+    CHECK(view[2].event.mouse_moved.dip_delta.x == doctest::Approx(1.5));
+}
+
 #if __cplusplus >= 202002L
 TEST_CASE("Queue C++ API - C++20 Visitor Scan") {
     auto queue_res = maru::Queue::create(16);
@@ -47,4 +82,167 @@ TEST_CASE("Queue C++ API - C++20 Visitor Scan") {
     CHECK(frame_count == 1);
     CHECK(close_count == 1);
 }
+
+namespace {
+struct QueueTestPayload {
+    int32_t code;
+    float weight;
+};
+}  // namespace
+
+TEST_CASE("Queue C++ API - C++20 Visitor User And Navigation Events") {
+    auto queue_res = maru::Queue::create(16);
+    REQUIRE(queue_res.has_value());
+    maru::Queue& queue = *queue_res;
+
+    MARU_Event user_evt = {};
+    const QueueTestPayload payload{7, 0.5f};
+    std::memcpy(user_evt.user.raw_payload, &payload, sizeof(payload));
+    queue.push(MARU_EVENT_USER_3, 5, user_evt);
+    queue.push(MARU_EVENT_USER_4, 6, user_evt);
+    MARU_Event nav_evt = {};
+    queue.push(MARU_EVENT_TEXT_EDIT_NAVIGATION, 5, nav_evt);
+    queue.commit();
+
+    int user_count = 0;
+    int nav_count = 0;
+    auto visitor = maru::overloads{
+        [&](maru::QueuedUserEvent<3, QueueTestPayload> evt) {
+            CHECK(evt.window_id == 5);
+            CHECK(evt->code == 7);
+            CHECK(evt->weight == doctest::Approx(0.5f));
+            user_count++;
+        },
+        [&](maru::QueuedTextEditNavigationEvent evt) {
+            CHECK(evt.window_id == 5);
+            nav_count++;
+        }
+    };
+    static_assert(maru::details::generateMask<decltype(visitor)>() ==
+                  (MARU_MASK_USER_3 | MARU_MASK_TEXT_EDIT_NAVIGATION));
+    queue.scan(std::move(visitor));
+
+    CHECK(user_count == 1);
+    CHECK(nav_count == 1);
+
+    // The raw union stays available as the default payload type.
+    int raw_count = 0;
+    queue.scan(maru::overloads{[&](maru::QueuedUserEvent<4> evt) {
+        CHECK(evt.window_id == 6);
+        CHECK(std::memcmp(evt->raw_payload, &payload, sizeof(payload)) == 0);
+        raw_count++;
+    }});
+    CHECK(raw_count == 1);
+}
+
+TEST_CASE("Queue C++ API - C++20 Catch-All Visitor Skips User Events") {
+    auto queue_res = maru::Queue::create(16);
+    REQUIRE(queue_res.has_value());
+    maru::Queue& queue = *queue_res;
+
+    MARU_Event evt = {};
+    queue.push(MARU_EVENT_USER_3, 5, evt);
+    queue.push(MARU_EVENT_WINDOW_FRAME, 5, evt);
+    queue.commit();
+
+    int frame_count = 0;
+    int other_count = 0;
+    auto visitor = maru::overloads{
+        [&](maru::QueuedWindowFrameEvent) { frame_count++; },
+        [&](const auto&) { other_count++; }
+    };
+    static_assert((maru::details::generateMask<decltype(visitor)>() & MARU_MASK_USER_3) == 0);
+    static_assert((maru::details::generateMask<decltype(visitor)>() & MARU_MASK_CLOSE_REQUESTED) != 0);
+    queue.scan(std::move(visitor));
+
+    CHECK(frame_count == 1);
+    CHECK(other_count == 0);
+}
+
+TEST_CASE("Queue C++ API - C++20 Ambiguous Handlers Are Detected") {
+    using UserSource = maru::details::EventBinding<MARU_EVENT_USER_3>::Queued;
+    auto ambiguous = maru::overloads{
+        [](maru::QueuedUserEvent<3, QueueTestPayload>) {},
+        [](maru::QueuedUserEvent<3>) {}
+    };
+    auto typed = maru::overloads{
+        [](maru::QueuedUserEvent<3, QueueTestPayload>) {},
+        [](maru::QueuedWindowFrameEvent) {}
+    };
+    static_assert(maru::details::isAmbiguousHandler<decltype(ambiguous), UserSource>());
+    static_assert(!maru::details::isAmbiguousHandler<decltype(typed), UserSource>());
+    static_assert(!maru::details::isAmbiguousHandler<decltype(typed),
+                                                     maru::QueuedCloseRequestedEvent>());
+    (void)ambiguous;
+    (void)typed;
+}
 #endif
+
+TEST_CASE("Context C++ API - Typed postEvent") {
+    struct Pick {
+        int32_t tool;
+        float pressure;
+    };
+
+    MARU_ContextCreateInfo create_info = MARU_CONTEXT_CREATE_INFO_DEFAULT;
+    create_info.backend = MARU_BACKEND_UNKNOWN;
+    auto ctx_res = maru::Context::create(create_info);
+    if (!ctx_res.has_value()) {
+        MESSAGE("Context creation unavailable; skipping typed postEvent test.");
+        return;
+    }
+    maru::Context& ctx = *ctx_res;
+
+    CHECK(ctx.postEvent(MARU_EVENT_USER_1, Pick{3, 0.25f}) == MARU_SUCCESS);
+
+    Pick received{};
+    auto on_event = [](MARU_EventId type, MARU_Window*, const MARU_Event* evt,
+                       void* userdata) {
+        if (type != MARU_EVENT_USER_1) return;
+        std::memcpy(userdata, evt->user.raw_payload, sizeof(Pick));
+    };
+    CHECK(maru_pumpEvents(ctx.get(), 0, MARU_MASK_USER_1, on_event, &received) ==
+          MARU_SUCCESS);
+    CHECK(received.tool == 3);
+    CHECK(received.pressure == doctest::Approx(0.25f));
+}
+
+TEST_CASE("Queue C++ API - Wait wakes on commit") {
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 16;
+    create_info.triple_buffered = true;
+    auto queue_res = maru::Queue::create(create_info);
+    REQUIRE(queue_res.has_value());
+    maru::Queue& queue = *queue_res;
+
+    CHECK(queue.wait(queue.generation(), std::chrono::milliseconds(1)) == 0u);
+
+    constexpr uint32_t kCommits = 64;
+    std::atomic<uint32_t> user_events{0};
+    std::thread consumer([&] {
+        uint32_t seen = 0;
+        while (seen < kCommits) {
+            const uint32_t generation = queue.wait(seen);
+            queue.scan(MARU_MASK_USER_0,
+                       [](MARU_EventId, MARU_WindowId, const MARU_Event*, void* userdata) {
+                           static_cast<std::atomic<uint32_t>*>(userdata)->fetch_add(1);
+                       },
+                       &user_events);
+            seen = generation;
+        }
+    });
+
+    MARU_Event evt = {};
+    for (uint32_t i = 0; i < kCommits; ++i) {
+        queue.push(MARU_EVENT_USER_0, 1, evt);
+        // Retried while the consumer pins both spare buffers.
+        while (!queue.commit()) {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+
+    CHECK(queue.generation() == kCommits);
+    CHECK(user_events.load() >= 1u);
+    CHECK(user_events.load() <= kCommits);
+}
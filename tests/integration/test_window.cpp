@@ -2,7 +2,9 @@
 
 #include <atomic>
 #include <chrono>
+#include <cstring>
 #include <thread>
+#include <vector>
 
 #include "maru/maru.h"
 #include "integration/support/tracking_allocator.h"
@@ -64,6 +66,104 @@ TEST_CASE("DesktopIntegration.CrossThreadPostEventWithoutWindow") {
   CHECK(tracking.is_clean());
 }
 
+TEST_CASE("DesktopIntegration.PostEventsDeliversBurstInOrder") {
+  MARU_IntegrationTrackingAllocator tracking;
+  MARU_ContextCreateInfo create_info = MARU_CONTEXT_CREATE_INFO_DEFAULT;
+  tracking.apply(&create_info);
+  create_info.backend = MARU_BACKEND_UNKNOWN;
+
+  MARU_Context *ctx = nullptr;
+  MARU_Status status = maru_createContext(&create_info, &ctx);
+  if (status != MARU_SUCCESS || !ctx) {
+    MESSAGE("Context creation unavailable; skipping postEvents test.");
+    return;
+  }
+
+  // Larger than the whole internal queue, so only a prefix can fit.
+  constexpr uint32_t kBurst = 1024;
+  std::vector<MARU_EventId> types(kBurst, MARU_EVENT_USER_2);
+  std::vector<MARU_UserDefinedEvent> events(kBurst);
+  for (uint32_t i = 0; i < kBurst; ++i) {
+    std::memset(&events[i], 0, sizeof(events[i]));
+    std::memcpy(events[i].raw_payload, &i, sizeof(i));
+  }
+
+  uint32_t posted = 0;
+  CHECK(maru_postEvents(ctx, types.data(), events.data(), kBurst, &posted) ==
+        MARU_FAILURE);
+  CHECK(posted > 0);
+  CHECK(posted < kBurst);
+
+  struct BurstLog {
+    uint32_t count = 0;
+    bool in_order = true;
+  } log;
+  auto on_event = [](MARU_EventId type, MARU_Window *, const MARU_Event *evt,
+                     void *userdata) {
+    auto *log = static_cast<BurstLog *>(userdata);
+    if (type != MARU_EVENT_USER_2) return;
+    uint32_t index = 0;
+    std::memcpy(&index, evt->user.raw_payload, sizeof(index));
+    log->in_order = log->in_order && index == log->count;
+    log->count++;
+  };
+  status = maru_pumpEvents(ctx, 0, MARU_MASK_USER_2, on_event, &log);
+
+  CHECK(status == MARU_SUCCESS);
+  CHECK(log.count == posted);
+  CHECK(log.in_order);
+
+  maru_destroyContext(ctx);
+  CHECK(tracking.is_clean());
+}
+
+TEST_CASE("DesktopIntegration.PostEventPayloadZeroesUnusedBytes") {
+  MARU_IntegrationTrackingAllocator tracking;
+  MARU_ContextCreateInfo create_info = MARU_CONTEXT_CREATE_INFO_DEFAULT;
+  tracking.apply(&create_info);
+  create_info.backend = MARU_BACKEND_UNKNOWN;
+
+  MARU_Context *ctx = nullptr;
+  MARU_Status status = maru_createContext(&create_info, &ctx);
+  if (status != MARU_SUCCESS || !ctx) {
+    MESSAGE("Context creation unavailable; skipping postEventPayload test.");
+    return;
+  }
+
+  const uint64_t payload = 0x0123456789abcdefull;
+  CHECK(maru_postEventPayload(ctx, MARU_EVENT_USER_4, &payload,
+                              sizeof(payload)) == MARU_SUCCESS);
+  CHECK(maru_postEventPayload(ctx, MARU_EVENT_USER_4, nullptr, 0) ==
+        MARU_SUCCESS);
+
+  struct PayloadLog {
+    uint32_t count = 0;
+    bool matches = true;
+  } log;
+  auto on_event = [](MARU_EventId type, MARU_Window *, const MARU_Event *evt,
+                     void *userdata) {
+    auto *log = static_cast<PayloadLog *>(userdata);
+    if (type != MARU_EVENT_USER_4) return;
+    MARU_UserDefinedEvent expected;
+    std::memset(&expected, 0, sizeof(expected));
+    if (log->count == 0) {
+      const uint64_t payload = 0x0123456789abcdefull;
+      std::memcpy(expected.raw_payload, &payload, sizeof(payload));
+    }
+    log->matches = log->matches &&
+                   std::memcmp(&expected, &evt->user, sizeof(expected)) == 0;
+    log->count++;
+  };
+  status = maru_pumpEvents(ctx, 0, MARU_MASK_USER_4, on_event, &log);
+
+  CHECK(status == MARU_SUCCESS);
+  CHECK(log.count == 2);
+  CHECK(log.matches);
+
+  maru_destroyContext(ctx);
+  CHECK(tracking.is_clean());
+}
+
 #ifndef MARU_VALIDATE_API_CALLS
 TEST_CASE("DesktopIntegration.PostEventFailsWhenUserEventsDisabled") {
   MARU_IntegrationTrackingAllocator tracking;
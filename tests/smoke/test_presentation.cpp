@@ -87,6 +87,12 @@ const char *event_name(MARU_EventId type) {
       return "CONTROLLER_CHANGED";
     case MARU_EVENT_CONTROLLER_BUTTON_CHANGED:
       return "CONTROLLER_BUTTON_CHANGED";
+    case MARU_EVENT_CONTROLLER_ANALOG_CHANGED:
+      return "CONTROLLER_ANALOG_CHANGED";
+    case MARU_EVENT_MIME_TYPES_READY:
+      return "MIME_TYPES_READY";
+    case MARU_EVENT_DATA_CHUNK_RECEIVED:
+      return "DATA_CHUNK_RECEIVED";
     case MARU_EVENT_TEXT_EDIT_NAVIGATION:
       return "TEXT_EDIT_NAVIGATION";
     case MARU_EVENT_USER_0:
@@ -0,0 +1,113 @@
+#include "utest.h"
+
+#include "maru_internal.h"
+
+#include <string.h>
+
+#define MS_NS 1000000ull
+
+UTEST(Deadline, TimeoutToDeadline) {
+  const uint64_t now_ns = 5000u * MS_NS;
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(0u, now_ns), now_ns);
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(16u, now_ns), now_ns + 16u * MS_NS);
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(MARU_NEVER, now_ns), (uint64_t)MARU_NEVER_NS);
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(MARU_NEVER - 1u, now_ns),
+            now_ns + (uint64_t)(MARU_NEVER - 1u) * MS_NS);
+}
+
+UTEST(Deadline, TimeoutToDeadlineSaturatesShortOfNever) {
+  const uint64_t late_ns = MARU_NEVER_NS - 10u * MS_NS;
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(5u, late_ns), late_ns + 5u * MS_NS);
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(10u, late_ns), (uint64_t)(MARU_NEVER_NS - 1u));
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(MARU_NEVER - 1u, late_ns),
+            (uint64_t)(MARU_NEVER_NS - 1u));
+  EXPECT_EQ(_maru_timeout_ms_to_deadline_ns(0u, MARU_NEVER_NS - 1u),
+            (uint64_t)(MARU_NEVER_NS - 1u));
+}
+
+UTEST(Deadline, DeadlineToTimeout) {
+  const uint64_t now_ns = 5000u * MS_NS;
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(MARU_NEVER_NS, now_ns), (uint32_t)MARU_NEVER);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(now_ns, now_ns), 0u);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(now_ns - 1u, now_ns), 0u);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(0u, now_ns), 0u);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(now_ns + 16u * MS_NS, now_ns), 16u);
+}
+
+UTEST(Deadline, DeadlineToTimeoutRoundsUp) {
+  const uint64_t now_ns = 5000u * MS_NS;
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(now_ns + 1u, now_ns), 1u);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(now_ns + MS_NS + 1u, now_ns), 2u);
+}
+
+UTEST(Deadline, DeadlineToTimeoutStaysFinite) {
+  // A finite deadline too far out for 32 bits must not read as MARU_NEVER.
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(MARU_NEVER_NS - 1u, 0u),
+            (uint32_t)(MARU_NEVER - 1u));
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms((uint64_t)MARU_NEVER * MS_NS, 0u),
+            (uint32_t)(MARU_NEVER - 1u));
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms((uint64_t)(MARU_NEVER - 1u) * MS_NS, 0u),
+            (uint32_t)(MARU_NEVER - 1u));
+}
+
+UTEST(Deadline, TimeoutRoundTrips) {
+  const uint64_t now_ns = 123456789u;
+  const uint32_t timeouts[] = {0u, 1u, 16u, 1000u, MARU_NEVER - 1u, MARU_NEVER};
+  for (size_t i = 0; i < sizeof(timeouts) / sizeof(timeouts[0]); ++i) {
+    const uint64_t deadline_ns = _maru_timeout_ms_to_deadline_ns(timeouts[i], now_ns);
+    EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(deadline_ns, now_ns), timeouts[i]);
+  }
+}
+
+struct CursorChain {
+  MARU_Context_Base ctx_base;
+  MARU_Cursor_Base cursors[2];
+};
+
+static void cursor_chain_init(struct CursorChain *c, uint64_t first_ms, uint64_t second_ms) {
+  memset(c, 0, sizeof(*c));
+  c->cursors[0].anim_next_frame_deadline_ms = first_ms;
+  c->cursors[0].anim_next = &c->cursors[1];
+  c->cursors[1].anim_next_frame_deadline_ms = second_ms;
+  c->ctx_base.animated_cursor_head = &c->cursors[0];
+}
+
+UTEST(Deadline, CursorAnimationPullsDeadlineIn) {
+  struct CursorChain c;
+  cursor_chain_init(&c, 40u, 25u);
+
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, 100u * MS_NS),
+            25u * MS_NS);
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, MARU_NEVER_NS),
+            25u * MS_NS);
+  // An earlier deadline is kept, including one already reached.
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, 10u * MS_NS),
+            10u * MS_NS);
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, 0u), (uint64_t)0u);
+
+  c.ctx_base.animated_cursor_head = NULL;
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, MARU_NEVER_NS),
+            (uint64_t)MARU_NEVER_NS);
+}
+
+UTEST(Deadline, CursorAnimationPastFrameWakesImmediately) {
+  struct CursorChain c;
+  cursor_chain_init(&c, 40u, 3u);
+
+  const uint64_t now_ns = 20u * MS_NS;
+  const uint64_t deadline_ns = _maru_adjust_deadline_for_cursor_animation(
+      &c.ctx_base, _maru_timeout_ms_to_deadline_ns(MARU_NEVER, now_ns));
+  EXPECT_EQ(deadline_ns, 3u * MS_NS);
+  EXPECT_EQ(_maru_deadline_ns_to_timeout_ms(deadline_ns, now_ns), 0u);
+}
+
+UTEST(Deadline, CursorAnimationIgnoresFramesBeyondTheClock) {
+  struct CursorChain c;
+  // Converting these to nanoseconds would wrap to a bogus early deadline.
+  cursor_chain_init(&c, UINT64_MAX, MARU_NEVER_NS / MS_NS + 1u);
+
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, MARU_NEVER_NS),
+            (uint64_t)MARU_NEVER_NS);
+  EXPECT_EQ(_maru_adjust_deadline_for_cursor_animation(&c.ctx_base, 100u * MS_NS),
+            100u * MS_NS);
+}
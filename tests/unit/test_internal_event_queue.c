@@ -0,0 +1,384 @@
+#include "utest.h"
+
+#include "maru_internal.h"
+
+#include <string.h>
+
+struct QueueFixture {
+  MARU_Context_Base ctx_base;
+  MARU_InternalEventQueue queue;
+};
+
+static bool queue_fixture_init_ex(struct QueueFixture *f, uint32_t capacity,
+                                  bool overflow) {
+  memset(f, 0, sizeof(*f));
+  f->ctx_base.allocator.alloc_cb = _maru_default_alloc;
+  f->ctx_base.allocator.realloc_cb = _maru_default_realloc;
+  f->ctx_base.allocator.free_cb = _maru_default_free;
+  return _maru_internal_event_queue_init(&f->queue, &f->ctx_base, capacity, overflow);
+}
+
+static bool queue_fixture_init(struct QueueFixture *f, uint32_t capacity) {
+  return queue_fixture_init_ex(f, capacity, false);
+}
+
+static bool push_user(struct QueueFixture *f, uint64_t payload) {
+  MARU_Event evt;
+  memset(&evt, 0, sizeof(evt));
+  memcpy(evt.user.raw_payload, &payload, sizeof(payload));
+  return _maru_internal_event_queue_push(&f->queue, MARU_EVENT_USER_0, NULL, &evt,
+                                         NULL, NULL);
+}
+
+static uint64_t payload_at(const struct QueueFixture *f, size_t seq) {
+  uint64_t payload;
+  memcpy(&payload, f->queue.events[seq % f->queue.capacity].user.raw_payload,
+         sizeof(payload));
+  return payload;
+}
+
+static void count_cleanup(MARU_Context_Base *ctx, void *userdata) {
+  (void)ctx;
+  (*(int *)userdata)++;
+}
+
+UTEST(InternalEventQueue, BatchAcquireKeepsOrderAcrossWrap) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 8));
+
+  // Move the consumer position off zero so the next batch wraps.
+  for (uint64_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(push_user(&f, i));
+  }
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 5u);
+  _maru_internal_event_queue_release(&f.queue, first, 5);
+
+  for (uint64_t i = 0; i < 8; ++i) {
+    ASSERT_TRUE(push_user(&f, 100 + i));
+  }
+  EXPECT_FALSE(push_user(&f, 999));
+
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 8u);
+  EXPECT_EQ(first, (size_t)5);
+  for (uint32_t i = 0; i < 8; ++i) {
+    EXPECT_EQ(payload_at(&f, first + i), (uint64_t)(100 + i));
+  }
+
+  // Claimed slots are not reusable until the batch is released.
+  EXPECT_FALSE(push_user(&f, 999));
+  _maru_internal_event_queue_release(&f.queue, first, 8);
+  EXPECT_TRUE(push_user(&f, 200));
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, AcquireStopsAtMaxCount) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 16));
+
+  for (uint64_t i = 0; i < 10; ++i) {
+    ASSERT_TRUE(push_user(&f, i));
+  }
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 4), 4u);
+  _maru_internal_event_queue_release(&f.queue, first, 4);
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 6u);
+  EXPECT_EQ(payload_at(&f, first), (uint64_t)4);
+  _maru_internal_event_queue_release(&f.queue, first, 6);
+  EXPECT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 0u);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, NestedAcquirePublishesTailOnOuterRelease) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 4));
+
+  ASSERT_TRUE(push_user(&f, 1));
+  ASSERT_TRUE(push_user(&f, 2));
+  size_t outer_first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &outer_first, 64), 2u);
+
+  ASSERT_TRUE(push_user(&f, 3));
+  size_t inner_first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &inner_first, 64), 1u);
+  EXPECT_EQ(payload_at(&f, inner_first), (uint64_t)3);
+  _maru_internal_event_queue_release(&f.queue, inner_first, 1);
+
+  // The outer batch is still being dispatched, so its slots must stay reserved.
+  ASSERT_TRUE(push_user(&f, 4));
+  EXPECT_FALSE(push_user(&f, 5));
+
+  _maru_internal_event_queue_release(&f.queue, outer_first, 2);
+  EXPECT_TRUE(push_user(&f, 5));
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, CleanupRunsForUnconsumedOwnedEvents) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 4));
+
+  int cleanups = 0;
+  MARU_Event evt;
+  memset(&evt, 0, sizeof(evt));
+  ASSERT_TRUE(_maru_internal_event_queue_push(&f.queue, MARU_EVENT_USER_0, NULL, &evt,
+                                              count_cleanup, &cleanups));
+  ASSERT_TRUE(push_user(&f, 1));
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+  EXPECT_EQ(cleanups, 1);
+}
+
+UTEST(InternalEventQueue, BulkUserPushQueuesLeadingEventsThatFit) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 8));
+
+  ASSERT_TRUE(push_user(&f, 0));
+  ASSERT_TRUE(push_user(&f, 0));
+  ASSERT_TRUE(push_user(&f, 0));
+
+  MARU_EventId types[8];
+  MARU_UserDefinedEvent events[8];
+  memset(events, 0, sizeof(events));
+  for (uint64_t i = 0; i < 8; ++i) {
+    types[i] = MARU_EVENT_USER_1;
+    memcpy(events[i].raw_payload, &i, sizeof(i));
+  }
+
+  EXPECT_EQ(_maru_internal_event_queue_push_user_events(&f.queue, types, events, 8), 5u);
+  EXPECT_EQ(_maru_internal_event_queue_push_user_events(&f.queue, types, events, 8), 0u);
+
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 8u);
+  for (uint32_t i = 0; i < 5; ++i) {
+    EXPECT_EQ(f.queue.slots[(first + 3 + i) % 8].type, (MARU_EventId)MARU_EVENT_USER_1);
+    EXPECT_EQ(payload_at(&f, first + 3 + i), (uint64_t)i);
+  }
+  _maru_internal_event_queue_release(&f.queue, first, 8);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+static bool post_user(struct QueueFixture *f, uint64_t payload) {
+  MARU_UserDefinedEvent evt;
+  memset(&evt, 0, sizeof(evt));
+  memcpy(evt.raw_payload, &payload, sizeof(payload));
+  return _maru_internal_event_queue_push_user_event(&f->queue, MARU_EVENT_USER_0, &evt);
+}
+
+// Drains ring then overflow the way _maru_drain_queued_events does, checking
+// that payloads come out as 0, 1, 2, ...
+static uint64_t drain_in_order(struct QueueFixture *f, bool *in_order) {
+  uint64_t expected = 0;
+  size_t first = 0;
+  uint32_t count;
+  for (;;) {
+    while ((count = _maru_internal_event_queue_acquire(&f->queue, &first, 64)) != 0) {
+      for (uint32_t i = 0; i < count; ++i) {
+        *in_order = *in_order && payload_at(f, first + i) == expected;
+        expected++;
+      }
+      _maru_internal_event_queue_release(&f->queue, first, count);
+    }
+    const MARU_InternalQueuedEventSlot *slots;
+    const MARU_Event *events;
+    count = _maru_internal_event_queue_acquire_overflow(&f->queue, &slots, &events, 64);
+    if (count == 0) {
+      break;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t payload;
+      memcpy(&payload, events[i].user.raw_payload, sizeof(payload));
+      *in_order = *in_order && payload == expected;
+      expected++;
+    }
+    _maru_internal_event_queue_release_overflow(&f->queue, count);
+  }
+  return expected;
+}
+
+UTEST(InternalEventQueue, FullQueueDropsWithoutOverflow) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init(&f, 4));
+
+  for (uint64_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(post_user(&f, i));
+  }
+  EXPECT_FALSE(post_user(&f, 4));
+  EXPECT_EQ(atomic_load(&f.queue.dropped_count), (uint64_t)1);
+  EXPECT_EQ(atomic_load(&f.queue.spilled_count), (uint64_t)0);
+  EXPECT_EQ(atomic_load(&f.queue.high_water_mark), 4u);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, OverflowSpillsAcrossSegmentsInOrder) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init_ex(&f, 8, true));
+
+  // Enough to fill the ring and chain several overflow segments.
+  const uint64_t total = 8 + 3 * MARU_INTERNAL_EVENT_SEGMENT_CAPACITY + 17;
+  for (uint64_t i = 0; i < total; ++i) {
+    ASSERT_TRUE(post_user(&f, i));
+  }
+  EXPECT_EQ(atomic_load(&f.queue.spilled_count), total - 8);
+  EXPECT_EQ(atomic_load(&f.queue.dropped_count), (uint64_t)0);
+
+  bool in_order = true;
+  EXPECT_EQ(drain_in_order(&f, &in_order), total);
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(atomic_load(&f.queue.overflow_pending), (size_t)0);
+
+  // With nothing pending, posts go back to the ring.
+  ASSERT_TRUE(post_user(&f, 0));
+  EXPECT_EQ(atomic_load(&f.queue.spilled_count), total - 8);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, PostsKeepSpillingWhileOverflowIsPending) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init_ex(&f, 4, true));
+
+  for (uint64_t i = 0; i < 6; ++i) {
+    ASSERT_TRUE(post_user(&f, i));
+  }
+
+  // Free up ring space; the next posts must still queue behind the spilled
+  // events rather than jump ahead of them.
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 2), 2u);
+  _maru_internal_event_queue_release(&f.queue, first, 2);
+
+  MARU_EventId types[3] = {MARU_EVENT_USER_0, MARU_EVENT_USER_0, MARU_EVENT_USER_0};
+  MARU_UserDefinedEvent events[3];
+  memset(events, 0, sizeof(events));
+  for (uint64_t i = 0; i < 3; ++i) {
+    const uint64_t payload = 6 + i;
+    memcpy(events[i].raw_payload, &payload, sizeof(payload));
+  }
+  EXPECT_EQ(_maru_internal_event_queue_push_user_events(&f.queue, types, events, 3), 3u);
+
+  // Skip the two events consumed above.
+  bool in_order = true;
+  uint64_t expected = 2;
+  uint32_t count;
+  while ((count = _maru_internal_event_queue_acquire(&f.queue, &first, 64)) != 0) {
+    for (uint32_t i = 0; i < count; ++i) {
+      in_order = in_order && payload_at(&f, first + i) == expected++;
+    }
+    _maru_internal_event_queue_release(&f.queue, first, count);
+  }
+  const MARU_InternalQueuedEventSlot *slots;
+  const MARU_Event *evts;
+  while ((count = _maru_internal_event_queue_acquire_overflow(&f.queue, &slots, &evts,
+                                                              64)) != 0) {
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t payload;
+      memcpy(&payload, evts[i].user.raw_payload, sizeof(payload));
+      in_order = in_order && payload == expected++;
+    }
+    _maru_internal_event_queue_release_overflow(&f.queue, count);
+  }
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(expected, (uint64_t)9);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, RingEventsWaitBehindOlderSpilledEvents) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init_ex(&f, 4, true));
+
+  for (uint64_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(post_user(&f, i));
+  }
+  EXPECT_EQ(atomic_load(&f.queue.spilled_count), (uint64_t)1);
+
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 2), 2u);
+  _maru_internal_event_queue_release(&f.queue, first, 2);
+
+  // Backend events still go through the ring, behind the spilled event.
+  ASSERT_TRUE(push_user(&f, 5));
+  ASSERT_TRUE(push_user(&f, 6));
+
+  bool in_order = true;
+  uint64_t expected = 2;
+  uint32_t count;
+  for (;;) {
+    while ((count = _maru_internal_event_queue_acquire(&f.queue, &first, 64)) != 0) {
+      for (uint32_t i = 0; i < count; ++i) {
+        in_order = in_order && payload_at(&f, first + i) == expected++;
+      }
+      _maru_internal_event_queue_release(&f.queue, first, count);
+    }
+    const MARU_InternalQueuedEventSlot *slots;
+    const MARU_Event *evts;
+    count = _maru_internal_event_queue_acquire_overflow(&f.queue, &slots, &evts, 64);
+    if (count == 0) {
+      break;
+    }
+    for (uint32_t i = 0; i < count; ++i) {
+      uint64_t payload;
+      memcpy(&payload, evts[i].user.raw_payload, sizeof(payload));
+      in_order = in_order && payload == expected++;
+    }
+    _maru_internal_event_queue_release_overflow(&f.queue, count);
+  }
+  EXPECT_TRUE(in_order);
+  EXPECT_EQ(expected, (uint64_t)7);
+  EXPECT_EQ(atomic_load(&f.queue.overflow_pending), (size_t)0);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
+
+UTEST(InternalEventQueue, UserPayloadPushZeroesTailInRingAndOverflow) {
+  struct QueueFixture f;
+  ASSERT_TRUE(queue_fixture_init_ex(&f, 4, true));
+
+  // Dirty every ring slot first, then wrap around with short payloads.
+  for (uint64_t i = 0; i < 4; ++i) {
+    ASSERT_TRUE(post_user(&f, ~(uint64_t)0));
+  }
+  size_t first = 0;
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 4), 4u);
+  for (uint32_t i = 0; i < 4; ++i) {
+    memset(f.queue.events[i].user.raw_payload, 0xab,
+           sizeof(f.queue.events[i].user.raw_payload));
+  }
+  _maru_internal_event_queue_release(&f.queue, first, 4);
+
+  // Four fit in the ring, the fifth spills.
+  for (uint64_t i = 0; i < 5; ++i) {
+    ASSERT_TRUE(_maru_internal_event_queue_push_user_payload(
+        &f.queue, MARU_EVENT_USER_2, &i, sizeof(i)));
+  }
+  EXPECT_EQ(atomic_load(&f.queue.spilled_count), (uint64_t)1);
+
+  static const uint8_t zeros[sizeof(((MARU_UserDefinedEvent *)0)->raw_payload)];
+  const size_t tail = sizeof(zeros) - sizeof(uint64_t);
+  ASSERT_EQ(_maru_internal_event_queue_acquire(&f.queue, &first, 64), 4u);
+  for (uint32_t i = 0; i < 4; ++i) {
+    const MARU_Event *evt = &f.queue.events[(first + i) % f.queue.capacity];
+    EXPECT_EQ(f.queue.slots[(first + i) % f.queue.capacity].type,
+              (MARU_EventId)MARU_EVENT_USER_2);
+    EXPECT_EQ(payload_at(&f, first + i), (uint64_t)i);
+    EXPECT_EQ(memcmp(evt->user.raw_payload + sizeof(uint64_t), zeros, tail), 0);
+  }
+  _maru_internal_event_queue_release(&f.queue, first, 4);
+
+  const MARU_InternalQueuedEventSlot *slots;
+  const MARU_Event *events;
+  ASSERT_EQ(_maru_internal_event_queue_acquire_overflow(&f.queue, &slots, &events, 64),
+            1u);
+  uint64_t payload;
+  memcpy(&payload, events[0].user.raw_payload, sizeof(payload));
+  EXPECT_EQ(payload, (uint64_t)4);
+  EXPECT_EQ(memcmp(events[0].user.raw_payload + sizeof(uint64_t), zeros, tail), 0);
+  _maru_internal_event_queue_release_overflow(&f.queue, 1);
+
+  _maru_internal_event_queue_cleanup(&f.queue, &f.ctx_base);
+}
@@ -0,0 +1,218 @@
+#include "utest.h"
+
+#include "linux/linux_internal.h"
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+struct AnalogEventLog {
+  int count;
+  MARU_ControllerAnalogChangedEvent last;
+};
+
+static void on_analog_event(MARU_EventId type, MARU_Window *window,
+                            const MARU_Event *evt, void *userdata) {
+  struct AnalogEventLog *log = (struct AnalogEventLog *)userdata;
+  (void)window;
+  if (type == MARU_EVENT_CONTROLLER_ANALOG_CHANGED) {
+    log->count++;
+    log->last = evt->controller_analog_changed;
+  }
+}
+
+struct AnalogFixture {
+  MARU_Context_Base ctx_base;
+  MARU_Context_Linux_Common common;
+  MARU_PumpContext pump_ctx;
+  MARU_LinuxController ctrl;
+  MARU_AnalogInputState states[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  MARU_Scalar reported[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  struct input_absinfo abs_info[MARU_CONTROLLER_ANALOG_STANDARD_COUNT];
+  struct AnalogEventLog log;
+  int pipe_fds[2];
+};
+
+static bool analog_fixture_init(struct AnalogFixture *f) {
+  memset(f, 0, sizeof(*f));
+  if (pipe(f->pipe_fds) != 0) {
+    return false;
+  }
+  (void)fcntl(f->pipe_fds[0], F_SETFL, O_NONBLOCK);
+
+  MARU_ContextTuning tuning = MARU_CONTEXT_TUNING_DEFAULT;
+  f->ctx_base.tuning = tuning;
+  f->ctx_base.pump_ctx = &f->pump_ctx;
+  f->pump_ctx.mask = MARU_ALL_EVENTS;
+  f->pump_ctx.callback = on_analog_event;
+  f->pump_ctx.userdata = &f->log;
+
+  f->ctrl.fd = f->pipe_fds[0];
+  f->ctrl.analog_states = f->states;
+  f->ctrl.analog_reported = f->reported;
+  f->ctrl.analog_abs_info = f->abs_info;
+  memset(f->ctrl.evdev_to_button, 0xff, sizeof(f->ctrl.evdev_to_button));
+  memset(f->ctrl.evdev_to_analog, 0xff, sizeof(f->ctrl.evdev_to_analog));
+  f->ctrl.evdev_to_analog[ABS_X] = MARU_CONTROLLER_ANALOG_LEFT_X;
+  f->ctrl.evdev_to_analog[ABS_Y] = MARU_CONTROLLER_ANALOG_LEFT_Y;
+  for (uint32_t i = 0; i < MARU_CONTROLLER_ANALOG_STANDARD_COUNT; ++i) {
+    f->abs_info[i].minimum = -1000;
+    f->abs_info[i].maximum = 1000;
+  }
+
+  f->common.ctx_base = &f->ctx_base;
+  f->common.controllers = &f->ctrl;
+  return true;
+}
+
+static void analog_fixture_shutdown(struct AnalogFixture *f) {
+  close(f->pipe_fds[0]);
+  close(f->pipe_fds[1]);
+}
+
+static bool write_input(struct AnalogFixture *f, uint16_t type, uint16_t code,
+                        int32_t value) {
+  struct input_event ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.type = type;
+  ev.code = code;
+  ev.value = value;
+  return write(f->pipe_fds[1], &ev, sizeof(ev)) == (ssize_t)sizeof(ev);
+}
+
+static void pump_input(struct AnalogFixture *f) {
+  struct pollfd pfd = {.fd = f->pipe_fds[0], .events = POLLIN, .revents = POLLIN};
+  _maru_linux_common_process_pollfds(&f->common, &pfd, 1);
+}
+
+UTEST(LinuxController, AnalogChangesCoalescePerReport) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 200));
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 600));
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_Y, 1000));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 0);
+
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 1);
+  EXPECT_TRUE(f.log.last.controller == (MARU_Controller *)&f.ctrl);
+  EXPECT_EQ(f.log.last.changed_mask, (uint64_t)0x3);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_X], 0.6f, 1e-4f);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_Y], -1.0f, 1e-4f);
+
+  analog_fixture_shutdown(&f);
+}
+
+UTEST(LinuxController, AnalogNoiseBelowEpsilonIsDropped) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+  f.ctx_base.tuning.controller.analog_epsilon = 0.01f;
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 500));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  ASSERT_EQ(f.log.count, 1);
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 502));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 1);
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 520));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 2);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_X], 0.52f, 1e-4f);
+
+  analog_fixture_shutdown(&f);
+}
+
+UTEST(LinuxController, AnalogDeadzoneReportsRest) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+  f.ctx_base.tuning.controller.analog_deadzone = 0.1f;
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 50));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 0);
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 800));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  ASSERT_EQ(f.log.count, 1);
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, -40));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 2);
+  EXPECT_EQ(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_X], 0.0f);
+  EXPECT_NEAR(f.ctrl.analog_states[MARU_CONTROLLER_ANALOG_LEFT_X].value, -0.04f, 1e-4f);
+
+  analog_fixture_shutdown(&f);
+}
+
+UTEST(LinuxController, ReportsSpanningReadBatchesStayGrouped) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+
+  // Three events per report never line up with the read batch size.
+  const int report_count = 100;
+  for (int i = 1; i <= report_count; ++i) {
+    ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, i * 10));
+    ASSERT_TRUE(write_input(&f, EV_ABS, ABS_Y, -i * 10));
+    ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  }
+  pump_input(&f);
+
+  EXPECT_EQ(f.log.count, report_count);
+  EXPECT_EQ(f.log.last.changed_mask, (uint64_t)0x3);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_X], 1.0f, 1e-4f);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_Y], 1.0f, 1e-4f);
+
+  analog_fixture_shutdown(&f);
+}
+
+UTEST(LinuxController, SynDroppedDiscardsUntilNextReport) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 300));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_DROPPED, 0));
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 900));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+
+  // The pipe cannot be resynced with EVIOCGABS, so nothing from the dropped
+  // report may surface.
+  EXPECT_EQ(f.log.count, 0);
+  EXPECT_FALSE(f.ctrl.syn_dropped);
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 500));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+  pump_input(&f);
+  EXPECT_EQ(f.log.count, 1);
+  EXPECT_NEAR(f.log.last.standard_values[MARU_CONTROLLER_ANALOG_LEFT_X], 0.5f, 1e-4f);
+
+  analog_fixture_shutdown(&f);
+}
+
+UTEST(LinuxController, PollfdLookupToleratesReorderedEntries) {
+  struct AnalogFixture f;
+  ASSERT_TRUE(analog_fixture_init(&f));
+
+  ASSERT_TRUE(write_input(&f, EV_ABS, ABS_X, 400));
+  ASSERT_TRUE(write_input(&f, EV_SYN, SYN_REPORT, 0));
+
+  struct pollfd pfds[2] = {
+      {.fd = -1, .events = POLLIN, .revents = 0},
+      {.fd = f.pipe_fds[0], .events = POLLIN, .revents = POLLIN},
+  };
+  _maru_linux_common_process_pollfds(&f.common, pfds, 2);
+  EXPECT_EQ(f.log.count, 1);
+
+  analog_fixture_shutdown(&f);
+}
@@ -0,0 +1,369 @@
+#include "utest.h"
+
+#include "linux/linux_dataexchange.h"
+#include "maru_mem_internal.h"
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PAYLOAD_SIZE (3u * MARU_LINUX_DATAEXCHANGE_CHUNK_SIZE + 1234u)
+
+struct TransferLog {
+  int chunk_count;
+  int final_count;
+  int received_count;
+  int released_count;
+  bool released_borrowed_data;
+  bool offsets_contiguous;
+  size_t largest_chunk;
+  size_t total;
+  MARU_Status final_status;
+  void *userdata;
+  uint8_t *payload;
+};
+
+static void on_transfer_event(MARU_EventId type, MARU_Window *window,
+                              const MARU_Event *evt, void *userdata) {
+  struct TransferLog *log = (struct TransferLog *)userdata;
+  (void)window;
+  if (type == MARU_EVENT_DATA_RELEASED) {
+    log->released_count++;
+    log->released_borrowed_data |= evt->data_released.data != NULL;
+    return;
+  }
+  if (type == MARU_EVENT_DATA_RECEIVED) {
+    log->received_count++;
+    log->final_status = evt->data_received.status;
+    log->userdata = evt->data_received.userdata;
+    if (evt->data_received.size <= PAYLOAD_SIZE) {
+      memcpy(log->payload, evt->data_received.data, evt->data_received.size);
+      log->total = evt->data_received.size;
+    }
+    return;
+  }
+  if (type != MARU_EVENT_DATA_CHUNK_RECEIVED) {
+    return;
+  }
+
+  const MARU_DataChunkReceivedEvent *chunk = &evt->data_chunk_received;
+  log->chunk_count++;
+  log->userdata = chunk->userdata;
+  if (chunk->offset != (uint64_t)log->total) {
+    log->offsets_contiguous = false;
+  }
+  if (chunk->size > log->largest_chunk) {
+    log->largest_chunk = chunk->size;
+  }
+  if (log->total + chunk->size <= PAYLOAD_SIZE) {
+    memcpy(log->payload + log->total, chunk->data, chunk->size);
+  }
+  log->total += chunk->size;
+  if (chunk->is_final) {
+    log->final_count++;
+    log->final_status = chunk->status;
+  }
+}
+
+struct TransferFixture {
+  MARU_Context_Base ctx_base;
+  MARU_PumpContext pump_ctx;
+  MARU_LinuxDataTransfer *transfers;
+  struct TransferLog log;
+  uint8_t source[PAYLOAD_SIZE];
+  uint8_t payload[PAYLOAD_SIZE];
+  int pipe_fds[2];
+};
+
+static bool transfer_fixture_init(struct TransferFixture *f) {
+  memset(f, 0, sizeof(*f));
+  if (pipe(f->pipe_fds) != 0) {
+    return false;
+  }
+  (void)fcntl(f->pipe_fds[0], F_SETFL, O_NONBLOCK);
+  (void)fcntl(f->pipe_fds[1], F_SETFL, O_NONBLOCK);
+
+  f->ctx_base.allocator.alloc_cb = _maru_default_alloc;
+  f->ctx_base.allocator.realloc_cb = _maru_default_realloc;
+  f->ctx_base.allocator.free_cb = _maru_default_free;
+  f->ctx_base.pump_ctx = &f->pump_ctx;
+  f->pump_ctx.mask = MARU_ALL_EVENTS;
+  f->pump_ctx.callback = on_transfer_event;
+  f->pump_ctx.userdata = &f->log;
+
+  f->log.offsets_contiguous = true;
+  f->log.payload = f->payload;
+  for (uint32_t i = 0; i < PAYLOAD_SIZE; ++i) {
+    f->source[i] = (uint8_t)(i * 31u + 7u);
+  }
+  return true;
+}
+
+static void pump_transfers(struct TransferFixture *f) {
+  struct pollfd pfds[4];
+  const int count = maru_linux_dataexchange_fillPollFds(f->transfers, pfds, 4);
+  for (int i = 0; i < count; ++i) {
+    pfds[i].revents = pfds[i].events;
+  }
+  maru_linux_dataexchange_processTransfers(&f->ctx_base, &f->transfers, pfds, 0,
+                                           count);
+}
+
+// Feeds the whole source through the pipe, pumping whenever it fills up, then
+// closes the write end so the next pump sees EOF.
+static void feed_and_drain(struct TransferFixture *f) {
+  size_t written = 0;
+  while (written < PAYLOAD_SIZE) {
+    const ssize_t n =
+        write(f->pipe_fds[1], f->source + written, PAYLOAD_SIZE - written);
+    if (n > 0) {
+      written += (size_t)n;
+    }
+    pump_transfers(f);
+  }
+  close(f->pipe_fds[1]);
+  f->pipe_fds[1] = -1;
+  for (int i = 0; i < 8 && f->transfers; ++i) {
+    pump_transfers(f);
+  }
+}
+
+UTEST(LinuxDataExchange, StreamedReadDeliversBoundedChunksInOrder) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+
+  int token = 0;
+  ASSERT_TRUE(maru_linux_dataexchange_queueTransfer(
+                  &f.ctx_base, &f.transfers, f.pipe_fds[0], NULL,
+                  MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "video/mp4", &token,
+                  true) == MARU_SUCCESS);
+  feed_and_drain(&f);
+
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.received_count, 0);
+  EXPECT_EQ(f.log.final_count, 1);
+  EXPECT_TRUE(f.log.final_status == MARU_SUCCESS);
+  EXPECT_TRUE(f.log.userdata == &token);
+  EXPECT_GE(f.log.chunk_count, 4);
+  EXPECT_TRUE(f.log.offsets_contiguous);
+  EXPECT_LE(f.log.largest_chunk, (size_t)MARU_LINUX_DATAEXCHANGE_CHUNK_SIZE);
+  EXPECT_EQ(f.log.total, (size_t)PAYLOAD_SIZE);
+  EXPECT_EQ(memcmp(f.payload, f.source, PAYLOAD_SIZE), 0);
+}
+
+UTEST(LinuxDataExchange, UnstreamedReadDeliversOneDataReceived) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+
+  int token = 0;
+  ASSERT_TRUE(maru_linux_dataexchange_queueTransfer(
+                  &f.ctx_base, &f.transfers, f.pipe_fds[0], NULL,
+                  MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "video/mp4", &token,
+                  false) == MARU_SUCCESS);
+  feed_and_drain(&f);
+
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.chunk_count, 0);
+  EXPECT_EQ(f.log.received_count, 1);
+  EXPECT_TRUE(f.log.final_status == MARU_SUCCESS);
+  EXPECT_TRUE(f.log.userdata == &token);
+  EXPECT_EQ(f.log.total, (size_t)PAYLOAD_SIZE);
+  EXPECT_EQ(memcmp(f.payload, f.source, PAYLOAD_SIZE), 0);
+}
+
+static bool write_source(struct TransferFixture *f, size_t offset, size_t size) {
+  return write(f->pipe_fds[1], f->source + offset, size) == (ssize_t)size;
+}
+
+UTEST(LinuxDataExchange, UnstreamedShortReadsKeepTheBufferSmall) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+
+  ASSERT_TRUE(maru_linux_dataexchange_queueTransfer(
+                  &f.ctx_base, &f.transfers, f.pipe_fds[0], NULL,
+                  MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "text/plain", NULL,
+                  false) == MARU_SUCCESS);
+  MARU_LinuxDataTransfer *transfer = f.transfers;
+
+  ASSERT_TRUE(write_source(&f, 0u, 100u));
+  pump_transfers(&f);
+  ASSERT_TRUE(f.transfers == transfer);
+  EXPECT_EQ(transfer->size, (size_t)100u);
+  EXPECT_EQ(transfer->capacity, (size_t)MARU_LINUX_DATAEXCHANGE_MIN_READ);
+
+  ASSERT_TRUE(write_source(&f, 100u, 200u));
+  pump_transfers(&f);
+  EXPECT_EQ(transfer->size, (size_t)300u);
+  EXPECT_EQ(transfer->capacity, (size_t)MARU_LINUX_DATAEXCHANGE_MIN_READ);
+  EXPECT_EQ(f.log.received_count, 0);
+
+  close(f.pipe_fds[1]);
+  f.pipe_fds[1] = -1;
+  pump_transfers(&f);
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.received_count, 1);
+  EXPECT_TRUE(f.log.final_status == MARU_SUCCESS);
+  EXPECT_EQ(f.log.total, (size_t)300u);
+  EXPECT_EQ(memcmp(f.payload, f.source, 300u), 0);
+}
+
+UTEST(LinuxDataExchange, UnstreamedReadGrowsToPendingBytes) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+
+  ASSERT_TRUE(maru_linux_dataexchange_queueTransfer(
+                  &f.ctx_base, &f.transfers, f.pipe_fds[0], NULL,
+                  MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "text/plain", NULL,
+                  false) == MARU_SUCCESS);
+  MARU_LinuxDataTransfer *transfer = f.transfers;
+
+  ASSERT_TRUE(write_source(&f, 0u, 100u));
+  pump_transfers(&f);
+  ASSERT_EQ(transfer->capacity, (size_t)MARU_LINUX_DATAEXCHANGE_MIN_READ);
+
+  // More than the free space is pending; the buffer grows to take it whole
+  // rather than by one floor step per read.
+  ASSERT_TRUE(write_source(&f, 100u, 20000u));
+  pump_transfers(&f);
+  EXPECT_EQ(transfer->size, (size_t)20100u);
+  EXPECT_GE(transfer->capacity, (size_t)20100u);
+  EXPECT_LE(transfer->capacity, (size_t)32768u);
+
+  close(f.pipe_fds[1]);
+  f.pipe_fds[1] = -1;
+  pump_transfers(&f);
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.received_count, 1);
+  EXPECT_EQ(f.log.total, (size_t)20100u);
+  EXPECT_EQ(memcmp(f.payload, f.source, 20100u), 0);
+}
+
+UTEST(LinuxDataExchange, UnstreamedReadOfEmptySourceSucceeds) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+
+  int token = 0;
+  ASSERT_TRUE(maru_linux_dataexchange_queueTransfer(
+                  &f.ctx_base, &f.transfers, f.pipe_fds[0], NULL,
+                  MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "text/plain", &token,
+                  false) == MARU_SUCCESS);
+  close(f.pipe_fds[1]);
+  f.pipe_fds[1] = -1;
+  pump_transfers(&f);
+
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.received_count, 1);
+  EXPECT_TRUE(f.log.final_status == MARU_SUCCESS);
+  EXPECT_TRUE(f.log.userdata == &token);
+  EXPECT_EQ(f.log.total, (size_t)0u);
+}
+
+struct PipeSink {
+  int read_fd;
+  size_t size;
+  uint8_t *data;
+};
+
+static void drain_sink(struct PipeSink *sink, size_t capacity) {
+  for (;;) {
+    const ssize_t n = read(sink->read_fd, sink->data + sink->size, capacity - sink->size);
+    if (n <= 0) {
+      return;
+    }
+    sink->size += (size_t)n;
+  }
+}
+
+// Queues a file-backed write of source[offset, offset + size) into a fresh
+// pipe whose read end is handed back through `sink`.
+static bool queue_fd_write(struct TransferFixture *f, int source_fd, uint64_t offset,
+                           size_t size, struct PipeSink *sink) {
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return false;
+  }
+  (void)fcntl(fds[0], F_SETFL, O_NONBLOCK);
+  sink->read_fd = fds[0];
+  const int dup_fd = fcntl(source_fd, F_DUPFD_CLOEXEC, 0);
+  return maru_linux_dataexchange_queueFdWriteTransfer(
+             &f->ctx_base, &f->transfers, fds[1], NULL,
+             MARU_DATA_EXCHANGE_TARGET_CLIPBOARD, "image/png", dup_fd, offset,
+             size) == MARU_SUCCESS;
+}
+
+static int make_source_file(const uint8_t *data, size_t size) {
+  FILE *file = tmpfile();
+  if (!file) {
+    return -1;
+  }
+  const int fd = dup(fileno(file));
+  const bool ok = fwrite(data, 1, size, file) == size && fflush(file) == 0;
+  fclose(file);
+  if (!ok) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+UTEST(LinuxDataExchange, FileBackedWriteServesSeveralRequestersFromOneFd) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+  close(f.pipe_fds[0]);
+  close(f.pipe_fds[1]);
+
+  const int source_fd = make_source_file(f.source, PAYLOAD_SIZE);
+  ASSERT_GE(source_fd, 0);
+  const uint64_t offset = 1000u;
+  const size_t size = PAYLOAD_SIZE - 1000u;
+
+  static uint8_t sink_data[2][PAYLOAD_SIZE];
+  struct PipeSink sinks[2] = {{.data = sink_data[0]}, {.data = sink_data[1]}};
+  ASSERT_TRUE(queue_fd_write(&f, source_fd, offset, size, &sinks[0]));
+  ASSERT_TRUE(queue_fd_write(&f, source_fd, offset, size, &sinks[1]));
+  // Maru holds its own duplicates, so the caller may let go of the source.
+  close(source_fd);
+
+  for (int i = 0; i < 1000 && f.transfers; ++i) {
+    pump_transfers(&f);
+    drain_sink(&sinks[0], PAYLOAD_SIZE);
+    drain_sink(&sinks[1], PAYLOAD_SIZE);
+  }
+  drain_sink(&sinks[0], PAYLOAD_SIZE);
+  drain_sink(&sinks[1], PAYLOAD_SIZE);
+
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.released_count, 2);
+  EXPECT_FALSE(f.log.released_borrowed_data);
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_EQ(sinks[i].size, size);
+    EXPECT_EQ(memcmp(sinks[i].data, f.source + offset, size), 0);
+    close(sinks[i].read_fd);
+  }
+}
+
+UTEST(LinuxDataExchange, FileBackedWriteFailsWhenSourceEndsEarly) {
+  struct TransferFixture f;
+  ASSERT_TRUE(transfer_fixture_init(&f));
+  close(f.pipe_fds[0]);
+  close(f.pipe_fds[1]);
+
+  const int source_fd = make_source_file(f.source, 100u);
+  ASSERT_GE(source_fd, 0);
+
+  static uint8_t sink_data[PAYLOAD_SIZE];
+  struct PipeSink sink = {.data = sink_data};
+  ASSERT_TRUE(queue_fd_write(&f, source_fd, 0u, 200u, &sink));
+  close(source_fd);
+
+  for (int i = 0; i < 10 && f.transfers; ++i) {
+    pump_transfers(&f);
+    drain_sink(&sink, PAYLOAD_SIZE);
+  }
+
+  EXPECT_TRUE(f.transfers == NULL);
+  EXPECT_EQ(f.log.released_count, 1);
+  EXPECT_EQ(sink.size, (size_t)100u);
+  close(sink.read_fd);
+}
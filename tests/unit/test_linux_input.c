@@ -0,0 +1,149 @@
+#include "utest.h"
+
+#include "linux/linux_internal.h"
+#include "maru_mem_internal.h"
+
+#include <string.h>
+
+struct MotionEventLog {
+  int count;
+  MARU_Window *window;
+  MARU_MouseMovedEvent last;
+  uint32_t sample_count;
+  MARU_MouseMotionSample samples[4];
+};
+
+struct MotionFixture {
+  MARU_Context_Base ctx_base;
+  MARU_PumpContext pump_ctx;
+  MARU_LinuxMotionBatch batch;
+  struct MotionEventLog log;
+};
+
+static void on_motion_event(MARU_EventId type, MARU_Window *window,
+                            const MARU_Event *evt, void *userdata) {
+  struct MotionFixture *f = (struct MotionFixture *)userdata;
+  if (type != MARU_EVENT_MOUSE_MOVED) {
+    return;
+  }
+  f->log.count++;
+  f->log.window = window;
+  f->log.last = evt->mouse_moved;
+  f->log.sample_count = f->ctx_base.pub.mouse_motion_sample_count;
+  for (uint32_t i = 0; i < f->log.sample_count && i < 4u; ++i) {
+    f->log.samples[i] = f->ctx_base.pub.mouse_motion_samples[i];
+  }
+}
+
+static void motion_fixture_init(struct MotionFixture *f) {
+  memset(f, 0, sizeof(*f));
+  f->ctx_base.allocator.alloc_cb = _maru_default_alloc;
+  f->ctx_base.allocator.realloc_cb = _maru_default_realloc;
+  f->ctx_base.allocator.free_cb = _maru_default_free;
+  f->ctx_base.pump_ctx = &f->pump_ctx;
+  f->pump_ctx.mask = MARU_ALL_EVENTS;
+  f->pump_ctx.callback = on_motion_event;
+  f->pump_ctx.userdata = f;
+}
+
+static MARU_MouseMotionSample make_sample(MARU_Scalar dx, MARU_Scalar dy,
+                                          uint64_t timestamp_ns) {
+  MARU_MouseMotionSample sample = {0};
+  sample.dip_delta.x = dx;
+  sample.dip_delta.y = dy;
+  sample.raw_dip_delta.x = dx * (MARU_Scalar)2.0;
+  sample.raw_dip_delta.y = dy * (MARU_Scalar)2.0;
+  sample.timestamp_ns = timestamp_ns;
+  return sample;
+}
+
+UTEST(LinuxInput, MotionBatchFoldsSamplesIntoOneEvent) {
+  struct MotionFixture f;
+  motion_fixture_init(&f);
+  MARU_Window *window = (MARU_Window *)&f;
+
+  const MARU_MouseMotionSample first = make_sample(1.0, 2.0, 100u);
+  const MARU_MouseMotionSample second = make_sample(3.0, -1.0, 200u);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &first, false);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &second, false);
+  EXPECT_EQ(f.log.count, 0);
+
+  const MARU_Vec2Dip position = {10.0, 20.0};
+  _maru_linux_motion_batch_flush(&f.ctx_base, &f.batch, window, position, 0);
+  ASSERT_EQ(f.log.count, 1);
+  EXPECT_TRUE(f.log.window == window);
+  EXPECT_EQ(f.log.last.dip_position.x, (MARU_Scalar)10.0);
+  EXPECT_EQ(f.log.last.dip_delta.x, (MARU_Scalar)4.0);
+  EXPECT_EQ(f.log.last.dip_delta.y, (MARU_Scalar)1.0);
+  EXPECT_EQ(f.log.last.timestamp_ns, (uint64_t)200u);
+  ASSERT_EQ(f.log.sample_count, (uint32_t)2);
+  EXPECT_EQ(f.log.samples[0].timestamp_ns, (uint64_t)100u);
+  EXPECT_EQ(f.log.samples[1].dip_delta.x, (MARU_Scalar)3.0);
+  EXPECT_TRUE(f.ctx_base.pub.mouse_motion_samples == NULL);
+
+  // The batch starts over, so a second flush has nothing to send.
+  EXPECT_EQ(f.batch.count, (uint32_t)0);
+  _maru_linux_motion_batch_flush(&f.ctx_base, &f.batch, window, position, 0);
+  EXPECT_EQ(f.log.count, 1);
+
+  _maru_linux_motion_batch_cleanup(&f.ctx_base, &f.batch);
+}
+
+UTEST(LinuxInput, MotionBatchPrefersRelativeDelta) {
+  struct MotionFixture f;
+  motion_fixture_init(&f);
+  MARU_Window *window = (MARU_Window *)&f;
+
+  const MARU_MouseMotionSample absolute = make_sample(1.0, 1.0, 100u);
+  const MARU_MouseMotionSample relative = make_sample(5.0, 6.0, 150u);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &absolute, false);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &relative, true);
+  _maru_linux_motion_batch_flush(&f.ctx_base, &f.batch, window, (MARU_Vec2Dip){0}, 0);
+
+  ASSERT_EQ(f.log.count, 1);
+  EXPECT_EQ(f.log.last.dip_delta.x, (MARU_Scalar)5.0);
+  EXPECT_EQ(f.log.last.raw_dip_delta.y, (MARU_Scalar)12.0);
+  EXPECT_EQ(f.log.sample_count, (uint32_t)2);
+
+  _maru_linux_motion_batch_cleanup(&f.ctx_base, &f.batch);
+}
+
+UTEST(LinuxInput, MotionBatchResetDropsPendingMotion) {
+  struct MotionFixture f;
+  motion_fixture_init(&f);
+  MARU_Window *window = (MARU_Window *)&f;
+
+  const MARU_MouseMotionSample sample = make_sample(1.0, 1.0, 100u);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &sample, true);
+  _maru_linux_motion_batch_reset(&f.batch);
+  EXPECT_TRUE(f.batch.window == NULL);
+  EXPECT_FALSE(f.batch.has_relative);
+  EXPECT_TRUE(f.batch.samples != NULL);
+
+  _maru_linux_motion_batch_flush(&f.ctx_base, &f.batch, window, (MARU_Vec2Dip){0}, 0);
+  EXPECT_EQ(f.log.count, 0);
+
+  // A flush without a live window drops the batch as well.
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &sample, false);
+  _maru_linux_motion_batch_flush(&f.ctx_base, &f.batch, NULL, (MARU_Vec2Dip){0}, 0);
+  EXPECT_EQ(f.log.count, 0);
+  EXPECT_EQ(f.batch.count, (uint32_t)0);
+  EXPECT_FALSE(f.batch.has_absolute);
+
+  _maru_linux_motion_batch_cleanup(&f.ctx_base, &f.batch);
+}
+
+UTEST(LinuxInput, MotionBatchSkipsCaptureWhileMouseMovedIsMasked) {
+  struct MotionFixture f;
+  motion_fixture_init(&f);
+  MARU_Window *window = (MARU_Window *)&f;
+  f.pump_ctx.mask = MARU_ALL_EVENTS & ~MARU_MASK_MOUSE_MOVED;
+
+  const MARU_MouseMotionSample sample = make_sample(1.0, 1.0, 100u);
+  _maru_linux_motion_batch_add(&f.ctx_base, &f.batch, window, &sample, false);
+  EXPECT_EQ(f.batch.count, (uint32_t)0);
+  EXPECT_FALSE(f.batch.has_absolute);
+  EXPECT_TRUE(f.batch.samples == NULL);
+
+  _maru_linux_motion_batch_cleanup(&f.ctx_base, &f.batch);
+}
@@ -2,6 +2,8 @@
 #include "maru/maru.h"
 #include "maru/queue.h"
 #include "maru_test_utils.h"
+#include "maru_event_filter.h"
+#include <stdio.h>
 #include <stdlib.h>
 
 struct QueueTestState {
@@ -151,6 +153,7 @@ struct CoalesceResult {
     int count;
     MARU_Vec2Dip dip_pos;
     MARU_Vec2Dip dip_delta;
+    uint64_t timestamp_ns;
 };
 
 static void on_coalesce_event(MARU_EventId type,
@@ -163,6 +166,7 @@ static void on_coalesce_event(MARU_EventId type,
     if (type == MARU_EVENT_MOUSE_MOVED) {
         r->dip_pos = evt->mouse_moved.dip_position;
         r->dip_delta = evt->mouse_moved.dip_delta;
+        r->timestamp_ns = evt->mouse_moved.timestamp_ns;
     }
 }
 
@@ -179,6 +183,7 @@ UTEST(QueueTest, Coalescence) {
     ev1.mouse_moved.dip_position.y = (MARU_Scalar)10.0;
     ev1.mouse_moved.dip_delta.x = (MARU_Scalar)5.0;
     ev1.mouse_moved.dip_delta.y = (MARU_Scalar)5.0;
+    ev1.mouse_moved.timestamp_ns = 1000u;
     maru_pushQueue(queue, MARU_EVENT_MOUSE_MOVED, MARU_WINDOW_ID_NONE, &ev1);
 
     // ev2
@@ -187,6 +192,7 @@ UTEST(QueueTest, Coalescence) {
     ev2.mouse_moved.dip_position.y = (MARU_Scalar)20.0;
     ev2.mouse_moved.dip_delta.x = (MARU_Scalar)10.0;
     ev2.mouse_moved.dip_delta.y = (MARU_Scalar)10.0;
+    ev2.mouse_moved.timestamp_ns = 2000u;
     maru_pushQueue(queue, MARU_EVENT_MOUSE_MOVED, MARU_WINDOW_ID_NONE, &ev2);
 
     maru_commitQueue(queue);
@@ -199,6 +205,7 @@ UTEST(QueueTest, Coalescence) {
     EXPECT_EQ(result.dip_pos.y, (MARU_Scalar)20.0);
     EXPECT_EQ(result.dip_delta.x, (MARU_Scalar)15.0);
     EXPECT_EQ(result.dip_delta.y, (MARU_Scalar)15.0);
+    EXPECT_EQ(result.timestamp_ns, (uint64_t)2000u);
 
     maru_destroyQueue(queue);
 }
@@ -451,3 +458,938 @@ UTEST(QueueTest, SurvivesUnrelatedContextDestruction) {
 
     maru_destroyQueue(queue);
 }
+
+static bool create_triple_buffered_queue(uint32_t capacity, MARU_Queue **out_queue) {
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = capacity;
+    create_info.triple_buffered = true;
+    return maru_createQueue(&create_info, out_queue);
+}
+
+UTEST(QueueTest, TripleBufferedCommitScan) {
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_triple_buffered_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    struct QueueTestState state = {0};
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &state);
+    EXPECT_EQ(state.event_count, 0);
+
+    // Cycle through every buffer more than once.
+    for (int round = 0; round < 5; ++round) {
+        const MARU_EventId type = (round % 2) ? MARU_EVENT_USER_1 : MARU_EVENT_USER_0;
+        for (int i = 0; i <= round; ++i) {
+            EXPECT_TRUE(push_user_event(queue, type));
+        }
+        EXPECT_TRUE(maru_commitQueue(queue));
+
+        state.event_count = 0;
+        maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &state);
+        EXPECT_EQ(state.event_count, round + 1);
+        EXPECT_EQ(state.last_type, type);
+    }
+
+    maru_destroyQueue(queue);
+}
+
+struct TripleBufferScanState {
+    MARU_Queue *queue;
+    int user0_count;
+    int other_count;
+    int commits;
+    int nested_commit_results[2];
+};
+
+static void on_triple_buffer_scan(MARU_EventId type,
+                                  MARU_WindowId window_id,
+                                  const MARU_Event *evt,
+                                  void *userdata) {
+    struct TripleBufferScanState *state = (struct TripleBufferScanState *)userdata;
+    (void)window_id;
+    (void)evt;
+    if (type == MARU_EVENT_USER_0) {
+        state->user0_count++;
+    } else {
+        state->other_count++;
+    }
+
+    // Commit repeatedly while this snapshot is pinned. None of them may reuse
+    // the buffer being scanned.
+    if (state->commits == 0) {
+        for (int i = 0; i < 4; ++i) {
+            push_user_event(state->queue, MARU_EVENT_USER_1);
+            push_user_event(state->queue, MARU_EVENT_USER_1);
+            if (maru_commitQueue(state->queue)) {
+                state->commits++;
+            }
+        }
+    }
+}
+
+UTEST(QueueTest, TripleBufferedCommitDuringScanKeepsSnapshot) {
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_triple_buffered_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    }
+    EXPECT_TRUE(maru_commitQueue(queue));
+
+    struct TripleBufferScanState state = {0};
+    state.queue = queue;
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_triple_buffer_scan, &state);
+    EXPECT_EQ(state.commits, 4);
+    EXPECT_EQ(state.user0_count, 3);
+    EXPECT_EQ(state.other_count, 0);
+
+    // Later scans see the latest commit.
+    struct QueueTestState latest = {0};
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &latest);
+    EXPECT_EQ(latest.event_count, 2);
+    EXPECT_EQ(latest.last_type, (MARU_EventId)MARU_EVENT_USER_1);
+
+    maru_destroyQueue(queue);
+}
+
+static void on_nested_triple_buffer_scan(MARU_EventId type,
+                                         MARU_WindowId window_id,
+                                         const MARU_Event *evt,
+                                         void *userdata) {
+    struct TripleBufferScanState *state = (struct TripleBufferScanState *)userdata;
+    (void)window_id;
+    (void)evt;
+    if (type == MARU_EVENT_USER_0) {
+        state->user0_count++;
+        // Publish a second snapshot and pin it too.
+        push_user_event(state->queue, MARU_EVENT_USER_1);
+        state->nested_commit_results[0] = maru_commitQueue(state->queue) ? 1 : 0;
+        maru_scanQueue(state->queue, MARU_ALL_EVENTS, on_nested_triple_buffer_scan,
+                       state);
+    } else if (type == MARU_EVENT_USER_1) {
+        state->other_count++;
+        // Both spare buffers are pinned: the commit is deferred.
+        push_user_event(state->queue, MARU_EVENT_USER_2);
+        state->nested_commit_results[1] = maru_commitQueue(state->queue) ? 1 : 0;
+    }
+}
+
+UTEST(QueueTest, TripleBufferedCommitDefersWhenAllBuffersPinned) {
+    struct QueueDiagnosticState diag_state = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 16u;
+    create_info.triple_buffered = true;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag_state;
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(maru_createQueue(&create_info, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+
+    struct TripleBufferScanState state = {0};
+    state.queue = queue;
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_nested_triple_buffer_scan, &state);
+    EXPECT_EQ(state.user0_count, 1);
+    EXPECT_EQ(state.other_count, 1);
+    EXPECT_EQ(state.nested_commit_results[0], 1);
+    EXPECT_EQ(state.nested_commit_results[1], 0);
+    // A deferred commit loses nothing, so it raises no diagnostic.
+    EXPECT_EQ(diag_state.call_count, 0);
+
+    // The deferred events are still pending and go out with the next commit.
+    EXPECT_TRUE(maru_commitQueue(queue));
+    struct QueueTestState latest = {0};
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &latest);
+    EXPECT_EQ(latest.event_count, 1);
+    EXPECT_EQ(latest.last_type, (MARU_EventId)MARU_EVENT_USER_2);
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, ViewExposesStableColumns) {
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    MARU_QueueView view;
+    maru_getQueueView(queue, &view);
+    EXPECT_EQ(view.count, (uint32_t)0);
+    maru_releaseQueueView(queue, &view);
+
+    MARU_Event evt = {0};
+    evt.mouse_moved.dip_delta.x = 2.0;
+    EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_MOUSE_MOVED, 7u, &evt));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+
+    // Uncommitted events are not visible.
+    maru_getQueueView(queue, &view);
+    EXPECT_EQ(view.count, (uint32_t)0);
+    maru_releaseQueueView(queue, &view);
+
+    EXPECT_TRUE(maru_commitQueue(queue));
+    maru_getQueueView(queue, &view);
+    ASSERT_EQ(view.count, (uint32_t)2);
+    EXPECT_EQ(view.types[0], (MARU_EventId)MARU_EVENT_MOUSE_MOVED);
+    EXPECT_EQ(view.window_ids[0], (MARU_WindowId)7u);
+    EXPECT_EQ(view.events[0].mouse_moved.dip_delta.x, 2.0);
+    EXPECT_EQ(view.types[1], (MARU_EventId)MARU_EVENT_USER_0);
+    EXPECT_EQ(view.window_ids[1], (MARU_WindowId)MARU_WINDOW_ID_NONE);
+    EXPECT_EQ(((uintptr_t)view.types) % 64u, (uintptr_t)0);
+    EXPECT_EQ(((uintptr_t)view.window_ids) % 64u, (uintptr_t)0);
+    EXPECT_EQ(((uintptr_t)view.events) % 64u, (uintptr_t)0);
+    maru_releaseQueueView(queue, &view);
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, TripleBufferedViewPinsSnapshot) {
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_triple_buffered_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+
+    MARU_QueueView held;
+    maru_getQueueView(queue, &held);
+    ASSERT_EQ(held.count, (uint32_t)1);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+        EXPECT_TRUE(maru_commitQueue(queue));
+    }
+
+    EXPECT_EQ(held.count, (uint32_t)1);
+    EXPECT_EQ(held.types[0], (MARU_EventId)MARU_EVENT_USER_0);
+
+    MARU_QueueView latest;
+    maru_getQueueView(queue, &latest);
+    EXPECT_EQ(latest.count, (uint32_t)2);
+    EXPECT_EQ(latest.types[0], (MARU_EventId)MARU_EVENT_USER_1);
+    maru_releaseQueueView(queue, &latest);
+    maru_releaseQueueView(queue, &held);
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, TripleBufferedCommitDefersWhileViewsPinEverySpare) {
+    struct QueueDiagnosticState diag_state = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 16u;
+    create_info.triple_buffered = true;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag_state;
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(maru_createQueue(&create_info, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    MARU_QueueView first;
+    maru_getQueueView(queue, &first);
+    ASSERT_EQ(first.count, (uint32_t)1);
+
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    MARU_QueueView second;
+    maru_getQueueView(queue, &second);
+    ASSERT_EQ(second.count, (uint32_t)1);
+
+    // Both spares are held, so this commit defers instead of waiting.
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_2));
+    EXPECT_FALSE(maru_commitQueue(queue));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_2));
+    EXPECT_FALSE(maru_commitQueue(queue));
+    EXPECT_EQ(diag_state.call_count, 0);
+    EXPECT_EQ(first.types[0], (MARU_EventId)MARU_EVENT_USER_0);
+    EXPECT_EQ(second.types[0], (MARU_EventId)MARU_EVENT_USER_1);
+
+    maru_releaseQueueView(queue, &first);
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_EQ(second.types[0], (MARU_EventId)MARU_EVENT_USER_1);
+    maru_releaseQueueView(queue, &second);
+
+    MARU_QueueView latest;
+    maru_getQueueView(queue, &latest);
+    ASSERT_EQ(latest.count, (uint32_t)2);
+    EXPECT_EQ(latest.types[0], (MARU_EventId)MARU_EVENT_USER_2);
+    EXPECT_EQ(latest.types[1], (MARU_EventId)MARU_EVENT_USER_2);
+    maru_releaseQueueView(queue, &latest);
+
+    maru_destroyQueue(queue);
+}
+
+struct QueueOrderState {
+    uint32_t count;
+    uint32_t last_index;
+    bool in_order;
+};
+
+static void on_ordered_event(MARU_EventId type,
+                             MARU_WindowId window_id,
+                             const MARU_Event *evt,
+                             void *userdata) {
+    struct QueueOrderState *state = (struct QueueOrderState *)userdata;
+    (void)type;
+    (void)evt;
+    // Each event carries its push index as its window id.
+    if (state->count > 0 && window_id <= state->last_index) {
+        state->in_order = false;
+    }
+    state->last_index = (uint32_t)window_id;
+    state->count++;
+}
+
+UTEST(QueueTest, ScanFiltersAcrossBlocks) {
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(256u, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    const uint32_t event_count = 203u;
+    uint32_t per_type[16] = {0};
+    MARU_Event evt = {0};
+    for (uint32_t i = 0; i < event_count; ++i) {
+        const uint32_t user = (i * 7u) % 16u;
+        EXPECT_TRUE(maru_pushQueue(queue, (MARU_EventId)(MARU_EVENT_USER_0 + user),
+                                   (MARU_WindowId)i, &evt));
+        per_type[user]++;
+    }
+    EXPECT_TRUE(maru_commitQueue(queue));
+
+    const MARU_EventMask masks[] = {
+        MARU_MASK_USER_3,
+        MARU_MASK_USER_0 | MARU_MASK_USER_5 | MARU_MASK_USER_15,
+        MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_USER_2 | MARU_MASK_USER_3 |
+            MARU_MASK_USER_8 | MARU_MASK_USER_9 | MARU_MASK_USER_10,
+        MARU_ALL_EVENTS,
+    };
+    for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); ++m) {
+        uint32_t expected = 0;
+        for (uint32_t user = 0; user < 16u; ++user) {
+            if (maru_eventMaskHas(masks[m], (MARU_EventId)(MARU_EVENT_USER_0 + user))) {
+                expected += per_type[user];
+            }
+        }
+
+        struct QueueOrderState state = {0, 0, true};
+        maru_scanQueue(queue, masks[m], on_ordered_event, &state);
+        EXPECT_EQ(state.count, expected);
+        EXPECT_TRUE(state.in_order);
+    }
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, EventFilterMatchesScalarReference) {
+    MARU_EventId types[MARU_EVENT_FILTER_BLOCK];
+    uint32_t seed = 12345u;
+    for (uint32_t i = 0; i < MARU_EVENT_FILTER_BLOCK; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        types[i] = (MARU_EventId)((seed >> 16) % 80u);
+    }
+    // Ids outside the mask range never match.
+    types[5] = (MARU_EventId)-1;
+    types[17] = (MARU_EventId)64;
+    types[40] = (MARU_EventId)96;
+
+    const MARU_EventMask masks[] = {
+        0,
+        MARU_MASK_MOUSE_MOVED,
+        MARU_MASK_CLOSE_REQUESTED | MARU_MASK_USER_15,
+        MARU_MASK_KEY_CHANGED | MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_WINDOW_FRAME,
+        MARU_MASK_KEY_CHANGED | MARU_MASK_USER_0 | MARU_MASK_USER_1 | MARU_MASK_WINDOW_FRAME |
+            MARU_MASK_MOUSE_SCROLLED,
+        MARU_ALL_EVENTS,
+        ~(MARU_EventMask)0,
+    };
+    for (size_t m = 0; m < sizeof(masks) / sizeof(masks[0]); ++m) {
+        MARU_EventFilter filter;
+        _maru_event_filter_init(&filter, masks[m]);
+        for (uint32_t count = 0; count <= MARU_EVENT_FILTER_BLOCK; ++count) {
+            uint64_t expected = 0;
+            for (uint32_t i = 0; i < count; ++i) {
+                if (maru_eventMaskHas(masks[m], types[i])) {
+                    expected |= (uint64_t)1u << i;
+                }
+            }
+            EXPECT_EQ(_maru_event_filter_block(&filter, types, count), expected);
+        }
+    }
+}
+
+UTEST(QueueTest, GrowsInsteadOfDropping) {
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 4u;
+    create_info.max_capacity = 64u;
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(maru_createQueue(&create_info, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    // Twice, so the other buffer has to catch up too.
+    for (int round = 0; round < 2; ++round) {
+        MARU_Event evt = {0};
+        for (uint32_t i = 0; i < 50u; ++i) {
+            EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_USER_0, (MARU_WindowId)i, &evt));
+        }
+        EXPECT_TRUE(maru_commitQueue(queue));
+
+        struct QueueOrderState state = {0, 0, true};
+        maru_scanQueue(queue, MARU_ALL_EVENTS, on_ordered_event, &state);
+        EXPECT_EQ(state.count, 50u);
+        EXPECT_TRUE(state.in_order);
+    }
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, GrowthStopsAtMaxCapacity) {
+    struct QueueDiagnosticState diag_state = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 4u;
+    create_info.max_capacity = 10u;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag_state;
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(maru_createQueue(&create_info, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    for (uint32_t i = 0; i < 10u; ++i) {
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    }
+    EXPECT_EQ(diag_state.call_count, 0);
+    EXPECT_FALSE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_EQ(diag_state.call_count, 1);
+    EXPECT_EQ(diag_state.last_diag,
+              (MARU_Diagnostic)MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE);
+
+    EXPECT_TRUE(maru_commitQueue(queue));
+    struct QueueTestState state = {0};
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &state);
+    EXPECT_EQ(state.event_count, 10);
+
+    maru_destroyQueue(queue);
+}
+
+UTEST(QueueTest, RejectsMaxCapacityBelowCapacity) {
+#ifdef MARU_VALIDATE_API_CALLS
+    return;
+#else
+    struct QueueDiagnosticState diag_state = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 16u;
+    create_info.max_capacity = 8u;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag_state;
+
+    MARU_Queue *queue = (MARU_Queue *)0x1;
+    EXPECT_FALSE(maru_createQueue(&create_info, &queue));
+    EXPECT_TRUE(queue == NULL);
+    EXPECT_EQ(diag_state.call_count, 1);
+    EXPECT_EQ(diag_state.last_diag,
+              (MARU_Diagnostic)MARU_DIAGNOSTIC_INVALID_ARGUMENT);
+#endif
+}
+
+struct QueueSizeTrackingAllocator {
+    size_t last_alloc_size;
+    size_t largest_alloc_size;
+};
+
+static void *queue_size_tracking_alloc(size_t size, void *userdata) {
+    struct QueueSizeTrackingAllocator *state =
+        (struct QueueSizeTrackingAllocator *)userdata;
+    state->last_alloc_size = size;
+    if (size > state->largest_alloc_size) {
+        state->largest_alloc_size = size;
+    }
+    return malloc(size);
+}
+
+UTEST(QueueTest, ShrinksAfterIdleCommits) {
+    struct QueueSizeTrackingAllocator alloc_state = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 4u;
+    create_info.max_capacity = 64u;
+    create_info.shrink_after_commits = 2u;
+    create_info.allocator.alloc_cb = queue_size_tracking_alloc;
+    create_info.allocator.realloc_cb = queue_test_realloc;
+    create_info.allocator.free_cb = queue_fail_free;
+    create_info.allocator.userdata = &alloc_state;
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(maru_createQueue(&create_info, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    for (uint32_t i = 0; i < 64u; ++i) {
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    }
+    EXPECT_TRUE(maru_commitQueue(queue));
+    const size_t grown_size = alloc_state.largest_alloc_size;
+
+    // One idle commit is not enough to give memory back.
+    alloc_state.last_alloc_size = 0;
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_EQ(alloc_state.last_alloc_size, (size_t)0);
+
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_TRUE(alloc_state.last_alloc_size != 0);
+    EXPECT_TRUE(alloc_state.last_alloc_size < grown_size);
+
+    // The shrunk buffer still grows again on demand.
+    for (uint32_t i = 0; i < 64u; ++i) {
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+    }
+    EXPECT_TRUE(maru_commitQueue(queue));
+    struct QueueTestState state = {0};
+    maru_scanQueue(queue, MARU_ALL_EVENTS, on_queue_event, &state);
+    EXPECT_EQ(state.event_count, 64);
+
+    maru_destroyQueue(queue);
+}
+
+struct QueueDeltaState {
+    uint32_t move_count;
+    uint32_t other_count;
+    bool deltas_ok;
+    bool in_order;
+    MARU_WindowId last_window_id;
+};
+
+static void on_delta_event(MARU_EventId type,
+                           MARU_WindowId window_id,
+                           const MARU_Event *evt,
+                           void *userdata) {
+    struct QueueDeltaState *state = (struct QueueDeltaState *)userdata;
+    if (type != MARU_EVENT_MOUSE_MOVED) {
+        state->other_count++;
+        return;
+    }
+    if (evt->mouse_moved.dip_delta.x != 2.0) {
+        state->deltas_ok = false;
+    }
+    if (state->move_count > 0 && window_id <= state->last_window_id) {
+        state->in_order = false;
+    }
+    state->last_window_id = window_id;
+    state->move_count++;
+}
+
+UTEST(QueueTest, CompactionScalesPastManyKeys) {
+    const uint32_t window_count = 150u;
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(window_count * 2u, &queue));
+    ASSERT_TRUE(queue != NULL);
+    maru_setQueueCoalesceMask(queue, MARU_MASK_MOUSE_MOVED);
+
+    // Run twice so the index is reused across compactions.
+    for (int round = 0; round < 2; ++round) {
+        MARU_Event evt = {0};
+        evt.mouse_moved.dip_delta.x = 1.0;
+        for (uint32_t pass = 0; pass < 2u; ++pass) {
+            for (uint32_t w = 1; w <= window_count; ++w) {
+                EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_MOUSE_MOVED,
+                                           (MARU_WindowId)w, &evt));
+            }
+        }
+        // The queue is full; this push compacts every key.
+        EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+        EXPECT_TRUE(maru_commitQueue(queue));
+
+        struct QueueDeltaState state = {0, 0, true, true, 0};
+        maru_scanQueue(queue, MARU_ALL_EVENTS, on_delta_event, &state);
+        EXPECT_EQ(state.move_count, window_count);
+        EXPECT_EQ(state.other_count, 1u);
+        EXPECT_TRUE(state.deltas_ok);
+        EXPECT_TRUE(state.in_order);
+    }
+
+    maru_destroyQueue(queue);
+}
+
+static void queue_recording_path(char *out, size_t size, const char *name) {
+#if defined(_WIN32)
+    const char *dir = getenv("TEMP");
+#else
+    const char *dir = getenv("TMPDIR");
+#endif
+    if (!dir || !dir[0]) {
+#if defined(_WIN32)
+        dir = ".";
+#else
+        dir = "/tmp";
+#endif
+    }
+    snprintf(out, size, "%s/maru_test_%s.mqrec", dir, name);
+}
+
+UTEST(QueueTest, RecordingReplaysCommittedSnapshots) {
+    char path[512];
+    queue_recording_path(path, sizeof(path), "replay");
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+
+    MARU_QueueRecordingInfo info;
+    EXPECT_FALSE(maru_getQueueRecordingInfo(queue, &info));
+    ASSERT_TRUE(maru_recordQueue(queue, path));
+
+    MARU_Event evt = {0};
+    evt.mouse_moved.dip_delta.x = 3.0;
+    EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_MOUSE_MOVED, 9u, &evt));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_2));
+    EXPECT_TRUE(maru_commitQueue(queue));
+
+    EXPECT_TRUE(maru_getQueueRecordingInfo(queue, &info));
+    EXPECT_EQ(info.frame_count, (uint32_t)3);
+    EXPECT_EQ(info.frame_index, (uint32_t)2);
+
+    // Stopping the recording leaves later commits out of the file.
+    EXPECT_TRUE(maru_recordQueue(queue, NULL));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_3));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    maru_destroyQueue(queue);
+
+    struct QueueDiagnosticState diag = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag;
+    MARU_Queue *replay = NULL;
+    ASSERT_TRUE(maru_openQueueRecording(path, &create_info, &replay));
+    ASSERT_TRUE(replay != NULL);
+
+    EXPECT_TRUE(maru_getQueueRecordingInfo(replay, &info));
+    EXPECT_EQ(info.frame_count, (uint32_t)3);
+    EXPECT_EQ(info.frame_index, (uint32_t)MARU_QUEUE_RECORDING_NO_FRAME);
+
+    MARU_QueueView view;
+    maru_getQueueView(replay, &view);
+    EXPECT_EQ(view.count, (uint32_t)0);
+    maru_releaseQueueView(replay, &view);
+
+    EXPECT_TRUE(maru_commitQueue(replay));
+    maru_getQueueView(replay, &view);
+    ASSERT_EQ(view.count, (uint32_t)2);
+    EXPECT_EQ(view.types[0], (MARU_EventId)MARU_EVENT_MOUSE_MOVED);
+    EXPECT_EQ(view.window_ids[0], (MARU_WindowId)9u);
+    EXPECT_EQ(view.events[0].mouse_moved.dip_delta.x, 3.0);
+    EXPECT_EQ(view.types[1], (MARU_EventId)MARU_EVENT_USER_1);
+    EXPECT_EQ(((uintptr_t)view.types) % 64u, (uintptr_t)0);
+    EXPECT_EQ(((uintptr_t)view.window_ids) % 64u, (uintptr_t)0);
+    EXPECT_EQ(((uintptr_t)view.events) % 64u, (uintptr_t)0);
+    maru_releaseQueueView(replay, &view);
+
+    EXPECT_TRUE(maru_getQueueRecordingInfo(replay, &info));
+    EXPECT_EQ(info.frame_index, (uint32_t)0);
+    const uint64_t first_timestamp = info.timestamp_ns;
+
+    EXPECT_TRUE(maru_commitQueue(replay));
+    struct QueueTestState state = {0};
+    maru_scanQueue(replay, MARU_ALL_EVENTS, on_queue_event, &state);
+    EXPECT_EQ(state.event_count, 0);
+
+    EXPECT_TRUE(maru_commitQueue(replay));
+    maru_scanQueue(replay, MARU_ALL_EVENTS, on_queue_event, &state);
+    EXPECT_EQ(state.event_count, 1);
+    EXPECT_EQ(state.last_type, (MARU_EventId)MARU_EVENT_USER_2);
+    EXPECT_TRUE(maru_getQueueRecordingInfo(replay, &info));
+    EXPECT_TRUE(info.timestamp_ns >= first_timestamp);
+
+    // The end of the recording keeps the last frame published.
+    EXPECT_FALSE(maru_commitQueue(replay));
+    maru_getQueueView(replay, &view);
+    EXPECT_EQ(view.count, (uint32_t)1);
+    maru_releaseQueueView(replay, &view);
+    EXPECT_EQ(diag.call_count, 0);
+
+    EXPECT_FALSE(push_user_event(replay, MARU_EVENT_USER_0));
+    EXPECT_EQ(diag.call_count, 1);
+    EXPECT_EQ(diag.last_diag, (MARU_Diagnostic)MARU_DIAGNOSTIC_INVALID_ARGUMENT);
+
+    EXPECT_TRUE(maru_rewindQueueRecording(replay));
+    EXPECT_TRUE(maru_commitQueue(replay));
+    maru_getQueueView(replay, &view);
+    EXPECT_EQ(view.count, (uint32_t)2);
+    maru_releaseQueueView(replay, &view);
+
+    maru_destroyQueue(replay);
+    remove(path);
+}
+
+UTEST(QueueTest, RejectsMalformedRecording) {
+    char path[512];
+    queue_recording_path(path, sizeof(path), "malformed");
+
+    struct QueueDiagnosticState diag = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag;
+
+    MARU_Queue *replay = (MARU_Queue *)0x1;
+    remove(path);
+    EXPECT_FALSE(maru_openQueueRecording(path, &create_info, &replay));
+    EXPECT_TRUE(replay == NULL);
+    EXPECT_EQ(diag.last_diag, (MARU_Diagnostic)MARU_DIAGNOSTIC_RESOURCE_UNAVAILABLE);
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+    ASSERT_TRUE(maru_recordQueue(queue, path));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    maru_destroyQueue(queue);
+
+    // Corrupt the magic of the only frame.
+    FILE *file = fopen(path, "rb");
+    ASSERT_TRUE(file != NULL);
+    unsigned char bytes[1024];
+    const size_t size = fread(bytes, 1, sizeof(bytes), file);
+    fclose(file);
+    ASSERT_TRUE(size > 128u);
+    bytes[64] ^= 0xffu;
+    file = fopen(path, "wb");
+    ASSERT_TRUE(file != NULL);
+    EXPECT_EQ(fwrite(bytes, 1, size, file), size);
+    fclose(file);
+
+    diag.call_count = 0;
+    EXPECT_FALSE(maru_openQueueRecording(path, &create_info, &replay));
+    EXPECT_EQ(diag.call_count, 1);
+    EXPECT_EQ(diag.last_diag, (MARU_Diagnostic)MARU_DIAGNOSTIC_INVALID_ARGUMENT);
+    bytes[64] ^= 0xffu;
+
+    // A header from another format version is rejected too.
+    bytes[8] ^= 0xffu;
+    file = fopen(path, "wb");
+    ASSERT_TRUE(file != NULL);
+    EXPECT_EQ(fwrite(bytes, 1, size, file), size);
+    fclose(file);
+    EXPECT_FALSE(maru_openQueueRecording(path, &create_info, &replay));
+    EXPECT_EQ(diag.call_count, 2);
+
+    remove(path);
+}
+
+static bool truncate_recording(const char *path, size_t drop) {
+    FILE *file = fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+    static unsigned char bytes[4096];
+    const size_t size = fread(bytes, 1, sizeof(bytes), file);
+    fclose(file);
+    if (size <= drop || size == sizeof(bytes)) {
+        return false;
+    }
+    file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    const bool ok = fwrite(bytes, 1, size - drop, file) == size - drop;
+    fclose(file);
+    return ok;
+}
+
+UTEST(QueueTest, OpensTheCompleteFramesOfATruncatedRecording) {
+    char path[512];
+    queue_recording_path(path, sizeof(path), "truncated");
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+    ASSERT_TRUE(maru_recordQueue(queue, path));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_0));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_1));
+    EXPECT_TRUE(push_user_event(queue, MARU_EVENT_USER_2));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    maru_destroyQueue(queue);
+
+    struct QueueDiagnosticState diag = {0};
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.diagnostic_cb = on_queue_diagnostic;
+    create_info.diagnostic_userdata = &diag;
+    MARU_QueueRecordingInfo info;
+
+    // Each cut shortens the file further: into the events of the last frame,
+    // then into its header.
+    const size_t drops[] = {8u, 64u * 4u + 8u};
+    for (size_t i = 0; i < sizeof(drops) / sizeof(drops[0]); ++i) {
+        ASSERT_TRUE(truncate_recording(path, drops[i]));
+        MARU_Queue *replay = NULL;
+        ASSERT_TRUE(maru_openQueueRecording(path, &create_info, &replay));
+        EXPECT_TRUE(maru_getQueueRecordingInfo(replay, &info));
+        EXPECT_EQ(info.frame_count, (uint32_t)1);
+
+        EXPECT_TRUE(maru_commitQueue(replay));
+        struct QueueTestState state = {0};
+        maru_scanQueue(replay, MARU_ALL_EVENTS, on_queue_event, &state);
+        EXPECT_EQ(state.event_count, 1);
+        EXPECT_EQ(state.last_type, (MARU_EventId)MARU_EVENT_USER_0);
+        EXPECT_FALSE(maru_commitQueue(replay));
+        maru_destroyQueue(replay);
+    }
+
+    // Now into the first frame: nothing to replay, but nothing malformed.
+    ASSERT_TRUE(truncate_recording(path, 64u * 2u + 8u));
+    MARU_Queue *replay = NULL;
+    ASSERT_TRUE(maru_openQueueRecording(path, &create_info, &replay));
+    EXPECT_TRUE(maru_getQueueRecordingInfo(replay, &info));
+    EXPECT_EQ(info.frame_count, (uint32_t)0);
+    EXPECT_FALSE(maru_commitQueue(replay));
+    maru_destroyQueue(replay);
+    EXPECT_EQ(diag.call_count, 0);
+
+    remove(path);
+}
+
+UTEST(QueueTest, RecordingZeroesBytesOutsideTheActiveMember) {
+    char path[512];
+    queue_recording_path(path, sizeof(path), "zeroed");
+
+    MARU_Queue *queue = NULL;
+    EXPECT_TRUE(create_queue(16, &queue));
+    ASSERT_TRUE(queue != NULL);
+    ASSERT_TRUE(maru_recordQueue(queue, path));
+
+    MARU_Event evt;
+    memset(&evt, 0xab, sizeof(evt));
+    evt.mouse_button_changed.button_id = 2u;
+    EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_MOUSE_BUTTON_CHANGED, 1u, &evt));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    maru_destroyQueue(queue);
+
+    MARU_Queue *replay = NULL;
+    ASSERT_TRUE(maru_openQueueRecording(path, NULL, &replay));
+    EXPECT_TRUE(maru_commitQueue(replay));
+    MARU_QueueView view;
+    maru_getQueueView(replay, &view);
+    ASSERT_EQ(view.count, (uint32_t)1);
+    EXPECT_EQ(view.events[0].mouse_button_changed.button_id, 2u);
+    const unsigned char *bytes = (const unsigned char *)&view.events[0];
+    bool tail_zeroed = true;
+    for (size_t i = sizeof(MARU_MouseButtonChangedEvent); i < sizeof(MARU_Event); ++i) {
+        tail_zeroed &= bytes[i] == 0u;
+    }
+    EXPECT_TRUE(tail_zeroed);
+    maru_releaseQueueView(replay, &view);
+    maru_destroyQueue(replay);
+
+    remove(path);
+}
+
+struct QueueWindowScanState {
+    uint32_t count;
+    bool in_order;
+    bool wrong_window;
+    MARU_WindowId window_id;
+    uintptr_t last_sequence;
+};
+
+static void on_window_event(MARU_EventId type,
+                            MARU_WindowId window_id,
+                            const MARU_Event *evt,
+                            void *userdata) {
+    struct QueueWindowScanState *state = (struct QueueWindowScanState *)userdata;
+    (void)type;
+    if (window_id != state->window_id) {
+        state->wrong_window = true;
+    }
+    // Each event carries its push index in `user.userdata`.
+    const uintptr_t sequence = (uintptr_t)evt->user.userdata;
+    if (state->count > 0 && sequence <= state->last_sequence) {
+        state->in_order = false;
+    }
+    state->last_sequence = sequence;
+    state->count++;
+}
+
+static struct QueueWindowScanState scan_window(const MARU_Queue *queue,
+                                               MARU_WindowId window_id,
+                                               MARU_EventMask mask) {
+    struct QueueWindowScanState state = {0};
+    state.in_order = true;
+    state.window_id = window_id;
+    maru_scanQueueForWindow(queue, window_id, mask, on_window_event, &state);
+    return state;
+}
+
+UTEST(QueueTest, ScanForWindowVisitsOnlyThatWindow) {
+    for (int indexed = 0; indexed < 2; ++indexed) {
+        MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+        create_info.capacity = 16;
+        create_info.max_capacity = 256;
+        create_info.index_windows = indexed != 0;
+        MARU_Queue *queue = NULL;
+        ASSERT_TRUE(maru_createQueue(&create_info, &queue));
+
+        EXPECT_EQ(scan_window(queue, 1u, MARU_ALL_EVENTS).count, (uint32_t)0);
+
+        // Spread 200 events over 7 windows, with runs, and grow past capacity.
+        MARU_Event evt = {0};
+        for (uint32_t i = 0; i < 200u; ++i) {
+            evt.user.userdata = (void *)(uintptr_t)i;
+            const MARU_WindowId window_id = (MARU_WindowId)((i / 3) % 7) + 1u;
+            const MARU_EventId type = (i % 2) ? MARU_EVENT_USER_1 : MARU_EVENT_USER_0;
+            ASSERT_TRUE(maru_pushQueue(queue, type, window_id, &evt));
+        }
+        EXPECT_TRUE(maru_commitQueue(queue));
+
+        uint32_t total = 0;
+        for (MARU_WindowId window_id = 1u; window_id <= 7u; ++window_id) {
+            const struct QueueWindowScanState state =
+                scan_window(queue, window_id, MARU_ALL_EVENTS);
+            EXPECT_TRUE(state.in_order);
+            EXPECT_FALSE(state.wrong_window);
+            EXPECT_TRUE(state.count > 0u);
+            total += state.count;
+        }
+        EXPECT_EQ(total, (uint32_t)200);
+        EXPECT_EQ(scan_window(queue, 8u, MARU_ALL_EVENTS).count, (uint32_t)0);
+        EXPECT_EQ(scan_window(queue, 1u, MARU_MASK_USER_1).count +
+                      scan_window(queue, 1u, MARU_MASK_USER_0).count,
+                  scan_window(queue, 1u, MARU_ALL_EVENTS).count);
+
+        // A later snapshot replaces the index of the buffer it reuses.
+        EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_USER_0, 8u, &evt));
+        EXPECT_TRUE(maru_commitQueue(queue));
+        EXPECT_TRUE(maru_commitQueue(queue));
+        EXPECT_EQ(scan_window(queue, 8u, MARU_ALL_EVENTS).count, (uint32_t)0);
+        EXPECT_EQ(scan_window(queue, 1u, MARU_ALL_EVENTS).count, (uint32_t)0);
+        EXPECT_TRUE(maru_pushQueue(queue, MARU_EVENT_USER_0, 8u, &evt));
+        EXPECT_TRUE(maru_commitQueue(queue));
+        EXPECT_EQ(scan_window(queue, 8u, MARU_ALL_EVENTS).count, (uint32_t)1);
+
+        maru_destroyQueue(queue);
+    }
+}
+
+UTEST(QueueTest, WaitReturnsOnceGenerationMoves) {
+    MARU_QueueCreateInfo create_info = MARU_QUEUE_CREATE_INFO_DEFAULT;
+    create_info.capacity = 4;
+    MARU_Queue *queue = NULL;
+    ASSERT_TRUE(maru_createQueue(&create_info, &queue));
+
+    EXPECT_EQ(maru_getQueueGeneration(queue), (uint32_t)0);
+    EXPECT_EQ(maru_waitQueue(queue, 0u, 0u), (uint32_t)0);
+    // Times out without a commit.
+    EXPECT_EQ(maru_waitQueue(queue, 0u, 1000000u), (uint32_t)0);
+
+    // Empty commits publish too.
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_TRUE(maru_commitQueue(queue));
+    EXPECT_EQ(maru_getQueueGeneration(queue), (uint32_t)2);
+    EXPECT_EQ(maru_waitQueue(queue, 0u, MARU_QUEUE_WAIT_FOREVER), (uint32_t)2);
+    EXPECT_EQ(maru_waitQueue(queue, 2u, 0u), (uint32_t)2);
+
+    maru_destroyQueue(queue);
+}
@@ -2,11 +2,16 @@
 
 #include "linux/x11/x11_internal.h"
 
+#include <stdlib.h>
 #include <string.h>
 
 static int g_xsend_event_count;
 static XEvent g_last_xsend_event;
 static int g_data_requested_count;
+static int g_convert_selection_count;
+static Time g_last_convert_time;
+static int g_mime_types_ready_count;
+static uint32_t g_mime_types_ready_size;
 
 static int test_xsend_event(Display *display, Window window, Bool propagate,
                             long event_mask, XEvent *event_send) {
@@ -22,11 +27,91 @@ static int test_xsend_event(Display *display, Window window, Bool propagate,
 static void test_event_callback(MARU_EventId type, MARU_Window *window,
                                 const MARU_Event *evt, void *userdata) {
   (void)window;
-  (void)evt;
   (void)userdata;
   if (type == MARU_EVENT_DATA_REQUESTED) {
     g_data_requested_count++;
   }
+  if (type == MARU_EVENT_MIME_TYPES_READY) {
+    g_mime_types_ready_count++;
+    g_mime_types_ready_size = evt->mime_types_ready.mime_types.count;
+  }
+}
+
+enum {
+  TEST_OWNER_WINDOW = 500,
+  TEST_ATOM_CLIPBOARD = 11,
+  TEST_ATOM_TARGETS = 20,
+  TEST_ATOM_TARGETS_PROPERTY = 21,
+  TEST_ATOM_TEXT_PLAIN = 30,
+  TEST_ATOM_IMAGE_PNG = 31,
+};
+
+static Window test_get_selection_owner(Display *display, Atom selection) {
+  (void)display;
+  (void)selection;
+  return TEST_OWNER_WINDOW;
+}
+
+static int test_convert_selection(Display *display, Atom selection, Atom target,
+                                  Atom property, Window requestor, Time time) {
+  (void)display;
+  (void)selection;
+  (void)target;
+  (void)property;
+  (void)requestor;
+  g_convert_selection_count++;
+  g_last_convert_time = time;
+  return 1;
+}
+
+static int test_delete_property(Display *display, Window window, Atom property) {
+  (void)display;
+  (void)window;
+  (void)property;
+  return 1;
+}
+
+static int test_flush(Display *display) {
+  (void)display;
+  return 1;
+}
+
+static int test_get_targets_property(Display *display, Window window, Atom property,
+                                     long offset, long length, Bool del, Atom req_type,
+                                     Atom *actual_type, int *actual_format,
+                                     unsigned long *item_count,
+                                     unsigned long *bytes_after,
+                                     unsigned char **prop) {
+  (void)display;
+  (void)window;
+  (void)property;
+  (void)offset;
+  (void)length;
+  (void)del;
+  (void)req_type;
+  Atom *atoms = (Atom *)malloc(3 * sizeof(Atom));
+  atoms[0] = TEST_ATOM_TARGETS;
+  atoms[1] = TEST_ATOM_TEXT_PLAIN;
+  atoms[2] = TEST_ATOM_IMAGE_PNG;
+  *actual_type = XA_ATOM;
+  *actual_format = 32;
+  *item_count = 3;
+  *bytes_after = 0;
+  *prop = (unsigned char *)atoms;
+  return Success;
+}
+
+static char *test_get_atom_name(Display *display, Atom atom) {
+  (void)display;
+  const char *name = atom == TEST_ATOM_TEXT_PLAIN ? "text/plain" : "image/png";
+  char *copy = (char *)malloc(strlen(name) + 1u);
+  memcpy(copy, name, strlen(name) + 1u);
+  return copy;
+}
+
+static int test_xfree(void *data) {
+  free(data);
+  return 1;
 }
 
 UTEST(X11DataExchange, SelectionNotifyIgnoresUnknownSelectionAtoms) {
@@ -56,9 +141,9 @@ UTEST(X11DataExchange, SelectionNotifyIgnoresUnknownSelectionAtoms) {
 
   ASSERT_TRUE(_maru_x11_process_dataexchange_event(&ctx, &ev));
   EXPECT_TRUE(ctx.dnd_request.pending);
-  EXPECT_EQ(ctx.dnd_request.window, &window);
-  EXPECT_EQ(ctx.dnd_request.property_atom, None);
-  EXPECT_EQ(ctx.dnd_request.userdata, (void *)0x1234);
+  EXPECT_TRUE(ctx.dnd_request.window == &window);
+  EXPECT_EQ(ctx.dnd_request.property_atom, (Atom)None);
+  EXPECT_TRUE(ctx.dnd_request.userdata == (void *)0x1234);
 }
 
 UTEST(X11DataExchange, SelectionRequestRejectsUnknownSelectionAtomsWithoutDndDispatch) {
@@ -100,7 +185,7 @@ UTEST(X11DataExchange, SelectionRequestRejectsUnknownSelectionAtomsWithoutDndDis
   EXPECT_EQ(g_last_xsend_event.type, SelectionNotify);
   EXPECT_EQ(g_last_xsend_event.xselection.requestor, ev.xselectionrequest.requestor);
   EXPECT_EQ(g_last_xsend_event.xselection.selection, ev.xselectionrequest.selection);
-  EXPECT_EQ(g_last_xsend_event.xselection.property, None);
+  EXPECT_EQ(g_last_xsend_event.xselection.property, (Atom)None);
   EXPECT_EQ(g_data_requested_count, 0);
 }
 
@@ -112,7 +197,7 @@ UTEST(X11DataExchange, DropActionNoneMapsToNoneAtom) {
   ctx.xdnd_action_move = 22;
   ctx.xdnd_action_link = 23;
 
-  EXPECT_EQ(_maru_x11_drop_action_to_atom(&ctx, MARU_DROP_ACTION_NONE), None);
+  EXPECT_EQ(_maru_x11_drop_action_to_atom(&ctx, MARU_DROP_ACTION_NONE), (Atom)None);
   EXPECT_EQ(_maru_x11_drop_action_to_atom(&ctx, MARU_DROP_ACTION_COPY),
             ctx.xdnd_action_copy);
   EXPECT_EQ(_maru_x11_drop_action_to_atom(&ctx, MARU_DROP_ACTION_MOVE),
@@ -180,3 +265,164 @@ UTEST(X11DataExchange, RejectedXdndFinishedAdvertisesNoAction) {
   EXPECT_EQ(g_last_xsend_event.xclient.data.l[1], 0);
   EXPECT_EQ(g_last_xsend_event.xclient.data.l[2], (long)None);
 }
+
+static void mime_query_fixture_init(MARU_Context_X11 *ctx, MARU_Window_X11 *window,
+                                    MARU_PumpContext *pump_ctx) {
+  memset(ctx, 0, sizeof(*ctx));
+  memset(window, 0, sizeof(*window));
+  memset(pump_ctx, 0, sizeof(*pump_ctx));
+  g_convert_selection_count = 0;
+  g_last_convert_time = CurrentTime;
+  g_mime_types_ready_count = 0;
+  g_mime_types_ready_size = 0;
+
+  ctx->base.allocator.alloc_cb = _maru_default_alloc;
+  ctx->base.allocator.realloc_cb = _maru_default_realloc;
+  ctx->base.allocator.free_cb = _maru_default_free;
+  ctx->base.tuning.x11.selection_query_timeout_ms = MARU_NEVER;
+  ctx->base.pump_ctx = pump_ctx;
+  pump_ctx->mask = MARU_ALL_EVENTS;
+  pump_ctx->callback = test_event_callback;
+
+  ctx->selection_clipboard = TEST_ATOM_CLIPBOARD;
+  ctx->selection_primary = 12;
+  ctx->xdnd_selection = 13;
+  ctx->selection_targets = TEST_ATOM_TARGETS;
+  ctx->maru_selection_targets_property = TEST_ATOM_TARGETS_PROPERTY;
+  ctx->x11_lib.XGetSelectionOwner = test_get_selection_owner;
+  ctx->x11_lib.XConvertSelection = test_convert_selection;
+  ctx->x11_lib.XDeleteProperty = test_delete_property;
+  ctx->x11_lib.XFlush = test_flush;
+  ctx->x11_lib.XGetWindowProperty = test_get_targets_property;
+  ctx->x11_lib.XGetAtomName = test_get_atom_name;
+  ctx->x11_lib.XFree = test_xfree;
+  ctx->xfixes_selection_events_available = true;
+  ctx->xfixes_event_base = 90;
+
+  window->base.ctx_base = &ctx->base;
+  window->handle = 77;
+}
+
+static void send_targets_notify(MARU_Context_X11 *ctx, const MARU_Window_X11 *window,
+                                Atom property) {
+  XEvent ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.type = SelectionNotify;
+  ev.xselection.requestor = window->handle;
+  ev.xselection.selection = TEST_ATOM_CLIPBOARD;
+  ev.xselection.target = TEST_ATOM_TARGETS;
+  ev.xselection.property = property;
+  ev.xselection.time = CurrentTime;
+  (void)_maru_x11_process_dataexchange_event(ctx, &ev);
+}
+
+UTEST(X11DataExchange, ClipboardMimeQueryCompletesAsyncAndCachesUntilOwnerChange) {
+  MARU_Context_X11 ctx;
+  MARU_Window_X11 window;
+  MARU_PumpContext pump_ctx;
+  MARU_StringList list;
+  XEvent ev;
+
+  mime_query_fixture_init(&ctx, &window, &pump_ctx);
+
+  // The first call only issues the TARGETS conversion.
+  ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                              MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                              &list) == MARU_PENDING);
+  EXPECT_EQ(list.count, 0u);
+  EXPECT_EQ(g_convert_selection_count, 1);
+
+  // While it is in flight, no second conversion is sent.
+  ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                              MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                              &list) == MARU_PENDING);
+  EXPECT_EQ(list.count, 0u);
+  EXPECT_EQ(g_convert_selection_count, 1);
+
+  memset(&ev, 0, sizeof(ev));
+  ev.type = SelectionNotify;
+  ev.xselection.requestor = window.handle;
+  ev.xselection.selection = TEST_ATOM_CLIPBOARD;
+  ev.xselection.target = TEST_ATOM_TARGETS;
+  ev.xselection.property = TEST_ATOM_TARGETS_PROPERTY;
+  ev.xselection.time = CurrentTime;
+  ASSERT_TRUE(_maru_x11_process_dataexchange_event(&ctx, &ev));
+  EXPECT_EQ(g_mime_types_ready_count, 1);
+  EXPECT_EQ(g_mime_types_ready_size, 2u);
+
+  // Served from the cache from now on.
+  ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                              MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                              &list) == MARU_SUCCESS);
+  ASSERT_EQ(list.count, 2u);
+  EXPECT_STREQ(list.strings[0], "text/plain");
+  EXPECT_STREQ(list.strings[1], "image/png");
+  EXPECT_EQ(g_convert_selection_count, 1);
+
+  // An XFixes ownership change drops the cache; the next query carries the
+  // new ownership time.
+  XFixesSelectionNotifyEvent owner_ev;
+  memset(&owner_ev, 0, sizeof(owner_ev));
+  owner_ev.type = ctx.xfixes_event_base + XFixesSelectionNotify;
+  owner_ev.subtype = XFixesSetSelectionOwnerNotify;
+  owner_ev.owner = TEST_OWNER_WINDOW;
+  owner_ev.selection = TEST_ATOM_CLIPBOARD;
+  owner_ev.selection_timestamp = 1234;
+  memset(&ev, 0, sizeof(ev));
+  memcpy(&ev, &owner_ev, sizeof(owner_ev));
+  ASSERT_TRUE(_maru_x11_process_dataexchange_event(&ctx, &ev));
+
+  ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                              MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                              &list) == MARU_PENDING);
+  EXPECT_EQ(list.count, 0u);
+  EXPECT_EQ(g_convert_selection_count, 2);
+  EXPECT_EQ(g_last_convert_time, (Time)1234);
+
+  // A reply to the superseded query is swallowed without completing.
+  memset(&ev, 0, sizeof(ev));
+  ev.type = SelectionNotify;
+  ev.xselection.requestor = window.handle;
+  ev.xselection.selection = TEST_ATOM_CLIPBOARD;
+  ev.xselection.target = TEST_ATOM_TARGETS;
+  ev.xselection.property = TEST_ATOM_TARGETS_PROPERTY;
+  ev.xselection.time = CurrentTime;
+  ASSERT_TRUE(_maru_x11_process_dataexchange_event(&ctx, &ev));
+  EXPECT_EQ(g_mime_types_ready_count, 1);
+  EXPECT_TRUE(ctx.clipboard_targets.pending);
+
+  _maru_x11_clear_mime_query_cache(&ctx);
+  _maru_x11_clear_selection_targets(&ctx, &ctx.clipboard_targets);
+}
+
+UTEST(X11DataExchange, ClipboardMimeQueryTellsPendingFromEmptyAnswer) {
+  MARU_Context_X11 ctx;
+  MARU_Window_X11 window;
+  MARU_PumpContext pump_ctx;
+  MARU_StringList list;
+
+  mime_query_fixture_init(&ctx, &window, &pump_ctx);
+
+  ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                              MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                              &list) == MARU_PENDING);
+  EXPECT_TRUE(list.strings == NULL);
+  EXPECT_EQ(list.count, 0u);
+
+  // The owner refuses the conversion: that is an answer, just an empty one.
+  send_targets_notify(&ctx, &window, None);
+  EXPECT_EQ(g_mime_types_ready_count, 1);
+  EXPECT_EQ(g_mime_types_ready_size, 0u);
+  EXPECT_FALSE(ctx.clipboard_targets.pending);
+
+  for (int i = 0; i < 2; ++i) {
+    ASSERT_TRUE(_maru_x11_getAvailableMIMETypes((MARU_Window *)&window,
+                                                MARU_DATA_EXCHANGE_TARGET_CLIPBOARD,
+                                                &list) == MARU_SUCCESS);
+    EXPECT_EQ(list.count, 0u);
+  }
+  EXPECT_EQ(g_convert_selection_count, 1);
+
+  _maru_x11_clear_mime_query_cache(&ctx);
+  _maru_x11_clear_selection_targets(&ctx, &ctx.clipboard_targets);
+}
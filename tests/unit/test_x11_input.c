@@ -0,0 +1,178 @@
+#include "utest.h"
+
+#include "linux/x11/x11_internal.h"
+
+#include <string.h>
+
+#define TEST_XI2_OPCODE 131
+
+static int g_query_pointer_count;
+static int g_mouse_moved_count;
+static MARU_MouseMovedEvent g_last_mouse_moved;
+static int g_mouse_scrolled_count;
+static MARU_MouseScrolledEvent g_last_mouse_scrolled;
+
+static Bool test_query_pointer(Display *display, Window window, Window *root_ret,
+                               Window *child_ret, int *root_x, int *root_y,
+                               int *win_x, int *win_y, unsigned int *mask) {
+  (void)display;
+  (void)window;
+  (void)root_ret;
+  (void)child_ret;
+  (void)root_x;
+  (void)root_y;
+  (void)win_x;
+  (void)win_y;
+  g_query_pointer_count++;
+  *mask = 0u;
+  return True;
+}
+
+static Bool test_get_event_data(Display *display, XGenericEventCookie *cookie) {
+  (void)display;
+  (void)cookie;
+  return True;
+}
+
+static void test_free_event_data(Display *display, XGenericEventCookie *cookie) {
+  (void)display;
+  (void)cookie;
+}
+
+static void test_event_callback(MARU_EventId type, MARU_Window *window,
+                                const MARU_Event *evt, void *userdata) {
+  (void)window;
+  (void)userdata;
+  if (type == MARU_EVENT_MOUSE_MOVED) {
+    g_mouse_moved_count++;
+    g_last_mouse_moved = evt->mouse_moved;
+  } else if (type == MARU_EVENT_MOUSE_SCROLLED) {
+    g_mouse_scrolled_count++;
+    g_last_mouse_scrolled = evt->mouse_scrolled;
+  }
+}
+
+UTEST(X11Input, LockedRawMotionMakesNoRoundTrips) {
+  MARU_Context_X11 ctx;
+  MARU_Window_X11 window;
+  MARU_PumpContext pump_ctx;
+  XIRawEvent raw;
+  unsigned char mask_bits[1];
+  double raw_values[2];
+  XEvent ev;
+
+  memset(&ctx, 0, sizeof(ctx));
+  memset(&window, 0, sizeof(window));
+  memset(&pump_ctx, 0, sizeof(pump_ctx));
+  memset(&raw, 0, sizeof(raw));
+  memset(&ev, 0, sizeof(ev));
+  g_query_pointer_count = 0;
+  g_mouse_moved_count = 0;
+
+  ctx.x11_lib.XQueryPointer = test_query_pointer;
+  ctx.x11_lib.XGetEventData = test_get_event_data;
+  ctx.x11_lib.XFreeEventData = test_free_event_data;
+  ctx.xi2_raw_motion_enabled = true;
+  ctx.xi2_opcode = TEST_XI2_OPCODE;
+  ctx.base.pump_ctx = &pump_ctx;
+  pump_ctx.mask = MARU_ALL_EVENTS;
+  pump_ctx.callback = test_event_callback;
+
+  window.handle = 77;
+  window.base.pub.cursor_mode = MARU_CURSOR_LOCKED;
+  window.lock_pointer_barriers_active = true;
+  ctx.locked_window = &window;
+
+  // Modifier state comes from the last core input event seen on the connection.
+  ev.type = MotionNotify;
+  ev.xmotion.window = 99;
+  ev.xmotion.state = ShiftMask | ControlMask;
+  ASSERT_TRUE(_maru_x11_process_input_event(&ctx, &ev));
+
+  mask_bits[0] = 0x3;
+  raw_values[0] = 3.0;
+  raw_values[1] = -4.0;
+  raw.valuators.mask_len = 1;
+  raw.valuators.mask = mask_bits;
+  raw.raw_values = raw_values;
+
+  memset(&ev, 0, sizeof(ev));
+  ev.type = GenericEvent;
+  ev.xcookie.extension = TEST_XI2_OPCODE;
+  ev.xcookie.evtype = XI_RawMotion;
+  ev.xcookie.data = &raw;
+
+  const int raw_event_count = 8;
+  for (int i = 0; i < raw_event_count; ++i) {
+    _maru_x11_process_event(&ctx, &ev);
+  }
+
+  EXPECT_EQ(g_query_pointer_count, 0);
+  EXPECT_EQ(g_mouse_moved_count, raw_event_count);
+  EXPECT_EQ(g_last_mouse_moved.dip_delta.x, (MARU_Scalar)3.0);
+  EXPECT_EQ(g_last_mouse_moved.dip_delta.y, (MARU_Scalar)-4.0);
+  EXPECT_EQ(g_last_mouse_moved.modifiers,
+            (MARU_ModifierFlags)(MARU_MODIFIER_SHIFT | MARU_MODIFIER_CONTROL));
+}
+
+UTEST(X11Input, Xi2PointerEventsUseTheDeviceTime) {
+  MARU_Context_X11 ctx;
+  MARU_Window_X11 window;
+  MARU_PumpContext pump_ctx;
+  XIDeviceEvent dev;
+  unsigned char button_bits[1];
+  XEvent ev;
+
+  memset(&ctx, 0, sizeof(ctx));
+  memset(&window, 0, sizeof(window));
+  memset(&pump_ctx, 0, sizeof(pump_ctx));
+  memset(&dev, 0, sizeof(dev));
+  memset(&ev, 0, sizeof(ev));
+  g_mouse_moved_count = 0;
+  g_mouse_scrolled_count = 0;
+
+  ctx.x11_lib.XGetEventData = test_get_event_data;
+  ctx.x11_lib.XFreeEventData = test_free_event_data;
+  ctx.xi2_raw_motion_enabled = true;
+  ctx.xi2_opcode = TEST_XI2_OPCODE;
+  ctx.base.pump_ctx = &pump_ctx;
+  pump_ctx.mask = MARU_ALL_EVENTS;
+  pump_ctx.callback = test_event_callback;
+
+  window.handle = 77;
+  ctx.base.window_list_head = &window.base;
+
+  const uint64_t device_ms = _maru_linux_get_monotonic_time_ns() / 1000000u - 5u;
+  button_bits[0] = 0x2;
+  dev.evtype = XI_Motion;
+  dev.time = (Time)(uint32_t)device_ms;
+  dev.event = window.handle;
+  dev.event_x = 12.75;
+  dev.event_y = 30.0;
+  dev.mods.effective = ShiftMask;
+  dev.buttons.mask_len = 1;
+  dev.buttons.mask = button_bits;
+
+  ev.type = GenericEvent;
+  ev.xcookie.extension = TEST_XI2_OPCODE;
+  ev.xcookie.evtype = XI_Motion;
+  ev.xcookie.data = &dev;
+  _maru_x11_process_event(&ctx, &ev);
+
+  ASSERT_EQ(g_mouse_moved_count, 1);
+  EXPECT_EQ(g_last_mouse_moved.timestamp_ns, device_ms * 1000000u);
+  EXPECT_EQ(g_last_mouse_moved.dip_position.x, (MARU_Scalar)12.0);
+  EXPECT_EQ(g_last_mouse_moved.dip_position.y, (MARU_Scalar)30.0);
+  EXPECT_EQ(g_last_mouse_moved.modifiers, (MARU_ModifierFlags)MARU_MODIFIER_SHIFT);
+  EXPECT_EQ(ctx.input_state, (unsigned int)(ShiftMask | Button1Mask));
+
+  dev.evtype = XI_ButtonPress;
+  dev.detail = 4;
+  dev.time = (Time)(uint32_t)(device_ms + 1u);
+  ev.xcookie.evtype = XI_ButtonPress;
+  _maru_x11_process_event(&ctx, &ev);
+
+  ASSERT_EQ(g_mouse_scrolled_count, 1);
+  EXPECT_EQ(g_last_mouse_scrolled.timestamp_ns, (device_ms + 1u) * 1000000u);
+  EXPECT_EQ(g_last_mouse_scrolled.steps.y, 1);
+}
@@ -0,0 +1,256 @@
+#include "utest.h"
+
+#include "linux/x11/x11_internal.h"
+#include "maru_mem_internal.h"
+
+#include <string.h>
+
+#define TEST_EVENT_BASE 90
+
+// The fake server state the XRandR stubs report.
+static XRRModeInfo g_modes[2];
+static RRMode g_output_modes[2];
+static RROutput g_outputs[2];
+static XRRMonitorInfo g_monitors[2];
+static int g_monitor_count;
+static RRMode g_current_mode;
+
+static int g_connected_count;
+static int g_lost_count;
+static int g_mode_changed_count;
+static MARU_Monitor *g_last_monitor;
+
+static Bool test_query_extension(Display *display, int *event_base, int *error_base) {
+  (void)display;
+  *event_base = TEST_EVENT_BASE;
+  *error_base = 0;
+  return True;
+}
+
+static void test_select_input(Display *display, Window window, int mask) {
+  (void)display;
+  (void)window;
+  (void)mask;
+}
+
+static int test_update_configuration(XEvent *event) {
+  (void)event;
+  return 1;
+}
+
+static XRRScreenResources g_resources;
+
+static XRRScreenResources *test_get_resources(Display *display, Window window) {
+  (void)display;
+  (void)window;
+  g_resources.nmode = 2;
+  g_resources.modes = g_modes;
+  return &g_resources;
+}
+
+static void test_free_resources(XRRScreenResources *resources) { (void)resources; }
+
+static XRRMonitorInfo *test_get_monitors(Display *display, Window window, Bool active,
+                                         int *count) {
+  (void)display;
+  (void)window;
+  (void)active;
+  *count = g_monitor_count;
+  return g_monitors;
+}
+
+static void test_free_monitors(XRRMonitorInfo *monitors) { (void)monitors; }
+
+static RROutput test_get_output_primary(Display *display, Window window) {
+  (void)display;
+  (void)window;
+  return g_outputs[0];
+}
+
+static XRROutputInfo g_output_info;
+
+static XRROutputInfo *test_get_output_info(Display *display, XRRScreenResources *resources,
+                                           RROutput output) {
+  (void)display;
+  (void)resources;
+  memset(&g_output_info, 0, sizeof(g_output_info));
+  g_output_info.crtc = (RRCrtc)(output + 100u);
+  g_output_info.nmode = 2;
+  g_output_info.modes = g_output_modes;
+  return &g_output_info;
+}
+
+static void test_free_output_info(XRROutputInfo *info) { (void)info; }
+
+static XRRCrtcInfo g_crtc_info;
+
+static XRRCrtcInfo *test_get_crtc_info(Display *display, XRRScreenResources *resources,
+                                       RRCrtc crtc) {
+  (void)display;
+  (void)resources;
+  (void)crtc;
+  memset(&g_crtc_info, 0, sizeof(g_crtc_info));
+  g_crtc_info.mode = g_current_mode;
+  return &g_crtc_info;
+}
+
+static void test_free_crtc_info(XRRCrtcInfo *info) { (void)info; }
+
+static Atom test_intern_atom(Display *display, const char *name, Bool only_if_exists) {
+  (void)display;
+  (void)name;
+  (void)only_if_exists;
+  return None;
+}
+
+static void test_event_callback(MARU_EventId type, MARU_Window *window,
+                                const MARU_Event *evt, void *userdata) {
+  (void)window;
+  (void)userdata;
+  if (type == MARU_EVENT_MONITOR_CHANGED) {
+    if (evt->monitor_changed.connected) {
+      g_connected_count++;
+    } else {
+      g_lost_count++;
+    }
+    g_last_monitor = evt->monitor_changed.monitor;
+  } else if (type == MARU_EVENT_MONITOR_MODE_CHANGED) {
+    g_mode_changed_count++;
+    g_last_monitor = evt->monitor_mode_changed.monitor;
+  }
+}
+
+struct MonitorFixture {
+  MARU_Context_X11 ctx;
+  MARU_PumpContext pump_ctx;
+};
+
+static void set_monitor(int index, RROutput output, int x) {
+  g_outputs[index] = output;
+  memset(&g_monitors[index], 0, sizeof(g_monitors[index]));
+  g_monitors[index].noutput = 1;
+  g_monitors[index].outputs = &g_outputs[index];
+  g_monitors[index].x = x;
+  g_monitors[index].width = 1920;
+  g_monitors[index].height = 1080;
+}
+
+static void monitor_fixture_init(struct MonitorFixture *f) {
+  memset(f, 0, sizeof(*f));
+  memset(g_modes, 0, sizeof(g_modes));
+  g_modes[0].id = 1;
+  g_modes[0].width = 1920;
+  g_modes[0].height = 1080;
+  g_modes[1].id = 2;
+  g_modes[1].width = 1280;
+  g_modes[1].height = 720;
+  g_output_modes[0] = 1;
+  g_output_modes[1] = 2;
+  g_current_mode = 1;
+  set_monitor(0, 10, 0);
+  g_monitor_count = 1;
+  g_connected_count = 0;
+  g_lost_count = 0;
+  g_mode_changed_count = 0;
+  g_last_monitor = NULL;
+
+  f->ctx.base.allocator.alloc_cb = _maru_default_alloc;
+  f->ctx.base.allocator.realloc_cb = _maru_default_realloc;
+  f->ctx.base.allocator.free_cb = _maru_default_free;
+  f->ctx.base.pump_ctx = &f->pump_ctx;
+  f->pump_ctx.mask = MARU_ALL_EVENTS;
+  f->pump_ctx.callback = test_event_callback;
+  f->ctx.display = (Display *)&f->ctx;
+  f->ctx.x11_lib.XInternAtom = test_intern_atom;
+
+  f->ctx.xrandr_lib.base.available = true;
+  f->ctx.xrandr_lib.XRRQueryExtension = test_query_extension;
+  f->ctx.xrandr_lib.XRRSelectInput = test_select_input;
+  f->ctx.xrandr_lib.XRRUpdateConfiguration = test_update_configuration;
+  f->ctx.xrandr_lib.XRRGetScreenResourcesCurrent = test_get_resources;
+  f->ctx.xrandr_lib.XRRFreeScreenResources = test_free_resources;
+  f->ctx.xrandr_lib.XRRGetMonitors = test_get_monitors;
+  f->ctx.xrandr_lib.XRRFreeMonitors = test_free_monitors;
+  f->ctx.xrandr_lib.XRRGetOutputPrimary = test_get_output_primary;
+  f->ctx.xrandr_lib.XRRGetOutputInfo = test_get_output_info;
+  f->ctx.xrandr_lib.XRRFreeOutputInfo = test_free_output_info;
+  f->ctx.xrandr_lib.XRRGetCrtcInfo = test_get_crtc_info;
+  f->ctx.xrandr_lib.XRRFreeCrtcInfo = test_free_crtc_info;
+}
+
+static void monitor_fixture_cleanup(struct MonitorFixture *f) {
+  for (uint32_t i = 0; i < f->ctx.base.monitor_cache_count; ++i) {
+    MARU_Monitor_X11 *monitor = (MARU_Monitor_X11 *)f->ctx.base.monitor_cache[i];
+    maru_context_free(&f->ctx.base, monitor->modes);
+    _maru_monitor_set_name(&monitor->base, NULL);
+    maru_context_free(&f->ctx.base, monitor);
+  }
+  maru_context_free(&f->ctx.base, f->ctx.base.monitor_cache);
+}
+
+static bool send_randr_notify(struct MonitorFixture *f) {
+  XEvent ev;
+  memset(&ev, 0, sizeof(ev));
+  ev.type = TEST_EVENT_BASE + RRNotify;
+  const bool handled = _maru_x11_process_monitor_event(&f->ctx, &ev);
+  _maru_x11_dispatch_monitor_changes(&f->ctx);
+  return handled;
+}
+
+static const MARU_Monitor_Base *cached_monitor(const struct MonitorFixture *f,
+                                               uint32_t index) {
+  return (const MARU_Monitor_Base *)f->ctx.base.monitor_cache[index];
+}
+
+UTEST(X11Monitor, SelectingRandrPrimesTheCacheSilently) {
+  struct MonitorFixture f;
+  monitor_fixture_init(&f);
+
+  _maru_x11_init_monitor_events(&f.ctx);
+  EXPECT_TRUE(f.ctx.xrandr_events_available);
+  EXPECT_TRUE(f.ctx.monitors_valid);
+  ASSERT_EQ(f.ctx.base.monitor_cache_count, (uint32_t)1);
+  EXPECT_TRUE(cached_monitor(&f, 0)->pub.is_primary);
+  EXPECT_EQ(cached_monitor(&f, 0)->pub.current_mode.px_size.x, 1920);
+  EXPECT_EQ(g_connected_count, 0);
+
+  monitor_fixture_cleanup(&f);
+}
+
+UTEST(X11Monitor, FirstNotificationReportsConnectedMonitor) {
+  struct MonitorFixture f;
+  monitor_fixture_init(&f);
+  _maru_x11_init_monitor_events(&f.ctx);
+
+  // maru_getMonitors() is never called.
+  set_monitor(1, 11, 1920);
+  g_monitor_count = 2;
+  EXPECT_TRUE(send_randr_notify(&f));
+  EXPECT_EQ(g_connected_count, 1);
+  EXPECT_EQ(g_mode_changed_count, 0);
+  ASSERT_EQ(f.ctx.base.monitor_cache_count, (uint32_t)2);
+  EXPECT_TRUE(g_last_monitor == f.ctx.base.monitor_cache[1]);
+  EXPECT_FALSE(f.ctx.monitors_dirty);
+
+  monitor_fixture_cleanup(&f);
+}
+
+UTEST(X11Monitor, FirstNotificationReportsModeChange) {
+  struct MonitorFixture f;
+  monitor_fixture_init(&f);
+  _maru_x11_init_monitor_events(&f.ctx);
+
+  g_current_mode = 2;
+  EXPECT_TRUE(send_randr_notify(&f));
+  EXPECT_EQ(g_mode_changed_count, 1);
+  EXPECT_EQ(g_connected_count, 0);
+  ASSERT_EQ(f.ctx.base.monitor_cache_count, (uint32_t)1);
+  EXPECT_TRUE(g_last_monitor == f.ctx.base.monitor_cache[0]);
+  EXPECT_EQ(cached_monitor(&f, 0)->pub.current_mode.px_size.x, 1280);
+
+  // A notification without a change reports nothing.
+  EXPECT_TRUE(send_randr_notify(&f));
+  EXPECT_EQ(g_mode_changed_count, 1);
+
+  monitor_fixture_cleanup(&f);
+}
@@ -0,0 +1,163 @@
+#include "utest.h"
+
+#include "linux/x11/x11_internal.h"
+
+#include <string.h>
+
+static int g_notify_msc_count;
+static uint32_t g_last_notify_serial;
+static int g_frame_count;
+static MARU_WindowFrameEvent g_last_frame;
+
+static Bool test_get_event_data(Display *display, XGenericEventCookie *cookie) {
+  (void)display;
+  (void)cookie;
+  return True;
+}
+
+static void test_free_event_data(Display *display, XGenericEventCookie *cookie) {
+  (void)display;
+  (void)cookie;
+}
+
+static int test_flush(Display *display) {
+  (void)display;
+  return 1;
+}
+
+static void test_notify_msc(Display *display, Window window, uint32_t serial,
+                            uint64_t target_msc, uint64_t divisor,
+                            uint64_t remainder) {
+  (void)display;
+  (void)window;
+  (void)target_msc;
+  (void)divisor;
+  (void)remainder;
+  g_notify_msc_count++;
+  g_last_notify_serial = serial;
+}
+
+static void test_event_callback(MARU_EventId type, MARU_Window *window,
+                                const MARU_Event *evt, void *userdata) {
+  (void)window;
+  (void)userdata;
+  if (type == MARU_EVENT_WINDOW_FRAME) {
+    g_frame_count++;
+    g_last_frame = evt->window_frame;
+  }
+}
+
+struct PresentFixture {
+  MARU_Context_X11 ctx;
+  MARU_Window_X11 window;
+  MARU_PumpContext pump_ctx;
+};
+
+static void present_fixture_init(struct PresentFixture *f) {
+  memset(f, 0, sizeof(*f));
+  g_notify_msc_count = 0;
+  g_last_notify_serial = 0;
+  g_frame_count = 0;
+  memset(&g_last_frame, 0, sizeof(g_last_frame));
+
+  f->ctx.x11_lib.XGetEventData = test_get_event_data;
+  f->ctx.x11_lib.XFreeEventData = test_free_event_data;
+  f->ctx.x11_lib.XFlush = test_flush;
+  f->ctx.xpresent_lib.XPresentNotifyMSC = test_notify_msc;
+  f->ctx.base.pump_ctx = &f->pump_ctx;
+  f->pump_ctx.mask = MARU_ALL_EVENTS;
+  f->pump_ctx.callback = test_event_callback;
+
+  f->window.handle = 42;
+  f->window.present_event_id = 7;
+  f->ctx.base.window_list_head = &f->window.base;
+}
+
+static void send_complete(struct PresentFixture *f, uint8_t kind, uint8_t mode,
+                          uint32_t serial, uint64_t ust_us, uint64_t msc) {
+  MARU_XPresentCompleteNotifyEvent complete;
+  XEvent ev;
+  memset(&complete, 0, sizeof(complete));
+  memset(&ev, 0, sizeof(ev));
+  complete.window = f->window.handle;
+  complete.kind = kind;
+  complete.mode = mode;
+  complete.serial_number = serial;
+  complete.ust = ust_us;
+  complete.msc = msc;
+  ev.type = GenericEvent;
+  ev.xcookie.evtype = PresentCompleteNotify;
+  ev.xcookie.data = &complete;
+  _maru_x11_process_present_event(&f->ctx, &ev);
+}
+
+static void request_frame(struct PresentFixture *f) {
+  f->window.pending_frame_request = true;
+  _maru_x11_dispatch_pending_frames(&f->ctx);
+}
+
+UTEST(X11Window, NotifyMscSamplesVblankUntilSwapsReport) {
+  struct PresentFixture f;
+  present_fixture_init(&f);
+
+  request_frame(&f);
+  EXPECT_EQ(g_frame_count, 1);
+  EXPECT_EQ(g_last_frame.last_presentation_ns, (uint64_t)0);
+  ASSERT_EQ(g_notify_msc_count, 1);
+
+  // Only one sample is in flight at a time.
+  request_frame(&f);
+  EXPECT_EQ(g_notify_msc_count, 1);
+
+  send_complete(&f, PresentCompleteKindNotifyMSC, 0, g_last_notify_serial, 1000u, 10u);
+  send_complete(&f, PresentCompleteKindNotifyMSC, 0, g_last_notify_serial, 1000u, 10u);
+  request_frame(&f);
+  EXPECT_EQ(g_last_frame.last_presentation_ns, (uint64_t)1000000u);
+  EXPECT_EQ(g_last_frame.presentation_msc, (uint64_t)10u);
+  EXPECT_EQ(g_notify_msc_count, 2);
+
+  send_complete(&f, PresentCompleteKindNotifyMSC, 0, g_last_notify_serial, 17666u, 11u);
+  request_frame(&f);
+  EXPECT_EQ(g_last_frame.refresh_interval_ns, (uint32_t)16666000u);
+}
+
+UTEST(X11Window, NotifyMscIgnoresStaleSerials) {
+  struct PresentFixture f;
+  present_fixture_init(&f);
+
+  request_frame(&f);
+  ASSERT_EQ(g_notify_msc_count, 1);
+  send_complete(&f, PresentCompleteKindNotifyMSC, 0, g_last_notify_serial + 1u, 1000u, 10u);
+  EXPECT_TRUE(f.window.present_notify_pending);
+  EXPECT_EQ(f.window.last_presentation_ns, (uint64_t)0);
+}
+
+UTEST(X11Window, SwapCompletionsReportActualPresentation) {
+  struct PresentFixture f;
+  present_fixture_init(&f);
+
+  request_frame(&f);
+  ASSERT_EQ(g_notify_msc_count, 1);
+  const uint32_t sample_serial = g_last_notify_serial;
+
+  send_complete(&f, PresentCompleteKindPixmap, PresentCompleteModeFlip, 0u, 5000u, 20u);
+  EXPECT_EQ(f.window.last_presentation_ns, (uint64_t)5000000u);
+  EXPECT_EQ(f.window.presentation_msc, (uint64_t)20u);
+
+  // The vblank sample no longer overrides the swap timing, and no new one is
+  // requested.
+  send_complete(&f, PresentCompleteKindNotifyMSC, 0, sample_serial, 6000u, 21u);
+  EXPECT_EQ(f.window.last_presentation_ns, (uint64_t)5000000u);
+  request_frame(&f);
+  EXPECT_EQ(g_notify_msc_count, 1);
+
+  // Skipped swaps never reached the display.
+  send_complete(&f, PresentCompleteKindPixmap, PresentCompleteModeSkip, 0u, 9000u, 25u);
+  EXPECT_EQ(f.window.presentation_msc, (uint64_t)20u);
+
+  send_complete(&f, PresentCompleteKindPixmap, PresentCompleteModeCopy, 0u, 38332u, 22u);
+  request_frame(&f);
+  EXPECT_EQ(g_last_frame.last_presentation_ns, (uint64_t)38332000u);
+  EXPECT_EQ(g_last_frame.presentation_msc, (uint64_t)22u);
+  EXPECT_EQ(g_last_frame.refresh_interval_ns, (uint32_t)16666000u);
+}
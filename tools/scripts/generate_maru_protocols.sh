@@ -41,6 +41,8 @@ gen_proto "$XML_DIR/idle-inhibit-unstable-v1.xml"
 gen_proto "$XML_DIR/ext-idle-notify-v1.xml"
 gen_proto "$XML_DIR/xdg-activation-v1.xml"
 gen_proto "$XML_DIR/content-type-v1.xml"
+gen_proto "$XML_DIR/input-timestamps-unstable-v1.xml"
+gen_proto "$XML_DIR/presentation-time.xml"
 gen_proto "$XML_DIR/tablet-v2.xml"
 
 echo "Done."